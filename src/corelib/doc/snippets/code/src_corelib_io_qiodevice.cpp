@@ -107,3 +107,13 @@ bool isExeFile(QFile *file)
     return file->peek(2) == "MZ";
 }
 //! [5]
+
+
+//! [6]
+void sendMessage(QTcpSocket *socket, const QByteArray &payload)
+{
+    const quint32 length = qToBigEndian(quint32(payload.size()));
+    const QByteArrayView header(reinterpret_cast<const char *>(&length), sizeof(length));
+    socket->writev({ header, payload });
+}
+//! [6]
@@ -354,3 +354,10 @@ size_t qHash(const K &key);
 size_t qHash(K key, size_t seed);
 size_t qHash(const K &key, size_t seed);
 //! [32]
+
+//! [33]
+QHash<QString, int> keywords = { { "if", 1 }, { "else", 2 }, { "while", 3 } };
+QString line = "while (true)";
+QStringView word = QStringView(line).left(line.indexOf(u' '));
+int token = keywords.value(word, -1);   // no temporary QString
+//! [33]
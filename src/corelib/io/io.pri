@@ -105,6 +105,14 @@ qtConfig(filesystemwatcher) {
     }
 }
 
+qtConfig(future) {
+    SOURCES += \
+        io/qrandomaccessasyncfile.cpp
+    HEADERS += \
+        io/qrandomaccessasyncfile.h \
+        io/qrandomaccessasyncfile_p.h
+}
+
 qtConfig(processenvironment) {
     SOURCES += \
         io/qprocess.cpp
@@ -1206,6 +1206,16 @@ qint64 QAbstractFileEngine::readLine(char *data, qint64 maxlen)
 
    \value UnMapExtension Whether the file engine provides the ability to
    unmap memory that was previously mapped.
+
+   \value ReadVectoredExtension Whether the file engine can read into
+   several buffers with a single operation. The input is a
+   ReadVectoredExtensionOption and the number of bytes read is stored in
+   a VectoredExtensionReturn. This extension was introduced in Qt 6.0.
+
+   \value WriteVectoredExtension Whether the file engine can write several
+   buffers with a single operation. The input is a
+   WriteVectoredExtensionOption and the number of bytes written is stored
+   in a VectoredExtensionReturn. This extension was introduced in Qt 6.0.
 */
 
 /*!
@@ -170,7 +170,9 @@ public:
         AtEndExtension,
         FastReadLineExtension,
         MapExtension,
-        UnMapExtension
+        UnMapExtension,
+        ReadVectoredExtension,
+        WriteVectoredExtension
     };
     class ExtensionOption
     {};
@@ -193,6 +195,22 @@ public:
         uchar *address;
     };
 
+    class ReadVectoredExtensionOption : public ExtensionOption {
+    public:
+        char *const *data;
+        const qint64 *maxSizes;
+        qsizetype count;
+    };
+    class WriteVectoredExtensionOption : public ExtensionOption {
+    public:
+        const QByteArrayView *buffers;
+        qsizetype count;
+    };
+    class VectoredExtensionReturn : public ExtensionReturn {
+    public:
+        qint64 result;
+    };
+
     virtual bool extension(Extension extension, const ExtensionOption *option = nullptr, ExtensionReturn *output = nullptr);
     virtual bool supportsExtension(Extension extension) const;
 
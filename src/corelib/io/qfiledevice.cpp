@@ -44,6 +44,12 @@
 
 #include <private/qmemory_p.h>
 
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <errno.h>
+#include <limits>
+#endif
+
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
 #endif
@@ -565,6 +571,86 @@ qint64 QFileDevice::writeData(const char *data, qint64 len)
     return len;
 }
 
+/*!
+    \reimp
+    \since 6.0
+
+    Reads into all buffers with a single system call if the file engine
+    supports it.
+*/
+qint64 QFileDevice::readDataVectored(char *const *data, const qint64 *maxSizes, qsizetype count)
+{
+    Q_D(QFileDevice);
+    if (!d->fileEngine->supportsExtension(QAbstractFileEngine::ReadVectoredExtension))
+        return QIODevice::readDataVectored(data, maxSizes, count);
+
+    unsetError();
+    if (!d->ensureFlushed())
+        return -1;
+
+    QAbstractFileEngine::ReadVectoredExtensionOption option;
+    option.data = data;
+    option.maxSizes = maxSizes;
+    option.count = count;
+    QAbstractFileEngine::VectoredExtensionReturn r;
+    if (!d->fileEngine->extension(QAbstractFileEngine::ReadVectoredExtension, &option, &r)) {
+        QFileDevice::FileError err = d->fileEngine->error();
+        if (err == QFileDevice::UnspecifiedError)
+            err = QFileDevice::ReadError;
+        d->setError(err, d->fileEngine->errorString());
+        return -1;
+    }
+
+    qint64 len = 0;
+    for (qsizetype i = 0; i < count; ++i)
+        len += maxSizes[i];
+    if (r.result < len) {
+        // failed to read all requested, may be at the end of file, stop caching size so that it's rechecked
+        d->cachedSize = 0;
+    }
+    return r.result;
+}
+
+/*!
+    \reimp
+    \since 6.0
+
+    Appends the buffers to the write buffer if they fit in it; otherwise
+    flushes it and writes all buffers with a single system call if the file
+    engine supports it.
+*/
+qint64 QFileDevice::writeDataVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_D(QFileDevice);
+    qint64 len = 0;
+    for (qsizetype i = 0; i < count; ++i)
+        len += buffers[i].size();
+
+    const bool buffered = !(d->openMode & Unbuffered);
+    if ((buffered && d->writeBuffer.size() + len <= d->writeBufferChunkSize)
+            || !d->fileEngine->supportsExtension(QAbstractFileEngine::WriteVectoredExtension)) {
+        return QIODevice::writeDataVectored(buffers, count);
+    }
+
+    unsetError();
+    d->lastWasWrite = true;
+    if (buffered && !flush())
+        return -1;
+
+    QAbstractFileEngine::WriteVectoredExtensionOption option;
+    option.buffers = buffers;
+    option.count = count;
+    QAbstractFileEngine::VectoredExtensionReturn r;
+    if (!d->fileEngine->extension(QAbstractFileEngine::WriteVectoredExtension, &option, &r)) {
+        QFileDevice::FileError err = d->fileEngine->error();
+        if (err == QFileDevice::UnspecifiedError)
+            err = QFileDevice::WriteError;
+        d->setError(err, d->fileEngine->errorString());
+        return -1;
+    }
+    return r.result;
+}
+
 /*!
     Returns the file error status.
 
@@ -683,6 +769,15 @@ bool QFileDevice::setPermissions(Permissions permissions)
     memory is unmapped.  It is unspecified whether modifications made
     to the file made after the mapping is created will be visible through
     the mapped memory. This enum value was introduced in Qt 5.4.
+    \value MapSequentialHint The mapped memory will be read mostly
+    sequentially, so the system may read ahead aggressively and drop pages
+    soon after they were accessed. This enum value was introduced in Qt 6.0.
+    \value MapWillNeedHint The whole mapped range will be needed soon, so
+    the system may start reading it in right away. This enum value was
+    introduced in Qt 6.0.
+
+    The hints are passed to \c madvise() where it is available, and are
+    ignored otherwise.
 */
 
 /*!
@@ -716,6 +811,133 @@ uchar *QFileDevice::map(qint64 offset, qint64 size, MemoryMapFlags flags)
     return nullptr;
 }
 
+#ifdef Q_OS_UNIX
+namespace {
+// Stored at the start of the page in front of the data of a mapped QByteArray
+struct QMappedByteArrayRegion
+{
+    void *address;
+    size_t length;
+};
+
+void releaseMappedByteArray(void *info)
+{
+    // The region record lives inside the range being unmapped
+    const QMappedByteArrayRegion region = *static_cast<QMappedByteArrayRegion *>(info);
+    ::munmap(region.address, region.length);
+}
+
+void adviseMapping(void *address, size_t length, QFileDevice::MemoryMapFlags flags)
+{
+    if (flags & QFileDevice::MapSequentialHint)
+        posix_madvise(address, length, POSIX_MADV_SEQUENTIAL);
+    if (flags & QFileDevice::MapWillNeedHint)
+        posix_madvise(address, length, POSIX_MADV_WILLNEED);
+}
+} // unnamed namespace
+#endif
+
+/*!
+    \since 6.0
+
+    Maps \a size bytes of the file starting at \a offset into memory and
+    returns them as a QByteArray that shares the mapping instead of copying
+    it. The file must be open for reading, and the range must lie within the
+    file.
+
+    The mapping is reference counted together with the byte array: it stays
+    valid after the file is closed or destroyed, and it is released when the
+    last QByteArray referring to it is destroyed. This makes it possible to
+    hand the contents of a large file to functions such as
+    QJsonDocument::fromJson() or QCborValue::fromCbor() without copying it and
+    without keeping track of the mapping's lifetime.
+
+    The mapping is always private, as with MapPrivateOption: modifying the
+    returned byte array never changes the file, and only the pages that are
+    modified get copied. Growing the byte array moves its contents into
+    regular memory. It is unspecified whether modifications made to the file
+    after the mapping was created are visible through the byte array.
+    MapSequentialHint and MapWillNeedHint may be passed in \a flags to tell
+    the system how the data is going to be accessed.
+
+    If the file cannot be mapped, for instance because it is not a regular
+    file on the local file system, this function falls back to reading the
+    range into a newly allocated QByteArray. On error, it returns a null
+    QByteArray and sets error().
+
+    \sa map()
+*/
+QByteArray QFileDevice::mapToByteArray(qint64 offset, qint64 size, MemoryMapFlags flags)
+{
+    Q_D(QFileDevice);
+    if (!isOpen() || !(openMode() & ReadOnly)) {
+        d->setError(PermissionsError, tr("File is not open for reading"));
+        return QByteArray();
+    }
+    if (offset < 0 || size < 0 || offset > this->size() || size > this->size() - offset) {
+        d->setError(UnspecifiedError, tr("Invalid mapping range"));
+        return QByteArray();
+    }
+    unsetError();
+    if (size == 0)
+        return QByteArray("");
+    if (openMode() & WriteOnly)
+        flush();
+
+#ifdef Q_OS_UNIX
+    if (const int fd = handle(); fd != -1) {
+        const qint64 pageSize = sysconf(_SC_PAGESIZE);
+        const qint64 extra = offset % pageSize;
+        const qint64 fileLength = extra + size;
+        // one page for the header, the file pages, and room for the terminating '\0'
+        const qint64 length = pageSize + (fileLength + 1 + pageSize - 1) / pageSize * pageSize;
+        if (length > qint64(std::numeric_limits<qsizetype>::max())) {
+            d->setError(ResourceError, qt_error_string(ENOMEM));
+            return QByteArray();
+        }
+
+        // Reserve the whole range first so that the header can be put right
+        // in front of the file data, as QArrayData expects
+        void *region = QT_MMAP(nullptr, size_t(length), PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED) {
+            char *dataStart = static_cast<char *>(region) + pageSize;
+            void *mapped = QT_MMAP(dataStart, size_t(fileLength), PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_FIXED, fd, QT_OFF_T(offset - extra));
+            if (mapped != MAP_FAILED) {
+                adviseMapping(dataStart, size_t(fileLength), flags);
+
+                auto *info = static_cast<QMappedByteArrayRegion *>(region);
+                info->address = region;
+                info->length = size_t(length);
+                QArrayData *header = QArrayData::initializeExternalHeader(
+                        dataStart - QArrayData::ExternalHeaderSize, qsizetype(fileLength),
+                        releaseMappedByteArray, info);
+
+                char *data = dataStart + extra;
+                if (data[size])
+                    data[size] = '\0';   // only touches our private copy of the page
+                return QByteArray(QByteArray::DataPointer(
+                        static_cast<QTypedArrayData<char> *>(header), data, qsizetype(size)));
+            }
+            ::munmap(region, size_t(length));
+        }
+        // fall back to reading below
+    }
+#endif
+
+    const qint64 oldPos = pos();
+    if (!seek(offset))
+        return QByteArray();
+    QByteArray result = read(size);
+    seek(oldPos);
+    if (result.size() != size) {
+        d->setError(ReadError, errorString());
+        return QByteArray();
+    }
+    return result;
+}
+
 /*!
     Unmaps the memory \a address.
 
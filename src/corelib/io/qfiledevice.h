@@ -120,11 +120,14 @@ public:
 
     enum MemoryMapFlag {
         NoOptions = 0,
-        MapPrivateOption = 0x0001
+        MapPrivateOption = 0x0001,
+        MapSequentialHint = 0x0002,
+        MapWillNeedHint = 0x0004
     };
     Q_DECLARE_FLAGS(MemoryMapFlags, MemoryMapFlag)
 
     uchar *map(qint64 offset, qint64 size, MemoryMapFlags flags = NoOptions);
+    QByteArray mapToByteArray(qint64 offset, qint64 size, MemoryMapFlags flags = NoOptions);
     bool unmap(uchar *address);
 
     QDateTime fileTime(QFileDevice::FileTime time) const;
@@ -142,6 +145,8 @@ protected:
     qint64 readData(char *data, qint64 maxlen) override;
     qint64 writeData(const char *data, qint64 len) override;
     qint64 readLineData(char *data, qint64 maxlen) override;
+    qint64 readDataVectored(char *const *data, const qint64 *maxSizes, qsizetype count) override;
+    qint64 writeDataVectored(const QByteArrayView *buffers, qsizetype count) override;
 
 private:
     Q_DISABLE_COPY(QFileDevice)
@@ -889,6 +889,23 @@ bool QFSFileEngine::extension(Extension extension, const ExtensionOption *option
         const UnMapExtensionOption *options = (const UnMapExtensionOption*)option;
         return d->unmap(options->address);
     }
+#ifndef Q_OS_WIN
+    if (extension == ReadVectoredExtension && !d->fh && d->fd != -1) {
+        const ReadVectoredExtensionOption *options = static_cast<const ReadVectoredExtensionOption *>(option);
+        VectoredExtensionReturn *returnValue = static_cast<VectoredExtensionReturn *>(output);
+        d->lastIOCommand = QFSFileEnginePrivate::IOReadCommand;
+        returnValue->result = d->nativeReadVectored(options->data, options->maxSizes, options->count);
+        return returnValue->result >= 0;
+    }
+    if (extension == WriteVectoredExtension && !d->fh && d->fd != -1) {
+        const WriteVectoredExtensionOption *options = static_cast<const WriteVectoredExtensionOption *>(option);
+        VectoredExtensionReturn *returnValue = static_cast<VectoredExtensionReturn *>(output);
+        d->metaData.clearFlags(QFileSystemMetaData::Times);
+        d->lastIOCommand = QFSFileEnginePrivate::IOWriteCommand;
+        returnValue->result = d->nativeWriteVectored(options->buffers, options->count);
+        return returnValue->result >= 0;
+    }
+#endif
 
     return false;
 }
@@ -907,6 +924,12 @@ bool QFSFileEngine::supportsExtension(Extension extension) const
         return true;
     if (extension == UnMapExtension || extension == MapExtension)
         return true;
+#ifndef Q_OS_WIN
+    // the stdio FILE buffer cannot be bypassed
+    if ((extension == ReadVectoredExtension || extension == WriteVectoredExtension)
+            && !d->fh && d->fd != -1)
+        return true;
+#endif
     return false;
 }
 
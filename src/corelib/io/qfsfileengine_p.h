@@ -174,6 +174,10 @@ public:
     qint64 readLineFdFh(char *data, qint64 maxlen);
     qint64 nativeWrite(const char *data, qint64 len);
     qint64 writeFdFh(const char *data, qint64 len);
+#ifndef Q_OS_WIN
+    qint64 nativeReadVectored(char *const *data, const qint64 *maxSizes, qsizetype count);
+    qint64 nativeWriteVectored(const QByteArrayView *buffers, qsizetype count);
+#endif
     int nativeHandle() const;
     bool nativeIsSequential() const;
 #ifndef Q_OS_WIN
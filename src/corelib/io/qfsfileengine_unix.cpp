@@ -53,6 +53,7 @@
 #include "qvarlengtharray.h"
 
 #include <sys/mman.h>
+#include <sys/uio.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <errno.h>
@@ -272,6 +273,86 @@ qint64 QFSFileEnginePrivate::nativeWrite(const char *data, qint64 len)
     return writeFdFh(data, len);
 }
 
+/*
+    Calls readv() or writev() on \a fd until all of \a iov has been
+    transferred, the end of the file is reached or an error occurs, and
+    returns the number of bytes transferred. Modifies \a iov.
+*/
+template <typename Transfer>
+static qint64 transferVectored(int fd, struct iovec *iov, qsizetype count, Transfer transfer)
+{
+#ifdef IOV_MAX
+    const qsizetype maxCount = IOV_MAX;
+#else
+    const qsizetype maxCount = 16;
+#endif
+    qint64 transferred = 0;
+    while (count > 0) {
+        qint64 result;
+        EINTR_LOOP(result, transfer(fd, iov, int(qMin(count, maxCount))));
+        if (result <= 0)
+            return transferred ? transferred : result;
+        transferred += result;
+
+        // skip what was transferred completely and resume in the middle of
+        // a partially transferred buffer
+        while (count > 0 && quint64(result) >= quint64(iov->iov_len)) {
+            result -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char *>(iov->iov_base) + result;
+            iov->iov_len -= result;
+        }
+    }
+    return transferred;
+}
+
+/*!
+    \internal
+*/
+qint64 QFSFileEnginePrivate::nativeReadVectored(char *const *data, const qint64 *maxSizes,
+                                                qsizetype count)
+{
+    Q_Q(QFSFileEngine);
+    QVarLengthArray<struct iovec, 16> iov(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        iov[i].iov_base = data[i];
+        iov[i].iov_len = size_t(maxSizes[i]);
+    }
+
+    const qint64 readBytes = transferVectored(fd, iov.data(), count, ::readv);
+    if (readBytes < 0)
+        q->setError(QFile::ReadError, QSystemError::stdString());
+    return readBytes;
+}
+
+/*!
+    \internal
+*/
+qint64 QFSFileEnginePrivate::nativeWriteVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_Q(QFSFileEngine);
+    QVarLengthArray<struct iovec, 16> iov(count);
+    qint64 len = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        iov[i].iov_base = const_cast<char *>(buffers[i].data());
+        iov[i].iov_len = size_t(buffers[i].size());
+        len += buffers[i].size();
+    }
+
+    const qint64 writtenBytes = len ? transferVectored(fd, iov.data(), count, ::writev) : 0;
+    if (len && writtenBytes <= 0) {
+        q->setError(errno == ENOSPC ? QFile::ResourceError : QFile::WriteError, QSystemError::stdString());
+        return -1;
+    }
+
+    // reset the cached size, if any
+    metaData.clearFlags(QFileSystemMetaData::SizeAttribute);
+    return writtenBytes;
+}
+
 /*!
     \internal
 */
@@ -618,6 +699,10 @@ uchar *QFSFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFla
     void *mapAddress = QT_MMAP((void*)nullptr, realSize,
                    access, sharemode, nativeHandle(), realOffset);
     if (MAP_FAILED != mapAddress) {
+        if (flags & QFileDevice::MapSequentialHint)
+            posix_madvise(mapAddress, realSize, POSIX_MADV_SEQUENTIAL);
+        if (flags & QFileDevice::MapWillNeedHint)
+            posix_madvise(mapAddress, realSize, POSIX_MADV_WILLNEED);
         uchar *address = extra + static_cast<uchar*>(mapAddress);
         maps[address] = QPair<int,size_t>(extra, realSize);
         return address;
@@ -1749,6 +1749,128 @@ qint64 QIODevice::write(const QByteArray &data)
     return ret;
 }
 
+/*!
+    \since 6.0
+
+    Writes the \a count buffers in \a buffers to the device, one after the
+    other, as if they were a single block of data. Returns the number of
+    bytes that were actually written, or -1 if an error occurred before
+    anything could be written.
+
+    This is equivalent to calling write() for each buffer, but lets the
+    device pass all of them to the operating system at once, avoiding the
+    need to concatenate a message header and its payload into a temporary
+    buffer. Devices that support it, like QFile and QTcpSocket opened in
+    \l{QIODeviceBase::}{Unbuffered} mode, reach the platform's \c writev()
+    system call directly.
+
+    \sa write(), readv(), writeDataVectored()
+*/
+qint64 QIODevice::writev(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_D(QIODevice);
+    CHECK_WRITABLE(writev, qint64(-1));
+    if (count < 0) {
+        checkWarnMessage(this, "writev", "Called with count < 0");
+        return qint64(-1);
+    }
+
+#ifdef Q_OS_WIN
+    if (d->openMode & Text) {
+        // needs the line ending conversion done by write()
+        qint64 written = 0;
+        for (qsizetype i = 0; i < count; ++i) {
+            const qint64 ret = write(buffers[i].data(), buffers[i].size());
+            if (ret < 0)
+                return written ? written : ret;
+            written += ret;
+            if (ret < buffers[i].size())
+                break;
+        }
+        return written;
+    }
+#endif
+
+    const bool sequential = d->isSequential();
+    // Make sure the device is positioned correctly.
+    if (d->pos != d->devicePos && !sequential && !seek(d->pos))
+        return qint64(-1);
+
+    const qint64 written = writeDataVectored(buffers, count);
+    if (!sequential && written > 0) {
+        d->pos += written;
+        d->devicePos += written;
+        d->buffer.skip(written);
+    }
+    return written;
+}
+
+/*!
+    \fn qint64 QIODevice::writev(std::initializer_list<QByteArrayView> buffers)
+    \since 6.0
+    \overload
+
+    Writes \a buffers to the device, one after the other. For example:
+
+    \snippet code/src_corelib_io_qiodevice.cpp 6
+*/
+
+/*!
+    \since 6.0
+
+    Reads from the device into the \a count buffers in \a data, filling
+    each one with up to the corresponding number of bytes in \a maxSizes
+    before moving on to the next one. Returns the total number of bytes
+    read, or -1 if an error occurred before anything could be read.
+
+    Reading stops at the first buffer that cannot be filled completely, so
+    this is equivalent to calling read() for each buffer until one returns
+    less than requested. When the device has no buffered data, the read
+    goes to the device in one call, which for QFile and unbuffered sockets
+    is a single \c readv() system call.
+
+    \sa read(), writev(), readDataVectored()
+*/
+qint64 QIODevice::readv(char *const *data, const qint64 *maxSizes, qsizetype count)
+{
+    Q_D(QIODevice);
+    CHECK_READABLE(readv, qint64(-1));
+    qint64 total = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        if (maxSizes[i] < 0) {
+            checkWarnMessage(this, "readv", "Called with maxSize < 0");
+            return qint64(-1);
+        }
+        total += maxSizes[i];
+    }
+
+    const bool sequential = d->isSequential();
+    const bool buffered = (d->openMode & Unbuffered) == 0;
+    // Bypass the read buffer the same way QIODevicePrivate::read() does for
+    // large reads; anything else needs the buffer or the text conversion.
+    if (total > 0 && d->isBufferEmpty() && !d->transactionStarted && !(d->openMode & Text)
+            && (!buffered || total >= d->readBufferChunkSize)
+            && (sequential || d->pos == d->devicePos || seek(d->pos))) {
+        const qint64 readBytes = readDataVectored(data, maxSizes, count);
+        if (!sequential && readBytes > 0) {
+            d->pos += readBytes;
+            d->devicePos += readBytes;
+        }
+        return readBytes;
+    }
+
+    qint64 readSoFar = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 ret = d->read(data[i], maxSizes[i]);
+        if (ret < 0)
+            return readSoFar ? readSoFar : ret;
+        readSoFar += ret;
+        if (ret < maxSizes[i])
+            break;
+    }
+    return readSoFar;
+}
+
 /*!
     \internal
 */
@@ -2043,6 +2165,89 @@ qint64 QIODevice::skipData(qint64 maxSize)
     return d_func()->skipByReading(maxSize);
 }
 
+/*!
+    \since 6.0
+
+    Reads from the device into the \a count buffers in \a data, up to
+    \a maxSizes[i] bytes into the i-th one, and returns the total number of
+    bytes read, or -1 if an error occurred before anything could be read.
+    Reading must only move on to the next buffer once the current one is
+    full.
+
+    This function is called by readv() when the device's read buffer is
+    empty. The base implementation calls readData() for each buffer until
+    one returns less than requested. Reimplement it for devices that can
+    read into several buffers with a single operation.
+
+    \sa readv(), readData()
+*/
+qint64 QIODevice::readDataVectored(char *const *data, const qint64 *maxSizes, qsizetype count)
+{
+    Q_D(QIODevice);
+    // readData() of random-access devices reads at pos(), so move it along
+    // between the calls; readv() does the final update.
+    const bool sequential = d->isSequential();
+    const qint64 startPos = d->pos;
+    qint64 readSoFar = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 ret = readData(data[i], maxSizes[i]);
+        if (ret < 0) {
+            if (readSoFar == 0)
+                readSoFar = ret;
+            break;
+        }
+        readSoFar += ret;
+        if (!sequential)
+            d->pos = d->devicePos = startPos + readSoFar;
+        if (ret < maxSizes[i])
+            break;
+    }
+    if (!sequential)
+        d->pos = d->devicePos = startPos;
+    return readSoFar;
+}
+
+/*!
+    \since 6.0
+
+    Writes the \a count buffers in \a buffers to the device, one after the
+    other, and returns the number of bytes written, or -1 if an error
+    occurred before anything could be written.
+
+    This function is called by writev(). The base implementation calls
+    writeData() for each buffer until one is not written completely.
+    Reimplement it for devices that can write several buffers with a single
+    operation. As with writeData(), it is important that all the data is
+    written or buffered before returning.
+
+    \sa writev(), writeData()
+*/
+qint64 QIODevice::writeDataVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_D(QIODevice);
+    // writeData() of random-access devices writes at pos(), so move it along
+    // between the calls; writev() does the final update.
+    const bool sequential = d->isSequential();
+    const qint64 startPos = d->pos;
+    qint64 written = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 ret = writeData(buffers[i].data(), buffers[i].size());
+        if (ret < 0) {
+            if (written == 0)
+                written = ret;
+            break;
+        }
+        written += ret;
+        if (!sequential)
+            d->pos = d->devicePos = startPos + written;
+        if (ret < buffers[i].size())
+            break;
+    }
+    if (!sequential)
+        d->pos = d->devicePos = startPos;
+    return written;
+}
+
 /*!
     Blocks until new data is available for reading and the readyRead()
     signal has been emitted, or until \a msecs milliseconds have
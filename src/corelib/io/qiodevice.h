@@ -124,6 +124,10 @@ public:
     qint64 write(const char *data, qint64 len);
     qint64 write(const char *data);
     qint64 write(const QByteArray &data);
+    qint64 writev(const QByteArrayView *buffers, qsizetype count);
+    qint64 writev(std::initializer_list<QByteArrayView> buffers)
+    { return writev(buffers.begin(), qsizetype(buffers.size())); }
+    qint64 readv(char *const *data, const qint64 *maxSizes, qsizetype count);
 
     qint64 peek(char *data, qint64 maxlen);
     QByteArray peek(qint64 maxlen);
@@ -158,6 +162,8 @@ protected:
     virtual qint64 readLineData(char *data, qint64 maxlen);
     virtual qint64 skipData(qint64 maxSize);
     virtual qint64 writeData(const char *data, qint64 len) = 0;
+    virtual qint64 readDataVectored(char *const *data, const qint64 *maxSizes, qsizetype count);
+    virtual qint64 writeDataVectored(const QByteArrayView *buffers, qsizetype count);
 
     void setOpenMode(OpenMode openMode);
 
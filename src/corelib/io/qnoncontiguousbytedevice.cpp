@@ -227,6 +227,78 @@ qint64 QNonContiguousByteDeviceByteArrayImpl::pos() const
     return currentPosition;
 }
 
+// Maps the remaining part of the file \a f into memory through a private
+// QFile handle, so that the mapping stays valid for as long as this device
+// lives, independently of what happens to \a f itself. Since the data is
+// never modified, readPointer() may be called from any thread.
+QNonContiguousByteDeviceMappedFileImpl::QNonContiguousByteDeviceMappedFileImpl(QFile *f)
+    : QNonContiguousByteDevice(), mappedFile(f->fileName()), data(nullptr), dataSize(0),
+      currentPosition(0)
+{
+    const qint64 offset = f->pos();
+    const qint64 length = f->size() - offset;
+    if (length <= 0 || !mappedFile.open(QIODevice::ReadOnly))
+        return;
+
+    data = mappedFile.map(offset, length);
+    if (data)
+        dataSize = length;
+    else
+        mappedFile.close();
+}
+
+QNonContiguousByteDeviceMappedFileImpl::~QNonContiguousByteDeviceMappedFileImpl()
+{
+}
+
+bool QNonContiguousByteDeviceMappedFileImpl::isMapped() const
+{
+    return data != nullptr;
+}
+
+const char* QNonContiguousByteDeviceMappedFileImpl::readPointer(qint64 maximumLength, qint64 &len)
+{
+    if (atEnd()) {
+        len = -1;
+        return nullptr;
+    }
+
+    if (maximumLength != -1)
+        len = qMin(maximumLength, dataSize - currentPosition);
+    else
+        len = dataSize - currentPosition;
+
+    return reinterpret_cast<const char *>(data) + currentPosition;
+}
+
+bool QNonContiguousByteDeviceMappedFileImpl::advanceReadPointer(qint64 amount)
+{
+    currentPosition += amount;
+    emit readProgress(currentPosition, dataSize);
+    return true;
+}
+
+bool QNonContiguousByteDeviceMappedFileImpl::atEnd() const
+{
+    return currentPosition >= dataSize;
+}
+
+bool QNonContiguousByteDeviceMappedFileImpl::reset()
+{
+    currentPosition = 0;
+    return true;
+}
+
+qint64 QNonContiguousByteDeviceMappedFileImpl::size() const
+{
+    return dataSize;
+}
+
+qint64 QNonContiguousByteDeviceMappedFileImpl::pos() const
+{
+    return currentPosition;
+}
+
 QNonContiguousByteDeviceRingBufferImpl::QNonContiguousByteDeviceRingBufferImpl(QSharedPointer<QRingBuffer> rb)
     : QNonContiguousByteDevice(), currentPosition(0)
 {
@@ -474,6 +546,16 @@ qint64 QByteDeviceWrappingIoDevice::writeData( const char* data, qint64 maxSize)
     \internal
 */
 
+static QFile *mappableFile(QIODevice *device)
+{
+    QFile *file = qobject_cast<QFile *>(device);
+    if (!file || file->isSequential() || !file->isReadable() || file->isTextModeEnabled()
+        || file->fileName().isEmpty()) {
+        return nullptr;
+    }
+    return file;
+}
+
 /*!
     \fn static QNonContiguousByteDevice* QNonContiguousByteDeviceFactory::create(QIODevice *device)
 
@@ -489,8 +571,13 @@ QNonContiguousByteDevice* QNonContiguousByteDeviceFactory::create(QIODevice *dev
         return new QNonContiguousByteDeviceBufferImpl(buffer);
     }
 
-    // ### FIXME special case if device is a QFile that supports map()
-    // then we can actually deal with the file without using read/peek
+    // a QFile that supports map() can be used without read/peek
+    if (QFile *file = mappableFile(device)) {
+        QNonContiguousByteDeviceMappedFileImpl *mapped = new QNonContiguousByteDeviceMappedFileImpl(file);
+        if (mapped->isMapped())
+            return mapped;
+        delete mapped;
+    }
 
     // generic QIODevice
     return new QNonContiguousByteDeviceIoDeviceImpl(device); // FIXME
@@ -508,8 +595,12 @@ QSharedPointer<QNonContiguousByteDevice> QNonContiguousByteDeviceFactory::create
     if (QBuffer *buffer = qobject_cast<QBuffer*>(device))
         return QSharedPointer<QNonContiguousByteDeviceBufferImpl>::create(buffer);
 
-    // ### FIXME special case if device is a QFile that supports map()
-    // then we can actually deal with the file without using read/peek
+    // a QFile that supports map() can be used without read/peek
+    if (QFile *file = mappableFile(device)) {
+        auto mapped = QSharedPointer<QNonContiguousByteDeviceMappedFileImpl>::create(file);
+        if (mapped->isMapped())
+            return mapped;
+    }
 
     // generic QIODevice
     return QSharedPointer<QNonContiguousByteDeviceIoDeviceImpl>::create(device); // FIXME
@@ -55,6 +55,7 @@
 #include <QtCore/qbytearray.h>
 #include <QtCore/qbuffer.h>
 #include <QtCore/qiodevice.h>
+#include <QtCore/qfile.h>
 #include <QtCore/QSharedPointer>
 #include "private/qringbuffer_p.h"
 
@@ -173,6 +174,26 @@ protected:
     QNonContiguousByteDeviceByteArrayImpl* arrayImpl;
 };
 
+class Q_CORE_EXPORT QNonContiguousByteDeviceMappedFileImpl : public QNonContiguousByteDevice
+{
+    Q_OBJECT
+public:
+    QNonContiguousByteDeviceMappedFileImpl(QFile *f);
+    ~QNonContiguousByteDeviceMappedFileImpl();
+    bool isMapped() const;
+    const char* readPointer(qint64 maximumLength, qint64 &len) override;
+    bool advanceReadPointer(qint64 amount) override;
+    bool atEnd() const override;
+    bool reset() override;
+    qint64 size() const override;
+    qint64 pos() const override;
+protected:
+    QFile mappedFile;
+    const uchar *data;
+    qint64 dataSize;
+    qint64 currentPosition;
+};
+
 // ... and the reverse thing
 class QByteDeviceWrappingIoDevice : public QIODevice
 {
@@ -0,0 +1,734 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+#include "qrandomaccessasyncfile_p.h"
+
+#include "qsocketnotifier.h"
+#include "qthread.h"
+#include "qthreadpool.h"
+
+#ifdef Q_OS_UNIX
+#  include <private/qcore_unix_p.h>
+#endif
+
+#ifdef QT_ASYNCFILE_IO_URING
+#  include <linux/io_uring.h>
+#  include <sys/eventfd.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+#ifdef QT_ASYNCFILE_IO_URING
+
+enum {
+    // submission queue entries; the kernel sizes the completion queue at
+    // twice that, which limits the number of operations in flight
+    IoUringEntries = 64
+};
+
+/*
+    A minimal io_uring submission and completion queue pair, set up with the
+    raw system calls. Submission and reaping are not thread-safe; the caller
+    serializes them.
+*/
+class QIoUring
+{
+public:
+    QIoUring() = default;
+    ~QIoUring();
+    Q_DISABLE_COPY_MOVE(QIoUring)
+
+    bool init(unsigned entries, int eventFd);
+    uint capacity() const { return cqEntries; }
+
+    bool prepare(QAsyncFileOperation *op, int fd);
+    int submit(uint waitFor = 0);
+
+    template <typename Callback>
+    void reap(Callback callback);
+
+private:
+    int ringFd = -1;
+    unsigned sqEntries = 0;
+    unsigned cqEntries = 0;
+
+    void *sqRing = nullptr;
+    size_t sqRingSize = 0;
+    void *cqRing = nullptr;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqMask = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned *cqMask = nullptr;
+    io_uring_cqe *cqes = nullptr;
+};
+
+QIoUring::~QIoUring()
+{
+    if (sqes)
+        munmap(sqes, sqesSize);
+    if (cqRing && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing)
+        munmap(sqRing, sqRingSize);
+    if (ringFd != -1)
+        qt_safe_close(ringFd);
+}
+
+bool QIoUring::init(unsigned entries, int eventFd)
+{
+    io_uring_params params = {};
+    ringFd = int(syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFd == -1)
+        return false;
+
+    sqEntries = params.sq_entries;
+    cqEntries = params.cq_entries;
+    sqRingSize = params.sq_off.array + sqEntries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + cqEntries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    const auto map = [this](size_t size, off_t offset) -> void * {
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ringFd, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    };
+    sqRing = map(sqRingSize, IORING_OFF_SQ_RING);
+    if (!sqRing)
+        return false;
+    cqRing = singleMmap ? sqRing : map(cqRingSize, IORING_OFF_CQ_RING);
+    if (!cqRing)
+        return false;
+    sqesSize = sqEntries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(map(sqesSize, IORING_OFF_SQES));
+    if (!sqes)
+        return false;
+
+    const auto field = [](void *ring, __u32 offset) {
+        return reinterpret_cast<unsigned *>(static_cast<char *>(ring) + offset);
+    };
+    sqHead = field(sqRing, params.sq_off.head);
+    sqTail = field(sqRing, params.sq_off.tail);
+    sqMask = field(sqRing, params.sq_off.ring_mask);
+    sqArray = field(sqRing, params.sq_off.array);
+    cqHead = field(cqRing, params.cq_off.head);
+    cqTail = field(cqRing, params.cq_off.tail);
+    cqMask = field(cqRing, params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(static_cast<char *>(cqRing) + params.cq_off.cqes);
+
+    // completions are signalled on eventFd, which the event dispatcher watches
+    return syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1) == 0;
+}
+
+/*
+    Queues the remaining part of \a op on \a fd. Returns false if the
+    submission queue is full.
+*/
+bool QIoUring::prepare(QAsyncFileOperation *op, int fd)
+{
+    const unsigned tail = *sqTail;
+    if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries)
+        return false;
+
+    const bool isRead = op->type == QAsyncFileOperation::Read;
+    char *data = isRead ? op->buffer.data() : const_cast<char *>(op->buffer.constData());
+    op->iov.iov_base = data + op->done;
+    op->iov.iov_len = size_t(op->size - op->done);
+
+    const unsigned index = tail & *sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = isRead ? IORING_OP_READV : IORING_OP_WRITEV;
+    sqe->fd = fd;
+    sqe->off = quint64(op->offset + op->done);
+    sqe->addr = quint64(quintptr(&op->iov));
+    sqe->len = 1;
+    sqe->user_data = quint64(quintptr(op));
+    sqArray[index] = index;
+
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/*
+    Hands all prepared entries to the kernel and, if \a waitFor is not 0,
+    waits until that many completions are available.
+*/
+int QIoUring::submit(uint waitFor)
+{
+    const unsigned toSubmit = *sqTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    if (!toSubmit && !waitFor)
+        return 0;
+
+    int ret;
+    EINTR_LOOP(ret, int(syscall(__NR_io_uring_enter, ringFd, toSubmit, waitFor,
+                                waitFor ? IORING_ENTER_GETEVENTS : 0, nullptr, 0)));
+    return ret;
+}
+
+template <typename Callback>
+void QIoUring::reap(Callback callback)
+{
+    unsigned head = *cqHead;
+    const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    for ( ; head != tail; ++head) {
+        const io_uring_cqe &cqe = cqes[head & *cqMask];
+        callback(reinterpret_cast<QAsyncFileOperation *>(quintptr(cqe.user_data)), cqe.res);
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+}
+
+#endif // QT_ASYNCFILE_IO_URING
+
+/*!
+    \class QRandomAccessAsyncFile
+    \inmodule QtCore
+    \since 6.0
+    \reentrant
+
+    \brief The QRandomAccessAsyncFile class reads and writes files at given
+    offsets without blocking the calling thread.
+
+    QRandomAccessAsyncFile starts each read() and write() right away and
+    returns a QFuture that is finished when the operation completes.
+    Operations are independent of each other: each one names the offset it
+    transfers data at, and any number of them may be in progress at a time.
+    readBatch() starts many reads at once.
+
+    \snippet code/src_corelib_io_qrandomaccessasyncfile.cpp 0
+
+    On Linux, the operations are handed to the kernel through io_uring,
+    without involving any additional thread, and their completions are
+    delivered by the event loop of the thread the QRandomAccessAsyncFile
+    lives in. That thread must therefore run an event loop, and must not block
+    waiting for one of the futures; use waitForFinished() instead, or a
+    QFutureWatcher or QFuture::then(). Where io_uring is not available, or if
+    the \c QT_NO_IO_URING environment variable is set, each operation runs
+    on a thread of QThreadPool::globalInstance() instead. backend() tells
+    which of the two is used.
+
+    A read that fails results in a canceled future. A write that fails
+    results in -1.
+
+    \sa QFile, QFuture
+*/
+
+/*!
+    \enum QRandomAccessAsyncFile::Backend
+
+    This enum describes how the operations are carried out.
+
+    \value NoBackend        The file is not open.
+    \value IoUringBackend   The operations are submitted to the Linux kernel
+                            through io_uring.
+    \value ThreadPoolBackend The operations run as blocking calls on the
+                            global thread pool.
+*/
+
+QRandomAccessAsyncFilePrivate::QRandomAccessAsyncFilePrivate()
+{
+}
+
+QRandomAccessAsyncFilePrivate::~QRandomAccessAsyncFilePrivate()
+{
+}
+
+bool QRandomAccessAsyncFilePrivate::startBackend()
+{
+#ifdef QT_ASYNCFILE_IO_URING
+    Q_Q(QRandomAccessAsyncFile);
+    if (qEnvironmentVariableIsEmpty("QT_NO_IO_URING")) {
+        eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        ring.reset(new QIoUring);
+        if (eventFd != -1 && ring->init(IoUringEntries, eventFd)) {
+            backend = QRandomAccessAsyncFile::IoUringBackend;
+            completionNotifier = new QSocketNotifier(eventFd, QSocketNotifier::Read, q);
+            QObject::connect(completionNotifier, &QSocketNotifier::activated, q,
+                             [this] { processCompletions(); });
+            return true;
+        }
+        stopBackend();
+    }
+#endif
+    backend = QRandomAccessAsyncFile::ThreadPoolBackend;
+    return true;
+}
+
+void QRandomAccessAsyncFilePrivate::stopBackend()
+{
+#ifdef QT_ASYNCFILE_IO_URING
+    delete completionNotifier;
+    completionNotifier = nullptr;
+    ring.reset();
+    if (eventFd != -1)
+        qt_safe_close(eventFd);
+    eventFd = -1;
+#endif
+    backend = QRandomAccessAsyncFile::NoBackend;
+}
+
+void QRandomAccessAsyncFilePrivate::start(const QList<QAsyncFileOperation *> &operations)
+{
+    QMutexLocker locker(&mutex);
+    pending += operations.size();
+
+#ifdef QT_ASYNCFILE_IO_URING
+    if (backend == QRandomAccessAsyncFile::IoUringBackend) {
+        for (QAsyncFileOperation *op : operations)
+            backlog.enqueue(op);
+        fillRing();
+        return;
+    }
+#endif
+
+    locker.unlock();
+    for (QAsyncFileOperation *op : operations) {
+        QThreadPool::globalInstance()->start([this, op] {
+            finish(op, transferSync(op));
+            operationsDone(1);
+        });
+    }
+}
+
+/*
+    Transfers the remaining part of \a op with blocking calls.
+*/
+bool QRandomAccessAsyncFilePrivate::transferSync(QAsyncFileOperation *op)
+{
+    const bool isRead = op->type == QAsyncFileOperation::Read;
+#ifdef Q_OS_UNIX
+    const int fd = file.handle();
+    while (op->done < op->size) {
+        const size_t count = size_t(op->size - op->done);
+        const QT_OFF_T offset = QT_OFF_T(op->offset + op->done);
+        ssize_t ret;
+        if (isRead)
+            EINTR_LOOP(ret, ::pread(fd, op->buffer.data() + op->done, count, offset));
+        else
+            EINTR_LOOP(ret, ::pwrite(fd, op->buffer.constData() + op->done, count, offset));
+        if (ret < 0)
+            return false;
+        if (ret == 0)
+            break;
+        op->done += ret;
+    }
+    return true;
+#else
+    QMutexLocker locker(&fileMutex);
+    if (!file.seek(op->offset))
+        return false;
+    const qint64 ret = isRead ? file.read(op->buffer.data(), op->size)
+                              : file.write(op->buffer.constData(), op->size);
+    if (ret < 0)
+        return false;
+    op->done = ret;
+    return true;
+#endif
+}
+
+/*
+    Finishes the future of \a op and deletes it.
+*/
+void QRandomAccessAsyncFilePrivate::finish(QAsyncFileOperation *op, bool ok)
+{
+    if (op->type == QAsyncFileOperation::Read) {
+        // a promise that is destroyed before it is finished cancels its future
+        if (ok) {
+            op->buffer.truncate(op->done);
+            op->readPromise.addResult(std::move(op->buffer));
+            op->readPromise.reportFinished();
+        }
+    } else {
+        op->writePromise.addResult(ok ? op->done : qint64(-1));
+        op->writePromise.reportFinished();
+    }
+    delete op;
+}
+
+void QRandomAccessAsyncFilePrivate::operationsDone(int count)
+{
+    QMutexLocker locker(&mutex);
+    pending -= count;
+    if (pending == 0)
+        allDone.wakeAll();
+}
+
+#ifdef QT_ASYNCFILE_IO_URING
+/*
+    Moves operations from the backlog into the ring, as far as the completion
+    queue has room for them, and submits them. Must be called with the mutex
+    locked.
+*/
+void QRandomAccessAsyncFilePrivate::fillRing()
+{
+    const int fd = file.handle();
+    while (!backlog.isEmpty() && inFlight < ring->capacity()) {
+        if (!ring->prepare(backlog.head(), fd)) {
+            // the submission queue is full; make room and try again
+            ring->submit();
+            if (!ring->prepare(backlog.head(), fd))
+                break;
+        }
+        backlog.dequeue();
+        ++inFlight;
+    }
+    if (ring->submit() < 0 && errno != EBUSY && errno != EAGAIN)
+        qErrnoWarning("QRandomAccessAsyncFile: io_uring submission failed");
+}
+
+void QRandomAccessAsyncFilePrivate::processCompletions()
+{
+    eventfd_t value;
+    eventfd_read(eventFd, &value);
+
+    QList<QPair<QAsyncFileOperation *, bool>> finished;
+    {
+        QMutexLocker locker(&mutex);
+        ring->reap([&](QAsyncFileOperation *op, int res) {
+            --inFlight;
+            if (res == -EINTR || res == -EAGAIN) {
+                backlog.prepend(op);
+            } else if (res < 0) {
+                finished.append(qMakePair(op, false));
+            } else {
+                op->done += res;
+                // a short transfer in the middle of the range: go on from there
+                if (res > 0 && op->done < op->size)
+                    backlog.prepend(op);
+                else
+                    finished.append(qMakePair(op, true));
+            }
+        });
+        fillRing();
+    }
+
+    // finishing a future can run continuations, which may start new operations
+    for (const auto &entry : qAsConst(finished))
+        finish(entry.first, entry.second);
+    if (!finished.isEmpty())
+        operationsDone(finished.size());
+}
+#endif
+
+template <typename T>
+static QFuture<T> canceledFuture()
+{
+    QFutureInterface<T> interface;
+    interface.reportStarted();
+    interface.reportCanceled();
+    interface.reportFinished();
+    return interface.future();
+}
+
+/*!
+    Constructs a QRandomAccessAsyncFile object with the given \a parent.
+*/
+QRandomAccessAsyncFile::QRandomAccessAsyncFile(QObject *parent)
+    : QObject(*new QRandomAccessAsyncFilePrivate, parent)
+{
+}
+
+/*!
+    Constructs a QRandomAccessAsyncFile object with the given \a parent, for
+    the file called \a name.
+*/
+QRandomAccessAsyncFile::QRandomAccessAsyncFile(const QString &name, QObject *parent)
+    : QRandomAccessAsyncFile(parent)
+{
+    setFileName(name);
+}
+
+/*!
+    Destroys the QRandomAccessAsyncFile object, closing the file after all
+    operations have finished.
+*/
+QRandomAccessAsyncFile::~QRandomAccessAsyncFile()
+{
+    close();
+}
+
+/*!
+    Returns the name set by setFileName() or by the constructor.
+*/
+QString QRandomAccessAsyncFile::fileName() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->file.fileName();
+}
+
+/*!
+    Sets the \a name of the file. Do not call this function if the file is
+    open.
+*/
+void QRandomAccessAsyncFile::setFileName(const QString &name)
+{
+    Q_D(QRandomAccessAsyncFile);
+    if (isOpen()) {
+        qWarning("QRandomAccessAsyncFile::setFileName: File (%ls) is already opened",
+                 qUtf16Printable(fileName()));
+        return;
+    }
+    d->file.setFileName(name);
+}
+
+/*!
+    Opens the file in the given \a mode and returns \c true if successful;
+    otherwise returns \c false.
+
+    Only the QIODevice::ReadOnly, QIODevice::WriteOnly, QIODevice::ReadWrite,
+    QIODevice::Truncate and QIODevice::ExistingOnly flags are meaningful.
+
+    \sa errorString()
+*/
+bool QRandomAccessAsyncFile::open(QIODevice::OpenMode mode)
+{
+    Q_D(QRandomAccessAsyncFile);
+    if (isOpen()) {
+        qWarning("QRandomAccessAsyncFile::open: File (%ls) already open",
+                 qUtf16Printable(fileName()));
+        return false;
+    }
+
+    mode &= ~(QIODevice::Append | QIODevice::Text);
+    if (!d->file.open(mode | QIODevice::Unbuffered))
+        return false;
+    return d->startBackend();
+}
+
+/*!
+    Returns \c true if the file is open.
+*/
+bool QRandomAccessAsyncFile::isOpen() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->file.isOpen();
+}
+
+/*!
+    Returns the mode the file was opened in.
+*/
+QIODevice::OpenMode QRandomAccessAsyncFile::openMode() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->file.openMode() & ~QIODevice::Unbuffered;
+}
+
+/*!
+    Waits for all operations to finish and closes the file.
+
+    \sa waitForFinished()
+*/
+void QRandomAccessAsyncFile::close()
+{
+    Q_D(QRandomAccessAsyncFile);
+    if (!isOpen())
+        return;
+    waitForFinished();
+    d->stopBackend();
+    d->file.close();
+}
+
+/*!
+    Returns the size of the file.
+*/
+qint64 QRandomAccessAsyncFile::size() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->file.size();
+}
+
+/*!
+    Returns a human-readable description of the last error that occurred
+    opening the file.
+*/
+QString QRandomAccessAsyncFile::errorString() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->file.errorString();
+}
+
+/*!
+    Returns how the operations are carried out, or NoBackend if the file is
+    not open.
+*/
+QRandomAccessAsyncFile::Backend QRandomAccessAsyncFile::backend() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->backend;
+}
+
+/*!
+    Starts reading up to \a maxSize bytes at \a offset, and returns a future
+    for the data. The data is shorter than \a maxSize only if the end of the
+    file is reached.
+
+    This function can be called from any thread.
+
+    \sa readBatch(), write()
+*/
+QFuture<QByteArray> QRandomAccessAsyncFile::read(qint64 offset, qint64 maxSize)
+{
+    return readBatch({ qMakePair(offset, maxSize) }).constFirst();
+}
+
+/*!
+    Starts reading each of the \a ranges, given as pairs of offset and
+    maximum size, and returns the futures for the data in the same order.
+    Starting the reads together is cheaper than calling read() for each of
+    them.
+
+    This function can be called from any thread.
+
+    \sa read()
+*/
+QList<QFuture<QByteArray>> QRandomAccessAsyncFile::readBatch(const QList<QPair<qint64, qint64>> &ranges)
+{
+    Q_D(QRandomAccessAsyncFile);
+    QList<QFuture<QByteArray>> futures;
+    futures.reserve(ranges.size());
+
+    if (!(openMode() & QIODevice::ReadOnly)) {
+        qWarning("QRandomAccessAsyncFile::read: File not open for reading");
+        for (qsizetype i = 0; i < ranges.size(); ++i)
+            futures.append(canceledFuture<QByteArray>());
+        return futures;
+    }
+
+    QList<QAsyncFileOperation *> operations;
+    operations.reserve(ranges.size());
+    for (const auto &range : ranges) {
+        if (range.first < 0 || range.second < 0) {
+            qWarning("QRandomAccessAsyncFile::read: Invalid offset or size");
+            futures.append(canceledFuture<QByteArray>());
+            continue;
+        }
+        auto op = new QAsyncFileOperation;
+        op->type = QAsyncFileOperation::Read;
+        op->offset = range.first;
+        op->size = range.second;
+        op->buffer.resize(range.second);
+        op->readPromise.reportStarted();
+        futures.append(op->readPromise.future());
+        operations.append(op);
+    }
+
+    d->start(operations);
+    return futures;
+}
+
+/*!
+    Starts writing \a data at \a offset, and returns a future for the number
+    of bytes written, or -1 if an error occurred.
+
+    This function can be called from any thread.
+
+    \sa read()
+*/
+QFuture<qint64> QRandomAccessAsyncFile::write(qint64 offset, const QByteArray &data)
+{
+    Q_D(QRandomAccessAsyncFile);
+    if (!(openMode() & QIODevice::WriteOnly)) {
+        qWarning("QRandomAccessAsyncFile::write: File not open for writing");
+        return canceledFuture<qint64>();
+    }
+    if (offset < 0) {
+        qWarning("QRandomAccessAsyncFile::write: Invalid offset");
+        return canceledFuture<qint64>();
+    }
+
+    auto op = new QAsyncFileOperation;
+    op->type = QAsyncFileOperation::Write;
+    op->offset = offset;
+    op->size = data.size();
+    op->buffer = data;
+    op->writePromise.reportStarted();
+    QFuture<qint64> future = op->writePromise.future();
+
+    d->start({ op });
+    return future;
+}
+
+/*!
+    Blocks until all operations that were started have finished.
+
+    With the io_uring backend, this function collects the completions itself,
+    so it does not need an event loop. It must be called from the thread the
+    QRandomAccessAsyncFile lives in.
+*/
+void QRandomAccessAsyncFile::waitForFinished()
+{
+    Q_D(QRandomAccessAsyncFile);
+#ifdef QT_ASYNCFILE_IO_URING
+    if (d->backend == IoUringBackend) {
+        Q_ASSERT_X(thread() == QThread::currentThread(), "QRandomAccessAsyncFile::waitForFinished",
+                   "Must be called from the thread the object lives in");
+        forever {
+            {
+                QMutexLocker locker(&d->mutex);
+                if (d->pending == 0)
+                    return;
+                if (d->inFlight)
+                    d->ring->submit(1);
+                else
+                    d->fillRing();
+            }
+            d->processCompletions();
+        }
+    }
+#endif
+
+    QMutexLocker locker(&d->mutex);
+    while (d->pending)
+        d->allDone.wait(&d->mutex);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qrandomaccessasyncfile.cpp"
@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QRANDOMACCESSASYNCFILE_P_H
+#define QRANDOMACCESSASYNCFILE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qrandomaccessasyncfile.h"
+
+#include <private/qobject_p.h>
+
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <memory>
+
+#if defined(Q_OS_LINUX) && __has_include(<linux/io_uring.h>)
+#  define QT_ASYNCFILE_IO_URING
+#  include <sys/uio.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QSocketNotifier;
+
+struct QAsyncFileOperation
+{
+    enum Type {
+        Read,
+        Write
+    };
+
+    Type type;
+    qint64 offset;
+    qint64 size;            // bytes to transfer
+    qint64 done = 0;        // bytes transferred so far
+    QByteArray buffer;
+    QPromise<QByteArray> readPromise;
+    QPromise<qint64> writePromise;
+#ifdef QT_ASYNCFILE_IO_URING
+    iovec iov;
+#endif
+};
+
+#ifdef QT_ASYNCFILE_IO_URING
+class QIoUring;
+#endif
+
+class QRandomAccessAsyncFilePrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QRandomAccessAsyncFile)
+
+public:
+    QRandomAccessAsyncFilePrivate();
+    ~QRandomAccessAsyncFilePrivate();
+
+    bool startBackend();
+    void stopBackend();
+
+    void start(const QList<QAsyncFileOperation *> &operations);
+    bool transferSync(QAsyncFileOperation *op);
+    void finish(QAsyncFileOperation *op, bool ok);
+    void operationsDone(int count);
+
+    QFile file;
+    QRandomAccessAsyncFile::Backend backend = QRandomAccessAsyncFile::NoBackend;
+
+    QMutex mutex;
+    QWaitCondition allDone;
+    int pending = 0;                        // started but not finished operations
+
+#ifdef QT_ASYNCFILE_IO_URING
+    void fillRing();
+    void processCompletions();
+
+    std::unique_ptr<QIoUring> ring;
+    int eventFd = -1;
+    QSocketNotifier *completionNotifier = nullptr;
+    QQueue<QAsyncFileOperation *> backlog;  // waiting for room in the ring
+    uint inFlight = 0;
+#endif
+#ifndef Q_OS_UNIX
+    QMutex fileMutex;                       // serializes seek() and read()/write()
+#endif
+};
+
+QT_END_NAMESPACE
+
+#endif // QRANDOMACCESSASYNCFILE_P_H
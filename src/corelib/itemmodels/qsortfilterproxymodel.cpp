@@ -46,6 +46,10 @@
 #include <qstringlist.h>
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
+#if QT_CONFIG(future)
+#include <qfuturewatcher.h>
+#include <qthreadpool.h>
+#endif
 
 #include <algorithm>
 
@@ -142,6 +146,69 @@ private:
     int end;
 };
 
+#if QT_CONFIG(future)
+// A snapshot of the top-level sort and filter keys, from which the row mapping
+// of the top level is computed in a worker thread when asynchronousSortFilter
+// is enabled. It applies the same rules as the default implementations of
+// QSortFilterProxyModel::filterAcceptsRow() and lessThan().
+struct QSortFilterProxyModelAsyncJob
+{
+    QList<int> source_rows;         // candidate rows, in their current order
+    QList<QString> filter_keys;     // filter_key_stride keys per candidate row
+    int filter_key_stride = 0;
+    QString filter_pattern;
+    QRegularExpression::PatternOptions filter_options;
+    QList<QVariant> sort_keys;      // one key per candidate row, or empty
+    Qt::SortOrder sort_order = Qt::AscendingOrder;
+    Qt::CaseSensitivity sort_casesensitivity = Qt::CaseSensitive;
+    bool sort_localeaware = false;
+
+    QList<int> run(const QFutureInterface<QList<int>> &future) const;
+};
+
+QList<int> QSortFilterProxyModelAsyncJob::run(const QFutureInterface<QList<int>> &future) const
+{
+    // positions into source_rows of the accepted rows
+    QList<int> accepted;
+    accepted.reserve(source_rows.size());
+    if (filter_key_stride > 0) {
+        const QRegularExpression re(filter_pattern, filter_options);
+        for (int i = 0; i < source_rows.size(); ++i) {
+            const auto first = filter_keys.cbegin() + qsizetype(i) * filter_key_stride;
+            if (std::any_of(first, first + filter_key_stride,
+                            [&re](const QString &key) { return re.match(key).hasMatch(); })) {
+                accepted.append(i);
+            }
+        }
+    } else {
+        for (int i = 0; i < source_rows.size(); ++i)
+            accepted.append(i);
+    }
+
+    if (future.isCanceled())
+        return QList<int>();
+
+    if (!sort_keys.isEmpty()) {
+        const auto lessThan = [this](int left, int right) {
+            if (sort_order == Qt::DescendingOrder)
+                std::swap(left, right);
+            return QAbstractItemModelPrivate::isVariantLessThan(sort_keys.at(left), sort_keys.at(right),
+                                                                sort_casesensitivity, sort_localeaware);
+        };
+        std::stable_sort(accepted.begin(), accepted.end(), lessThan);
+    } else {
+        // restore the source model order
+        std::stable_sort(accepted.begin(), accepted.end(), [this](int left, int right) {
+            return source_rows.at(left) < source_rows.at(right);
+        });
+    }
+
+    for (int &row : accepted)
+        row = source_rows.at(row);
+    return accepted;
+}
+#endif // QT_CONFIG(future)
+
 class QSortFilterProxyModelPrivate : public QAbstractProxyModelPrivate
 {
     Q_DECLARE_PUBLIC(QSortFilterProxyModel)
@@ -185,6 +252,28 @@ public:
     QModelIndexPairList saved_persistent_indexes;
     QList<QPersistentModelIndex> saved_layoutChange_parents;
 
+    enum AsyncRequest {
+        AsyncSort = 0x1,
+        AsyncFilter = 0x2
+    };
+    // with asynchronousSortFilter, changes to more rows than this are
+    // re-sorted and re-filtered in the background ...
+    static constexpr int AsyncDataChangedThreshold = 1000;
+    // ... and insertions that end up in more places than this are merged
+    // into the mapping in one go
+    static constexpr int AsyncMergeThreshold = 32;
+    bool async_sortfilter = false;
+#if QT_CONFIG(future)
+    bool async_scheduled = false;
+    int async_pending = 0;
+    int async_running = 0;
+    // incremented whenever the top-level source rows change, which makes the
+    // result of a running job unusable
+    uint async_generation = 0;
+    uint async_job_generation = 0;
+    std::unique_ptr<QFutureWatcher<QList<int>>> async_watcher;
+#endif
+
     QHash<QModelIndex, Mapping *>::const_iterator create_mapping(
         const QModelIndex &source_parent) const;
     QModelIndex proxy_to_source(const QModelIndex &proxyIndex) const;
@@ -308,6 +397,15 @@ public:
     bool filterAcceptsRowInternal(int source_row, const QModelIndex &source_parent) const;
     bool recursiveChildAcceptsRow(int source_row, const QModelIndex &source_parent) const;
     bool recursiveParentAcceptsRow(const QModelIndex &source_parent) const;
+
+    bool can_sort_filter_async(const QModelIndex &source_parent, int requests) const;
+    void request_async_sort_filter(int requests);
+    void invalidate_async_sort_filter();
+#if QT_CONFIG(future)
+    void start_async_sort_filter();
+    void async_sort_filter_finished();
+    void apply_async_sort_filter(const QList<int> &source_rows, int requests);
+#endif
 };
 
 typedef QHash<QModelIndex, QSortFilterProxyModelPrivate::Mapping *> IndexMap;
@@ -320,6 +418,7 @@ static bool operator&(QSortFilterProxyModelPrivate::Direction a, QSortFilterProx
 void QSortFilterProxyModelPrivate::_q_sourceModelDestroyed()
 {
     QAbstractProxyModelPrivate::_q_sourceModelDestroyed();
+    invalidate_async_sort_filter();
     qDeleteAll(source_index_mapping);
     source_index_mapping.clear();
 }
@@ -390,6 +489,7 @@ void QSortFilterProxyModelPrivate::_q_clearMapping()
     // store the persistent indexes
     QModelIndexPairList source_indexes = store_persistent_indexes();
 
+    invalidate_async_sort_filter();
     qDeleteAll(source_index_mapping);
     source_index_mapping.clear();
     if (dynamic_sortfilter)
@@ -423,7 +523,12 @@ IndexMap::const_iterator QSortFilterProxyModelPrivate::create_mapping(
             m->source_columns.append(i);
     }
 
-    sort_source_rows(m->source_rows, source_parent);
+    if (source_sort_column >= 0 && can_sort_filter_async(source_parent, AsyncSort)) {
+        // show the rows in source order until the background job sorted them
+        const_cast<QSortFilterProxyModelPrivate *>(this)->request_async_sort_filter(AsyncSort);
+    } else {
+        sort_source_rows(m->source_rows, source_parent);
+    }
     m->proxy_rows.resize(source_rows);
     build_source_to_proxy_mapping(m->source_rows, m->proxy_rows);
     m->proxy_columns.resize(source_cols);
@@ -511,6 +616,11 @@ bool QSortFilterProxyModelPrivate::can_create_mapping(const QModelIndex &source_
 void QSortFilterProxyModelPrivate::sort()
 {
     Q_Q(QSortFilterProxyModel);
+    if (can_sort_filter_async(QModelIndex(), AsyncSort)) {
+        // the child mappings are sorted when the result is applied
+        request_async_sort_filter(AsyncSort);
+        return;
+    }
     emit q->layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
     QModelIndexPairList source_indexes = store_persistent_indexes();
     const auto end = source_index_mapping.constEnd();
@@ -524,6 +634,195 @@ void QSortFilterProxyModelPrivate::sort()
     emit q->layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 }
 
+/*!
+  \internal
+
+  Returns \c true if the \a requests (a combination of AsyncRequest values)
+  for the mapping of \a source_parent are handled by a background job.
+  Only the top level is sorted and filtered asynchronously; recursive
+  filtering needs to look at the children, so it is done synchronously.
+*/
+bool QSortFilterProxyModelPrivate::can_sort_filter_async(const QModelIndex &source_parent,
+                                                         int requests) const
+{
+#if QT_CONFIG(future)
+    if (!async_sortfilter || source_parent.isValid()
+        || model == QAbstractItemModelPrivate::staticEmptyModel()) {
+        return false;
+    }
+    return !(requests & AsyncFilter) || !filter_recursive;
+#else
+    Q_UNUSED(source_parent);
+    Q_UNUSED(requests);
+    return false;
+#endif
+}
+
+/*!
+  \internal
+
+  Schedules a background job that re-sorts and/or re-filters the top level,
+  depending on \a requests. Requests made while a job is scheduled or running
+  are merged, and handled by the next job.
+*/
+void QSortFilterProxyModelPrivate::request_async_sort_filter(int requests)
+{
+#if QT_CONFIG(future)
+    Q_Q(QSortFilterProxyModel);
+    async_pending |= requests;
+    if (async_scheduled || async_running)
+        return;
+    async_scheduled = true;
+    // take the snapshot from the event loop, not from within whatever
+    // (possibly nested) change notification triggered the request
+    QMetaObject::invokeMethod(q, [this] { start_async_sort_filter(); }, Qt::QueuedConnection);
+#else
+    Q_UNUSED(requests);
+#endif
+}
+
+/*!
+  \internal
+
+  Called when the top-level source rows change, so that the result of a
+  running job, computed from a snapshot of the old rows, is discarded.
+*/
+void QSortFilterProxyModelPrivate::invalidate_async_sort_filter()
+{
+#if QT_CONFIG(future)
+    ++async_generation;
+#endif
+}
+
+#if QT_CONFIG(future)
+void QSortFilterProxyModelPrivate::start_async_sort_filter()
+{
+    Q_Q(QSortFilterProxyModel);
+    async_scheduled = false;
+    const int requests = std::exchange(async_pending, 0);
+    if (!requests || !can_sort_filter_async(QModelIndex(), requests))
+        return;
+
+    // nothing to do if the top level isn't mapped yet; it will be
+    // filtered when it is created, and sorted from create_mapping()
+    const IndexMap::const_iterator it = source_index_mapping.constFind(QModelIndex());
+    if (it == source_index_mapping.constEnd())
+        return;
+    const Mapping *m = it.value();
+    const QModelIndex root;
+
+    QSortFilterProxyModelAsyncJob job;
+    if (requests & AsyncFilter) {
+        const int source_row_count = m->proxy_rows.size();
+        job.source_rows.reserve(source_row_count);
+        for (int row = 0; row < source_row_count; ++row)
+            job.source_rows.append(row);
+
+        const int source_column_count = model->columnCount(root);
+        if (!filter_data.pattern().isEmpty()
+            && (filter_column == -1 || filter_column < source_column_count)) {
+            const int first_column = filter_column == -1 ? 0 : filter_column;
+            job.filter_key_stride = filter_column == -1 ? source_column_count : 1;
+            job.filter_keys.reserve(qsizetype(source_row_count) * job.filter_key_stride);
+            for (int row = 0; row < source_row_count; ++row) {
+                for (int column = 0; column < job.filter_key_stride; ++column) {
+                    const QModelIndex index = model->index(row, first_column + column, root);
+                    job.filter_keys.append(model->data(index, filter_role).toString());
+                }
+            }
+            job.filter_pattern = filter_data.pattern();
+            job.filter_options = filter_data.patternOptions();
+        }
+    } else {
+        job.source_rows = m->source_rows;
+    }
+
+    if (source_sort_column >= 0) {
+        job.sort_keys.reserve(job.source_rows.size());
+        for (int row : qAsConst(job.source_rows))
+            job.sort_keys.append(model->data(model->index(row, source_sort_column, root), sort_role));
+        job.sort_order = sort_order;
+        job.sort_casesensitivity = sort_casesensitivity;
+        job.sort_localeaware = sort_localeaware;
+    }
+
+    if (!async_watcher) {
+        async_watcher.reset(new QFutureWatcher<QList<int>>);
+        QObject::connect(async_watcher.get(), &QFutureWatcherBase::finished,
+                         q, [this] { async_sort_filter_finished(); });
+    }
+
+    QFutureInterface<QList<int>> future;
+    future.reportStarted();
+    async_watcher->setFuture(future.future());
+    async_running = requests;
+    async_job_generation = async_generation;
+
+    QThreadPool::globalInstance()->start([future, job = std::move(job)]() mutable {
+        if (!future.isCanceled())
+            future.reportResult(job.run(future));
+        future.reportFinished();
+    });
+}
+
+void QSortFilterProxyModelPrivate::async_sort_filter_finished()
+{
+    const int requests = std::exchange(async_running, 0);
+    const QFuture<QList<int>> future = async_watcher->future();
+    if (!requests || !async_sortfilter || future.isCanceled() || future.resultCount() == 0)
+        return;
+
+    if (async_job_generation == async_generation)
+        apply_async_sort_filter(future.result(), requests);
+    else // the source rows changed in the meantime, start over
+        async_pending |= requests;
+
+    if (async_pending)
+        request_async_sort_filter(0);
+}
+
+/*!
+  \internal
+
+  Replaces the top-level mapping by \a source_rows, the result of a background
+  job for \a requests, in a single layout change.
+*/
+void QSortFilterProxyModelPrivate::apply_async_sort_filter(const QList<int> &source_rows, int requests)
+{
+    Q_Q(QSortFilterProxyModel);
+    const IndexMap::const_iterator it = source_index_mapping.constFind(QModelIndex());
+    if (it == source_index_mapping.constEnd())
+        return;
+    Mapping *m = it.value();
+
+    // with a new filter, rows may disappear and appear along with the new order
+    const auto hint = (requests & AsyncFilter) ? QAbstractItemModel::NoLayoutChangeHint
+                                               : QAbstractItemModel::VerticalSortHint;
+    emit q->layoutAboutToBeChanged(QList<QPersistentModelIndex>(), hint);
+    QModelIndexPairList source_indexes = store_persistent_indexes();
+
+    if (requests & AsyncFilter) {
+        // the child mappings are filtered again when they are needed
+        for (const QModelIndex &source_child : qAsConst(m->mapped_children))
+            remove_from_mapping(source_child);
+        m->mapped_children.clear();
+    } else {
+        for (auto child = source_index_mapping.constBegin(); child != source_index_mapping.constEnd(); ++child) {
+            if (child.value() == m)
+                continue;
+            sort_source_rows(child.value()->source_rows, child.key());
+            build_source_to_proxy_mapping(child.value()->source_rows, child.value()->proxy_rows);
+        }
+    }
+
+    m->source_rows = source_rows;
+    build_source_to_proxy_mapping(m->source_rows, m->proxy_rows);
+
+    update_persistent_indexes(source_indexes);
+    emit q->layoutChanged(QList<QPersistentModelIndex>(), hint);
+}
+#endif // QT_CONFIG(future)
+
 /*!
   \internal
 
@@ -812,6 +1111,41 @@ void QSortFilterProxyModelPrivate::insert_source_items(
     const auto proxy_intervals = proxy_intervals_for_source_items_to_add(
         proxy_to_source, source_items, source_parent, orient);
 
+    if (emit_signal && orient == Qt::Vertical && proxy_intervals.size() > AsyncMergeThreshold
+        && can_sort_filter_async(source_parent, AsyncSort)) {
+        // Inserting many scattered intervals one by one shifts the whole mapping
+        // for each of them. Instead, append all new rows at once, and move them
+        // into their sorted places in a single layout change.
+        const int old_count = proxy_to_source.size();
+        int new_count = old_count;
+        for (const auto &interval : proxy_intervals)
+            new_count += interval.second.size();
+
+        q->beginInsertRows(proxy_parent, old_count, new_count - 1);
+        for (const auto &interval : proxy_intervals)
+            proxy_to_source.append(interval.second);
+        build_source_to_proxy_mapping(proxy_to_source, source_to_proxy, old_count);
+        q->endInsertRows();
+
+        emit q->layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+        QModelIndexPairList source_indexes = store_persistent_indexes();
+        QList<int> merged;
+        merged.reserve(new_count);
+        int proxy_item = 0;
+        for (const auto &interval : proxy_intervals) {
+            for (; proxy_item < interval.first; ++proxy_item)
+                merged.append(proxy_to_source.at(proxy_item));
+            merged.append(interval.second);
+        }
+        for (; proxy_item < old_count; ++proxy_item)
+            merged.append(proxy_to_source.at(proxy_item));
+        proxy_to_source = std::move(merged);
+        build_source_to_proxy_mapping(proxy_to_source, source_to_proxy);
+        update_persistent_indexes(source_indexes);
+        emit q->layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+        return;
+    }
+
     const auto end = proxy_intervals.rend();
     for (auto it = proxy_intervals.rbegin(); it != end; ++it) {
         const QPair<int, QList<int>> &interval = *it;
@@ -1185,6 +1519,13 @@ void QSortFilterProxyModelPrivate::filter_about_to_be_changed(const QModelIndex
 */
 void QSortFilterProxyModelPrivate::filter_changed(Direction dir, const QModelIndex &source_parent)
 {
+    if ((dir & Direction::Rows) && can_sort_filter_async(source_parent, AsyncFilter)) {
+        request_async_sort_filter(AsyncFilter);
+        if (!(dir & Direction::Columns))
+            return;
+        dir = Direction::Columns;
+    }
+
     IndexMap::const_iterator it = source_index_mapping.constFind(source_parent);
     if (it == source_index_mapping.constEnd())
         return;
@@ -1326,6 +1667,10 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
         }
         Mapping *m = it.value();
 
+        const bool async = dynamic_sortfilter
+                && source_bottom_right.row() - source_top_left.row() >= AsyncDataChangedThreshold
+                && can_sort_filter_async(source_parent, AsyncFilter);
+
         // Figure out how the source changes affect us
         QList<int> source_rows_remove;
         QList<int> source_rows_insert;
@@ -1333,7 +1678,7 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
         QList<int> source_rows_resort;
         int end = qMin(source_bottom_right.row(), m->proxy_rows.count() - 1);
         for (int source_row = source_top_left.row(); source_row <= end; ++source_row) {
-            if (dynamic_sortfilter) {
+            if (dynamic_sortfilter && !async) {
                 if (m->proxy_rows.at(source_row) != -1) {
                     if (!filterAcceptsRowInternal(source_row, source_parent)) {
                         // This source row no longer satisfies the filter, so it must be removed
@@ -1357,6 +1702,11 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
             }
         }
 
+        // rows that start or stop matching the filter, or move, are updated
+        // once the background job has finished
+        if (async)
+            request_async_sort_filter(AsyncFilter);
+
         if (!source_rows_remove.isEmpty()) {
             remove_source_items(m->proxy_rows, m->source_rows,
                                 source_rows_remove, source_parent, Qt::Vertical);
@@ -1523,6 +1873,7 @@ void QSortFilterProxyModelPrivate::_q_sourceLayoutChanged(const QList<QPersisten
 
     // Optimize: We only actually have to clear the mapping related to the contents of
     // sourceParents, not everything.
+    invalidate_async_sort_filter();
     qDeleteAll(source_index_mapping);
     source_index_mapping.clear();
 
@@ -1570,6 +1921,8 @@ void QSortFilterProxyModelPrivate::_q_sourceRowsAboutToBeInserted(
 void QSortFilterProxyModelPrivate::_q_sourceRowsInserted(
     const QModelIndex &source_parent, int start, int end)
 {
+    if (!source_parent.isValid())
+        invalidate_async_sort_filter();
     if (!filter_recursive || complete_insert) {
         if (filter_recursive)
             complete_insert = false;
@@ -1609,6 +1962,8 @@ void QSortFilterProxyModelPrivate::_q_sourceRowsRemoved(
     const QModelIndex &source_parent, int start, int end)
 {
     itemsBeingRemoved = QRowsRemoval();
+    if (!source_parent.isValid())
+        invalidate_async_sort_filter();
     source_items_removed(source_parent, start, end, Qt::Vertical);
 
     if (filter_recursive) {
@@ -1917,6 +2272,12 @@ QSortFilterProxyModel::QSortFilterProxyModel(QObject *parent)
 QSortFilterProxyModel::~QSortFilterProxyModel()
 {
     Q_D(QSortFilterProxyModel);
+#if QT_CONFIG(future)
+    if (d->async_watcher) {
+        d->async_watcher->future().cancel();
+        d->async_watcher.reset();
+    }
+#endif
     qDeleteAll(d->source_index_mapping);
     d->source_index_mapping.clear();
 }
@@ -2719,6 +3080,71 @@ void QSortFilterProxyModel::setDynamicSortFilter(bool enable)
         d->sort();
 }
 
+/*!
+    \since 6.0
+    \property QSortFilterProxyModel::asynchronousSortFilter
+    \brief whether the top level of the proxy model is sorted and filtered
+    in a worker thread
+
+    Sorting and filtering a source model with millions of rows can block the
+    thread the proxy model lives in for a long time. When this property is
+    true, sort() and changes to the filter only take a snapshot of the
+    sortRole() and filterRole() data of the top-level source rows. The new
+    row order is computed from that snapshot by a thread of the global
+    QThreadPool, and applied with a single layoutChanged() signal once it is
+    ready; until then, the proxy model keeps exposing the previous order. As
+    the filter may have changed as well, the number of rows may differ after
+    the layout change. The same applies when large ranges of the source
+    model's top level change, while large batches of inserted rows are merged
+    into the sorted rows with one rowsInserted() and one layoutChanged()
+    signal, instead of one rowsInserted() signal per position.
+
+    The snapshot is evaluated with the built-in rules of lessThan() and
+    filterAcceptsRow(), so this property should not be enabled by subclasses
+    that reimplement these functions. Child rows, and the top level when
+    \l{recursiveFilteringEnabled}{recursive filtering} is used, are still
+    sorted and filtered synchronously.
+
+    The default value is false. Without support for QFuture in Qt, this
+    property has no effect.
+
+    \sa dynamicSortFilter, sort(), invalidateFilter()
+*/
+
+/*!
+    \since 6.0
+    \fn void QSortFilterProxyModel::asynchronousSortFilterChanged(bool asynchronousSortFilter)
+    \brief This signal is emitted when the asynchronousSortFilter property
+    changes to \a asynchronousSortFilter.
+*/
+bool QSortFilterProxyModel::asynchronousSortFilter() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->async_sortfilter;
+}
+
+void QSortFilterProxyModel::setAsynchronousSortFilter(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    if (d->async_sortfilter == enable)
+        return;
+
+    d->async_sortfilter = enable;
+#if QT_CONFIG(future)
+    if (!enable) {
+        // finish the outstanding work synchronously
+        const int requests = std::exchange(d->async_pending, 0) | std::exchange(d->async_running, 0);
+        if (d->async_watcher)
+            d->async_watcher->future().cancel();
+        if (requests & QSortFilterProxyModelPrivate::AsyncFilter)
+            d->filter_changed(QSortFilterProxyModelPrivate::Direction::Rows);
+        if (requests)
+            d->sort();
+    }
+#endif
+    emit asynchronousSortFilterChanged(enable);
+}
+
 /*!
     \since 4.2
     \property QSortFilterProxyModel::sortRole
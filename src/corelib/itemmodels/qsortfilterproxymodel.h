@@ -73,6 +73,7 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
     Q_PROPERTY(int filterRole READ filterRole WRITE setFilterRole NOTIFY filterRoleChanged)
     Q_PROPERTY(bool recursiveFilteringEnabled READ isRecursiveFilteringEnabled WRITE setRecursiveFilteringEnabled NOTIFY recursiveFilteringEnabledChanged)
     Q_PROPERTY(bool autoAcceptChildRows READ autoAcceptChildRows WRITE setAutoAcceptChildRows NOTIFY autoAcceptChildRowsChanged)
+    Q_PROPERTY(bool asynchronousSortFilter READ asynchronousSortFilter WRITE setAsynchronousSortFilter NOTIFY asynchronousSortFilterChanged)
 
 public:
     explicit QSortFilterProxyModel(QObject *parent = nullptr);
@@ -120,6 +121,9 @@ public:
     bool autoAcceptChildRows() const;
     void setAutoAcceptChildRows(bool accept);
 
+    bool asynchronousSortFilter() const;
+    void setAsynchronousSortFilter(bool enable);
+
 public Q_SLOTS:
 #if QT_CONFIG(regularexpression)
     void setFilterRegularExpression(const QString &pattern);
@@ -189,6 +193,7 @@ Q_SIGNALS:
     void filterRoleChanged(int filterRole);
     void recursiveFilteringEnabledChanged(bool recursiveFilteringEnabled);
     void autoAcceptChildRowsChanged(bool autoAcceptChildRows);
+    void asynchronousSortFilterChanged(bool asynchronousSortFilter);
 
 private:
     Q_DECLARE_PRIVATE(QSortFilterProxyModel)
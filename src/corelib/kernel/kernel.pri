@@ -158,6 +158,13 @@ unix|integrity {
         QMAKE_USE_PRIVATE += glib
     }
 
+    linux:!android {
+        SOURCES += \
+            kernel/qeventdispatcher_epoll.cpp
+        HEADERS += \
+            kernel/qeventdispatcher_epoll_p.h
+    }
+
     qtConfig(clock-gettime): QMAKE_USE_PRIVATE += librt
 
     !android {
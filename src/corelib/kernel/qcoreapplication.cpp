@@ -487,6 +487,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->addQueuedEvents();
         for (int i = 0; i < thisThreadData->postEventList.size(); ++i) {
             const QPostEvent &pe = thisThreadData->postEventList.at(i);
             if (pe.event) {
@@ -1524,6 +1525,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QThreadData *data = locker.threadData;
 
+    // keep the order with queued connections from this thread
+    data->addQueuedEvents();
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1572,6 +1576,46 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+  \internal
+
+  Posts the queued connection call \a event to \a receiver like postEvent()
+  does with normal priority, but without locking the receiving thread's
+  post event list: the event is pushed onto a lock-free queue that the
+  receiving thread moves into the list when it next sends posted events.
+  The receiving thread is only woken up if the queue was empty, so a burst
+  of emissions is delivered in one go.
+
+  Must be called with the signal slot lock of \a receiver held, so that
+  \a receiver cannot be destroyed concurrently.
+*/
+void QCoreApplicationPrivate::postMetaCallEvent(QObject *receiver, QMetaCallEvent *event)
+{
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+    QThreadData *data = threadData.loadAcquire();
+    if (data) {
+        data->postEventList.enqueuers.ref();
+        // pairs with the fence in QPostEventList::waitForEnqueuers(): either
+        // we see the thread data set by moveToThread(), or moveToThread()
+        // waits for us and collects the event from the old thread's queue
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (data == threadData.loadRelaxed()) {
+            Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+            event->posted = true;
+            if (data->postEventList.enqueue(receiver, event)) {
+                if (QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire())
+                    dispatcher->wakeUp();
+            }
+            data->postEventList.enqueuers.deref();
+            return;
+        }
+        data->postEventList.enqueuers.deref();
+    }
+
+    // the receiver is being moved to another thread (or destroyed); take the slow path
+    QCoreApplication::postEvent(receiver, event);
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1670,6 +1714,8 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
 
+    data->addQueuedEvents();
+
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
     // events, canWait will be set to false.
@@ -1824,6 +1870,9 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     QThreadData *data = locker.threadData;
 
+    if (data)
+        data->addQueuedEvents();
+
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
     // and when we get here, we may not have any more posted events
@@ -1887,6 +1936,8 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
 
+    data->addQueuedEvents();
+
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
         qDebug("QCoreApplication::removePostedEvent: Internal error: %p %d is posted",
@@ -144,6 +144,7 @@ public:
     static bool threadRequiresCoreApplication();
 
     static void sendPostedEvents(QObject *receiver, int event_type, QThreadData *data);
+    static void postMetaCallEvent(QObject *receiver, QMetaCallEvent *event);
 
     static void checkReceiverThread(QObject *receiver);
     void cleanupThreadData();
@@ -0,0 +1,536 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qeventdispatcher_epoll_p.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <stdio.h>
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QEventDispatcherEpoll is a Linux event dispatcher for event loops that
+    watch a large number of sockets. Unlike QEventDispatcherUNIX, which hands
+    every registered descriptor to poll() on each iteration, it keeps them in
+    a persistent epoll set that is only updated when a socket notifier is
+    enabled or disabled, and it waits for the next timer with a timerfd. The
+    cost of an iteration then depends on the number of ready descriptors, not
+    on the number of registered ones.
+
+    It is used instead of the default dispatcher when the environment
+    variable QT_EVENT_DISPATCHER_EPOLL is set to a positive number.
+*/
+
+enum {
+    // events collected per epoll_wait() call; more are picked up by the next
+    // iteration, as the set is level-triggered
+    MaxEpollEvents = 256
+};
+
+static const char *socketType(QSocketNotifier::Type type)
+{
+    switch (type) {
+    case QSocketNotifier::Read:
+        return "Read";
+    case QSocketNotifier::Write:
+        return "Write";
+    case QSocketNotifier::Exception:
+        return "Exception";
+    }
+
+    Q_UNREACHABLE();
+}
+
+static uint toEpollEvents(short pollEvents)
+{
+    uint result = 0;
+    if (pollEvents & POLLIN)
+        result |= EPOLLIN;
+    if (pollEvents & POLLOUT)
+        result |= EPOLLOUT;
+    if (pollEvents & POLLPRI)
+        result |= EPOLLPRI;
+    return result;
+}
+
+static void addToEpollSet(int epollFd, int fd)
+{
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1)
+        qFatal("QEventDispatcherEpollPrivate(): Cannot watch internal descriptor: %s",
+               qPrintable(qt_error_string(errno)));
+}
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate()
+{
+    if (Q_UNLIKELY(threadPipe.init() == false))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot continue without a thread pipe");
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (Q_UNLIKELY(epollFd == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot create epoll set: %s",
+               qPrintable(qt_error_string(errno)));
+
+    // QTimerInfoList measures time with CLOCK_MONOTONIC on Linux
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (Q_UNLIKELY(timerFd == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot create timerfd: %s",
+               qPrintable(qt_error_string(errno)));
+
+    addToEpollSet(epollFd, threadPipe.fds[0]);
+    addToEpollSet(epollFd, timerFd);
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    qt_safe_close(timerFd);
+    qt_safe_close(epollFd);
+
+    // cleanup timers
+    qDeleteAll(timerList);
+}
+
+/*
+    Brings the epoll set in line with the events that the notifiers on \a fd
+    now want, which used to be \a oldEvents.
+*/
+void QEventDispatcherEpollPrivate::updateWatchedEvents(int fd, short oldEvents, short newEvents)
+{
+    if (oldEvents == newEvents)
+        return;
+
+    if (alwaysReadyFds.contains(fd)) {
+        if (!newEvents)
+            alwaysReadyFds.remove(fd);
+        return;
+    }
+
+    epoll_event event = {};
+    event.events = toEpollEvents(newEvents);
+    event.data.fd = fd;
+
+    const int op = !oldEvents ? EPOLL_CTL_ADD : newEvents ? EPOLL_CTL_MOD : EPOLL_CTL_DEL;
+    int ret = epoll_ctl(epollFd, op, fd, &event);
+
+    // A descriptor is removed from the set when it is closed, unless other
+    // descriptors still refer to the same file, so the set can be out of date
+    // if a descriptor was closed and its number reused while being watched.
+    if (ret == -1 && op == EPOLL_CTL_ADD && errno == EEXIST)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    else if (ret == -1 && op == EPOLL_CTL_MOD && errno == ENOENT)
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+
+    if (ret == 0 || op == EPOLL_CTL_DEL)
+        return;
+
+    if (errno == EPERM) {
+        // Regular files and directories can't be added to an epoll set.
+        // poll() always reports them as ready, so do the same.
+        alwaysReadyFds.insert(fd);
+        return;
+    }
+
+    qErrnoWarning("QSocketNotifier: Cannot watch socket %d", fd);
+}
+
+/*
+    Sets the timerfd to expire at \a deadline, on the QTimerInfoList clock,
+    or disarms it if \a deadline is null.
+*/
+void QEventDispatcherEpollPrivate::armTimer(const timespec *deadline)
+{
+    const timespec next = deadline ? *deadline : timespec { 0, 0 };
+    if (next.tv_sec == armedDeadline.tv_sec && next.tv_nsec == armedDeadline.tv_nsec)
+        return;
+
+    itimerspec spec = {};
+    spec.it_value = next;
+    if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) == -1) {
+        perror("timerfd_settime");
+        return;
+    }
+    armedDeadline = next;
+}
+
+void QEventDispatcherEpollPrivate::consumeTimerExpiry()
+{
+    quint64 expirations;
+    qt_safe_read(timerFd, &expirations, sizeof(expirations));
+
+    // the timerfd is one-shot, so it is disarmed now
+    armedDeadline = { 0, 0 };
+}
+
+void QEventDispatcherEpollPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+
+    if (pendingNotifiers.contains(notifier))
+        return;
+
+    pendingNotifiers << notifier;
+}
+
+void QEventDispatcherEpollPrivate::markPendingSocketNotifier(int fd, uint epollEvents)
+{
+    auto it = socketNotifiers.constFind(fd);
+    if (it == socketNotifiers.cend()) {
+        // left behind by a descriptor that was closed while another one
+        // still refers to the same file; don't let it keep waking us up
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        return;
+    }
+
+    static const struct {
+        QSocketNotifier::Type type;
+        uint flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      EPOLLIN  | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Write,     EPOLLOUT | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Exception, EPOLLPRI | EPOLLHUP | EPOLLERR }
+    };
+
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = it.value().notifiers[n.type];
+        if (notifier && (epollEvents & n.flags))
+            setSocketNotifierPending(notifier);
+    }
+}
+
+int QEventDispatcherEpollPrivate::activateSocketNotifiers()
+{
+    if (pendingNotifiers.isEmpty())
+        return 0;
+
+    int n_activated = 0;
+    QEvent event(QEvent::SockAct);
+
+    while (!pendingNotifiers.isEmpty()) {
+        QSocketNotifier *notifier = pendingNotifiers.takeFirst();
+        QCoreApplication::sendEvent(notifier, &event);
+        ++n_activated;
+    }
+
+    return n_activated;
+}
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QAbstractEventDispatcher(*new QEventDispatcherEpollPrivate, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QAbstractEventDispatcher(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{ }
+
+/*!
+    \internal
+*/
+void QEventDispatcherEpoll::registerTimer(int timerId, qint64 interval, Qt::TimerType timerType, QObject *obj)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1 || interval < 0 || !obj) {
+        qWarning("QEventDispatcherEpoll::registerTimer: invalid arguments");
+        return;
+    } else if (obj->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::registerTimer: timers cannot be started from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    d->timerList.registerTimer(timerId, interval, timerType, obj);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimer(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: invalid argument");
+        return false;
+    } else if (thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimer(timerId);
+}
+
+/*!
+    \internal
+*/
+bool QEventDispatcherEpoll::unregisterTimers(QObject *object)
+{
+#ifndef QT_NO_DEBUG
+    if (!object) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: invalid argument");
+        return false;
+    } else if (object->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimers(object);
+}
+
+QList<QEventDispatcherEpoll::TimerInfo>
+QEventDispatcherEpoll::registeredTimers(QObject *object) const
+{
+    if (!object) {
+        qWarning("QEventDispatcherEpoll:registeredTimers: invalid argument");
+        return QList<TimerInfo>();
+    }
+
+    Q_D(const QEventDispatcherEpoll);
+    return d->timerList.registeredTimers(object);
+}
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be enabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    QSocketNotifierSetUNIX &sn_set = d->socketNotifiers[sockfd];
+
+    if (sn_set.notifiers[type] && sn_set.notifiers[type] != notifier)
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = notifier;
+    d->updateWatchedEvents(sockfd, oldEvents, sn_set.events());
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifier (fd %d) cannot be disabled from another thread.\n"
+                "(Notifier's thread is %s(%p), event dispatcher's thread is %s(%p), current thread is %s(%p))",
+                sockfd,
+                notifier->thread() ? notifier->thread()->metaObject()->className() : "QThread", notifier->thread(),
+                thread() ? thread()->metaObject()->className() : "QThread", thread(),
+                QThread::currentThread() ? QThread::currentThread()->metaObject()->className() : "QThread", QThread::currentThread());
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+
+    d->pendingNotifiers.removeOne(notifier);
+
+    auto i = d->socketNotifiers.find(sockfd);
+    if (i == d->socketNotifiers.end())
+        return;
+
+    QSocketNotifierSetUNIX &sn_set = i.value();
+
+    if (sn_set.notifiers[type] == nullptr)
+        return;
+
+    if (sn_set.notifiers[type] != notifier) {
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+        return;
+    }
+
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = nullptr;
+    d->updateWatchedEvents(sockfd, oldEvents, sn_set.events());
+
+    if (sn_set.isEmpty())
+        d->socketNotifiers.erase(i);
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(0);
+
+    // we are awake, broadcast it
+    emit awake();
+
+    auto threadData = d->threadData.loadRelaxed();
+    QCoreApplicationPrivate::sendPostedEvents(nullptr, 0, threadData);
+
+    const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
+    const bool include_notifiers = (flags & QEventLoop::ExcludeSocketNotifiers) == 0;
+    const bool wait_for_events = flags & QEventLoop::WaitForMoreEvents;
+
+    const bool canWait = (threadData->canWaitLocked()
+                          && !d->interrupt.loadRelaxed()
+                          && wait_for_events);
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (d->interrupt.loadRelaxed())
+        return false;
+
+    // The next timer wakes us up through the timerfd, so there is no timeout
+    // to compute: we either block or return right away.
+    bool block = canWait;
+    timespec deadline;
+    if (include_timers && d->timerList.timerDeadline(deadline)) {
+        if (d->timerList.currentTime < deadline)
+            d->armTimer(&deadline);
+        else
+            block = false;
+    } else {
+        d->armTimer(nullptr);
+    }
+
+    int nevents = 0;
+
+    if (include_notifiers) {
+        if (!d->alwaysReadyFds.isEmpty()) {
+            block = false;
+            for (int fd : qAsConst(d->alwaysReadyFds))
+                d->markPendingSocketNotifier(fd, EPOLLIN | EPOLLOUT);
+        }
+
+        epoll_event events[MaxEpollEvents];
+        int nready;
+        EINTR_LOOP(nready, epoll_wait(d->epollFd, events, MaxEpollEvents, block ? -1 : 0));
+        if (nready == -1)
+            perror("epoll_wait");
+
+        for (int i = 0; i < nready; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == d->threadPipe.fds[0]) {
+                pollfd pfd = d->threadPipe.prepare();
+                pfd.revents = (events[i].events & EPOLLIN) ? POLLIN : 0;
+                nevents += d->threadPipe.check(pfd);
+            } else if (fd == d->timerFd) {
+                d->consumeTimerExpiry();
+            } else {
+                d->markPendingSocketNotifier(fd, events[i].events);
+            }
+        }
+
+        nevents += d->activateSocketNotifiers();
+    } else {
+        // The sockets can't be taken out of the epoll set just for this call,
+        // so wait for the wake-up and the timer alone.
+        pollfd pfds[2] = { d->threadPipe.prepare(), qt_make_pollfd(d->timerFd, POLLIN) };
+        timespec noWait = { 0, 0 };
+
+        switch (qt_safe_poll(pfds, 2, block ? nullptr : &noWait)) {
+        case -1:
+            perror("qt_safe_poll");
+            break;
+        case 0:
+            break;
+        default:
+            nevents += d->threadPipe.check(pfds[0]);
+            if (pfds[1].revents & POLLIN)
+                d->consumeTimerExpiry();
+            break;
+        }
+    }
+
+    if (include_timers)
+        nevents += d->timerList.activateTimers();
+
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+int QEventDispatcherEpoll::remainingTime(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::remainingTime: invalid argument");
+        return -1;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.timerRemainingTime(timerId);
+}
+
+void QEventDispatcherEpoll::wakeUp()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->threadPipe.wakeUp();
+}
+
+void QEventDispatcherEpoll::interrupt()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(1);
+    wakeUp();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qeventdispatcher_epoll_p.cpp"
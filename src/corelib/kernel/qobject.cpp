@@ -222,7 +222,7 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    if (postedEvents || thisThreadData->postEventList.hasQueuedEvents())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     thisThreadData->deref();
@@ -1576,6 +1576,26 @@ void QObject::moveToThread(QThread *targetThread)
     // move the object
     d_func()->setThreadData_helper(currentData, targetData);
 
+    // queued connections that saw the old thread data may still have pushed
+    // events for the moved objects onto currentData's queue; move those too
+    currentData->postEventList.waitForEnqueuers();
+    if (currentData->postEventList.addQueuedEvents()) {
+        int eventsMoved = 0;
+        for (int i = 0; i < currentData->postEventList.size(); ++i) {
+            const QPostEvent &pe = currentData->postEventList.at(i);
+            if (pe.event && pe.receiver->d_func()->threadData.loadRelaxed() == targetData) {
+                targetData->postEventList.addEvent(pe);
+                const_cast<QPostEvent &>(pe).event = nullptr;
+                ++eventsMoved;
+            }
+        }
+        currentData->canWait = false;
+        if (eventsMoved > 0 && targetData->hasEventDispatcher()) {
+            targetData->canWait = false;
+            targetData->eventDispatcher.loadRelaxed()->wakeUp();
+        }
+    }
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -3686,7 +3706,7 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
-    QCoreApplication::postEvent(receiver, ev);
+    QCoreApplicationPrivate::postMetaCallEvent(receiver, ev);
 }
 
 template <bool callbacks_enabled>
@@ -558,6 +558,7 @@ public:
     virtual void placeMetaCall(QObject *object) override;
 
 private:
+    friend class QPostEventList;
     inline void allocArgs();
 
     struct Data {
@@ -570,6 +571,10 @@ private:
     } d;
     // preallocate enough space for three arguments
     alignas(void *) char prealloc_[3*sizeof(void*) + 3*sizeof(QMetaType)];
+
+    // link in QPostEventList's queue of lock-free posted events
+    QMetaCallEvent *nextQueued_ = nullptr;
+    QObject *queuedReceiver_ = nullptr;
 };
 
 class QBoolBlocker
@@ -408,6 +408,24 @@ bool QTimerInfoList::timerWait(timespec &tm)
     return true;
 }
 
+/*
+  Like timerWait(), but returns the absolute time at which the first timer
+  is due, on the same clock as currentTime, without rounding it.
+*/
+bool QTimerInfoList::timerDeadline(timespec &deadline)
+{
+    updateCurrentTime();
+    repairTimersIfNeeded();
+
+    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
+        if (!(*it)->activateRef) {
+            deadline = (*it)->timeout;
+            return true;
+        }
+    }
+    return false;
+}
+
 /*
   Returns the timer's remaining time in milliseconds with the given timerId, or
   null if there is nothing left. If the timer id is not found in the list, the
@@ -102,6 +102,7 @@ public:
     void repairTimersIfNeeded();
 
     bool timerWait(timespec &);
+    bool timerDeadline(timespec &);
     void timerInsert(QTimerInfo *);
 
     int timerRemainingTime(int timerId);
@@ -47,6 +47,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -60,8 +61,6 @@ static int indent = 0;
 #define DEBUG if (1) ; else qDebug()
 #endif
 
-static const int nestingLimit = 1024;
-
 QT_BEGIN_NAMESPACE
 
 // error strings for the JSON parser
@@ -272,6 +271,106 @@ enum {
     Quote = 0x22
 };
 
+static inline bool isJsonSpace(char c) noexcept
+{
+    return c == Space || c == Tab || c == LineFeed || c == Return;
+}
+
+// Returns a pointer to the first character in [ptr, end) that is not JSON
+// whitespace, or \a end. Compact documents rarely have more than one
+// whitespace character between tokens, so those are dealt with before
+// loading any vector registers; indented documents benefit from skipping
+// the indentation a block at a time.
+const char *QJsonPrivate::skipSpace(const char *ptr, const char *end) noexcept
+{
+    if (ptr < end && *ptr > Space)
+        return ptr;
+    if (ptr < end && isJsonSpace(*ptr) && (++ptr == end || *ptr > Space))
+        return ptr;
+
+#ifdef __SSE2__
+#  if defined(__AVX2__) && !defined(__OPTIMIZE_SIZE__)
+    const __m256i space32 = _mm256_set1_epi8(Space);
+    const __m256i tab32 = _mm256_set1_epi8(Tab);
+    const __m256i lf32 = _mm256_set1_epi8(LineFeed);
+    const __m256i cr32 = _mm256_set1_epi8(Return);
+    while (end - ptr >= 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, space32),
+                                                     _mm256_cmpeq_epi8(data, tab32)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(data, lf32),
+                                                     _mm256_cmpeq_epi8(data, cr32)));
+        uint mask = ~uint(_mm256_movemask_epi8(ws));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 32;
+    }
+#  endif
+    const __m128i space = _mm_set1_epi8(Space);
+    const __m128i tab = _mm_set1_epi8(Tab);
+    const __m128i lf = _mm_set1_epi8(LineFeed);
+    const __m128i cr = _mm_set1_epi8(Return);
+    while (end - ptr >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                               _mm_cmpeq_epi8(data, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(data, lf),
+                                               _mm_cmpeq_epi8(data, cr)));
+        uint mask = ~uint(_mm_movemask_epi8(ws)) & 0xffff;
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 16;
+    }
+#endif
+
+    while (ptr < end && isJsonSpace(*ptr))
+        ++ptr;
+    return ptr;
+}
+
+// Returns a pointer to the first character in [ptr, end) that needs the
+// attention of the string parser: a quotation mark, a reverse solidus or
+// the lead byte of a multi-byte UTF-8 sequence. Everything before it is
+// plain US-ASCII that can be copied verbatim.
+const char *QJsonPrivate::skipPlainAscii(const char *ptr, const char *end) noexcept
+{
+#ifdef __SSE2__
+#  if defined(__AVX2__) && !defined(__OPTIMIZE_SIZE__)
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i backslash32 = _mm256_set1_epi8('\\');
+    while (end - ptr >= 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(data, quote32),
+                                          _mm256_cmpeq_epi8(data, backslash32));
+        // the high bit of each byte is set either by the comparison or by non-ASCII input
+        uint mask = uint(_mm256_movemask_epi8(_mm256_or_si256(special, data)));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 32;
+    }
+#  endif
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    while (end - ptr >= 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                       _mm_cmpeq_epi8(data, backslash));
+        uint mask = uint(_mm_movemask_epi8(_mm_or_si128(special, data)));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+        ptr += 16;
+    }
+#endif
+
+    while (ptr < end) {
+        const uchar c = uchar(*ptr);
+        if (c == '"' || c == '\\' || c >= 0x80)
+            break;
+        ++ptr;
+    }
+    return ptr;
+}
+
 void Parser::eatBOM()
 {
     // eat UTF-8 byte order mark
@@ -285,16 +384,7 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
-    }
+    json = skipSpace(json, end);
     return (json < end);
 }
 
@@ -670,12 +760,11 @@ bool Parser::parseValue()
 
 */
 
-bool Parser::parseNumber()
+// Returns a pointer past the end of the number starting at \a json. Sets
+// \a isInt to false if the number has a non-zero fraction or an exponent.
+const char *QJsonPrivate::scanNumber(const char *json, const char *end, bool *isInt) noexcept
 {
-    BEGIN << "parseNumber" << json;
-
-    const char *start = json;
-    bool isInt = true;
+    *isInt = true;
 
     // minus
     if (json < end && *json == '-')
@@ -693,14 +782,14 @@ bool Parser::parseNumber()
     if (json < end && *json == '.') {
         ++json;
         while (json < end && *json >= '0' && *json <= '9') {
-            isInt = isInt && *json == '0';
+            *isInt = *isInt && *json == '0';
             ++json;
         }
     }
 
     // exp = e [ minus / plus ] 1*DIGIT
     if (json < end && (*json == 'e' || *json == 'E')) {
-        isInt = false;
+        *isInt = false;
         ++json;
         if (json < end && (*json == '-' || *json == '+'))
             ++json;
@@ -708,37 +797,55 @@ bool Parser::parseNumber()
             ++json;
     }
 
-    if (json >= end) {
-        lastError = QJsonParseError::TerminationByNumber;
-        return false;
-    }
+    return json;
+}
 
-    const QByteArray number = QByteArray::fromRawData(start, json - start);
+// Converts a number found by scanNumber(). Returns an invalid QCborValue if
+// the text isn't a well-formed number.
+QCborValue QJsonPrivate::numberValue(const char *begin, const char *end, bool isInt)
+{
+    const QByteArray number = QByteArray::fromRawData(begin, end - begin);
     DEBUG << "numberstring" << number;
 
     if (isInt) {
         bool ok;
         qlonglong n = number.toLongLong(&ok);
-        if (ok) {
-            container->append(QCborValue(n));
-            END;
-            return true;
-        }
+        if (ok)
+            return QCborValue(n);
     }
 
     bool ok;
     double d = number.toDouble(&ok);
 
-    if (!ok) {
+    if (!ok)
+        return QCborValue(QCborValue::Invalid);
+
+    qint64 n;
+    if (convertDoubleTo(d, &n))
+        return QCborValue(n);
+    return QCborValue(d);
+}
+
+bool Parser::parseNumber()
+{
+    BEGIN << "parseNumber" << json;
+
+    const char *start = json;
+    bool isInt;
+    json = scanNumber(json, end, &isInt);
+
+    if (json >= end) {
+        lastError = QJsonParseError::TerminationByNumber;
+        return false;
+    }
+
+    QCborValue number = numberValue(start, json, isInt);
+    if (number.isInvalid()) {
         lastError = QJsonParseError::IllegalNumber;
         return false;
     }
 
-    qint64 n;
-    if (convertDoubleTo(d, &n))
-        container->append(QCborValue(n));
-    else
-        container->append(QCborValue(d));
+    container->append(number);
 
     END;
     return true;
@@ -780,7 +887,7 @@ static inline bool addHexDigit(char digit, uint *result)
     return true;
 }
 
-static inline bool scanEscapeSequence(const char *&json, const char *end, uint *ch)
+bool QJsonPrivate::scanEscapeSequence(const char *&json, const char *end, uint *ch)
 {
     ++json;
     if (json >= end)
@@ -825,7 +932,7 @@ static inline bool scanEscapeSequence(const char *&json, const char *end, uint *
     return true;
 }
 
-static inline bool scanUtf8Char(const char *&json, const char *end, uint *result)
+bool QJsonPrivate::scanUtf8Char(const char *&json, const char *end, uint *result)
 {
     const auto *usrc = reinterpret_cast<const uchar *>(json);
     const auto *uend = reinterpret_cast<const uchar *>(end);
@@ -849,6 +956,9 @@ bool Parser::parseString()
     bool isAscii = true;
     while (json < end) {
         uint ch = 0;
+        json = skipPlainAscii(json, end);
+        if (json >= end)
+            break;
         if (*json == '"')
             break;
         if (*json == '\\') {
@@ -891,6 +1001,12 @@ bool Parser::parseString()
     QString ucs4;
     while (json < end) {
         uint ch = 0;
+        const char *plain = json;
+        json = skipPlainAscii(json, end);
+        if (json != plain)
+            ucs4.append(QLatin1String(plain, json - plain));
+        if (json >= end)
+            break;
         if (*json == '"')
             break;
         else if (*json == '\\') {
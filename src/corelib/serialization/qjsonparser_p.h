@@ -59,6 +59,16 @@ QT_BEGIN_NAMESPACE
 
 namespace QJsonPrivate {
 
+constexpr int nestingLimit = 1024;
+
+// Scanning primitives shared by Parser and QJsonStreamReader
+const char *skipSpace(const char *ptr, const char *end) noexcept;
+const char *skipPlainAscii(const char *ptr, const char *end) noexcept;
+const char *scanNumber(const char *json, const char *end, bool *isInt) noexcept;
+QCborValue numberValue(const char *begin, const char *end, bool isInt);
+bool scanEscapeSequence(const char *&json, const char *end, uint *ch);
+bool scanUtf8Char(const char *&json, const char *end, uint *result);
+
 class Parser
 {
 public:
@@ -0,0 +1,824 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamreader.h"
+
+#include "qjsonparser_p.h"
+
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QJsonPrivate;
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.0
+
+    \brief The QJsonStreamReader class is a simple JSON parser that operates
+    on either a QByteArray or QIODevice.
+
+    QJsonStreamReader is a pull parser: instead of building a complete
+    QJsonDocument in memory, it reports the document one token at a time
+    through readNext(). The memory needed to read a document is therefore
+    bounded by the size of the largest single token and the nesting depth,
+    not by the size of the document, which makes it suitable for very large
+    files and for newline-delimited JSON.
+
+    The reader accepts a sequence of top-level values of any type separated
+    by insignificant whitespace. Within those values, it applies the same
+    grammar as QJsonDocument::fromJson() and reports the same
+    QJsonParseError::ParseError codes, available from parseError().
+
+    A typical loop looks like this:
+
+    \code
+        QJsonStreamReader reader(&file);
+        while (!reader.atEnd()) {
+            reader.readNext();
+            if (reader.isName() && reader.text() == u"payload") {
+                reader.skipValue();
+                continue;
+            }
+            // ...
+        }
+        if (reader.hasError()) {
+            // ...
+        }
+    \endcode
+
+    \section1 Incremental parsing
+
+    When data arrives in pieces, as from a network socket, feed each piece
+    with addData() or let the reader pull from a QIODevice. If the reader
+    runs out of data in the middle of a token or a container, readNext()
+    returns Invalid and error() is PrematureEndOfDocumentError. This error is
+    recoverable: once more data is available, calling readNext() again
+    resumes from where parsing stopped. Running out of data between two
+    top-level values is reported as EndDocument instead; reading may
+    continue after that, too, if more data arrives.
+
+    Strings and member names are returned by text() as a view into the
+    reader's buffer whenever they contain no escape sequences, so no copy
+    is made. That view, and any other data of the current token, is only
+    valid until the next call to readNext(), skipValue(), addData() or
+    clear().
+
+    \sa QJsonDocument, QCborStreamReader, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken      The reader has not yet read anything.
+    \value Invalid      An error has occurred, reported in error() and
+                        errorString().
+    \value StartArray   The reader reports the start of an array.
+    \value EndArray     The reader reports the end of an array.
+    \value StartObject  The reader reports the start of an object.
+    \value EndObject    The reader reports the end of an object.
+    \value Name         The reader reports the name of an object member,
+                        available with text(). The member's value follows.
+    \value String       The reader reports a string, available with text().
+    \value Number       The reader reports a number, available with
+                        toInteger() or toDouble().
+    \value Bool         The reader reports \c true or \c false, available
+                        with toBool().
+    \value Null         The reader reports \c null.
+    \value EndDocument  The reader has consumed all available top-level
+                        values.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the different error cases.
+
+    \value NoError      No error has occurred.
+    \value NotWellFormedError   The parser internally raised an error due to
+                        the read JSON not being well-formed. parseError()
+                        has the details.
+    \value PrematureEndOfDocumentError  The input stream ended before the
+                        current value was complete. This error is
+                        recoverable: more data can be added and
+                        readNext() called again.
+*/
+
+enum { ReadChunkSize = 16 * 1024 };
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum Expectation : quint8 {
+        ExpectTopLevelValue,
+        ExpectValue,
+        ExpectValueOrEndArray,
+        ExpectNameOrEndObject,
+        ExpectName,
+        ExpectNameSeparator,
+        ExpectSeparatorOrEnd
+    };
+    enum ScanResult { Scanned, NeedMoreData, Malformed };
+
+    QJsonStreamReader::TokenType readNext();
+    bool fill();
+    void compact();
+    bool inputComplete() const
+    { return device && !device->isSequential() && device->atEnd(); }
+
+    ScanResult scanString();
+    ScanResult scanLiteral(const char *literal, qsizetype len);
+    ScanResult scanNumber();
+
+    QJsonStreamReader::TokenType finishValue(QJsonStreamReader::TokenType t)
+    {
+        expect = containers.isEmpty() ? ExpectTopLevelValue : ExpectSeparatorOrEnd;
+        return type = t;
+    }
+    QJsonStreamReader::TokenType closeContainer()
+    {
+        const char open = containers.last();
+        containers.removeLast();
+        ++pos;
+        return finishValue(open == '[' ? QJsonStreamReader::EndArray
+                                       : QJsonStreamReader::EndObject);
+    }
+    QJsonStreamReader::TokenType malformed(QJsonParseError::ParseError e)
+    {
+        error = QJsonStreamReader::NotWellFormedError;
+        parseError = e;
+        skipDepth = -1;
+        return type = QJsonStreamReader::Invalid;
+    }
+    QJsonStreamReader::TokenType prematureEnd()
+    {
+        error = QJsonStreamReader::PrematureEndOfDocumentError;
+        return type = QJsonStreamReader::Invalid;
+    }
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;          // first byte in buffer not consumed yet
+    qint64 bufferOffset = 0;    // offset of buffer[0] in the stream
+
+    QVarLengthArray<char, 32> containers;   // '[' or '{' for each open container
+    Expectation expect = ExpectTopLevelValue;
+    int skipDepth = -1;
+
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    QJsonStreamReader::Error error = QJsonStreamReader::NoError;
+    QJsonParseError::ParseError parseError = QJsonParseError::NoError;
+
+    // the current token
+    qsizetype textBegin = 0;
+    qsizetype textLength = 0;
+    bool textHasEscapes = false;
+    QString decoded;
+    QCborValue number;
+    bool boolean = false;
+};
+
+// Drops the consumed part of the buffer. Views handed out for the previous
+// token are invalidated by this.
+void QJsonStreamReaderPrivate::compact()
+{
+    if (!pos)
+        return;
+    if (pos == buffer.size())
+        buffer.clear();
+    else
+        buffer.remove(0, pos);
+    bufferOffset += pos;
+    pos = 0;
+}
+
+bool QJsonStreamReaderPrivate::fill()
+{
+    if (!device)
+        return false;
+
+    compact();
+    const qsizetype oldSize = buffer.size();
+    buffer.resize(oldSize + ReadChunkSize);
+    const qint64 n = device->read(buffer.data() + oldSize, ReadChunkSize);
+    buffer.resize(oldSize + qMax(n, qint64(0)));
+    return n > 0;
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::scanString()
+{
+    const char *begin = buffer.constData();
+    const char *end = begin + buffer.size();
+    const char *bodyBegin = begin + pos + 1;
+
+    // find the closing quotation mark first, so that multi-byte sequences
+    // and escape sequences are never cut off by the end of the buffer
+    const char *ptr = bodyBegin;
+    bool hasEscapes = false;
+    for (;;) {
+        ptr = skipPlainAscii(ptr, end);
+        if (ptr == end)
+            return NeedMoreData;
+        if (*ptr == '"')
+            break;
+        if (*ptr == '\\') {
+            if (end - ptr < 2)
+                return NeedMoreData;
+            hasEscapes = true;
+            ptr += 2;
+        } else {
+            ++ptr;
+        }
+    }
+    const char *bodyEnd = ptr;
+
+    if (!hasEscapes) {
+        for (ptr = skipPlainAscii(bodyBegin, bodyEnd); ptr < bodyEnd;
+             ptr = skipPlainAscii(ptr, bodyEnd)) {
+            uint ch;
+            if (!scanUtf8Char(ptr, bodyEnd, &ch)) {
+                parseError = QJsonParseError::IllegalUTF8String;
+                return Malformed;
+            }
+        }
+    } else {
+        decoded.clear();
+        ptr = bodyBegin;
+        while (ptr < bodyEnd) {
+            const char *plain = ptr;
+            ptr = skipPlainAscii(ptr, bodyEnd);
+            if (ptr != plain)
+                decoded.append(QLatin1String(plain, ptr - plain));
+            if (ptr == bodyEnd)
+                break;
+
+            uint ch = 0;
+            if (*ptr == '\\') {
+                if (!scanEscapeSequence(ptr, bodyEnd, &ch)) {
+                    parseError = QJsonParseError::IllegalEscapeSequence;
+                    return Malformed;
+                }
+            } else if (!scanUtf8Char(ptr, bodyEnd, &ch)) {
+                parseError = QJsonParseError::IllegalUTF8String;
+                return Malformed;
+            }
+            decoded.append(QChar::fromUcs4(ch));
+        }
+    }
+
+    textHasEscapes = hasEscapes;
+    textBegin = bodyBegin - begin;
+    textLength = bodyEnd - bodyBegin;
+    pos = bodyEnd + 1 - begin;
+    return Scanned;
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::scanLiteral(const char *literal,
+                                                                           qsizetype len)
+{
+    const qsizetype available = qMin(buffer.size() - pos, len);
+    if (memcmp(buffer.constData() + pos, literal, available) != 0) {
+        parseError = QJsonParseError::IllegalValue;
+        return Malformed;
+    }
+    if (available < len)
+        return NeedMoreData;
+    pos += len;
+    return Scanned;
+}
+
+QJsonStreamReaderPrivate::ScanResult QJsonStreamReaderPrivate::scanNumber()
+{
+    const char *begin = buffer.constData() + pos;
+    const char *end = buffer.constData() + buffer.size();
+    bool isInt;
+    const char *ptr = QJsonPrivate::scanNumber(begin, end, &isInt);
+
+    // more digits may follow in data we haven't seen yet
+    if (ptr == end && !inputComplete())
+        return NeedMoreData;
+
+    number = numberValue(begin, ptr, isInt);
+    if (number.isInvalid()) {
+        parseError = QJsonParseError::IllegalNumber;
+        return Malformed;
+    }
+    pos += ptr - begin;
+    return Scanned;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readNext()
+{
+    if (error == QJsonStreamReader::NotWellFormedError)
+        return QJsonStreamReader::Invalid;
+    error = QJsonStreamReader::NoError;
+    textHasEscapes = false;
+    textLength = 0;
+
+    for (;;) {
+        const char *begin = buffer.constData();
+        const char *end = begin + buffer.size();
+        pos = skipSpace(begin + pos, end) - begin;
+        if (pos == buffer.size()) {
+            if (fill())
+                continue;
+            if (expect == ExpectTopLevelValue)
+                return type = QJsonStreamReader::EndDocument;
+            return prematureEnd();
+        }
+
+        const char c = buffer.at(pos);
+        switch (expect) {
+        case ExpectNameSeparator:
+            if (c != ':')
+                return malformed(QJsonParseError::MissingNameSeparator);
+            ++pos;
+            expect = ExpectValue;
+            continue;
+
+        case ExpectSeparatorOrEnd: {
+            const bool inArray = containers.last() == '[';
+            if (c == ',') {
+                ++pos;
+                expect = inArray ? ExpectValue : ExpectName;
+                continue;
+            }
+            if (c == (inArray ? ']' : '}'))
+                return closeContainer();
+            return malformed(inArray ? QJsonParseError::MissingValueSeparator
+                                     : QJsonParseError::UnterminatedObject);
+        }
+
+        case ExpectValueOrEndArray:
+            if (c == ']')
+                return closeContainer();
+            break;
+
+        case ExpectNameOrEndObject:
+            if (c == '}')
+                return closeContainer();
+            Q_FALLTHROUGH();
+        case ExpectName:
+            if (c != '"') {
+                return malformed(expect == ExpectName && c == '}'
+                                 ? QJsonParseError::MissingObject
+                                 : QJsonParseError::UnterminatedObject);
+            }
+            switch (scanString()) {
+            case Scanned:
+                expect = ExpectNameSeparator;
+                return type = QJsonStreamReader::Name;
+            case NeedMoreData:
+                if (fill())
+                    continue;
+                return prematureEnd();
+            case Malformed:
+                return malformed(parseError);
+            }
+            Q_UNREACHABLE();
+
+        case ExpectTopLevelValue:
+        case ExpectValue:
+            break;
+        }
+
+        // value = false / null / true / object / array / number / string
+        ScanResult result;
+        QJsonStreamReader::TokenType valueType;
+        switch (c) {
+        case '[':
+        case '{':
+            if (containers.size() >= nestingLimit)
+                return malformed(QJsonParseError::DeepNesting);
+            containers.append(c);
+            ++pos;
+            expect = c == '[' ? ExpectValueOrEndArray : ExpectNameOrEndObject;
+            return type = c == '[' ? QJsonStreamReader::StartArray
+                                   : QJsonStreamReader::StartObject;
+        case ']':
+        case '}':
+            return malformed(QJsonParseError::MissingObject);
+        case ',':
+            return malformed(QJsonParseError::IllegalValue);
+        case '"':
+            result = scanString();
+            valueType = QJsonStreamReader::String;
+            break;
+        case 't':
+            result = scanLiteral("true", 4);
+            boolean = true;
+            valueType = QJsonStreamReader::Bool;
+            break;
+        case 'f':
+            result = scanLiteral("false", 5);
+            boolean = false;
+            valueType = QJsonStreamReader::Bool;
+            break;
+        case 'n':
+            result = scanLiteral("null", 4);
+            valueType = QJsonStreamReader::Null;
+            break;
+        default:
+            result = scanNumber();
+            valueType = QJsonStreamReader::Number;
+            break;
+        }
+
+        switch (result) {
+        case Scanned:
+            return finishValue(valueType);
+        case NeedMoreData:
+            if (fill())
+                continue;
+            return prematureEnd();
+        case Malformed:
+            return malformed(parseError);
+        }
+        Q_UNREACHABLE();
+    }
+}
+
+/*!
+    Constructs a stream reader with no data. Use addData() or setDevice()
+    to provide the JSON to read.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Creates a new JSON stream reader that reads from the \a len bytes
+    starting at \a data. The data is copied.
+*/
+QJsonStreamReader::QJsonStreamReader(const char *data, qsizetype len)
+    : QJsonStreamReader()
+{
+    addData(data, len);
+}
+
+/*!
+    Creates a new JSON stream reader that reads from \a data.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    addData(data);
+}
+
+/*!
+    Creates a new JSON stream reader that reads from \a device. The device
+    must already be open.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    setDevice(device);
+}
+
+/*!
+    Destroys the reader. The device, if any, is not closed.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the current device to \a device, discarding any buffered data and
+    the parser state.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    clear();
+    d->device = device;
+}
+
+/*!
+    Returns the current device, or \nullptr if there is none.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Adds more \a data for the reader to read. This function does nothing
+    if the reader has a device().
+
+    If the previous call to readNext() ran out of data, the next call
+    continues from where it stopped.
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+/*!
+    \overload
+
+    Adds the \a len bytes starting at \a data. The data is copied.
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->compact();
+    d->buffer.append(data, len);
+}
+
+/*!
+    Removes the device or data from the reader and resets it to its initial
+    state.
+*/
+void QJsonStreamReader::clear()
+{
+    d.reset(new QJsonStreamReaderPrivate);
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    If the reader had previously run out of data, readNext() tries again,
+    using any data added in the meantime. Once a NotWellFormedError has
+    occurred, readNext() always returns Invalid.
+
+    \sa tokenType(), atEnd()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    return d->readNext();
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa readNext()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d->type;
+}
+
+/*!
+    Returns \c true if the reader has consumed all available input or
+    encountered an error; otherwise returns \c false.
+
+    Reaching the end of the available data does not mean that the stream
+    has ended: if more data is added, reading can continue.
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    return d->type == EndDocument || d->type == Invalid;
+}
+
+/*!
+    Skips the current value.
+
+    If the current token is a Name, the member's value is skipped. If it is
+    StartArray or StartObject, everything up to and including the matching
+    EndArray or EndObject is skipped. Any other token is a complete value
+    already, and nothing is done.
+
+    Returns \c true on success. If an error occurs, returns \c false. If the
+    error is PrematureEndOfDocumentError, calling skipValue() again after
+    more data has become available continues skipping.
+*/
+bool QJsonStreamReader::skipValue()
+{
+    if (d->skipDepth < 0) {
+        switch (d->type) {
+        case Name:
+            d->skipDepth = depth();
+            break;
+        case StartArray:
+        case StartObject:
+            d->skipDepth = depth() - 1;
+            break;
+        case Invalid:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    for (;;) {
+        switch (readNext()) {
+        case Invalid:
+            return false;
+        case EndDocument:
+            d->skipDepth = -1;
+            return false;
+        case Name:
+        case StartArray:
+        case StartObject:
+            continue;
+        default:
+            if (depth() == d->skipDepth) {
+                d->skipDepth = -1;
+                return true;
+            }
+        }
+    }
+}
+
+/*!
+    Returns the number of arrays and objects that are open at the current
+    position.
+*/
+int QJsonStreamReader::depth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Returns the offset in the input stream just past the last byte the
+    reader has consumed. After an error, this is where the offending token
+    begins.
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+    Returns the text of the current Name or String token. For any other
+    token, returns a null view.
+
+    If the string contains no escape sequences, the returned view refers
+    directly to the UTF-8 data in the reader's buffer. The view is only
+    valid until the next call to readNext().
+
+    \sa toString()
+*/
+QAnyStringView QJsonStreamReader::text() const
+{
+    if (d->type != Name && d->type != String)
+        return QAnyStringView();
+    if (d->textHasEscapes)
+        return d->decoded;
+    return QUtf8StringView(d->buffer.constData() + d->textBegin, d->textLength);
+}
+
+/*!
+    Returns the text of the current Name or String token as a QString. For
+    any other token, returns a null string.
+
+    \sa text()
+*/
+QString QJsonStreamReader::toString() const
+{
+    if (d->type != Name && d->type != String)
+        return QString();
+    if (d->textHasEscapes)
+        return d->decoded;
+    return QString::fromUtf8(d->buffer.constData() + d->textBegin, d->textLength);
+}
+
+/*!
+    Returns \c true if the current token is a Number that can be
+    represented exactly as a 64-bit integer.
+
+    \sa toInteger(), toDouble()
+*/
+bool QJsonStreamReader::isInteger() const
+{
+    return d->type == Number && d->number.isInteger();
+}
+
+/*!
+    Returns the current Number token as a 64-bit integer, truncating if it
+    isn't one. Returns 0 for any other token.
+
+    \sa isInteger(), toDouble()
+*/
+qint64 QJsonStreamReader::toInteger() const
+{
+    return d->type == Number ? d->number.toInteger() : 0;
+}
+
+/*!
+    Returns the current Number token as a double. Returns 0 for any other
+    token.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    return d->type == Number ? d->number.toDouble() : 0;
+}
+
+/*!
+    Returns the value of the current Bool token. Returns \c false for any
+    other token.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    return d->type == Bool && d->boolean;
+}
+
+/*!
+    Returns the type of the current error, or NoError if no error occurred.
+
+    \sa errorString(), parseError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    return d->error;
+}
+
+/*!
+    If error() is NotWellFormedError, returns which rule of the grammar was
+    violated. Otherwise returns QJsonParseError::NoError.
+
+    \sa errorString(), currentOffset()
+*/
+QJsonParseError::ParseError QJsonStreamReader::parseError() const
+{
+    return d->error == NotWellFormedError ? d->parseError : QJsonParseError::NoError;
+}
+
+/*!
+    Returns a human-readable description of the current error.
+
+    \sa error(), parseError()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    QJsonParseError e;
+    switch (d->error) {
+    case NoError:
+        e.error = QJsonParseError::NoError;
+        break;
+    case NotWellFormedError:
+        e.error = d->parseError;
+        break;
+    case PrematureEndOfDocumentError: {
+        const char c = d->pos < d->buffer.size() ? d->buffer.at(d->pos) : '\0';
+        if (c == '"')
+            e.error = QJsonParseError::UnterminatedString;
+        else if (c == '-' || (c >= '0' && c <= '9'))
+            e.error = QJsonParseError::TerminationByNumber;
+        else if (d->containers.isEmpty())
+            e.error = QJsonParseError::IllegalValue;
+        else if (d->containers.last() == '[')
+            e.error = QJsonParseError::UnterminatedArray;
+        else
+            e.error = QJsonParseError::UnterminatedObject;
+        break;
+    }
+    }
+    return e.errorString();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QJSONSTREAMREADER_H
+#define QJSONSTREAMREADER_H
+
+#include <QtCore/qanystringview.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QJsonStreamReaderPrivate;
+class Q_CORE_EXPORT QJsonStreamReader
+{
+    Q_GADGET
+public:
+    enum TokenType {
+        NoToken = 0,
+        Invalid,
+        StartArray,
+        EndArray,
+        StartObject,
+        EndObject,
+        Name,
+        String,
+        Number,
+        Bool,
+        Null,
+        EndDocument
+    };
+    Q_ENUM(TokenType)
+
+    enum Error {
+        NoError = 0,
+        NotWellFormedError,
+        PrematureEndOfDocumentError
+    };
+    Q_ENUM(Error)
+
+    QJsonStreamReader();
+    QJsonStreamReader(const char *data, qsizetype len);
+    explicit QJsonStreamReader(const QByteArray &data);
+    explicit QJsonStreamReader(QIODevice *device);
+    ~QJsonStreamReader();
+    Q_DISABLE_COPY(QJsonStreamReader)
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+    void addData(const QByteArray &data);
+    void addData(const char *data, qsizetype len);
+    void clear();
+
+    TokenType readNext();
+    TokenType tokenType() const;
+    bool atEnd() const;
+    bool skipValue();
+
+    int depth() const;
+    qint64 currentOffset() const;
+
+    bool isStartArray() const { return tokenType() == StartArray; }
+    bool isEndArray() const { return tokenType() == EndArray; }
+    bool isStartObject() const { return tokenType() == StartObject; }
+    bool isEndObject() const { return tokenType() == EndObject; }
+    bool isName() const { return tokenType() == Name; }
+    bool isString() const { return tokenType() == String; }
+    bool isNumber() const { return tokenType() == Number; }
+    bool isBool() const { return tokenType() == Bool; }
+    bool isNull() const { return tokenType() == Null; }
+
+    QAnyStringView text() const;
+    QString toString() const;
+    bool isInteger() const;
+    qint64 toInteger() const;
+    double toDouble() const;
+    bool toBool() const;
+
+    Error error() const;
+    QJsonParseError::ParseError parseError() const;
+    QString errorString() const;
+    bool hasError() const { return error() != NoError; }
+
+private:
+    QScopedPointer<QJsonStreamReaderPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QJSONSTREAMREADER_H
@@ -17,6 +17,7 @@ HEADERS += \
     serialization/qjsonarray.h \
     serialization/qjsonwriter_p.h \
     serialization/qjsonparser_p.h \
+    serialization/qjsonstreamreader.h \
     serialization/qtextstream.h \
     serialization/qtextstream_p.h \
     serialization/qxmlstream.h \
@@ -37,6 +38,7 @@ SOURCES += \
     serialization/qjsonvalue.cpp \
     serialization/qjsonwriter.cpp \
     serialization/qjsonparser.cpp \
+    serialization/qjsonstreamreader.cpp \
     serialization/qtextstream.cpp \
     serialization/qxmlstream.cpp \
     serialization/qxmlstreamgrammar.cpp \
@@ -53,6 +53,37 @@
 
 QT_BEGIN_NAMESPACE
 
+/*
+  QPostEventList
+*/
+
+int QPostEventList::addQueuedEvents()
+{
+    QMetaCallEvent *ev = queuedEvents.fetchAndStoreAcquire(nullptr);
+    if (!ev)
+        return 0;
+
+    // the stack holds the most recently posted event first
+    QMetaCallEvent *ordered = nullptr;
+    while (ev) {
+        QMetaCallEvent *next = ev->nextQueued_;
+        ev->nextQueued_ = ordered;
+        ordered = ev;
+        ev = next;
+    }
+
+    int count = 0;
+    while (ordered) {
+        QMetaCallEvent *next = std::exchange(ordered->nextQueued_, nullptr);
+        QObject *receiver = std::exchange(ordered->queuedReceiver_, nullptr);
+        addEvent(QPostEvent(receiver, ordered, Qt::NormalEventPriority));
+        ++QObjectPrivate::get(receiver)->postedEvents;
+        ordered = next;
+        ++count;
+    }
+    return count;
+}
+
 /*
   QThreadData
 */
@@ -93,6 +124,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    postEventList.addQueuedEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -107,6 +107,13 @@ public:
 
     QMutex mutex;
 
+    // Events of queued connections are pushed onto this lock-free stack
+    // without taking the mutex (see QCoreApplicationPrivate::postMetaCallEvent),
+    // and moved into the list by addQueuedEvents() by whoever holds the mutex
+    // next. enqueuers counts the threads that are about to push.
+    QAtomicPointer<QMetaCallEvent> queuedEvents;
+    QAtomicInt enqueuers;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev) {
@@ -125,6 +132,33 @@ public:
             insert(at, ev);
         }
     }
+
+    // Returns true if the queue was empty, i.e. if nobody has woken up the
+    // receiving thread for the events in the queue yet.
+    bool enqueue(QObject *receiver, QMetaCallEvent *ev) noexcept
+    {
+        ev->queuedReceiver_ = receiver;
+        QMetaCallEvent *head = queuedEvents.loadRelaxed();
+        do {
+            ev->nextQueued_ = head;
+        } while (!queuedEvents.testAndSetRelease(head, ev, head));
+        return head == nullptr;
+    }
+
+    bool hasQueuedEvents() const noexcept
+    { return queuedEvents.loadRelaxed() != nullptr; }
+
+    // Waits until no thread is pushing onto the queue anymore; used after
+    // objects have been moved to another thread.
+    void waitForEnqueuers() noexcept
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (enqueuers.loadAcquire())
+            QThread::yieldCurrentThread();
+    }
+
+    int addQueuedEvents();
+
 private:
     //hides because they do not keep that list sorted. addEvent must be used
     using QList<QPostEvent>::append;
@@ -255,7 +289,15 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasQueuedEvents();
+    }
+
+    // moves the events of the lock-free queue into postEventList;
+    // postEventList.mutex must be locked
+    void addQueuedEvents()
+    {
+        if (postEventList.hasQueuedEvents() && postEventList.addQueuedEvents())
+            canWait = false;
     }
 
     // This class provides per-thread (by way of being a QThreadData
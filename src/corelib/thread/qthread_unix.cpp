@@ -54,6 +54,9 @@
 #endif
 
 #include <private/qeventdispatcher_unix_p.h>
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+#  include <private/qeventdispatcher_epoll_p.h>
+#endif
 
 #include "qthreadstorage.h"
 
@@ -243,6 +246,12 @@ typedef void*(*QtThreadCallback)(void*);
 QAbstractEventDispatcher *QThreadPrivate::createEventDispatcher(QThreadData *data)
 {
     Q_UNUSED(data);
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    bool epollOk = false;
+    int epollValue = qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL", &epollOk);
+    if (epollOk && epollValue > 0)
+        return new QEventDispatcherEpoll;
+#endif
 #if defined(Q_OS_DARWIN)
     bool ok = false;
     int value = qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_CORE_FOUNDATION", &ok);
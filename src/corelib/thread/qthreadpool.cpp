@@ -60,6 +60,17 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    QWorkStealingDeque localQueue;
+    QThreadPoolThread *nextStealable = nullptr;
+};
+
+static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
+enum {
+    // tasks a thread may take from the per-thread queues before it has to
+    // look at the shared queue again
+    MaxUnlockedRuns = 64
 };
 
 /*
@@ -81,6 +92,7 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -88,27 +100,37 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                int unlockedRuns = 0;
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // Tasks on the per-thread queues are taken without the
+                    // mutex, but not indefinitely: the shared queue must get
+                    // its turn, too.
+                    r = nullptr;
+                    if (++unlockedRuns < MaxUnlockedRuns)
+                        r = manager->takeLocalRunnable(this);
+                } while (r);
                 locker.relock();
             }
 
@@ -117,7 +139,9 @@ void QThreadPoolThread::run()
                 break;
 
             if (manager->queue.isEmpty()) {
-                r = nullptr;
+                r = manager->takeLocalRunnable(this);
+                if (r)
+                    continue;
                 break;
             }
 
@@ -134,9 +158,23 @@ void QThreadPoolThread::run()
         bool expired = manager->tooManyThreadsActive();
         if (!expired) {
             manager->waitingThreads.enqueue(this);
+            ++manager->idleThreads;
+            manager->saturated.store(false, std::memory_order_relaxed);
+
+            // pushToLocalQueue() only locks the mutex if it sees an idle
+            // thread, so look at the per-thread queues once more now that
+            // this thread counts as one.
+            if (QRunnable *stolen = manager->takeLocalRunnable(this)) {
+                manager->waitingThreads.removeOne(this);
+                --manager->idleThreads;
+                runnable = stolen;
+                continue;
+            }
+
             registerThreadInactive();
             // wait for work, exiting after the expiry timeout is reached
             runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
+            --manager->idleThreads;
             ++manager->activeThreads;
             if (manager->waitingThreads.removeOne(this))
                 expired = true;
@@ -146,6 +184,10 @@ void QThreadPoolThread::run()
             }
         }
         if (expired) {
+            // don't leave work behind on this thread's own queue
+            while (QRunnable *left = localQueue.pop())
+                manager->enqueueTask(left);
+            manager->saturated.store(false, std::memory_order_relaxed);
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
             break;
@@ -246,6 +288,92 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
     }
 }
 
+/*!
+    \internal
+
+    With work stealing enabled, puts \a runnable on the calling thread's own
+    queue if that is a thread of this pool. This does not lock the mutex
+    unless a thread needs to be woken or started to share the work.
+*/
+bool QThreadPoolPrivate::pushToLocalQueue(QRunnable *runnable)
+{
+    QThreadPoolThread *thread = currentPoolThread;
+    if (!thread || thread->manager != this || !workStealing.load(std::memory_order_relaxed))
+        return false;
+    if (!thread->localQueue.push(runnable))
+        return false;
+
+    // Pairs with the idle check in QThreadPoolThread::run(): either the
+    // thread going idle sees the new task, or we see it counted as idle.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idleThreads.load(std::memory_order_relaxed) > 0
+            || !saturated.load(std::memory_order_relaxed)) {
+        QMutexLocker locker(&mutex);
+        startThreadForLocalWork();
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns a task for \a thread to run from its own queue or, if that is
+    empty and work stealing is enabled, from another thread's queue.
+*/
+QRunnable *QThreadPoolPrivate::takeLocalRunnable(QThreadPoolThread *thread)
+{
+    if (QRunnable *r = thread->localQueue.pop())
+        return r;
+    if (!workStealing.load(std::memory_order_relaxed))
+        return nullptr;
+    return stealRunnable(thread);
+}
+
+/*!
+    \internal
+
+    Steals a task from the top of any thread's queue but \a thief's own,
+    starting with the thread after \a thief so that thieves spread out.
+*/
+QRunnable *QThreadPoolPrivate::stealRunnable(QThreadPoolThread *thief)
+{
+    const auto stealFrom = [thief](QThreadPoolThread *begin,
+                                   QThreadPoolThread *end) -> QRunnable * {
+        for (QThreadPoolThread *victim = begin; victim != end; victim = victim->nextStealable) {
+            if (victim == thief)
+                continue;
+            if (QRunnable *r = victim->localQueue.steal())
+                return r;
+        }
+        return nullptr;
+    };
+
+    QThreadPoolThread *head = stealableThreads.load(std::memory_order_acquire);
+    QThreadPoolThread *from = (thief && thief->nextStealable) ? thief->nextStealable : head;
+    if (QRunnable *r = stealFrom(from, nullptr))
+        return r;
+    return stealFrom(head, from);
+}
+
+/*!
+    \internal
+
+    Gets another thread to help with the work on the per-thread queues, by
+    moving one task off them and starting it the usual way. Must be called
+    with the mutex locked.
+*/
+void QThreadPoolPrivate::startThreadForLocalWork()
+{
+    if (activeThreadCount() >= maxThreadCount) {
+        saturated.store(true, std::memory_order_relaxed);
+        return;
+    }
+    if (QRunnable *r = stealRunnable(nullptr)) {
+        if (!tryStart(r))
+            enqueueTask(r);
+    }
+}
+
 bool QThreadPoolPrivate::tooManyThreadsActive() const
 {
     const int activeThreadCount = this->activeThreadCount();
@@ -264,6 +392,9 @@ void QThreadPoolPrivate::startThread(QRunnable *runnable)
     allThreads.insert(thread.data());
     ++activeThreads;
 
+    thread->nextStealable = stealableThreads.load(std::memory_order_relaxed);
+    stealableThreads.store(thread.data(), std::memory_order_release);
+
     thread->runnable = runnable;
     thread.take()->start();
 }
@@ -280,6 +411,8 @@ void QThreadPoolPrivate::reset()
     allThreadsCopy.swap(allThreads);
     expiredThreads.clear();
     waitingThreads.clear();
+    // all threads are inactive, so their queues are empty and nobody is stealing
+    stealableThreads.store(nullptr, std::memory_order_relaxed);
     mutex.unlock();
 
     for (QThreadPoolThread *thread: qAsConst(allThreadsCopy)) {
@@ -336,6 +469,18 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+
+    for (QThreadPoolThread *thread = stealableThreads.load(std::memory_order_acquire); thread;
+         thread = thread->nextStealable) {
+        while (!thread->localQueue.isEmpty()) {
+            QRunnable *r = thread->localQueue.steal();
+            if (r && r->autoDelete()) {
+                locker.unlock();
+                delete r;
+                locker.relock();
+            }
+        }
+    }
 }
 
 /*!
@@ -353,6 +498,11 @@ void QThreadPoolPrivate::clear()
     the intended one. For this reason, we recommend calling this function only for
     runnables that are not auto-deleting.
 
+    With \l{workStealingEnabled}{work stealing} enabled, a runnable that was
+    started from a thread of this pool can only be taken by that same thread,
+    and only while it is the most recently started one that has not begun
+    running yet.
+
     \sa start(), QRunnable::autoDelete()
 */
 bool QThreadPool::tryTake(QRunnable *runnable)
@@ -362,6 +512,17 @@ bool QThreadPool::tryTake(QRunnable *runnable)
     if (runnable == nullptr)
         return false;
 
+    // The per-thread queues can only be accessed from the top and, by their
+    // owner, from the bottom. That covers starting a task and then waiting
+    // for it, the common case.
+    if (QThreadPoolThread *thread = currentPoolThread; thread && thread->manager == d) {
+        if (QRunnable *last = thread->localQueue.pop()) {
+            if (last == runnable)
+                return true;
+            thread->localQueue.push(last);
+        }
+    }
+
     QMutexLocker locker(&d->mutex);
     for (QueuePage *page : qAsConst(d->queue)) {
         if (page->tryTake(runnable)) {
@@ -443,6 +604,15 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     implementing time-consuming operations that are not visible to the
     QThreadPool.
 
+    By default, all runnables that cannot be started right away wait in a
+    single queue ordered by priority. With
+    \l{workStealingEnabled}{work stealing} enabled, runnables that a pool
+    thread starts with the default priority go to a queue owned by that
+    thread instead. Each thread runs the runnables from its own queue first,
+    most recent first, and takes the oldest ones from other threads' queues
+    when it runs out of work. This avoids contention on the shared queue when
+    many small tasks are started from within running tasks.
+
     Note that QThreadPool is a low-level class for managing threads, see
     the Qt Concurrent module for higher level alternatives.
 
@@ -500,6 +670,9 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->pushToLocalQueue(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable)) {
@@ -635,6 +808,7 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
         return;
 
     d->maxThreadCount = maxThreadCount;
+    d->saturated.store(false, std::memory_order_relaxed);
     d->tryToStartMoreThreads();
 }
 
@@ -700,6 +874,36 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \since 6.0
+
+    This property holds whether runnables started from the pool's own
+    threads are scheduled on per-thread queues with work stealing.
+
+    When enabled, a runnable that a thread of this pool starts with the
+    default priority of 0 is put on that thread's own queue, without locking
+    the pool. Idle threads take work from the other threads' queues. This
+    scales much better for fine-grained tasks that spawn more tasks, such as
+    nested QtConcurrent::run() calls. Runnables started from other threads,
+    and runnables with a non-default priority, always go through the shared
+    queue, where priorities are respected.
+
+    The default is \c false.
+
+    \sa start(), tryTake()
+*/
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.load(std::memory_order_relaxed);
+}
+
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.store(enabled, std::memory_order_relaxed);
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -717,6 +921,7 @@ void QThreadPool::releaseThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
+    d->saturated.store(false, std::memory_order_relaxed);
     d->tryToStartMoreThreads();
 }
 
@@ -59,6 +59,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <atomic>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -146,6 +148,86 @@ private:
     QRunnable *m_entries[MaxPageSize];
 };
 
+/*
+    A fixed-size work-stealing deque (Chase & Lev, in the C11 formulation by
+    Le et al.). Only the owning thread may push() and pop() at the bottom;
+    any thread may steal() from the top. push() fails when the deque is full,
+    in which case the caller falls back to the shared queue, so no memory
+    ever has to be reclaimed while other threads might be reading it.
+*/
+class QWorkStealingDeque
+{
+public:
+    enum {
+        Capacity = 1024     // must be a power of two
+    };
+
+    QWorkStealingDeque()
+    {
+        for (auto &entry : m_entries)
+            entry.store(nullptr, std::memory_order_relaxed);
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+    }
+
+    bool push(QRunnable *runnable) noexcept
+    {
+        const qint64 b = m_bottom.load(std::memory_order_relaxed);
+        const qint64 t = m_top.load(std::memory_order_acquire);
+        if (b - t >= Capacity)
+            return false;
+        m_entries[b & (Capacity - 1)].store(runnable, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    QRunnable *pop() noexcept
+    {
+        const qint64 b = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        qint64 t = m_top.load(std::memory_order_relaxed);
+        if (t > b) {
+            // empty
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        QRunnable *runnable = m_entries[b & (Capacity - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // last entry: race against thieves for it
+            if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed))
+                runnable = nullptr;
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return runnable;
+    }
+
+    // may return nullptr if another thread won the race for the top entry
+    QRunnable *steal() noexcept
+    {
+        qint64 t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const qint64 b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+        QRunnable *runnable = m_entries[t & (Capacity - 1)].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed))
+            return nullptr;
+        return runnable;
+    }
+
+private:
+    std::atomic<qint64> m_top { 0 };
+    std::atomic<qint64> m_bottom { 0 };
+    std::atomic<QRunnable *> m_entries[Capacity];
+};
+
 class QThreadPoolThread;
 class Q_CORE_EXPORT QThreadPoolPrivate : public QObjectPrivate
 {
@@ -170,6 +252,11 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    bool pushToLocalQueue(QRunnable *runnable);
+    QRunnable *takeLocalRunnable(QThreadPoolThread *thread);
+    QRunnable *stealRunnable(QThreadPoolThread *thief);
+    void startThreadForLocalWork();
+
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
@@ -182,6 +269,13 @@ public:
     int reservedThreads = 0;
     int activeThreads = 0;
     uint stackSize = 0;
+
+    // Work stealing: the per-thread deques are reached through a list that
+    // is only ever prepended to (under the mutex) and read without it.
+    std::atomic<bool> workStealing { false };
+    std::atomic<QThreadPoolThread *> stealableThreads { nullptr };
+    std::atomic<int> idleThreads { 0 };         // threads in waitingThreads
+    std::atomic<bool> saturated { false };      // hint: no thread could be started or woken
 };
 
 QT_END_NAMESPACE
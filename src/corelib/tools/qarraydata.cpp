@@ -46,10 +46,29 @@
 #include <QtCore/qbytearray.h>  // QBA::value_type
 #include <QtCore/qstring.h>  // QString::value_type
 
+#include <new>
 #include <stdlib.h>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+// Layout of the block in front of data allocated with ExternalStorage
+struct QExternalArrayData
+{
+    QArrayData::CleanupFunction cleanup;
+    void *cleanupInfo;
+    QArrayData header;
+
+    static QExternalArrayData *fromHeader(QArrayData *header)
+    {
+        return reinterpret_cast<QExternalArrayData *>(
+                reinterpret_cast<char *>(header) - offsetof(QExternalArrayData, header));
+    }
+};
+static_assert(sizeof(QExternalArrayData) == QArrayData::ExternalHeaderSize);
+static_assert(offsetof(QExternalArrayData, header) + sizeof(QArrayData) == sizeof(QExternalArrayData));
+} // unnamed namespace
+
 /*
  * This pair of functions is declared in qtools_p.h and is used by the Qt
  * containers to allocate memory and grow the memory block during append
@@ -233,6 +252,23 @@ QArrayData::reallocateUnaligned(QArrayData *data, void *dataPointer,
 {
     Q_ASSERT(!data || !data->isShared());
 
+    if (data && (data->flags & ExternalStorage)) {
+        // Can't realloc() memory we don't own: move into a block of our own,
+        // keeping the same offset from the start of the data
+        const auto dataStart = QTypedArrayData<char>::dataStart(data, alignof(QArrayData));
+        const qsizetype offset = static_cast<char *>(dataPointer) - dataStart;
+        const qsizetype available = data->alloc * objectSize - offset;
+
+        QArrayData *header;
+        void *newData = allocate(&header, objectSize, alignof(QArrayData), capacity, options);
+        if (!header)
+            return qMakePair(data, dataPointer);
+        newData = static_cast<char *>(newData) + offset;
+        ::memcpy(newData, dataPointer, size_t(qMin(capacity * objectSize - offset, available)));
+        deallocate(data, objectSize, alignof(QArrayData));
+        return qMakePair(header, newData);
+    }
+
     qsizetype headerSize = sizeof(QArrayData);
     qsizetype allocSize = calculateBlockSize(capacity, objectSize, headerSize, options);
     qptrdiff offset = dataPointer ? reinterpret_cast<char *>(dataPointer) - reinterpret_cast<char *>(data) : headerSize;
@@ -259,7 +295,42 @@ void QArrayData::deallocate(QArrayData *data, qsizetype objectSize,
     Q_UNUSED(objectSize);
     Q_UNUSED(alignment);
 
+    if (data && (data->flags & ExternalStorage)) {
+        QExternalArrayData *external = QExternalArrayData::fromHeader(data);
+        external->cleanup(external->cleanupInfo);
+        return;
+    }
+
     ::free(data);
 }
 
+/*!
+    \internal
+
+    Initializes the header for a block of \a capacity objects whose memory is
+    not owned by malloc(). \a block must point to ExternalHeaderSize bytes,
+    aligned like a pointer, that immediately precede the first object. The
+    objects' alignment must not exceed that of QArrayData.
+
+    The returned header has a reference count of one. When the last reference
+    is dropped, \a cleanup is called with \a cleanupInfo instead of free();
+    it is responsible for releasing both the header block and the data. Any
+    reallocation moves the contents into a regular malloc()ed block first.
+*/
+QArrayData *QArrayData::initializeExternalHeader(void *block, qsizetype capacity,
+                                                 CleanupFunction cleanup, void *cleanupInfo) noexcept
+{
+    Q_ASSERT(block);
+    Q_ASSERT(cleanup);
+    Q_ASSERT(quintptr(block) % alignof(QExternalArrayData) == 0);
+
+    QExternalArrayData *external = new (block) QExternalArrayData;
+    external->cleanup = cleanup;
+    external->cleanupInfo = cleanupInfo;
+    external->header.ref_.storeRelaxed(1);
+    external->header.flags = ExternalStorage;
+    external->header.alloc = capacity;
+    return &external->header;
+}
+
 QT_END_NAMESPACE
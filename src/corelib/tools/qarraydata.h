@@ -56,7 +56,8 @@ struct Q_CORE_EXPORT QArrayData
         DefaultAllocationFlags = 0,
         CapacityReserved     = 0x1,  //!< the capacity was reserved by the user, try to keep it
         GrowsForward         = 0x2,  //!< allocate with eyes towards growing through append()
-        GrowsBackwards       = 0x4   //!< allocate with eyes towards growing through prepend()
+        GrowsBackwards       = 0x4,  //!< allocate with eyes towards growing through prepend()
+        ExternalStorage      = 0x8   //!< header and data are released by a cleanup function, not free()
     };
     Q_DECLARE_FLAGS(ArrayOptions, ArrayOption)
 
@@ -125,6 +126,12 @@ struct Q_CORE_EXPORT QArrayData
             qsizetype objectSize, qsizetype newCapacity, ArrayOptions newOptions = DefaultAllocationFlags) noexcept;
     static void deallocate(QArrayData *data, qsizetype objectSize,
             qsizetype alignment) noexcept;
+
+    typedef void (*CleanupFunction)(void *);
+    // Size of the block that must immediately precede externally owned data
+    static constexpr qsizetype ExternalHeaderSize = 2 * sizeof(void *) + 2 * sizeof(qsizetype);
+    static QArrayData *initializeExternalHeader(void *block, qsizetype capacity,
+            CleanupFunction cleanup, void *cleanupInfo) noexcept;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QArrayData::ArrayOptions)
@@ -0,0 +1,554 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATHASH_P_H
+#define QFLATHASH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of a number of Qt sources files.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qhash.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*
+  QFlatHash is an open addressing hash table in the style of Abseil's "Swiss
+  tables". It is meant for large tables where lookups are dominated by cache
+  misses.
+
+  Next to the array of nodes there is an array of control bytes, one per slot.
+  A control byte either marks the slot as empty or deleted, or holds seven bits
+  of the key's hash. The nodes are probed in groups of 16: one SSE2 compare of
+  the group's control bytes yields the nodes whose hash bits match, and only
+  those nodes are touched. A lookup ends at the first group that has an empty
+  slot, so unsuccessful lookups usually don't touch any node at all.
+
+  Unlike QHash, QFlatHash is not implicitly shared, and inserting or removing
+  elements invalidates all iterators. Lookups can be done with the same
+  heterogeneous key types as QHash, e.g. QStringView for a QString key.
+*/
+
+namespace QFlatHashPrivate {
+
+enum Control : signed char {
+    Empty = -128,   // 0b10000000
+    Deleted = -2    // 0b11111110
+    // full nodes store the lower seven bits of the hash: 0b0hhhhhhh
+};
+
+constexpr size_t GroupSize = 16;
+
+// The set bits of a mask say which nodes of a group matched
+struct GroupMask
+{
+    uint mask;
+
+    explicit operator bool() const noexcept { return mask != 0; }
+    uint lowest() const noexcept { return qCountTrailingZeroBits(mask); }
+    void removeLowest() noexcept { mask &= mask - 1; }
+};
+
+struct Group
+{
+#ifdef __SSE2__
+    __m128i ctrl;
+
+    explicit Group(const signed char *p) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)))
+    {
+    }
+    GroupMask match(signed char h2) const noexcept
+    {
+        return GroupMask{ uint(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))) };
+    }
+    GroupMask matchEmpty() const noexcept
+    {
+        return match(Empty);
+    }
+    GroupMask matchEmptyOrDeleted() const noexcept
+    {
+        // only full nodes have the sign bit cleared
+        return GroupMask{ uint(_mm_movemask_epi8(ctrl)) };
+    }
+#else
+    const signed char *ctrl;
+
+    explicit Group(const signed char *p) noexcept
+        : ctrl(p)
+    {
+    }
+    GroupMask match(signed char h2) const noexcept
+    {
+        uint mask = 0;
+        for (size_t i = 0; i < GroupSize; ++i)
+            mask |= uint(ctrl[i] == h2) << i;
+        return GroupMask{ mask };
+    }
+    GroupMask matchEmpty() const noexcept
+    {
+        return match(Empty);
+    }
+    GroupMask matchEmptyOrDeleted() const noexcept
+    {
+        uint mask = 0;
+        for (size_t i = 0; i < GroupSize; ++i)
+            mask |= uint(ctrl[i] < 0) << i;
+        return GroupMask{ mask };
+    }
+#endif
+};
+
+template <typename Key, typename K>
+using if_searchable = std::enable_if_t<std::is_same_v<Key, K>
+                                       || QHashPrivate::HeterogeneousSearch<Key, K>::value, bool>;
+
+} // namespace QFlatHashPrivate
+
+template <class Key, class T>
+class QFlatHash
+{
+    struct Node
+    {
+        Key key;
+        T value;
+    };
+
+    template <bool Const>
+    class base_iterator
+    {
+        friend class QFlatHash;
+        template <bool> friend class base_iterator;
+        using HashPtr = std::conditional_t<Const, const QFlatHash *, QFlatHash *>;
+
+        HashPtr h = nullptr;
+        size_t slot = 0;
+
+        base_iterator(HashPtr hash, size_t s) noexcept : h(hash), slot(s) {}
+        void skipUnused() noexcept
+        {
+            while (slot < h->capacity_ && h->ctrl[slot] < 0)
+                ++slot;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+        base_iterator() noexcept = default;
+        template <bool C = Const, std::enable_if_t<C, bool> = true>
+        base_iterator(const base_iterator<false> &other) noexcept : h(other.h), slot(other.slot) {}
+
+        const Key &key() const noexcept { return h->nodes[slot].key; }
+        reference value() const noexcept { return h->nodes[slot].value; }
+        reference operator*() const noexcept { return value(); }
+        pointer operator->() const noexcept { return &value(); }
+
+        base_iterator &operator++() noexcept
+        {
+            ++slot;
+            skipUnused();
+            return *this;
+        }
+        base_iterator operator++(int) noexcept
+        {
+            base_iterator r = *this;
+            ++*this;
+            return r;
+        }
+
+        friend bool operator==(const base_iterator &lhs, const base_iterator &rhs) noexcept
+        { return lhs.slot == rhs.slot; }
+        friend bool operator!=(const base_iterator &lhs, const base_iterator &rhs) noexcept
+        { return lhs.slot != rhs.slot; }
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+    using iterator = base_iterator<false>;
+    using const_iterator = base_iterator<true>;
+
+    QFlatHash() noexcept = default;
+    QFlatHash(std::initializer_list<std::pair<Key, T>> list)
+    {
+        reserve(qsizetype(list.size()));
+        for (const auto &p : list)
+            insert(p.first, p.second);
+    }
+    QFlatHash(const QFlatHash &other)
+        : seed(other.seed)
+    {
+        if (!other.size_)
+            return;
+        allocate(other.capacity_);
+        growthLeft = other.growthLeft;
+        std::copy(other.ctrl, other.ctrl + capacity_, ctrl);
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl[i] >= 0) {
+                new (nodes + i) Node(other.nodes[i]);
+                ++size_;
+            }
+        }
+    }
+    QFlatHash(QFlatHash &&other) noexcept
+        : ctrl(std::exchange(other.ctrl, nullptr)),
+          nodes(std::exchange(other.nodes, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)),
+          size_(std::exchange(other.size_, 0)),
+          growthLeft(std::exchange(other.growthLeft, 0)),
+          seed(other.seed)
+    {
+    }
+    QFlatHash &operator=(const QFlatHash &other)
+    {
+        if (this != &other) {
+            QFlatHash copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    QFlatHash &operator=(QFlatHash &&other) noexcept
+    {
+        QFlatHash moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    ~QFlatHash()
+    {
+        destroy();
+    }
+
+    void swap(QFlatHash &other) noexcept
+    {
+        qSwap(ctrl, other.ctrl);
+        qSwap(nodes, other.nodes);
+        qSwap(capacity_, other.capacity_);
+        qSwap(size_, other.size_);
+        qSwap(growthLeft, other.growthLeft);
+        qSwap(seed, other.seed);
+    }
+
+    qsizetype size() const noexcept { return qsizetype(size_); }
+    qsizetype count() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return size_ == 0; }
+    bool empty() const noexcept { return isEmpty(); }
+    qsizetype capacity() const noexcept { return qsizetype(maxLoad(capacity_)); }
+
+    void clear()
+    {
+        destroy();
+        ctrl = nullptr;
+        nodes = nullptr;
+        capacity_ = size_ = growthLeft = 0;
+    }
+
+    void reserve(qsizetype n)
+    {
+        if (size_t(n) > maxLoad(capacity_))
+            rehash(capacityFor(size_t(n)));
+    }
+
+    iterator begin() noexcept { iterator it(this, 0); it.skipUnused(); return it; }
+    const_iterator begin() const noexcept { const_iterator it(this, 0); it.skipUnused(); return it; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator constBegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(this, capacity_); }
+    const_iterator end() const noexcept { return const_iterator(this, capacity_); }
+    const_iterator cend() const noexcept { return end(); }
+    const_iterator constEnd() const noexcept { return end(); }
+
+    template <typename K, QFlatHashPrivate::if_searchable<Key, K> = true>
+    iterator find(const K &key) noexcept
+    {
+        const size_t s = findSlot(key);
+        return s == NoSlot ? end() : iterator(this, s);
+    }
+    template <typename K, QFlatHashPrivate::if_searchable<Key, K> = true>
+    const_iterator find(const K &key) const noexcept
+    {
+        return constFind(key);
+    }
+    template <typename K, QFlatHashPrivate::if_searchable<Key, K> = true>
+    const_iterator constFind(const K &key) const noexcept
+    {
+        const size_t s = findSlot(key);
+        return s == NoSlot ? end() : const_iterator(this, s);
+    }
+    template <typename K, QFlatHashPrivate::if_searchable<Key, K> = true>
+    bool contains(const K &key) const noexcept
+    {
+        return findSlot(key) != NoSlot;
+    }
+    template <typename K, QFlatHashPrivate::if_searchable<Key, K> = true>
+    T value(const K &key, const T &defaultValue = T()) const
+    {
+        const size_t s = findSlot(key);
+        return s == NoSlot ? defaultValue : nodes[s].value;
+    }
+
+    template <typename ...Args>
+    iterator emplace(const Key &key, Args &&...args)
+    {
+        return emplace(Key(key), std::forward<Args>(args)...);
+    }
+    template <typename ...Args>
+    iterator emplace(Key &&key, Args &&...args)
+    {
+        const auto r = findOrPrepareInsert(key);
+        if (r.found) {
+            nodes[r.slot].value = T(std::forward<Args>(args)...);
+        } else {
+            new (nodes + r.slot) Node{ std::move(key), T(std::forward<Args>(args)...) };
+            ++size_;
+        }
+        return iterator(this, r.slot);
+    }
+    iterator insert(const Key &key, const T &value)
+    {
+        return emplace(key, value);
+    }
+    T &operator[](const Key &key)
+    {
+        const auto r = findOrPrepareInsert(key);
+        if (!r.found) {
+            new (nodes + r.slot) Node{ key, T() };
+            ++size_;
+        }
+        return nodes[r.slot].value;
+    }
+
+    template <typename K, QFlatHashPrivate::if_searchable<Key, K> = true>
+    bool remove(const K &key)
+    {
+        const size_t s = findSlot(key);
+        if (s == NoSlot)
+            return false;
+        eraseSlot(s);
+        return true;
+    }
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it.h == this && it.slot < capacity_ && ctrl[it.slot] >= 0);
+        eraseSlot(it.slot);
+        iterator next(this, it.slot);
+        next.skipUnused();
+        return next;
+    }
+
+private:
+    static constexpr size_t NoSlot = ~size_t(0);
+
+    struct InsertPosition
+    {
+        size_t slot;
+        bool found;
+    };
+
+    // keep at least 1/8 of the nodes empty so that probing terminates quickly
+    static constexpr size_t maxLoad(size_t capacity) noexcept { return capacity - capacity / 8; }
+    static size_t capacityFor(size_t n) noexcept
+    {
+        size_t capacity = QFlatHashPrivate::GroupSize;
+        while (maxLoad(capacity) < n)
+            capacity *= 2;
+        return capacity;
+    }
+
+    static signed char h2(size_t hash) noexcept { return static_cast<signed char>(hash & 0x7f); }
+    size_t firstGroup(size_t hash) const noexcept
+    {
+        return (hash >> 7) & (capacity_ / QFlatHashPrivate::GroupSize - 1);
+    }
+    size_t nextGroup(size_t group, size_t &step) const noexcept
+    {
+        // triangular probing visits every group once when their number is a power of two
+        return (group + ++step) & (capacity_ / QFlatHashPrivate::GroupSize - 1);
+    }
+
+    template <typename K>
+    size_t findSlot(const K &key) const noexcept
+    {
+        if (!size_)
+            return NoSlot;
+        return findSlot(key, qHash(key, seed));
+    }
+    template <typename K>
+    size_t findSlot(const K &key, size_t hash) const noexcept
+    {
+        size_t group = firstGroup(hash);
+        size_t step = 0;
+        while (true) {
+            const signed char *groupCtrl = ctrl + group * QFlatHashPrivate::GroupSize;
+            const QFlatHashPrivate::Group g(groupCtrl);
+            for (auto m = g.match(h2(hash)); m; m.removeLowest()) {
+                const size_t s = group * QFlatHashPrivate::GroupSize + m.lowest();
+                if (nodes[s].key == key)
+                    return s;
+            }
+            if (g.matchEmpty())
+                return NoSlot;
+            group = nextGroup(group, step);
+        }
+    }
+
+    size_t findInsertSlot(size_t hash) const noexcept
+    {
+        size_t group = firstGroup(hash);
+        size_t step = 0;
+        while (true) {
+            const QFlatHashPrivate::Group g(ctrl + group * QFlatHashPrivate::GroupSize);
+            if (auto m = g.matchEmptyOrDeleted())
+                return group * QFlatHashPrivate::GroupSize + m.lowest();
+            group = nextGroup(group, step);
+        }
+    }
+
+    InsertPosition findOrPrepareInsert(const Key &key)
+    {
+        const size_t hash = qHash(key, seed);
+        if (size_) {
+            const size_t s = findSlot(key, hash);
+            if (s != NoSlot)
+                return { s, true };
+        }
+        if (!growthLeft) {
+            // grow, unless there are enough deleted nodes to reclaim
+            rehash(size_ + 1 > maxLoad(capacity_) / 2 ? capacityFor(2 * (size_ + 1))
+                                                      : capacity_);
+        }
+        const size_t slot = findInsertSlot(hash);
+        if (ctrl[slot] == QFlatHashPrivate::Empty)
+            --growthLeft;
+        ctrl[slot] = h2(hash);
+        return { slot, false };
+    }
+
+    void eraseSlot(size_t s)
+    {
+        nodes[s].~Node();
+        --size_;
+        // A lookup only stops at a group with an empty slot. If this group
+        // has one already, it can get another; otherwise lookups for keys
+        // further down the probe sequence still need to pass it.
+        const size_t group = s / QFlatHashPrivate::GroupSize;
+        if (QFlatHashPrivate::Group(ctrl + group * QFlatHashPrivate::GroupSize).matchEmpty()) {
+            ctrl[s] = QFlatHashPrivate::Empty;
+            ++growthLeft;
+        } else {
+            ctrl[s] = QFlatHashPrivate::Deleted;
+        }
+    }
+
+    void allocate(size_t capacity)
+    {
+        ctrl = new signed char[capacity];
+        std::fill(ctrl, ctrl + capacity, static_cast<signed char>(QFlatHashPrivate::Empty));
+        nodes = std::allocator<Node>().allocate(capacity);
+        capacity_ = capacity;
+        growthLeft = maxLoad(capacity);
+    }
+
+    void destroy() noexcept
+    {
+        if (!ctrl)
+            return;
+        if constexpr (!std::is_trivially_destructible_v<Node>) {
+            for (size_t i = 0; i < capacity_; ++i) {
+                if (ctrl[i] >= 0)
+                    nodes[i].~Node();
+            }
+        }
+        std::allocator<Node>().deallocate(nodes, capacity_);
+        delete [] ctrl;
+    }
+
+    void rehash(size_t newCapacity)
+    {
+        signed char *oldCtrl = ctrl;
+        Node *oldSlots = nodes;
+        const size_t oldCapacity = capacity_;
+        allocate(newCapacity);
+        if (!oldCtrl)
+            return;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] < 0)
+                continue;
+            const size_t hash = qHash(oldSlots[i].key, seed);
+            const size_t slot = findInsertSlot(hash);
+            ctrl[slot] = h2(hash);
+            new (nodes + slot) Node(std::move(oldSlots[i]));
+            oldSlots[i].~Node();
+        }
+        growthLeft -= size_;
+        std::allocator<Node>().deallocate(oldSlots, oldCapacity);
+        delete [] oldCtrl;
+    }
+
+    signed char *ctrl = nullptr;
+    Node *nodes = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    size_t growthLeft = 0;
+    size_t seed = qGlobalQHashSeed();
+};
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_P_H
@@ -1817,6 +1817,23 @@ size_t qHash(long double key, size_t seed) noexcept
     \sa find()
 */
 
+/*! \fn template <class Key, class T> template <typename K> bool QHash<Key, T>::contains(const K &key) const
+    \fn template <class Key, class T> template <typename K> qsizetype QHash<Key, T>::count(const K &key) const
+    \fn template <class Key, class T> template <typename K> T QHash<Key, T>::value(const K &key, const T &defaultValue) const
+    \fn template <class Key, class T> template <typename K> QHash<Key, T>::iterator QHash<Key, T>::find(const K &key)
+    \fn template <class Key, class T> template <typename K> QHash<Key, T>::const_iterator QHash<Key, T>::find(const K &key) const
+    \fn template <class Key, class T> template <typename K> QHash<Key, T>::const_iterator QHash<Key, T>::constFind(const K &key) const
+    \since 6.0
+    \overload
+
+    These overloads look up \a key without converting it to the hash's key
+    type first. They are available when \c Key is QString and \c K is
+    QStringView, and when \c Key is QByteArray and \c K is QByteArrayView.
+    Looking up a part of a larger string this way does not allocate memory:
+
+    \snippet code/src_corelib_tools_qhash.cpp 33
+*/
+
 /*! \fn template <class Key, class T> QHash<Key, T>::iterator QHash<Key, T>::insert(const Key &key, const T &value)
 
     Inserts a new item with the \a key and a value of \a value.
@@ -58,6 +58,18 @@ struct QHashDummyValue
 
 namespace QHashPrivate {
 
+// Lookups in a hash with keys of type Key may also be done with a K when the
+// two hash and compare the same way, and K is cheaper to create (no allocation)
+template <typename Key, typename K>
+struct HeterogeneousSearch : std::false_type {};
+template <>
+struct HeterogeneousSearch<QString, QStringView> : std::true_type {};
+template <>
+struct HeterogeneousSearch<QByteArray, QByteArrayView> : std::true_type {};
+
+template <typename Key, typename K>
+using if_heterogeneously_searchable = std::enable_if_t<HeterogeneousSearch<Key, K>::value, bool>;
+
 // QHash uses a power of two growth policy.
 namespace GrowthPolicy
 {
@@ -548,7 +560,8 @@ struct Data
         return size >= (numBuckets >> 1);
     }
 
-    iterator find(const Key &key) const noexcept
+    template <typename K>
+    iterator find(const K &key) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
         size_t hash = qHash(key, seed);
@@ -573,7 +586,8 @@ struct Data
         }
     }
 
-    Node *findNode(const Key &key) const noexcept
+    template <typename K>
+    Node *findNode(const K &key) const noexcept
     {
         if (!size)
             return nullptr;
@@ -855,6 +869,18 @@ public:
     {
         return contains(key) ? 1 : 0;
     }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    bool contains(const K &key) const noexcept
+    {
+        if (!d)
+            return false;
+        return d->findNode(key) != nullptr;
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    qsizetype count(const K &key) const noexcept
+    {
+        return contains(key) ? 1 : 0;
+    }
 
     Key key(const T &value, const Key &defaultKey = Key()) const noexcept
     {
@@ -878,6 +904,16 @@ public:
         }
         return defaultValue;
     }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    T value(const K &key, const T &defaultValue = T()) const noexcept
+    {
+        if (d) {
+            Node *n = d->findNode(key);
+            if (n)
+                return n->value;
+        }
+        return defaultValue;
+    }
     T &operator[](const Key &key)
     {
         detach();
@@ -1091,6 +1127,32 @@ public:
     {
         return find(key);
     }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    iterator find(const K &key)
+    {
+        if (isEmpty()) // prevents detaching shared null
+            return end();
+        detach();
+        auto it = d->find(key);
+        if (it.isUnused())
+            it = d->end();
+        return iterator(it);
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    const_iterator find(const K &key) const noexcept
+    {
+        if (isEmpty())
+            return end();
+        auto it = d->find(key);
+        if (it.isUnused())
+            it = d->end();
+        return const_iterator(it);
+    }
+    template <typename K, QHashPrivate::if_heterogeneously_searchable<Key, K> = true>
+    const_iterator constFind(const K &key) const noexcept
+    {
+        return find(key);
+    }
     iterator insert(const Key &key, const T &value)
     {
         return emplace(key, value);
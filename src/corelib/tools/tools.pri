@@ -13,6 +13,7 @@ HEADERS +=  \
         tools/qcontainertools_impl.h \
         tools/qcryptographichash.h \
         tools/qduplicatetracker_p.h \
+        tools/qflathash_p.h \
         tools/qflatmap_p.h \
         tools/qfreelist_p.h \
         tools/qhash.h \
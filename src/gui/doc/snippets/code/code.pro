@@ -29,6 +29,7 @@ SOURCES = \
     src_gui_painting_qcolor.cpp \
     src_gui_painting_qpainter.cpp \
     src_gui_painting_qpainterpath.cpp \
+    src_gui_painting_qparallelimagerenderer.cpp \
     src_gui_painting_qpen.cpp \
     src_gui_painting_qregion.cpp \
     src_gui_painting_qregion_unix.cpp \
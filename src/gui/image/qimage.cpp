@@ -4434,10 +4434,14 @@ QImage QImage::smoothScaled(int w, int h) const {
     case QImage::Format_RGBX8888:
 #endif
     case QImage::Format_RGBA8888_Premultiplied:
+    case QImage::Format_Grayscale8:
+    case QImage::Format_Grayscale16:
 #if QT_CONFIG(raster_64bit)
     case QImage::Format_RGBX64:
     case QImage::Format_RGBA64_Premultiplied:
+#endif
         break;
+#if QT_CONFIG(raster_64bit)
     case QImage::Format_RGBA64:
         src = src.convertToFormat(QImage::Format_RGBA64_Premultiplied);
         break;
@@ -4454,6 +4458,44 @@ QImage QImage::smoothScaled(int w, int h) const {
     return src;
 }
 
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+#define QT_USE_THREAD_PARALLEL_IMAGE_TRANSFORMS
+#endif
+
+// Splits [0, count) into segments the same way the image conversions do, and
+// processes them on the global thread pool when the image is large enough.
+template <typename Segment>
+static void processSegmented(qsizetype nbytes, int count, Segment segment)
+{
+#ifdef QT_USE_THREAD_PARALLEL_IMAGE_TRANSFORMS
+    int segments = nbytes / (1<<16);
+    segments = std::min(segments, count);
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    if (segments > 1 && !threadPool->contains(QThread::currentThread())) {
+        QSemaphore semaphore;
+        int y = 0;
+        for (int i = 0; i < segments; ++i) {
+            int yn = (count - y) / (segments - i);
+            threadPool->start([&, y, yn]() {
+                segment(y, y + yn);
+                semaphore.release(1);
+            });
+            y += yn;
+        }
+        semaphore.acquire(segments);
+    } else
+#endif
+        segment(0, count);
+}
+
+// The 90 and 270 degree rotations are segmented by strips of source columns,
+// so that each segment writes whole rows of the destination.
+static const int RotationStripWidth = 32;
+
+// Each band of a painted transformation sets up its own painter and
+// rasterizes the outline of the whole image, so the bands are kept high.
+static const int TransformBandHeight = 64;
+
 static QImage rotated90(const QImage &image)
 {
     QImage out(image.height(), image.width(), image.format());
@@ -4464,7 +4506,17 @@ static QImage rotated90(const QImage &image)
     int h = image.height();
     const MemRotateFunc memrotate = qMemRotateFunctions[qPixelLayouts[image.format()].bpp][2];
     if (memrotate) {
-        memrotate(image.constBits(), w, h, image.bytesPerLine(), out.bits(), out.bytesPerLine());
+        const int bytesPerPixel = image.depth() / 8;
+        const uchar *src = image.constBits();
+        uchar *dest = out.bits();
+        const int sbpl = image.bytesPerLine();
+        const int dbpl = out.bytesPerLine();
+        processSegmented(image.sizeInBytes(), (w + RotationStripWidth - 1) / RotationStripWidth,
+                         [&](int start, int end) {
+            const int x = start * RotationStripWidth;
+            const int xn = std::min(end * RotationStripWidth, w);
+            memrotate(src + x * bytesPerPixel, xn - x, h, sbpl, dest + x * dbpl, dbpl);
+        });
     } else {
         for (int y=0; y<h; ++y) {
             if (image.colorCount())
@@ -4490,7 +4542,13 @@ static QImage rotated180(const QImage &image)
         out.setColorTable(image.colorTable());
     int w = image.width();
     int h = image.height();
-    memrotate(image.constBits(), w, h, image.bytesPerLine(), out.bits(), out.bytesPerLine());
+    const uchar *src = image.constBits();
+    uchar *dest = out.bits();
+    const int sbpl = image.bytesPerLine();
+    const int dbpl = out.bytesPerLine();
+    processSegmented(image.sizeInBytes(), h, [&](int y, int yn) {
+        memrotate(src + y * sbpl, w, yn - y, sbpl, dest + (h - yn) * dbpl, dbpl);
+    });
     return out;
 }
 
@@ -4504,7 +4562,17 @@ static QImage rotated270(const QImage &image)
     int h = image.height();
     const MemRotateFunc memrotate = qMemRotateFunctions[qPixelLayouts[image.format()].bpp][0];
     if (memrotate) {
-        memrotate(image.constBits(), w, h, image.bytesPerLine(), out.bits(), out.bytesPerLine());
+        const int bytesPerPixel = image.depth() / 8;
+        const uchar *src = image.constBits();
+        uchar *dest = out.bits();
+        const int sbpl = image.bytesPerLine();
+        const int dbpl = out.bytesPerLine();
+        processSegmented(image.sizeInBytes(), (w + RotationStripWidth - 1) / RotationStripWidth,
+                         [&](int start, int end) {
+            const int x = start * RotationStripWidth;
+            const int xn = std::min(end * RotationStripWidth, w);
+            memrotate(src + x * bytesPerPixel, xn - x, h, sbpl, dest + (w - xn) * dbpl, dbpl);
+        });
     } else {
         for (int y=0; y<h; ++y) {
             if (image.colorCount())
@@ -4607,6 +4675,8 @@ QImage QImage::transformed(const QTransform &matrix, Qt::TransformationMode mode
         case QImage::Format_RGBX8888:
 #endif
         case QImage::Format_RGBA8888_Premultiplied:
+        case QImage::Format_Grayscale8:
+        case QImage::Format_Grayscale16:
 #if QT_CONFIG(raster_64bit)
         case QImage::Format_RGBX64:
         case QImage::Format_RGBA64_Premultiplied:
@@ -4678,13 +4748,36 @@ QImage QImage::transformed(const QTransform &matrix, Qt::TransformationMode mode
         Q_ASSERT(sImage.devicePixelRatio() == 1);
         Q_ASSERT(sImage.devicePixelRatio() == dImage.devicePixelRatio());
 
-        QPainter p(&dImage);
-        if (mode == Qt::SmoothTransformation) {
-            p.setRenderHint(QPainter::Antialiasing);
-            p.setRenderHint(QPainter::SmoothPixmapTransform);
-        }
-        p.setTransform(mat);
-        p.drawImage(QPoint(0, 0), sImage);
+        const auto paint = [&](QImage *device) {
+            QPainter p(device);
+            if (mode == Qt::SmoothTransformation) {
+                p.setRenderHint(QPainter::Antialiasing);
+                p.setRenderHint(QPainter::SmoothPixmapTransform);
+            }
+            p.setTransform(mat);
+            p.drawImage(QPoint(0, 0), sImage);
+        };
+
+        // Bands are painted in parallel on their own devices sharing the
+        // pixels of dImage. Like in QParallelImageRenderer, each of them is
+        // clipped to its band but rasterized as for the whole image, so the
+        // result is the same as when painting on a single thread.
+        uchar *dBits = dImage.bits();
+        const int bands = std::max(hd / TransformBandHeight, 1);
+        processSegmented(dImage.sizeInBytes(), bands, [&](int start, int end) {
+            if (start == 0 && end == bands) {
+                paint(&dImage);
+                return;
+            }
+            const int y = start * TransformBandHeight;
+            const int yn = end == bands ? hd : end * TransformBandHeight;
+            QImage device(dBits, wd, hd, dImage.bytesPerLine(), target_format);
+            QPaintEngine *engine = device.paintEngine();
+            if (engine->type() == QPaintEngine::Raster)
+                static_cast<QRasterPaintEnginePrivate *>(QPaintEnginePrivate::get(engine))->deviceRectIgnoresSystemClip = true;
+            engine->setSystemClip(QRegion(0, y, wd, yn - y));
+            paint(&device);
+        });
     } else {
         bool invertible;
         mat = mat.inverted(&invertible);                // invert matrix
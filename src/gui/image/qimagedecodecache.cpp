@@ -0,0 +1,285 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qimagedecodecache_p.h"
+
+#include <qdatetime.h>
+#include <qfileinfo.h>
+#include <qimagereader.h>
+#if QT_CONFIG(future)
+#include <qfutureinterface.h>
+#include <qthreadpool.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QImageDecodeCache
+    \inmodule QtGui
+    \internal
+
+    \brief The QImageDecodeCache class holds decoded image files for all of
+    Qt GUI.
+
+    Images loaded through it are decoded once per file, and consumers such
+    as QPixmap::load() and the icon loader share the decoded image data
+    through QImage's implicit sharing. Entries are keyed by the absolute file
+    name, modification time, file size and format, so a changed file is
+    decoded again. The least recently used entries are evicted when the
+    total size of the cached images exceeds maxCost() bytes.
+
+    The cache is thread-safe. imageAsync() decodes on the global thread pool,
+    and concurrent requests for the same file share a single decode.
+*/
+
+// The same default as QPixmapCache
+static const qsizetype DefaultDecodeCacheCost = 10 * 1024 * 1024;
+
+Q_GLOBAL_STATIC(QImageDecodeCache, decodeCache)
+
+size_t qHash(const QImageDecodeCache::Key &key, size_t seed) noexcept
+{
+    return qHashMulti(seed, key.fileName, key.lastModified, key.size, key.format);
+}
+
+QImageDecodeCache::QImageDecodeCache()
+    : cache(DefaultDecodeCacheCost)
+{
+}
+
+QImageDecodeCache::~QImageDecodeCache()
+{
+}
+
+/*!
+    Returns the process-wide cache, or \nullptr while the application exits.
+*/
+QImageDecodeCache *QImageDecodeCache::instance()
+{
+    return decodeCache();
+}
+
+/*!
+    Returns the key for the current state of the file \a fileName, read with
+    the image \a format. The key has an empty file name if the file does not
+    exist, in which case the image is not cached.
+*/
+QImageDecodeCache::Key QImageDecodeCache::keyForFile(const QString &fileName, const QByteArray &format)
+{
+    Key key;
+    const QFileInfo info(fileName);
+    // Without a suffix, QImageReader may end up reading another file
+    if (!info.exists())
+        return key;
+    key.fileName = info.absoluteFilePath();
+    key.lastModified = info.lastModified().toMSecsSinceEpoch();
+    key.size = info.size();
+    key.format = format;
+    return key;
+}
+
+QImage QImageDecodeCache::decode(const Key &key)
+{
+    return QImageReader(key.fileName, key.format).read();
+}
+
+bool QImageDecodeCache::find(const Key &key, QImage *image)
+{
+    if (const QImage *cached = cache.object(key)) {
+        *image = *cached;
+        ++hits;
+        return true;
+    }
+    return false;
+}
+
+void QImageDecodeCache::insert(const Key &key, const QImage &image)
+{
+    if (!image.isNull())
+        cache.insert(key, new QImage(image), image.sizeInBytes());
+}
+
+/*!
+    Returns the image in the file \a fileName, decoding it with the image
+    \a format unless it is in the cache. Waits for the image if it is being
+    decoded by imageAsync().
+*/
+QImage QImageDecodeCache::image(const QString &fileName, const QByteArray &format)
+{
+    const Key key = keyForFile(fileName, format);
+    if (key.fileName.isEmpty())
+        return QImageReader(fileName, format).read();
+
+    QImage image;
+    QMutexLocker locker(&mutex);
+    if (find(key, &image))
+        return image;
+#if QT_CONFIG(future)
+    const auto it = pending.constFind(key);
+    if (it != pending.cend()) {
+        QFuture<QImage> future = it.value();
+        ++hits;
+        locker.unlock();
+        return future.result();
+    }
+#endif
+    ++misses;
+#if QT_CONFIG(future)
+    // Let concurrent requests for the same file wait for this decode
+    QFutureInterface<QImage> promise;
+    promise.reportStarted();
+    pending.insert(key, promise.future());
+#endif
+    locker.unlock();
+
+    image = decode(key);
+
+    locker.relock();
+    insert(key, image);
+#if QT_CONFIG(future)
+    pending.remove(key);
+    locker.unlock();
+    promise.reportFinished(&image);
+#endif
+    return image;
+}
+
+#if QT_CONFIG(future)
+/*!
+    Returns a future for the image in the file \a fileName, which is decoded
+    with the image \a format on the global thread pool unless it is in the
+    cache. The future has finished already if the image was in the cache.
+*/
+QFuture<QImage> QImageDecodeCache::imageAsync(const QString &fileName, const QByteArray &format)
+{
+    QFutureInterface<QImage> promise;
+    promise.reportStarted();
+    QFuture<QImage> future = promise.future();
+
+    Key key = keyForFile(fileName, format);
+    const bool cacheable = !key.fileName.isEmpty();
+    if (cacheable) {
+        QMutexLocker locker(&mutex);
+        QImage image;
+        if (find(key, &image)) {
+            promise.reportFinished(&image);
+            return future;
+        }
+        const auto it = pending.constFind(key);
+        if (it != pending.cend()) {
+            ++hits;
+            return it.value();
+        }
+        ++misses;
+        pending.insert(key, future);
+    } else {
+        key.fileName = fileName;
+        key.format = format;
+    }
+
+    QThreadPool::globalInstance()->start([key, cacheable, promise]() mutable {
+        const QImage image = decode(key);
+        QImageDecodeCache *cache = instance();
+        if (cacheable && cache) {
+            QMutexLocker locker(&cache->mutex);
+            cache->insert(key, image);
+            cache->pending.remove(key);
+        }
+        promise.reportFinished(&image);
+    });
+    return future;
+}
+#endif // QT_CONFIG(future)
+
+/*!
+    Sets the maximum total size of the cached images to \a bytes, evicting
+    the least recently used images if needed.
+*/
+void QImageDecodeCache::setMaxCost(qsizetype bytes)
+{
+    QMutexLocker locker(&mutex);
+    cache.setMaxCost(bytes);
+}
+
+/*!
+    Returns the maximum total size of the cached images, in bytes.
+*/
+qsizetype QImageDecodeCache::maxCost() const
+{
+    QMutexLocker locker(&mutex);
+    return cache.maxCost();
+}
+
+/*!
+    Returns the number of cache hits and misses since the last call to
+    resetStatistics(), and the current use of the cache. A request that
+    joins a decode in progress counts as a hit.
+*/
+QImageDecodeCache::Statistics QImageDecodeCache::statistics() const
+{
+    QMutexLocker locker(&mutex);
+    Statistics statistics;
+    statistics.hits = hits;
+    statistics.misses = misses;
+    statistics.count = cache.count();
+    statistics.totalCost = cache.totalCost();
+    statistics.maxCost = cache.maxCost();
+    return statistics;
+}
+
+/*!
+    Resets the number of cache hits and misses to zero.
+*/
+void QImageDecodeCache::resetStatistics()
+{
+    QMutexLocker locker(&mutex);
+    hits = 0;
+    misses = 0;
+}
+
+/*!
+    Removes all images from the cache. Decodes in progress are not affected.
+*/
+void QImageDecodeCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    cache.clear();
+}
+
+QT_END_NAMESPACE
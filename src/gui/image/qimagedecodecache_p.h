@@ -0,0 +1,129 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QIMAGEDECODECACHE_P_H
+#define QIMAGEDECODECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtGui/private/qtguiglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+#include <QtGui/qimage.h>
+
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class Q_GUI_EXPORT QImageDecodeCache
+{
+public:
+    struct Key
+    {
+        QString fileName;
+        qint64 lastModified = 0;
+        qint64 size = 0;
+        QByteArray format;
+
+        bool operator==(const Key &other) const
+        {
+            return fileName == other.fileName && lastModified == other.lastModified
+                && size == other.size && format == other.format;
+        }
+    };
+
+    struct Statistics
+    {
+        qint64 hits = 0;
+        qint64 misses = 0;
+        qsizetype count = 0;
+        qsizetype totalCost = 0;
+        qsizetype maxCost = 0;
+    };
+
+    QImageDecodeCache();
+    ~QImageDecodeCache();
+
+    static QImageDecodeCache *instance();
+    static Key keyForFile(const QString &fileName, const QByteArray &format = QByteArray());
+
+    QImage image(const QString &fileName, const QByteArray &format = QByteArray());
+#if QT_CONFIG(future)
+    QFuture<QImage> imageAsync(const QString &fileName, const QByteArray &format = QByteArray());
+#endif
+
+    void setMaxCost(qsizetype bytes);
+    qsizetype maxCost() const;
+    Statistics statistics() const;
+    void resetStatistics();
+    void clear();
+
+private:
+    bool find(const Key &key, QImage *image);
+    void insert(const Key &key, const QImage &image);
+    static QImage decode(const Key &key);
+
+    mutable QMutex mutex;
+    QCache<Key, QImage> cache;
+#if QT_CONFIG(future)
+    QHash<Key, QFuture<QImage>> pending;
+#endif
+    qint64 hits = 0;
+    qint64 misses = 0;
+};
+
+Q_GUI_EXPORT size_t qHash(const QImageDecodeCache::Key &key, size_t seed = 0) noexcept;
+
+QT_END_NAMESPACE
+
+#endif // QIMAGEDECODECACHE_P_H
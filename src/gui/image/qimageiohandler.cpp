@@ -170,6 +170,14 @@
     the transformation metadata of an image. A handler that supports this option
     should not apply the transformation itself.
 
+    \value ParallelWrite. A handler which supports this option is expected
+    to spread the encoding of the image over several threads. This option
+    was introduced in Qt 6.0.
+
+    \value FastWrite. A handler which supports this option is expected to
+    favor encoding speed over file size when writing. This option was
+    introduced in Qt 6.0.
+
 \if !defined(qt6)
     \value TransformedByDefault. A handler that reports support for this feature
     will have image transformation metadata applied by default on read.
@@ -499,6 +507,53 @@ QRect QImageIOHandler::currentImageRect() const
     return QRect();
 }
 
+/*!
+    \since 6.0
+
+    Returns \c true if the handler can decode images from data that is
+    pushed to it in pieces with decodeProgressively(); otherwise returns
+    \c false.
+
+    The default implementation returns \c false.
+
+    \sa decodeProgressively(), QImageReader::decodeProgressively()
+*/
+bool QImageIOHandler::supportsProgressiveDecoding() const
+{
+    return false;
+}
+
+/*!
+    \since 6.0
+
+    Decodes as much of the image as possible from \a data, the next piece
+    of the image stream, continuing where the previous call stopped. The
+    bytes are not read from device(), and are only valid during the call.
+
+    The partially decoded image is stored in \a image, which is the same
+    for all calls, as soon as its size is known. Pixels that have not been
+    decoded yet are filled with zeros. The area decoded by this call is
+    stored in \a updatedRect, and \a finished is set to \c true once the
+    whole image has been decoded.
+    For formats that support animation, only the first image is decoded.
+
+    Returns \c false if the data could not be decoded; otherwise returns
+    \c true.
+
+    The default implementation returns \c false.
+
+    \sa supportsProgressiveDecoding(), QImageReader::decodeProgressively()
+*/
+bool QImageIOHandler::decodeProgressively(const QByteArray &data, QImage *image,
+                                          QRect *updatedRect, bool *finished)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(image);
+    Q_UNUSED(updatedRect);
+    Q_UNUSED(finished);
+    return false;
+}
+
 /*!
     For image formats that support animation, this function returns
     the number of images in the animation. If the image format does
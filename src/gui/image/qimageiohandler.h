@@ -93,7 +93,9 @@ public:
         SupportedSubTypes,
         OptimizedWrite,
         ProgressiveScanWrite,
-        ImageTransformation
+        ImageTransformation,
+        ParallelWrite,
+        FastWrite
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
         , TransformedByDefault
 #endif
@@ -124,6 +126,11 @@ public:
     virtual int currentImageNumber() const;
     virtual QRect currentImageRect() const;
 
+    // progressive decoding
+    virtual bool supportsProgressiveDecoding() const;
+    virtual bool decodeProgressively(const QByteArray &data, QImage *image,
+                                     QRect *updatedRect, bool *finished);
+
     static bool allocateImage(QSize size, QImage::Format format, QImage *image);
 
 protected:
@@ -90,6 +90,16 @@
     stream contents. You can enable or disable this feature, by calling
     setAutoDetectImageFormat().
 
+    \section1 Progressive Decoding
+
+    Images that are still arriving, for example over the network, can be
+    decoded and displayed while their data comes in. Instead of setting a
+    device, pass each piece of the data to decodeProgressively() as it is
+    received. After each call, progressiveImage() returns the image decoded
+    so far, and progressiveUpdateRect() the area that changed. Only the
+    formats whose handler supports it can be decoded this way, which
+    includes PNG and GIF.
+
     \section1 High Resolution Versions of Images
 
     It is possible to provide high resolution versions of images should a scaling
@@ -133,6 +143,7 @@
 */
 #include "qimagereader.h"
 
+#include <qbuffer.h>
 #include <qbytearray.h>
 #ifdef QIMAGEREADER_DEBUG
 #include <qdebug.h>
@@ -491,6 +502,14 @@ public:
     QImageReader::ImageReaderError imageReaderError;
     QString errorString;
 
+    // progressive decoding
+    QBuffer *progressiveBuffer = nullptr;
+    qsizetype progressiveDecodedSize = 0;
+    QImage progressiveImage;
+    QRect progressiveUpdateRect;
+    bool progressiveFinished = false;
+    void resetProgressiveDecoding();
+
     QImageReader *q;
 
     static int maxAlloc;
@@ -524,6 +543,18 @@ QImageReaderPrivate::~QImageReaderPrivate()
     delete handler;
 }
 
+/*!
+    \internal
+*/
+void QImageReaderPrivate::resetProgressiveDecoding()
+{
+    progressiveBuffer = nullptr;
+    progressiveDecodedSize = 0;
+    progressiveImage = QImage();
+    progressiveUpdateRect = QRect();
+    progressiveFinished = false;
+}
+
 /*!
     \internal
 */
@@ -785,6 +816,7 @@ void QImageReader::setDevice(QIODevice *device)
     delete d->handler;
     d->handler = nullptr;
     d->text.clear();
+    d->resetProgressiveDecoding();
 }
 
 /*!
@@ -1438,6 +1470,123 @@ QRect QImageReader::currentImageRect() const
     return d->handler->currentImageRect();
 }
 
+/*!
+    \since 6.0
+
+    Decodes \a data, the next piece of the image stream, on top of the
+    data passed in previous calls. This allows showing an image while its
+    data is still being received. The format is detected from the first
+    bytes, unless set with setFormat().
+
+    Use progressiveImage() to get the image decoded so far, and
+    progressiveUpdateRect() to find which part of it was decoded by this
+    call. The image is complete once isProgressiveDecodingFinished() returns
+    \c true. Options such as the scaled size, clip rects and automatic
+    transformation are not applied to progressively decoded images, and
+    only the first image of an animation is decoded.
+
+    Progressive decoding cannot be used with a reader that has a file or a
+    device assigned, and cannot be mixed with read(). Call setDevice() with
+    \nullptr to start decoding a new image.
+
+    Returns \c false if an error occurred; otherwise returns \c true. The
+    type of the error can be found with error() and errorString().
+
+    \sa QImageIOHandler::decodeProgressively()
+*/
+bool QImageReader::decodeProgressively(const QByteArray &data)
+{
+    // Enough to recognize any of the supported formats
+    const qsizetype FormatProbeSize = 32;
+
+    d->progressiveUpdateRect = QRect();
+    if (!d->progressiveBuffer) {
+        if (d->device) {
+            d->imageReaderError = DeviceError;
+            d->errorString = QImageReader::tr("Cannot decode progressively from a device");
+            return false;
+        }
+        d->progressiveBuffer = new QBuffer;
+        d->progressiveBuffer->open(QIODevice::ReadOnly);
+        d->device = d->progressiveBuffer;
+        d->deleteDevice = true;
+    }
+    if (d->progressiveFinished)
+        return true;
+
+    // The data is kept in the device, so that the handler can still be
+    // queried for the image size and other options.
+    d->progressiveBuffer->buffer().append(data);
+
+    if (!d->handler) {
+        if (d->progressiveBuffer->size() < FormatProbeSize)
+            return true;
+        if (!d->initHandler())
+            return false;
+        if (!d->handler->supportsProgressiveDecoding()) {
+            d->imageReaderError = UnsupportedFormatError;
+            d->errorString = QImageReader::tr("Progressive decoding is not supported for this image format");
+            return false;
+        }
+    }
+
+    const QByteArray &buffered = d->progressiveBuffer->data();
+    // Handlers may keep the data they are given, so this is a real copy.
+    const QByteArray pending = buffered.mid(d->progressiveDecodedSize);
+    d->progressiveDecodedSize = buffered.size();
+
+    bool finished = false;
+    if (!d->handler->decodeProgressively(pending, &d->progressiveImage,
+                                         &d->progressiveUpdateRect, &finished)) {
+        d->imageReaderError = InvalidDataError;
+        d->errorString = QImageReader::tr("Unable to read image data");
+        return false;
+    }
+    d->progressiveFinished = finished;
+    return true;
+}
+
+/*!
+    \since 6.0
+
+    Returns the image decoded so far by decodeProgressively(). The parts of
+    the image that have not been decoded yet are filled with zeros.
+    Returns a null image if not enough data has been decoded to know the
+    size of the image.
+
+    \sa progressiveUpdateRect(), isProgressiveDecodingFinished()
+*/
+QImage QImageReader::progressiveImage() const
+{
+    return d->progressiveImage;
+}
+
+/*!
+    \since 6.0
+
+    Returns the part of progressiveImage() that was decoded by the last
+    call to decodeProgressively(), or an empty rect if nothing changed.
+
+    \sa decodeProgressively()
+*/
+QRect QImageReader::progressiveUpdateRect() const
+{
+    return d->progressiveUpdateRect;
+}
+
+/*!
+    \since 6.0
+
+    Returns \c true if decodeProgressively() has decoded the whole image;
+    otherwise returns \c false.
+
+    \sa decodeProgressively()
+*/
+bool QImageReader::isProgressiveDecodingFinished() const
+{
+    return d->progressiveFinished;
+}
+
 /*!
     Returns the type of error that occurred last.
 
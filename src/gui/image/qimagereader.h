@@ -131,6 +131,11 @@ public:
     int currentImageNumber() const;
     QRect currentImageRect() const;
 
+    bool decodeProgressively(const QByteArray &data);
+    QImage progressiveImage() const;
+    QRect progressiveUpdateRect() const;
+    bool isProgressiveDecodingFinished() const;
+
     ImageReaderError error() const;
     QString errorString() const;
 
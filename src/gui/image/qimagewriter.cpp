@@ -255,6 +255,8 @@ public:
     QByteArray subType;
     bool optimizedWrite;
     bool progressiveScanWrite;
+    bool parallelWrite;
+    bool fastWrite;
     QImageIOHandler::Transformations transformation;
 
     // error
@@ -277,6 +279,8 @@ QImageWriterPrivate::QImageWriterPrivate(QImageWriter *qq)
     gamma = 0.0;
     optimizedWrite = false;
     progressiveScanWrite = false;
+    parallelWrite = false;
+    fastWrite = false;
     imageWriterError = QImageWriter::UnknownError;
     errorString = QImageWriter::tr("Unknown error");
     transformation = QImageIOHandler::TransformationNone;
@@ -595,6 +599,64 @@ bool QImageWriter::progressiveScanWrite() const
     return d->progressiveScanWrite;
 }
 
+/*!
+    \since 6.0
+
+    This is an image format-specific function which turns on encoding the
+    image on several threads when \a parallel is true. The output is a
+    regular image file. For image formats that do not support parallel
+    writing, this value is ignored.
+
+    The default is false.
+
+    \sa parallelWrite(), QThreadPool
+*/
+void QImageWriter::setParallelWrite(bool parallel)
+{
+    d->parallelWrite = parallel;
+}
+
+/*!
+    \since 6.0
+
+    Returns whether the image should be encoded on several threads.
+
+    \sa setParallelWrite()
+*/
+bool QImageWriter::parallelWrite() const
+{
+    return d->parallelWrite;
+}
+
+/*!
+    \since 6.0
+
+    This is an image format-specific function which makes the handler favor
+    encoding speed over file size when \a fast is true. For the PNG format,
+    this limits the filters tried for each row to the cheapest ones. For
+    image formats that do not support fast writing, this value is ignored.
+
+    The default is false.
+
+    \sa fastWrite(), setCompression()
+*/
+void QImageWriter::setFastWrite(bool fast)
+{
+    d->fastWrite = fast;
+}
+
+/*!
+    \since 6.0
+
+    Returns whether the image should be written favoring speed over size.
+
+    \sa setFastWrite()
+*/
+bool QImageWriter::fastWrite() const
+{
+    return d->fastWrite;
+}
+
 /*!
     \since 5.5
 
@@ -712,6 +774,10 @@ bool QImageWriter::write(const QImage &image)
         d->handler->setOption(QImageIOHandler::OptimizedWrite, d->optimizedWrite);
     if (d->handler->supportsOption(QImageIOHandler::ProgressiveScanWrite))
         d->handler->setOption(QImageIOHandler::ProgressiveScanWrite, d->progressiveScanWrite);
+    if (d->handler->supportsOption(QImageIOHandler::ParallelWrite))
+        d->handler->setOption(QImageIOHandler::ParallelWrite, d->parallelWrite);
+    if (d->handler->supportsOption(QImageIOHandler::FastWrite))
+        d->handler->setOption(QImageIOHandler::FastWrite, d->fastWrite);
     if (d->handler->supportsOption(QImageIOHandler::ImageTransformation))
         d->handler->setOption(QImageIOHandler::ImageTransformation, int(d->transformation));
     else
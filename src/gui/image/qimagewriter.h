@@ -94,6 +94,12 @@ public:
     void setProgressiveScanWrite(bool progressive);
     bool progressiveScanWrite() const;
 
+    void setParallelWrite(bool parallel);
+    bool parallelWrite() const;
+
+    void setFastWrite(bool fast);
+    bool fastWrite() const;
+
     QImageIOHandler::Transformations transformation() const;
     void setTransformation(QImageIOHandler::Transformations orientation);
 
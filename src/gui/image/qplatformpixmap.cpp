@@ -43,6 +43,7 @@
 #include <QtGui/qbitmap.h>
 #include <QtGui/qimagereader.h>
 #include <private/qguiapplication_p.h>
+#include <private/qimagedecodecache_p.h>
 #include <private/qimagepixmapcleanuphooks_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -131,7 +132,9 @@ void QPlatformPixmap::fromImageReader(QImageReader *imageReader,
 bool QPlatformPixmap::fromFile(const QString &fileName, const char *format,
                            Qt::ImageConversionFlags flags)
 {
-    QImage image = QImageReader(fileName, format).read();
+    // Share the decoded image with the other pixmaps and icons of the file
+    QImageDecodeCache *cache = QImageDecodeCache::instance();
+    QImage image = cache ? cache->image(fileName, format) : QImageReader(fileName, format).read();
     if (image.isNull())
         return false;
     fromImage(makeBitmapCompliantIfNeeded(this, image, flags), flags);
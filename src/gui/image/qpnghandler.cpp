@@ -43,10 +43,16 @@
 #ifndef QT_NO_IMAGEFORMAT_PNG
 #include <qcoreapplication.h>
 #include <qdebug.h>
+#include <qendian.h>
 #include <qiodevice.h>
 #include <qimage.h>
 #include <qloggingcategory.h>
 #include <qvariant.h>
+#include <qvarlengtharray.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
 #include <private/qimage_p.h> // for qt_getImageText
 
@@ -55,6 +61,7 @@
 
 #include <png.h>
 #include <pngconf.h>
+#include <zlib.h>
 
 #if PNG_LIBPNG_VER >= 10400 && PNG_LIBPNG_VER <= 10502 \
         && defined(PNG_PEDANTIC_WARNINGS_SUPPORTED)
@@ -99,6 +106,7 @@ public:
         Ready,
         ReadHeader,
         ReadingEnd,
+        ReadingProgressively,
         Error
     };
     // Defines the order of how the various ways of setting colorspace overrides eachother:
@@ -110,13 +118,15 @@ public:
     };
 
     QPngHandlerPrivate(QPngHandler *qq)
-        : gamma(0.0), fileGamma(0.0), quality(50), compression(50), colorSpaceState(Undefined), png_ptr(nullptr), info_ptr(nullptr), end_info(nullptr), state(Ready), q(qq)
+        : gamma(0.0), fileGamma(0.0), quality(50), compression(50), parallelWrite(false), fastWrite(false), colorSpaceState(Undefined), png_ptr(nullptr), info_ptr(nullptr), end_info(nullptr), state(Ready), q(qq)
     { }
 
     float gamma;
     float fileGamma;
     int quality; // quality is used for backward compatibility, maps to compression
     int compression;
+    bool parallelWrite;
+    bool fastWrite;
     QString description;
     QSize scaledSize;
     QStringList readTexts;
@@ -127,9 +137,18 @@ public:
     png_info *info_ptr;
     png_info *end_info;
 
+    bool createReadStruct();
     bool readPngHeader();
     bool readPngImage(QImage *image);
     void readPngTexts(png_info *info);
+    void readPngColorSpace();
+    void setupGammaCorrection();
+
+    bool decodeProgressively(const QByteArray &data, QImage *image,
+                             QRect *updatedRect, bool *finished);
+    QImage *progressiveImage = nullptr;
+    QRect progressiveUpdateRect;
+    bool progressiveFinished = false;
 
     QImage::Format readImageFormat();
 
@@ -173,6 +192,8 @@ public:
     void setLooping(int loops=0); // 0 == infinity
     void setFrameDelay(int msecs);
     void setGamma(float);
+    void setParallel(bool);
+    void setFastFilters(bool);
 
     bool writeImage(const QImage& img, int x, int y);
     bool writeImage(const QImage& img, int compression_in, const QString &description, int x, int y);
@@ -190,6 +211,8 @@ private:
     int looping;
     int ms_delay;
     float gamma;
+    bool parallel;
+    bool fastFilters;
 };
 
 extern "C" {
@@ -537,9 +560,8 @@ void QPngHandlerPrivate::readPngTexts(png_info *info)
 }
 
 
-bool QPngHandlerPrivate::readPngHeader()
+bool QPngHandlerPrivate::createReadStruct()
 {
-    state = Error;
     png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING,nullptr,nullptr,nullptr);
     if (!png_ptr)
         return false;
@@ -565,6 +587,14 @@ bool QPngHandlerPrivate::readPngHeader()
         png_ptr = nullptr;
         return false;
     }
+    return true;
+}
+
+bool QPngHandlerPrivate::readPngHeader()
+{
+    state = Error;
+    if (!createReadStruct())
+        return false;
 
     if (setjmp(png_jmpbuf(png_ptr))) {
         png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
@@ -576,7 +606,14 @@ bool QPngHandlerPrivate::readPngHeader()
     png_read_info(png_ptr, info_ptr);
 
     readPngTexts(info_ptr);
+    readPngColorSpace();
 
+    state = ReadHeader;
+    return true;
+}
+
+void QPngHandlerPrivate::readPngColorSpace()
+{
 #ifdef PNG_iCCP_SUPPORTED
     if (png_get_valid(png_ptr, info_ptr, PNG_INFO_iCCP)) {
         png_charp name = nullptr;
@@ -635,9 +672,17 @@ bool QPngHandlerPrivate::readPngHeader()
             colorSpaceState = GammaChrm;
         }
     }
+}
 
-    state = ReadHeader;
-    return true;
+void QPngHandlerPrivate::setupGammaCorrection()
+{
+    if (gamma != 0.0 && fileGamma != 0.0) {
+        // This configuration forces gamma correction and
+        // thus changes the output colorspace
+        png_set_gamma(png_ptr, 1.0f / gamma, fileGamma);
+        colorSpace.setTransferFunction(QColorSpace::TransferFunction::Gamma, 1.0f / gamma);
+        colorSpaceState = GammaChrm;
+    }
 }
 
 bool QPngHandlerPrivate::readPngImage(QImage *outImage)
@@ -658,13 +703,7 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
         return false;
     }
 
-    if (gamma != 0.0 && fileGamma != 0.0) {
-        // This configuration forces gamma correction and
-        // thus changes the output colorspace
-        png_set_gamma(png_ptr, 1.0f / gamma, fileGamma);
-        colorSpace.setTransferFunction(QColorSpace::TransferFunction::Gamma, 1.0f / gamma);
-        colorSpaceState = GammaChrm;
-    }
+    setupGammaCorrection();
 
     bool doScaledRead = false;
     if (!setup_qt(*outImage, png_ptr, info_ptr, scaledSize, &doScaledRead)) {
@@ -740,6 +779,105 @@ bool QPngHandlerPrivate::readPngImage(QImage *outImage)
     return true;
 }
 
+extern "C" {
+static void qt_png_progressive_info(png_structp png_ptr, png_infop info_ptr)
+{
+    QPngHandlerPrivate *d = (QPngHandlerPrivate *)png_get_progressive_ptr(png_ptr);
+    d->readPngColorSpace();
+    d->setupGammaCorrection();
+
+    QImage *image = d->progressiveImage;
+    if (!setup_qt(*image, png_ptr, info_ptr, QSize(), nullptr))
+        png_error(png_ptr, "Could not allocate image");
+    image->fill(0);
+
+    png_int_32 offset_x = 0;
+    png_int_32 offset_y = 0;
+    int unit_type = PNG_OFFSET_PIXEL;
+    png_get_oFFs(png_ptr, info_ptr, &offset_x, &offset_y, &unit_type);
+    image->setDotsPerMeterX(png_get_x_pixels_per_meter(png_ptr, info_ptr));
+    image->setDotsPerMeterY(png_get_y_pixels_per_meter(png_ptr, info_ptr));
+    if (unit_type == PNG_OFFSET_PIXEL)
+        image->setOffset(QPoint(offset_x, offset_y));
+
+    if (d->colorSpaceState > QPngHandlerPrivate::Undefined && d->colorSpace.isValid())
+        image->setColorSpace(d->colorSpace);
+}
+
+static void qt_png_progressive_row(png_structp png_ptr, png_bytep new_row, png_uint_32 row_num, int)
+{
+    // Rows left unchanged by an interlace pass are not passed
+    if (!new_row)
+        return;
+
+    QPngHandlerPrivate *d = (QPngHandlerPrivate *)png_get_progressive_ptr(png_ptr);
+    QImage *image = d->progressiveImage;
+    if (row_num >= png_uint_32(image->height()))
+        return;
+
+    uchar *line = image->scanLine(row_num);
+    png_progressive_combine_row(png_ptr, line, new_row);
+
+    // sanity check palette entries
+    if (png_get_color_type(png_ptr, d->info_ptr) == PNG_COLOR_TYPE_PALETTE
+        && image->format() == QImage::Format_Indexed8) {
+        const int color_table_size = image->colorCount();
+        for (uchar *p = line, *end = line + image->width(); p < end; ++p) {
+            if (*p >= color_table_size)
+                *p = 0;
+        }
+    }
+
+    d->progressiveUpdateRect |= QRect(0, row_num, image->width(), 1);
+}
+
+static void qt_png_progressive_end(png_structp png_ptr, png_infop info_ptr)
+{
+    QPngHandlerPrivate *d = (QPngHandlerPrivate *)png_get_progressive_ptr(png_ptr);
+
+    // The texts before and after the image data end up in the same info
+    d->readPngTexts(info_ptr);
+    for (int i = 0; i < d->readTexts.size()-1; i+=2)
+        d->progressiveImage->setText(d->readTexts.at(i), d->readTexts.at(i+1));
+
+    d->progressiveFinished = true;
+}
+}
+
+bool QPngHandlerPrivate::decodeProgressively(const QByteArray &data, QImage *image,
+                                             QRect *updatedRect, bool *finished)
+{
+    if (state == Ready) {
+        state = Error;
+        if (!createReadStruct())
+            return false;
+        png_set_progressive_read_fn(png_ptr, this, qt_png_progressive_info,
+                                    qt_png_progressive_row, qt_png_progressive_end);
+        progressiveFinished = false;
+        state = ReadingProgressively;
+    }
+    if (state != ReadingProgressively)
+        return false;
+
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = nullptr;
+        progressiveImage = nullptr;
+        state = Error;
+        return false;
+    }
+
+    progressiveImage = image;
+    progressiveUpdateRect = QRect();
+    if (!progressiveFinished && !data.isEmpty())
+        png_process_data(png_ptr, info_ptr, (png_bytep)data.constData(), data.size());
+    progressiveImage = nullptr;
+
+    *updatedRect = progressiveUpdateRect;
+    *finished = progressiveFinished;
+    return true;
+}
+
 QImage::Format QPngHandlerPrivate::readImageFormat()
 {
         QImage::Format format = QImage::Format_Invalid;
@@ -789,7 +927,9 @@ QPNGImageWriter::QPNGImageWriter(QIODevice* iod) :
     disposal(Unspecified),
     looping(-1),
     ms_delay(-1),
-    gamma(0.0)
+    gamma(0.0),
+    parallel(false),
+    fastFilters(false)
 {
 }
 
@@ -817,6 +957,16 @@ void QPNGImageWriter::setGamma(float g)
     gamma = g;
 }
 
+void QPNGImageWriter::setParallel(bool p)
+{
+    parallel = p;
+}
+
+void QPNGImageWriter::setFastFilters(bool f)
+{
+    fastFilters = f;
+}
+
 static void set_text(const QImage &image, png_structp png_ptr, png_infop info_ptr,
                      const QString &description)
 {
@@ -875,6 +1025,272 @@ static void set_text(const QImage &image, png_structp png_ptr, png_infop info_pt
     delete [] text_ptr;
 }
 
+#if QT_CONFIG(thread)
+// Parallel writing deflates the filtered image data in chunks of rows on the
+// global thread pool, like pigz does. Every chunk but the last ends with a
+// sync flush, so the raw deflate streams concatenate into a single zlib
+// stream, and every chunk is primed with the last 32K of data preceding it,
+// so the compression ratio stays close to that of a serial write.
+static const qsizetype ParallelPngChunkSize = 512 * 1024;
+static const qsizetype ParallelPngDictionarySize = 32 * 1024;
+
+static inline uchar pngPaethPredictor(int a, int b, int c)
+{
+    const int p = a + b - c;
+    const int pa = qAbs(p - a);
+    const int pb = qAbs(p - b);
+    const int pc = qAbs(p - c);
+    if (pa <= pb && pa <= pc)
+        return a;
+    return pb <= pc ? b : c;
+}
+
+// Filters one row with the given filter type, writing the type byte followed by the
+// filtered bytes to out.
+static void pngFilterRow(int type, const uchar *row, const uchar *prev, uchar *out, qsizetype rowBytes, int bpp)
+{
+    out[0] = uchar(type);
+    uchar *dst = out + 1;
+    switch (type) {
+    case PNG_FILTER_VALUE_NONE:
+        memcpy(dst, row, rowBytes);
+        break;
+    case PNG_FILTER_VALUE_SUB:
+        for (qsizetype i = 0; i < bpp; ++i)
+            dst[i] = row[i];
+        for (qsizetype i = bpp; i < rowBytes; ++i)
+            dst[i] = row[i] - row[i - bpp];
+        break;
+    case PNG_FILTER_VALUE_UP:
+        for (qsizetype i = 0; i < rowBytes; ++i)
+            dst[i] = row[i] - prev[i];
+        break;
+    case PNG_FILTER_VALUE_AVG:
+        for (qsizetype i = 0; i < bpp; ++i)
+            dst[i] = row[i] - (prev[i] >> 1);
+        for (qsizetype i = bpp; i < rowBytes; ++i)
+            dst[i] = row[i] - ((row[i - bpp] + prev[i]) >> 1);
+        break;
+    default:
+        for (qsizetype i = 0; i < bpp; ++i)
+            dst[i] = row[i] - prev[i];
+        for (qsizetype i = bpp; i < rowBytes; ++i)
+            dst[i] = row[i] - pngPaethPredictor(row[i - bpp], prev[i], prev[i - bpp]);
+        break;
+    }
+}
+
+// The sum of the filtered bytes taken as signed magnitudes, which is the
+// heuristic libpng uses to pick the filter for a row.
+static quint64 pngFilterCost(const uchar *filtered, qsizetype rowBytes)
+{
+    quint64 sum = 0;
+    for (qsizetype i = 1; i <= rowBytes; ++i)
+        sum += filtered[i] < 128 ? filtered[i] : 256 - filtered[i];
+    return sum;
+}
+
+// Writes the filtered row to out, choosing among the filter types in the
+// png_set_filter() mask like libpng does.
+static void pngFilterRowAdaptive(int filters, const uchar *row, const uchar *prev, uchar *out,
+                                 uchar *scratch, qsizetype rowBytes, int bpp)
+{
+    static const int filterFlags[] = { PNG_FILTER_NONE, PNG_FILTER_SUB, PNG_FILTER_UP,
+                                       PNG_FILTER_AVG, PNG_FILTER_PAETH };
+    quint64 best = std::numeric_limits<quint64>::max();
+    for (int type = PNG_FILTER_VALUE_NONE; type <= PNG_FILTER_VALUE_PAETH; ++type) {
+        if (filters == filterFlags[type]) {
+            pngFilterRow(type, row, prev, out, rowBytes, bpp);
+            return;
+        }
+        if (!(filters & filterFlags[type]))
+            continue;
+        pngFilterRow(type, row, prev, scratch, rowBytes, bpp);
+        const quint64 cost = pngFilterCost(scratch, rowBytes);
+        if (cost < best) {
+            best = cost;
+            memcpy(out, scratch, rowBytes + 1);
+        }
+    }
+}
+
+// Converts rows of image into the sample layout of the PNG file: the channels in
+// RGBA order and 16-bit samples in network byte order. Returns false for the
+// indexed formats, which are left to the serial writer.
+static bool pngRowFormat(const QImage &image, int color_type, int bpc, QImage::Format *format, int *bpp)
+{
+    switch (color_type) {
+    case PNG_COLOR_TYPE_GRAY:
+        if (image.format() != QImage::Format_Grayscale8 && image.format() != QImage::Format_Grayscale16)
+            return false;
+        *format = image.format();
+        *bpp = bpc / 8;
+        return true;
+    case PNG_COLOR_TYPE_RGB:
+        *format = bpc == 16 ? QImage::Format_RGBX64 : QImage::Format_RGB888;
+        *bpp = 3 * bpc / 8;
+        return true;
+    case PNG_COLOR_TYPE_RGB_ALPHA:
+        *format = bpc == 16 ? QImage::Format_RGBA64 : QImage::Format_RGBA8888;
+        *bpp = 4 * bpc / 8;
+        return true;
+    }
+    return false;
+}
+
+static void pngStoreRow(const QImage &rows, int y, uchar *out, qsizetype rowBytes)
+{
+    const uchar *src = rows.constScanLine(y);
+    switch (rows.format()) {
+    case QImage::Format_Grayscale16:
+    case QImage::Format_RGBA64:
+        qToBigEndian<quint16>(src, rowBytes / 2, out);
+        break;
+    case QImage::Format_RGBX64: {
+        const quint16 *s = reinterpret_cast<const quint16 *>(src);
+        for (qsizetype i = 0; i < rowBytes / 6; ++i, s += 4, out += 6)
+            qToBigEndian<quint16>(s, 3, out);
+        break;
+    }
+    default:
+        memcpy(out, src, rowBytes);
+        break;
+    }
+}
+
+struct QPngDeflateChunk
+{
+    int startY;
+    int endY;
+    QByteArray deflated;
+    uLong adler;
+    qsizetype length;
+    bool ok;
+};
+
+static void pngDeflateChunk(const QImage &image, QImage::Format format, int bpp, int filters,
+                            int level, bool last, QPngDeflateChunk *chunk)
+{
+    const qsizetype rowBytes = qsizetype(image.width()) * bpp;
+    const qsizetype filteredBytes = rowBytes + 1;
+    // Filter the rows preceding the chunk too, for the dictionary.
+    const int dictionaryRows = (ParallelPngDictionarySize + filteredBytes - 1) / filteredBytes;
+    const int firstY = qMax(0, chunk->startY - dictionaryRows);
+    const int prevY = qMax(0, firstY - 1);
+    const QImage rows = QImage(image.constScanLine(prevY), image.width(), chunk->endY - prevY,
+                               image.bytesPerLine(), image.format()).convertToFormat(format);
+
+    QByteArray filtered(qsizetype(chunk->endY - firstY) * filteredBytes, Qt::Uninitialized);
+    QByteArray buffer(3 * filteredBytes, Qt::Uninitialized);
+    uchar *prev = reinterpret_cast<uchar *>(buffer.data());
+    uchar *row = prev + filteredBytes;
+    uchar *scratch = row + filteredBytes;
+    if (firstY > 0)
+        pngStoreRow(rows, 0, prev, rowBytes);
+    else
+        memset(prev, 0, rowBytes);
+    uchar *out = reinterpret_cast<uchar *>(filtered.data());
+    for (int y = firstY; y < chunk->endY; ++y, out += filteredBytes) {
+        pngStoreRow(rows, y - prevY, row, rowBytes);
+        pngFilterRowAdaptive(filters, row, prev, out, scratch, rowBytes, bpp);
+        qSwap(prev, row);
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(filtered.constData());
+    const qsizetype dictionaryLength = qMin(qsizetype(chunk->startY - firstY) * filteredBytes,
+                                            ParallelPngDictionarySize);
+    const qsizetype dataOffset = qsizetype(chunk->startY - firstY) * filteredBytes;
+    chunk->length = filtered.size() - dataOffset;
+    chunk->adler = adler32(adler32(0, nullptr, 0), data + dataOffset, uInt(chunk->length));
+
+    z_stream stream = {};
+    chunk->ok = deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8,
+                             filters == PNG_FILTER_NONE ? Z_DEFAULT_STRATEGY : Z_FILTERED) == Z_OK;
+    if (!chunk->ok)
+        return;
+    if (dictionaryLength > 0)
+        deflateSetDictionary(&stream, data + dataOffset - dictionaryLength, uInt(dictionaryLength));
+
+    const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    chunk->deflated.resize(deflateBound(&stream, uLong(chunk->length)) + 16);
+    stream.next_in = const_cast<Bytef *>(data + dataOffset);
+    stream.avail_in = uInt(chunk->length);
+    qsizetype produced = 0;
+    forever {
+        stream.next_out = reinterpret_cast<Bytef *>(chunk->deflated.data()) + produced;
+        stream.avail_out = uInt(chunk->deflated.size() - produced);
+        const int ret = deflate(&stream, flush);
+        produced = chunk->deflated.size() - stream.avail_out;
+        if (ret == Z_STREAM_ERROR) {
+            chunk->ok = false;
+            break;
+        }
+        if (last ? ret == Z_STREAM_END : (stream.avail_in == 0 && stream.avail_out > 0))
+            break;
+        chunk->deflated.resize(chunk->deflated.size() * 2);
+    }
+    chunk->deflated.truncate(produced);
+    deflateEnd(&stream);
+}
+
+// Writes the IDAT chunks of image, deflating in parallel. Returns false without
+// having written anything if the image is left to the serial writer.
+static bool writeParallelPngImageData(png_structp png_ptr, const QImage &image, int color_type,
+                                      int bpc, int filters, int compression)
+{
+    QImage::Format format;
+    int bpp;
+    if (!pngRowFormat(image, color_type, bpc, &format, &bpp))
+        return false;
+    const qsizetype filteredBytes = qsizetype(image.width()) * bpp + 1;
+    const int chunkRows = int(qMax(qsizetype(1), ParallelPngChunkSize / filteredBytes));
+    const int chunkCount = (image.height() + chunkRows - 1) / chunkRows;
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    if (chunkCount < 2 || threadPool->contains(QThread::currentThread()))
+        return false;
+
+    const int level = compression >= 0 ? compression : Z_DEFAULT_COMPRESSION;
+    QVarLengthArray<QPngDeflateChunk, 64> chunks(chunkCount);
+    QSemaphore semaphore;
+    for (int i = 0; i < chunkCount; ++i) {
+        QPngDeflateChunk *chunk = &chunks[i];
+        chunk->startY = i * chunkRows;
+        chunk->endY = qMin(chunk->startY + chunkRows, image.height());
+        const bool last = i == chunkCount - 1;
+        threadPool->start([&, chunk, last]() {
+            pngDeflateChunk(image, format, bpp, filters, level, last, chunk);
+            semaphore.release(1);
+        });
+    }
+    semaphore.acquire(chunkCount);
+
+    for (const QPngDeflateChunk &chunk : chunks) {
+        if (!chunk.ok)
+            return false;
+    }
+
+    // Wrap the raw deflate streams into a zlib stream, with a 32K window and
+    // the level hint libpng would give.
+    const int levelHint = level == Z_DEFAULT_COMPRESSION || level == 6 ? 2 : level < 2 ? 0 : level < 6 ? 1 : 3;
+    char header[2] = { 0x78, char(levelHint << 6) };
+    header[1] |= 31 - (0x78 * 256 + uchar(header[1])) % 31;
+    chunks[0].deflated.prepend(header, 2);
+
+    uLong adler = chunks[0].adler;
+    for (int i = 1; i < chunkCount; ++i)
+        adler = adler32_combine(adler, chunks[i].adler, chunks[i].length);
+    const char trailer[4] = { char(adler >> 24), char(adler >> 16), char(adler >> 8), char(adler) };
+    chunks[chunkCount - 1].deflated.append(trailer, 4);
+
+    for (const QPngDeflateChunk &chunk : chunks) {
+        png_write_chunk(png_ptr, const_cast<png_bytep>((const png_byte *)"IDAT"),
+                        reinterpret_cast<png_const_bytep>(chunk.deflated.constData()),
+                        chunk.deflated.size());
+    }
+    return true;
+}
+#endif // QT_CONFIG(thread)
+
 bool QPNGImageWriter::writeImage(const QImage& image, int off_x, int off_y)
 {
     return writeImage(image, -1, QString(), off_x, off_y);
@@ -922,6 +1338,10 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
 
     png_set_write_fn(png_ptr, (void*)this, qpiw_write_fn, qpiw_flush_fn);
 
+    // Fast writing leaves out the Avg and Paeth filters, the costly ones to try
+    const int fastFilterMask = PNG_FILTER_NONE | PNG_FILTER_SUB | PNG_FILTER_UP;
+    if (fastFilters)
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, fastFilterMask);
 
     int color_type = 0;
     if (image.format() <= QImage::Format_Indexed8) {
@@ -1104,6 +1524,18 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
         png_write_chunk(png_ptr, const_cast<png_bytep>((const png_byte *)"gIFg"), data, 4);
     }
 
+#if QT_CONFIG(thread)
+    if (parallel && writeParallelPngImageData(png_ptr, image, color_type, bpc,
+                                              fastFilters ? fastFilterMask : PNG_ALL_FILTERS,
+                                              compression)) {
+        // png_write_end() refuses to end image data that libpng did not write
+        png_write_chunk(png_ptr, const_cast<png_bytep>((const png_byte *)"IEND"), nullptr, 0);
+        frames_written++;
+        png_destroy_write_struct(&png_ptr, &info_ptr);
+        return true;
+    }
+#endif
+
     int height = image.height();
     int width = image.width();
     switch (image.format()) {
@@ -1162,7 +1594,8 @@ bool QPNGImageWriter::writeImage(const QImage& image, int compression_in, const
 }
 
 static bool write_png_image(const QImage &image, QIODevice *device,
-                            int compression, int quality, float gamma, const QString &description)
+                            int compression, int quality, float gamma, const QString &description,
+                            bool parallel, bool fast)
 {
     // quality is used for backward compatibility, maps to compression
 
@@ -1176,6 +1609,8 @@ static bool write_png_image(const QImage &image, QIODevice *device,
         compression = (compression * 9) / 91; // map [0,100] -> [0,9]
 
     writer.setGamma(gamma);
+    writer.setParallel(parallel);
+    writer.setFastFilters(fast);
     return writer.writeImage(image, compression, description);
 }
 
@@ -1221,9 +1656,21 @@ bool QPngHandler::read(QImage *image)
     return d->readPngImage(image);
 }
 
+bool QPngHandler::supportsProgressiveDecoding() const
+{
+    return true;
+}
+
+bool QPngHandler::decodeProgressively(const QByteArray &data, QImage *image,
+                                      QRect *updatedRect, bool *finished)
+{
+    return d->decodeProgressively(data, image, updatedRect, finished);
+}
+
 bool QPngHandler::write(const QImage &image)
 {
-    return write_png_image(image, device(), d->compression, d->quality, d->gamma, d->description);
+    return write_png_image(image, device(), d->compression, d->quality, d->gamma, d->description,
+                           d->parallelWrite, d->fastWrite);
 }
 
 bool QPngHandler::supportsOption(ImageOption option) const
@@ -1233,6 +1680,8 @@ bool QPngHandler::supportsOption(ImageOption option) const
         || option == ImageFormat
         || option == Quality
         || option == CompressionRatio
+        || option == ParallelWrite
+        || option == FastWrite
         || option == Size
         || option == ScaledSize;
 }
@@ -1250,6 +1699,10 @@ QVariant QPngHandler::option(ImageOption option) const
         return d->quality;
     else if (option == CompressionRatio)
         return d->compression;
+    else if (option == ParallelWrite)
+        return d->parallelWrite;
+    else if (option == FastWrite)
+        return d->fastWrite;
     else if (option == Description)
         return d->description;
     else if (option == Size)
@@ -1270,6 +1723,10 @@ void QPngHandler::setOption(ImageOption option, const QVariant &value)
         d->quality = value.toInt();
     else if (option == CompressionRatio)
         d->compression = value.toInt();
+    else if (option == ParallelWrite)
+        d->parallelWrite = value.toBool();
+    else if (option == FastWrite)
+        d->fastWrite = value.toBool();
     else if (option == Description)
         d->description = value.toString();
     else if (option == ScaledSize)
@@ -75,6 +75,10 @@ public:
 
     static bool canRead(QIODevice *device);
 
+    bool supportsProgressiveDecoding() const override;
+    bool decodeProgressively(const QByteArray &data, QImage *image,
+                             QRect *updatedRect, bool *finished) override;
+
 private:
     QPngHandlerPrivate *d;
 };
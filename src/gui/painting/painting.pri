@@ -42,6 +42,7 @@ HEADERS += \
         painting/qpainter_p.h \
         painting/qpainterpath.h \
         painting/qpainterpath_p.h \
+        painting/qparallelimagerenderer.h \
         painting/qvectorpath_p.h \
         painting/qpathclipper_p.h \
         painting/qpdf_p.h \
@@ -97,6 +98,7 @@ SOURCES += \
         painting/qpaintengine_raster.cpp \
         painting/qpainter.cpp \
         painting/qpainterpath.cpp \
+        painting/qparallelimagerenderer.cpp \
         painting/qpathclipper.cpp \
         painting/qpdf.cpp \
         painting/qpdfwriter.cpp \
@@ -142,7 +144,8 @@ gcc:equals(QT_GCC_MAJOR_VERSION, 5) {
     SSSE3_SOURCES += painting/qdrawhelper_ssse3.cpp
     SSE4_1_SOURCES += painting/qdrawhelper_sse4.cpp \
                       painting/qimagescale_sse4.cpp
-    ARCH_HASWELL_SOURCES += painting/qdrawhelper_avx2.cpp
+    ARCH_HASWELL_SOURCES += painting/qdrawhelper_avx2.cpp \
+                            painting/qimagescale_avx2.cpp
 
     NEON_SOURCES += painting/qdrawhelper_neon.cpp painting/qimagescale_neon.cpp
     NEON_HEADERS += painting/qdrawhelper_neon_p.h
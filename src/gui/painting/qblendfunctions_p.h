@@ -246,7 +246,8 @@ void qt_transform_image_rasterize(DestT *destPixels, int dbpl,
                                   int dudx, int dvdx, int dudy, int dvdy, int u0, int v0,
                                   Blender blender)
 {
-    int fromY = qMax(qRound(topY), clip.top());
+    const int startY = qRound(topY);
+    int fromY = qMax(startY, clip.top());
     int toY = qMin(qRound(bottomY), clip.top() + clip.height());
     if (fromY >= toY)
         return;
@@ -255,8 +256,12 @@ void qt_transform_image_rasterize(DestT *destPixels, int dbpl,
     qreal rightSlope = (bottomRight.x - topRight.x) / (bottomRight.y - topRight.y);
     int dx_l = int(leftSlope * 0x10000);
     int dx_r = int(rightSlope * 0x10000);
-    int x_l = int((topLeft.x + (qreal(0.5) + fromY - topLeft.y) * leftSlope + qreal(0.5)) * 0x10000);
-    int x_r = int((topRight.x + (qreal(0.5) + fromY - topRight.y) * rightSlope + qreal(0.5)) * 0x10000);
+    // The edges are walked from the top of the primitive even when it is
+    // clipped, so that the clip does not change how they are rounded.
+    int x_l = int((topLeft.x + (qreal(0.5) + startY - topLeft.y) * leftSlope + qreal(0.5)) * 0x10000)
+            + (fromY - startY) * dx_l;
+    int x_r = int((topRight.x + (qreal(0.5) + startY - topRight.y) * rightSlope + qreal(0.5)) * 0x10000)
+            + (fromY - startY) * dx_r;
 
     int fromX, toX, x1, x2, u, v, i, ii;
     DestT *line;
@@ -5171,6 +5171,11 @@ static void qInitDrawhelperFunctions()
     qt_functionForModeSolid_C[QPainter::CompositionMode_Source] = comp_func_solid_Source_sse2;
     qt_functionForMode_C[QPainter::CompositionMode_Plus] = comp_func_Plus_sse2;
 
+    extern void qt_memrotate90_32_sse2(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl);
+    extern void qt_memrotate270_32_sse2(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl);
+    qMemRotateFunctions[QPixelLayout::BPP32][0] = qt_memrotate90_32_sse2;
+    qMemRotateFunctions[QPixelLayout::BPP32][2] = qt_memrotate270_32_sse2;
+
 #ifdef QT_COMPILER_SUPPORTS_SSSE3
     if (qCpuHasFeature(SSSE3)) {
         extern void qt_blend_argb32_on_argb32_ssse3(uchar *destPixels, int dbpl,
@@ -5339,6 +5344,9 @@ static void qInitDrawhelperFunctions()
 
     sourceFetchUntransformed[QImage::Format_RGB888] = qt_fetchUntransformed_888_neon;
 
+    qMemRotateFunctions[QPixelLayout::BPP32][0] = qt_memrotate90_32_neon;
+    qMemRotateFunctions[QPixelLayout::BPP32][2] = qt_memrotate270_32_neon;
+
 #if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
     extern void QT_FASTCALL convertARGB32ToARGB32PM_neon(uint *buffer, int count, const QList<QRgb> *);
     extern void QT_FASTCALL convertRGBA8888ToARGB32PM_neon(uint *buffer, int count, const QList<QRgb> *);
@@ -40,6 +40,7 @@
 #include <private/qdrawhelper_neon_p.h>
 #include <private/qblendfunctions_p.h>
 #include <private/qmath_p.h>
+#include <private/qmemrotate_p.h>
 #include <private/qpixellayout_p.h>
 
 #ifdef __ARM_NEON__
@@ -1394,6 +1395,27 @@ void QT_FASTCALL storeRGBXFromARGB32PM_neon(uchar *dest, const uint *src, int in
 
 #endif // Q_BYTE_ORDER == Q_LITTLE_ENDIAN
 
+static inline void transpose4x4_32_neon(const quint32 *src, qsizetype sstep,
+                                        quint32 *dest, qsizetype dstep)
+{
+    const uint32x4x2_t t01 = vtrnq_u32(vld1q_u32(src), vld1q_u32(src + sstep));
+    const uint32x4x2_t t23 = vtrnq_u32(vld1q_u32(src + 2 * sstep), vld1q_u32(src + 3 * sstep));
+    vst1q_u32(dest, vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+    vst1q_u32(dest + dstep, vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+    vst1q_u32(dest + 2 * dstep, vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+    vst1q_u32(dest + 3 * dstep, vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+}
+
+void qt_memrotate90_32_neon(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
+{
+    qt_memrotate_32_blocked<90, 4>(srcPixels, w, h, sbpl, destPixels, dbpl, transpose4x4_32_neon);
+}
+
+void qt_memrotate270_32_neon(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
+{
+    qt_memrotate_32_blocked<270, 4>(srcPixels, w, h, sbpl, destPixels, dbpl, transpose4x4_32_neon);
+}
+
 QT_END_NAMESPACE
 
 #endif // __ARM_NEON__
@@ -43,6 +43,7 @@
 #ifdef QT_COMPILER_SUPPORTS_SSE2
 
 #include <private/qdrawingprimitive_sse2_p.h>
+#include <private/qmemrotate_p.h>
 #include <private/qpaintengine_raster_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -650,6 +651,32 @@ void qt_scale_image_argb32_on_argb32_sse2(uchar *destPixels, int dbpl,
     }
 }
 
+static inline void transpose4x4_32_sse2(const quint32 *src, qsizetype sstep,
+                                        quint32 *dest, qsizetype dstep)
+{
+    const __m128i row0 = _mm_loadu_si128((const __m128i *)src);
+    const __m128i row1 = _mm_loadu_si128((const __m128i *)(src + sstep));
+    const __m128i row2 = _mm_loadu_si128((const __m128i *)(src + 2 * sstep));
+    const __m128i row3 = _mm_loadu_si128((const __m128i *)(src + 3 * sstep));
+    const __m128i t0 = _mm_unpacklo_epi32(row0, row1); // 00 10 01 11
+    const __m128i t1 = _mm_unpacklo_epi32(row2, row3); // 20 30 21 31
+    const __m128i t2 = _mm_unpackhi_epi32(row0, row1); // 02 12 03 13
+    const __m128i t3 = _mm_unpackhi_epi32(row2, row3); // 22 32 23 33
+    _mm_storeu_si128((__m128i *)dest, _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i *)(dest + dstep), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i *)(dest + 2 * dstep), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i *)(dest + 3 * dstep), _mm_unpackhi_epi64(t2, t3));
+}
+
+void qt_memrotate90_32_sse2(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
+{
+    qt_memrotate_32_blocked<90, 4>(srcPixels, w, h, sbpl, destPixels, dbpl, transpose4x4_32_sse2);
+}
+
+void qt_memrotate270_32_sse2(const uchar *srcPixels, int w, int h, int sbpl, uchar *destPixels, int dbpl)
+{
+    qt_memrotate_32_blocked<270, 4>(srcPixels, w, h, sbpl, destPixels, dbpl, transpose4x4_32_sse2);
+}
 
 QT_END_NAMESPACE
 
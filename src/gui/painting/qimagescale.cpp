@@ -277,6 +277,18 @@ static void qt_qimageScaleAARGBA_down_x_up_y(QImageScaleInfo *isi, unsigned int
 static void qt_qimageScaleAARGBA_down_xy(QImageScaleInfo *isi, unsigned int *dest,
                                          int dw, int dh, int dow, int sow);
 
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+template<bool RGB>
+void qt_qimageScaleAARGBA_up_x_down_y_avx2(QImageScaleInfo *isi, unsigned int *dest,
+                                           int dw, int dh, int dow, int sow);
+template<bool RGB>
+void qt_qimageScaleAARGBA_down_x_up_y_avx2(QImageScaleInfo *isi, unsigned int *dest,
+                                           int dw, int dh, int dow, int sow);
+template<bool RGB>
+void qt_qimageScaleAARGBA_down_xy_avx2(QImageScaleInfo *isi, unsigned int *dest,
+                                       int dw, int dh, int dow, int sow);
+#endif
+
 #if defined(QT_COMPILER_SUPPORTS_SSE4_1)
 template<bool RGB>
 void qt_qimageScaleAARGBA_up_x_down_y_sse4(QImageScaleInfo *isi, unsigned int *dest,
@@ -377,6 +389,11 @@ static void qt_qimageScaleAARGBA(QImageScaleInfo *isi, unsigned int *dest,
     }
     /* if we're scaling down vertically */
     else if (isi->xup_yup == 1) {
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+        if (qCpuHasFeature(ArchHaswell))
+            qt_qimageScaleAARGBA_up_x_down_y_avx2<false>(isi, dest, dw, dh, dow, sow);
+        else
+#endif
 #ifdef QT_COMPILER_SUPPORTS_SSE4_1
         if (qCpuHasFeature(SSE4_1))
             qt_qimageScaleAARGBA_up_x_down_y_sse4<false>(isi, dest, dw, dh, dow, sow);
@@ -390,6 +407,11 @@ static void qt_qimageScaleAARGBA(QImageScaleInfo *isi, unsigned int *dest,
     }
     /* if we're scaling down horizontally */
     else if (isi->xup_yup == 2) {
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+        if (qCpuHasFeature(ArchHaswell))
+            qt_qimageScaleAARGBA_down_x_up_y_avx2<false>(isi, dest, dw, dh, dow, sow);
+        else
+#endif
 #ifdef QT_COMPILER_SUPPORTS_SSE4_1
         if (qCpuHasFeature(SSE4_1))
             qt_qimageScaleAARGBA_down_x_up_y_sse4<false>(isi, dest, dw, dh, dow, sow);
@@ -403,6 +425,11 @@ static void qt_qimageScaleAARGBA(QImageScaleInfo *isi, unsigned int *dest,
     }
     /* if we're scaling down horizontally & vertically */
     else {
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+        if (qCpuHasFeature(ArchHaswell))
+            qt_qimageScaleAARGBA_down_xy_avx2<false>(isi, dest, dw, dh, dow, sow);
+        else
+#endif
 #ifdef QT_COMPILER_SUPPORTS_SSE4_1
         if (qCpuHasFeature(SSE4_1))
             qt_qimageScaleAARGBA_down_xy_sse4<false>(isi, dest, dw, dh, dow, sow);
@@ -582,6 +609,15 @@ static void qt_qimageScaleRgba64_down_x_up_y(QImageScaleInfo *isi, QRgba64 *dest
 static void qt_qimageScaleRgba64_down_xy(QImageScaleInfo *isi, QRgba64 *dest,
                                          int dw, int dh, int dow, int sow);
 
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+void qt_qimageScaleRgba64_up_x_down_y_avx2(QImageScaleInfo *isi, QRgba64 *dest,
+                                           int dw, int dh, int dow, int sow);
+void qt_qimageScaleRgba64_down_x_up_y_avx2(QImageScaleInfo *isi, QRgba64 *dest,
+                                           int dw, int dh, int dow, int sow);
+void qt_qimageScaleRgba64_down_xy_avx2(QImageScaleInfo *isi, QRgba64 *dest,
+                                       int dw, int dh, int dow, int sow);
+#endif
+
 static void qt_qimageScaleRgba64_up_xy(QImageScaleInfo *isi, QRgba64 *dest,
                                        int dw, int dh, int dow, int sow)
 {
@@ -624,6 +660,17 @@ static void qt_qimageScaleRgba64_up_xy(QImageScaleInfo *isi, QRgba64 *dest,
 void qt_qimageScaleRgba64(QImageScaleInfo *isi, QRgba64 *dest,
                           int dw, int dh, int dow, int sow)
 {
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+    if (isi->xup_yup != 3 && qCpuHasFeature(ArchHaswell)) {
+        if (isi->xup_yup == 1)
+            qt_qimageScaleRgba64_up_x_down_y_avx2(isi, dest, dw, dh, dow, sow);
+        else if (isi->xup_yup == 2)
+            qt_qimageScaleRgba64_down_x_up_y_avx2(isi, dest, dw, dh, dow, sow);
+        else
+            qt_qimageScaleRgba64_down_xy_avx2(isi, dest, dw, dh, dow, sow);
+        return;
+    }
+#endif
     if (isi->xup_yup == 3)
         qt_qimageScaleRgba64_up_xy(isi, dest, dw, dh, dow, sow);
     else if (isi->xup_yup == 1)
@@ -806,6 +853,11 @@ static void qt_qimageScaleAARGB(QImageScaleInfo *isi, unsigned int *dest,
     }
     /* if we're scaling down vertically */
     else if (isi->xup_yup == 1) {
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+        if (qCpuHasFeature(ArchHaswell))
+            qt_qimageScaleAARGBA_up_x_down_y_avx2<true>(isi, dest, dw, dh, dow, sow);
+        else
+#endif
 #ifdef QT_COMPILER_SUPPORTS_SSE4_1
         if (qCpuHasFeature(SSE4_1))
             qt_qimageScaleAARGBA_up_x_down_y_sse4<true>(isi, dest, dw, dh, dow, sow);
@@ -819,6 +871,11 @@ static void qt_qimageScaleAARGB(QImageScaleInfo *isi, unsigned int *dest,
     }
     /* if we're scaling down horizontally */
     else if (isi->xup_yup == 2) {
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+        if (qCpuHasFeature(ArchHaswell))
+            qt_qimageScaleAARGBA_down_x_up_y_avx2<true>(isi, dest, dw, dh, dow, sow);
+        else
+#endif
 #ifdef QT_COMPILER_SUPPORTS_SSE4_1
         if (qCpuHasFeature(SSE4_1))
             qt_qimageScaleAARGBA_down_x_up_y_sse4<true>(isi, dest, dw, dh, dow, sow);
@@ -832,6 +889,11 @@ static void qt_qimageScaleAARGB(QImageScaleInfo *isi, unsigned int *dest,
     }
     /* if we're scaling down horizontally & vertically */
     else {
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+        if (qCpuHasFeature(ArchHaswell))
+            qt_qimageScaleAARGBA_down_xy_avx2<true>(isi, dest, dw, dh, dow, sow);
+        else
+#endif
 #ifdef QT_COMPILER_SUPPORTS_SSE4_1
         if (qCpuHasFeature(SSE4_1))
             qt_qimageScaleAARGBA_down_xy_sse4<true>(isi, dest, dw, dh, dow, sow);
@@ -992,6 +1054,189 @@ static void qt_qimageScaleAARGB_down_xy(QImageScaleInfo *isi, unsigned int *dest
     multithread_pixels_function(isi, dh, scaleSection);
 }
 
+/* scale by area sampling - single channel, 8 or 16 bits */
+
+// The accumulators must hold the largest pixel value times 1 << 24
+template<typename T>
+struct QImageScaleGrayTraits;
+
+template<>
+struct QImageScaleGrayTraits<uchar>
+{
+    using Accumulator = uint;
+};
+
+template<>
+struct QImageScaleGrayTraits<quint16>
+{
+    using Accumulator = quint64;
+};
+
+template<typename T>
+static void qt_qimageScaleAAGray_up_xy(QImageScaleInfo *isi, T *dest,
+                                       int dw, int dh, int dow, int sow)
+{
+    using Acc = typename QImageScaleGrayTraits<T>::Accumulator;
+    const T **ypoints = (const T **)isi->ypoints;
+    int *xpoints = isi->xpoints;
+    int *xapoints = isi->xapoints;
+    int *yapoints = isi->yapoints;
+
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            const T *sptr = ypoints[y];
+            T *dptr = dest + (y * dow);
+            const int yap = yapoints[y];
+            for (int x = 0; x < dw; x++) {
+                const T *pix = sptr + xpoints[x];
+                const int xap = xapoints[x];
+                Acc v = pix[0];
+                if (xap > 0)
+                    v = (v * (256 - xap) + Acc(pix[1]) * xap) >> 8;
+                if (yap > 0) {
+                    Acc vv = pix[sow];
+                    if (xap > 0)
+                        vv = (vv * (256 - xap) + Acc(pix[sow + 1]) * xap) >> 8;
+                    v = (v * (256 - yap) + vv * yap) >> 8;
+                }
+                *dptr++ = T(v);
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+template<typename T>
+inline static typename QImageScaleGrayTraits<T>::Accumulator
+qt_qimageScaleAAGray_helper(const T *pix, int xyap, int Cxy, int step)
+{
+    using Acc = typename QImageScaleGrayTraits<T>::Accumulator;
+    Acc v = Acc(*pix) * xyap;
+    int j;
+    for (j = (1 << 14) - xyap; j > Cxy; j -= Cxy) {
+        pix += step;
+        v += Acc(*pix) * Cxy;
+    }
+    pix += step;
+    v += Acc(*pix) * j;
+    return v;
+}
+
+template<typename T>
+static void qt_qimageScaleAAGray_up_x_down_y(QImageScaleInfo *isi, T *dest,
+                                             int dw, int dh, int dow, int sow)
+{
+    using Acc = typename QImageScaleGrayTraits<T>::Accumulator;
+    const T **ypoints = (const T **)isi->ypoints;
+    int *xpoints = isi->xpoints;
+    int *xapoints = isi->xapoints;
+    int *yapoints = isi->yapoints;
+
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            int Cy = yapoints[y] >> 16;
+            int yap = yapoints[y] & 0xffff;
+
+            T *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                const T *sptr = ypoints[y] + xpoints[x];
+                Acc v = qt_qimageScaleAAGray_helper(sptr, yap, Cy, sow);
+
+                int xap = xapoints[x];
+                if (xap > 0) {
+                    Acc vv = qt_qimageScaleAAGray_helper(sptr + 1, yap, Cy, sow);
+                    v = (v * (256 - xap) + vv * xap) >> 8;
+                }
+                *dptr++ = T(v >> 14);
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+template<typename T>
+static void qt_qimageScaleAAGray_down_x_up_y(QImageScaleInfo *isi, T *dest,
+                                             int dw, int dh, int dow, int sow)
+{
+    using Acc = typename QImageScaleGrayTraits<T>::Accumulator;
+    const T **ypoints = (const T **)isi->ypoints;
+    int *xpoints = isi->xpoints;
+    int *xapoints = isi->xapoints;
+    int *yapoints = isi->yapoints;
+
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            T *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                int Cx = xapoints[x] >> 16;
+                int xap = xapoints[x] & 0xffff;
+
+                const T *sptr = ypoints[y] + xpoints[x];
+                Acc v = qt_qimageScaleAAGray_helper(sptr, xap, Cx, 1);
+
+                int yap = yapoints[y];
+                if (yap > 0) {
+                    Acc vv = qt_qimageScaleAAGray_helper(sptr + sow, xap, Cx, 1);
+                    v = (v * (256 - yap) + vv * yap) >> 8;
+                }
+                *dptr++ = T(v >> 14);
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+template<typename T>
+static void qt_qimageScaleAAGray_down_xy(QImageScaleInfo *isi, T *dest,
+                                         int dw, int dh, int dow, int sow)
+{
+    using Acc = typename QImageScaleGrayTraits<T>::Accumulator;
+    const T **ypoints = (const T **)isi->ypoints;
+    int *xpoints = isi->xpoints;
+    int *xapoints = isi->xapoints;
+    int *yapoints = isi->yapoints;
+
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            int Cy = yapoints[y] >> 16;
+            int yap = yapoints[y] & 0xffff;
+
+            T *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                int Cx = xapoints[x] >> 16;
+                int xap = xapoints[x] & 0xffff;
+
+                const T *sptr = ypoints[y] + xpoints[x];
+                Acc v = (qt_qimageScaleAAGray_helper(sptr, xap, Cx, 1) >> 4) * yap;
+                int j;
+                for (j = (1 << 14) - yap; j > Cy; j -= Cy) {
+                    sptr += sow;
+                    v += (qt_qimageScaleAAGray_helper(sptr, xap, Cx, 1) >> 4) * Cy;
+                }
+                sptr += sow;
+                v += (qt_qimageScaleAAGray_helper(sptr, xap, Cx, 1) >> 4) * j;
+
+                *dptr++ = T(v >> 24);
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+template<typename T>
+static void qt_qimageScaleAAGray(QImageScaleInfo *isi, T *dest,
+                                 int dw, int dh, int dow, int sow)
+{
+    if (isi->xup_yup == 3)
+        qt_qimageScaleAAGray_up_xy(isi, dest, dw, dh, dow, sow);
+    else if (isi->xup_yup == 1)
+        qt_qimageScaleAAGray_up_x_down_y(isi, dest, dw, dh, dow, sow);
+    else if (isi->xup_yup == 2)
+        qt_qimageScaleAAGray_down_x_up_y(isi, dest, dw, dh, dow, sow);
+    else
+        qt_qimageScaleAAGray_down_xy(isi, dest, dw, dh, dow, sow);
+}
+
 QImage qSmoothScaleImage(const QImage &src, int dw, int dh)
 {
     QImage buffer;
@@ -1012,6 +1257,13 @@ QImage qSmoothScaleImage(const QImage &src, int dw, int dh)
         return QImage();
     }
 
+    if (src.format() == QImage::Format_Grayscale8)
+        qt_qimageScaleAAGray<uchar>(scaleinfo, buffer.scanLine(0),
+                                    dw, dh, buffer.bytesPerLine(), src.bytesPerLine());
+    else if (src.format() == QImage::Format_Grayscale16)
+        qt_qimageScaleAAGray<quint16>(scaleinfo, (quint16 *)buffer.scanLine(0),
+                                      dw, dh, buffer.bytesPerLine() / 2, src.bytesPerLine() / 2);
+    else
 #if QT_CONFIG(raster_64bit)
     if (src.depth() > 32)
         qt_qimageScaleRgba64(scaleinfo, (QRgba64 *)buffer.scanLine(0),
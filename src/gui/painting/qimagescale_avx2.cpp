@@ -0,0 +1,500 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qimagescale_p.h"
+#include "qimage.h"
+#include <private/qdrawhelper_x86_p.h>
+#include <private/qsimd_p.h>
+
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+#include "qsemaphore.h"
+#include "qthreadpool.h"
+#endif
+
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+
+QT_BEGIN_NAMESPACE
+
+using namespace QImageScale;
+
+template<typename T>
+static inline void multithread_pixels_function(QImageScaleInfo *isi, int dh, const T &scaleSection)
+{
+#if QT_CONFIG(thread) && !defined(Q_OS_WASM)
+    int segments = (qsizetype(isi->sh) * isi->sw) / (1<<16);
+    segments = std::min(segments, dh);
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    if (segments > 1 && threadPool && !threadPool->contains(QThread::currentThread())) {
+        QSemaphore semaphore;
+        int y = 0;
+        for (int i = 0; i < segments; ++i) {
+            int yn = (dh - y) / (segments - i);
+            threadPool->start([&, y, yn]() {
+                scaleSection(y, y + yn);
+                semaphore.release(1);
+            });
+            y += yn;
+        }
+        semaphore.acquire(segments);
+        return;
+    }
+#endif
+    scaleSection(0, dh);
+}
+
+/*
+  The kernels in this file compute exactly the same sums as the generic and
+  SSE4.1 ones, but filter two source pixels, or two source rows, at once:
+  the first one in the low 128-bit lane and the second one in the high lane.
+*/
+
+// Walks the source rows of one destination pixel with the weights used by
+// the generic down_xy kernels: yap for the first row, Cy for as long as more
+// than Cy is left, and what remains for the last row. Rows are handed out in
+// pairs, the last one on its own if their number is odd.
+template<typename T, typename PairFunction, typename SingleFunction>
+static inline void walk_rows(const T *sptr, int sow, int yap, int Cy,
+                             const PairFunction &pair, const SingleFunction &single)
+{
+    int w = yap;
+    int j = (1 << 14) - yap;
+    bool last = false;
+    const auto advance = [&]() {
+        if (j > Cy) {
+            w = Cy;
+            j -= Cy;
+        } else {
+            w = j;
+            last = true;
+        }
+    };
+    for (;;) {
+        if (last) {
+            single(sptr, w);
+            return;
+        }
+        const int w0 = w;
+        advance();
+        pair(sptr, w0, w);
+        if (last)
+            return;
+        sptr += 2 * sow;
+        advance();
+    }
+}
+
+inline static __m128i Q_DECL_VECTORCALL
+qt_qimageScaleAARGBA_helper(const unsigned int *pix, int xyap, int Cxy, int step, const __m128i vxyap, const __m128i vCxy)
+{
+    __m128i vpix = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*pix));
+    __m128i vx = _mm_mullo_epi32(vpix, vxyap);
+    int i;
+    for (i = (1 << 14) - xyap; i > Cxy; i -= Cxy) {
+        pix += step;
+        vpix = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*pix));
+        vx = _mm_add_epi32(vx, _mm_mullo_epi32(vpix, vCxy));
+    }
+    pix += step;
+    vpix = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*pix));
+    vx = _mm_add_epi32(vx, _mm_mullo_epi32(vpix, _mm_set1_epi32(i)));
+    return vx;
+}
+
+inline static __m256i Q_DECL_VECTORCALL
+qt_qimageScaleAARGBA_helper_x2(const unsigned int *pix, qsizetype offset, int xyap, int Cxy, int step,
+                               const __m256i vxyap, const __m256i vCxy)
+{
+    const auto load = [offset](const unsigned int *p) {
+        return _mm256_cvtepu8_epi32(_mm_unpacklo_epi32(_mm_cvtsi32_si128(p[0]), _mm_cvtsi32_si128(p[offset])));
+    };
+    __m256i vx = _mm256_mullo_epi32(load(pix), vxyap);
+    int i;
+    for (i = (1 << 14) - xyap; i > Cxy; i -= Cxy) {
+        pix += step;
+        vx = _mm256_add_epi32(vx, _mm256_mullo_epi32(load(pix), vCxy));
+    }
+    pix += step;
+    vx = _mm256_add_epi32(vx, _mm256_mullo_epi32(load(pix), _mm256_set1_epi32(i)));
+    return vx;
+}
+
+// Blends the two lanes of vx with the weights 256 - ap and ap
+inline static __m128i Q_DECL_VECTORCALL qt_qimageScaleAARGBA_blend(__m256i vx, int ap)
+{
+    vx = _mm256_mullo_epi32(vx, _mm256_setr_epi32(256 - ap, 256 - ap, 256 - ap, 256 - ap, ap, ap, ap, ap));
+    const __m128i v = _mm_add_epi32(_mm256_castsi256_si128(vx), _mm256_extracti128_si256(vx, 1));
+    return _mm_srli_epi32(v, 8);
+}
+
+inline static unsigned int Q_DECL_VECTORCALL qt_qimageScaleAARGBA_pack(__m128i vx)
+{
+    vx = _mm_packus_epi32(vx, vx);
+    vx = _mm_packus_epi16(vx, vx);
+    return _mm_cvtsi128_si32(vx);
+}
+
+template<bool RGB>
+void qt_qimageScaleAARGBA_up_x_down_y_avx2(QImageScaleInfo *isi, unsigned int *dest,
+                                           int dw, int dh, int dow, int sow)
+{
+    const unsigned int **ypoints = isi->ypoints;
+    const int *xpoints = isi->xpoints;
+    const int *xapoints = isi->xapoints;
+    const int *yapoints = isi->yapoints;
+
+    /* go through every scanline in the output buffer */
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            const int Cy = yapoints[y] >> 16;
+            const int yap = yapoints[y] & 0xffff;
+            const __m256i vCy = _mm256_set1_epi32(Cy);
+            const __m256i vyap = _mm256_set1_epi32(yap);
+
+            unsigned int *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                const unsigned int *sptr = ypoints[y] + xpoints[x];
+                const int xap = xapoints[x];
+                __m128i vx;
+                if (xap > 0) {
+                    // filter the column of the pixel and the one to its right together
+                    const __m256i vxx = qt_qimageScaleAARGBA_helper_x2(sptr, 1, yap, Cy, sow, vyap, vCy);
+                    vx = qt_qimageScaleAARGBA_blend(vxx, xap);
+                } else {
+                    vx = qt_qimageScaleAARGBA_helper(sptr, yap, Cy, sow,
+                                                     _mm256_castsi256_si128(vyap),
+                                                     _mm256_castsi256_si128(vCy));
+                }
+                *dptr = qt_qimageScaleAARGBA_pack(_mm_srli_epi32(vx, 14));
+                if (RGB)
+                    *dptr |= 0xff000000;
+                dptr++;
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+template<bool RGB>
+void qt_qimageScaleAARGBA_down_x_up_y_avx2(QImageScaleInfo *isi, unsigned int *dest,
+                                           int dw, int dh, int dow, int sow)
+{
+    const unsigned int **ypoints = isi->ypoints;
+    const int *xpoints = isi->xpoints;
+    const int *xapoints = isi->xapoints;
+    const int *yapoints = isi->yapoints;
+
+    /* go through every scanline in the output buffer */
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            const int yap = yapoints[y];
+            unsigned int *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                const int Cx = xapoints[x] >> 16;
+                const int xap = xapoints[x] & 0xffff;
+
+                const unsigned int *sptr = ypoints[y] + xpoints[x];
+                __m128i vx;
+                if (yap > 0) {
+                    // filter the row of the pixel and the one below it together
+                    const __m256i vxx = qt_qimageScaleAARGBA_helper_x2(sptr, sow, xap, Cx, 1,
+                                                                       _mm256_set1_epi32(xap),
+                                                                       _mm256_set1_epi32(Cx));
+                    vx = qt_qimageScaleAARGBA_blend(vxx, yap);
+                } else {
+                    vx = qt_qimageScaleAARGBA_helper(sptr, xap, Cx, 1,
+                                                     _mm_set1_epi32(xap), _mm_set1_epi32(Cx));
+                }
+                *dptr = qt_qimageScaleAARGBA_pack(_mm_srli_epi32(vx, 14));
+                if (RGB)
+                    *dptr |= 0xff000000;
+                dptr++;
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+template<bool RGB>
+void qt_qimageScaleAARGBA_down_xy_avx2(QImageScaleInfo *isi, unsigned int *dest,
+                                       int dw, int dh, int dow, int sow)
+{
+    const unsigned int **ypoints = isi->ypoints;
+    const int *xpoints = isi->xpoints;
+    const int *xapoints = isi->xapoints;
+    const int *yapoints = isi->yapoints;
+
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            const int Cy = yapoints[y] >> 16;
+            const int yap = yapoints[y] & 0xffff;
+
+            unsigned int *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                const int Cx = xapoints[x] >> 16;
+                const int xap = xapoints[x] & 0xffff;
+                const __m256i vCx = _mm256_set1_epi32(Cx);
+                const __m256i vxap = _mm256_set1_epi32(xap);
+
+                __m256i vr2 = _mm256_setzero_si256();
+                __m128i vr = _mm_setzero_si128();
+                const auto pair = [&](const unsigned int *sptr, int w0, int w1) {
+                    __m256i vx = qt_qimageScaleAARGBA_helper_x2(sptr, sow, xap, Cx, 1, vxap, vCx);
+                    vx = _mm256_mullo_epi32(_mm256_srli_epi32(vx, 4),
+                                            _mm256_setr_epi32(w0, w0, w0, w0, w1, w1, w1, w1));
+                    vr2 = _mm256_add_epi32(vr2, vx);
+                };
+                const auto single = [&](const unsigned int *sptr, int w) {
+                    const __m128i vx = qt_qimageScaleAARGBA_helper(sptr, xap, Cx, 1,
+                                                                   _mm256_castsi256_si128(vxap),
+                                                                   _mm256_castsi256_si128(vCx));
+                    vr = _mm_mullo_epi32(_mm_srli_epi32(vx, 4), _mm_set1_epi32(w));
+                };
+                walk_rows(ypoints[y] + xpoints[x], sow, yap, Cy, pair, single);
+
+                vr = _mm_add_epi32(vr, _mm256_castsi256_si128(vr2));
+                vr = _mm_add_epi32(vr, _mm256_extracti128_si256(vr2, 1));
+                *dptr = qt_qimageScaleAARGBA_pack(_mm_srli_epi32(vr, 24));
+                if (RGB)
+                    *dptr |= 0xff000000;
+                dptr++;
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+template void qt_qimageScaleAARGBA_up_x_down_y_avx2<false>(QImageScaleInfo *isi, unsigned int *dest,
+                                                           int dw, int dh, int dow, int sow);
+
+template void qt_qimageScaleAARGBA_up_x_down_y_avx2<true>(QImageScaleInfo *isi, unsigned int *dest,
+                                                          int dw, int dh, int dow, int sow);
+
+template void qt_qimageScaleAARGBA_down_x_up_y_avx2<false>(QImageScaleInfo *isi, unsigned int *dest,
+                                                           int dw, int dh, int dow, int sow);
+
+template void qt_qimageScaleAARGBA_down_x_up_y_avx2<true>(QImageScaleInfo *isi, unsigned int *dest,
+                                                          int dw, int dh, int dow, int sow);
+
+template void qt_qimageScaleAARGBA_down_xy_avx2<false>(QImageScaleInfo *isi, unsigned int *dest,
+                                                       int dw, int dh, int dow, int sow);
+
+template void qt_qimageScaleAARGBA_down_xy_avx2<true>(QImageScaleInfo *isi, unsigned int *dest,
+                                                      int dw, int dh, int dow, int sow);
+
+#if QT_CONFIG(raster_64bit)
+// The 16-bit channels are summed in 32-bit lanes like the 8-bit ones, since
+// the filter weights add up to 1 << 14, but the blending of those sums needs
+// 64-bit lanes.
+
+inline static __m128i Q_DECL_VECTORCALL
+qt_qimageScaleRgba64_helper(const QRgba64 *pix, int xyap, int Cxy, int step, const __m128i vxyap, const __m128i vCxy)
+{
+    const auto load = [](const QRgba64 *p) {
+        return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+    };
+    __m128i vx = _mm_mullo_epi32(load(pix), vxyap);
+    int i;
+    for (i = (1 << 14) - xyap; i > Cxy; i -= Cxy) {
+        pix += step;
+        vx = _mm_add_epi32(vx, _mm_mullo_epi32(load(pix), vCxy));
+    }
+    pix += step;
+    vx = _mm_add_epi32(vx, _mm_mullo_epi32(load(pix), _mm_set1_epi32(i)));
+    return vx;
+}
+
+inline static __m256i Q_DECL_VECTORCALL
+qt_qimageScaleRgba64_helper_x2(const QRgba64 *pix, qsizetype offset, int xyap, int Cxy, int step,
+                               const __m256i vxyap, const __m256i vCxy)
+{
+    const auto load = [offset](const QRgba64 *p) {
+        const __m128i p0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+        const __m128i p1 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p + offset));
+        return _mm256_cvtepu16_epi32(_mm_unpacklo_epi64(p0, p1));
+    };
+    __m256i vx = _mm256_mullo_epi32(load(pix), vxyap);
+    int i;
+    for (i = (1 << 14) - xyap; i > Cxy; i -= Cxy) {
+        pix += step;
+        vx = _mm256_add_epi32(vx, _mm256_mullo_epi32(load(pix), vCxy));
+    }
+    pix += step;
+    vx = _mm256_add_epi32(vx, _mm256_mullo_epi32(load(pix), _mm256_set1_epi32(i)));
+    return vx;
+}
+
+// Multiplies the low and high lanes of vx by w0 and w1, widening to 64 bits
+inline static __m256i Q_DECL_VECTORCALL qt_qimageScaleRgba64_weigh(__m256i vx, int w0, int w1)
+{
+    const __m256i lo = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(vx));
+    const __m256i hi = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(vx, 1));
+    return _mm256_add_epi64(_mm256_mul_epu32(lo, _mm256_set1_epi64x(w0)),
+                            _mm256_mul_epu32(hi, _mm256_set1_epi64x(w1)));
+}
+
+inline static QRgba64 Q_DECL_VECTORCALL qt_qimageScaleRgba64_pack(__m128i vx)
+{
+    vx = _mm_packus_epi32(vx, vx);
+    QRgba64 result;
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(&result), vx);
+    return result;
+}
+
+inline static QRgba64 Q_DECL_VECTORCALL qt_qimageScaleRgba64_pack(__m256i vx)
+{
+    // the four channels are in the low halves of the 64-bit lanes
+    vx = _mm256_permutevar8x32_epi32(vx, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+    return qt_qimageScaleRgba64_pack(_mm256_castsi256_si128(vx));
+}
+
+void qt_qimageScaleRgba64_up_x_down_y_avx2(QImageScaleInfo *isi, QRgba64 *dest,
+                                           int dw, int dh, int dow, int sow)
+{
+    const QRgba64 **ypoints = (const QRgba64 **)isi->ypoints;
+    const int *xpoints = isi->xpoints;
+    const int *xapoints = isi->xapoints;
+    const int *yapoints = isi->yapoints;
+
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            const int Cy = yapoints[y] >> 16;
+            const int yap = yapoints[y] & 0xffff;
+            const __m256i vCy = _mm256_set1_epi32(Cy);
+            const __m256i vyap = _mm256_set1_epi32(yap);
+
+            QRgba64 *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                const QRgba64 *sptr = ypoints[y] + xpoints[x];
+                const int xap = xapoints[x];
+                if (xap > 0) {
+                    __m256i vx = qt_qimageScaleRgba64_helper_x2(sptr, 1, yap, Cy, sow, vyap, vCy);
+                    vx = qt_qimageScaleRgba64_weigh(vx, 256 - xap, xap);
+                    *dptr++ = qt_qimageScaleRgba64_pack(_mm256_srli_epi64(vx, 8 + 14));
+                } else {
+                    const __m128i vx = qt_qimageScaleRgba64_helper(sptr, yap, Cy, sow,
+                                                                   _mm256_castsi256_si128(vyap),
+                                                                   _mm256_castsi256_si128(vCy));
+                    *dptr++ = qt_qimageScaleRgba64_pack(_mm_srli_epi32(vx, 14));
+                }
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+void qt_qimageScaleRgba64_down_x_up_y_avx2(QImageScaleInfo *isi, QRgba64 *dest,
+                                           int dw, int dh, int dow, int sow)
+{
+    const QRgba64 **ypoints = (const QRgba64 **)isi->ypoints;
+    const int *xpoints = isi->xpoints;
+    const int *xapoints = isi->xapoints;
+    const int *yapoints = isi->yapoints;
+
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            const int yap = yapoints[y];
+            QRgba64 *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                const int Cx = xapoints[x] >> 16;
+                const int xap = xapoints[x] & 0xffff;
+
+                const QRgba64 *sptr = ypoints[y] + xpoints[x];
+                if (yap > 0) {
+                    __m256i vx = qt_qimageScaleRgba64_helper_x2(sptr, sow, xap, Cx, 1,
+                                                                _mm256_set1_epi32(xap),
+                                                                _mm256_set1_epi32(Cx));
+                    vx = qt_qimageScaleRgba64_weigh(vx, 256 - yap, yap);
+                    *dptr++ = qt_qimageScaleRgba64_pack(_mm256_srli_epi64(vx, 8 + 14));
+                } else {
+                    const __m128i vx = qt_qimageScaleRgba64_helper(sptr, xap, Cx, 1,
+                                                                   _mm_set1_epi32(xap),
+                                                                   _mm_set1_epi32(Cx));
+                    *dptr++ = qt_qimageScaleRgba64_pack(_mm_srli_epi32(vx, 14));
+                }
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+
+void qt_qimageScaleRgba64_down_xy_avx2(QImageScaleInfo *isi, QRgba64 *dest,
+                                       int dw, int dh, int dow, int sow)
+{
+    const QRgba64 **ypoints = (const QRgba64 **)isi->ypoints;
+    const int *xpoints = isi->xpoints;
+    const int *xapoints = isi->xapoints;
+    const int *yapoints = isi->yapoints;
+
+    auto scaleSection = [&] (int yStart, int yEnd) {
+        for (int y = yStart; y < yEnd; ++y) {
+            const int Cy = yapoints[y] >> 16;
+            const int yap = yapoints[y] & 0xffff;
+
+            QRgba64 *dptr = dest + (y * dow);
+            for (int x = 0; x < dw; x++) {
+                const int Cx = xapoints[x] >> 16;
+                const int xap = xapoints[x] & 0xffff;
+                const __m256i vCx = _mm256_set1_epi32(Cx);
+                const __m256i vxap = _mm256_set1_epi32(xap);
+
+                __m256i vr = _mm256_setzero_si256();
+                const auto pair = [&](const QRgba64 *sptr, int w0, int w1) {
+                    const __m256i vx = qt_qimageScaleRgba64_helper_x2(sptr, sow, xap, Cx, 1, vxap, vCx);
+                    vr = _mm256_add_epi64(vr, qt_qimageScaleRgba64_weigh(vx, w0, w1));
+                };
+                const auto single = [&](const QRgba64 *sptr, int w) {
+                    const __m128i vx = qt_qimageScaleRgba64_helper(sptr, xap, Cx, 1,
+                                                                   _mm256_castsi256_si128(vxap),
+                                                                   _mm256_castsi256_si128(vCx));
+                    vr = _mm256_add_epi64(vr, _mm256_mul_epu32(_mm256_cvtepu32_epi64(vx),
+                                                               _mm256_set1_epi64x(w)));
+                };
+                walk_rows(ypoints[y] + xpoints[x], sow, yap, Cy, pair, single);
+
+                *dptr++ = qt_qimageScaleRgba64_pack(_mm256_srli_epi64(vr, 28));
+            }
+        }
+    };
+    multithread_pixels_function(isi, dh, scaleSection);
+}
+#endif // QT_CONFIG(raster_64bit)
+
+QT_END_NAMESPACE
+
+#endif
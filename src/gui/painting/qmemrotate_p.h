@@ -69,6 +69,60 @@ QT_DECL_MEMROTATE(quint64);
 
 #undef QT_DECL_MEMROTATE
 
+// Rotates 32-bit pixels by 90 or 270 degrees a block of BlockSize x BlockSize
+// pixels at a time. transposeBlock(s, sstep, d, dstep) loads BlockSize rows
+// of BlockSize pixels starting at s, sstep pixels apart, and stores their
+// transpose as BlockSize rows starting at d, dstep pixels apart. The pixels
+// left over at the right and bottom edges are rotated one by one.
+template <int Angle, int BlockSize, typename TransposeBlock>
+inline void qt_memrotate_32_blocked(const uchar *srcPixels, int w, int h, int sbpl,
+                                    uchar *destPixels, int dbpl, TransposeBlock transposeBlock)
+{
+    static_assert(Angle == 90 || Angle == 270);
+    const quint32 *src = reinterpret_cast<const quint32 *>(srcPixels);
+    quint32 *dest = reinterpret_cast<quint32 *>(destPixels);
+    const qsizetype sstride = sbpl / sizeof(quint32);
+    const qsizetype dstride = dbpl / sizeof(quint32);
+    const auto rotatePixel = [&](int x, int y) {
+        if (Angle == 90)
+            dest[(w - 1 - x) * dstride + y] = src[y * sstride + x];
+        else
+            dest[x * dstride + h - 1 - y] = src[y * sstride + x];
+    };
+
+    constexpr int tileSize = 32;
+    static_assert(tileSize % BlockSize == 0);
+    const int blockedWidth = w - w % BlockSize;
+    const int blockedHeight = h - h % BlockSize;
+
+    for (int ty = 0; ty < blockedHeight; ty += tileSize) {
+        const int stopy = qMin(ty + tileSize, blockedHeight);
+        for (int tx = 0; tx < blockedWidth; tx += tileSize) {
+            const int stopx = qMin(tx + tileSize, blockedWidth);
+            for (int y = ty; y < stopy; y += BlockSize) {
+                for (int x = tx; x < stopx; x += BlockSize) {
+                    if (Angle == 90) {
+                        transposeBlock(src + y * sstride + x, sstride,
+                                       dest + (w - 1 - x) * dstride + y, -dstride);
+                    } else {
+                        transposeBlock(src + (y + BlockSize - 1) * sstride + x, -sstride,
+                                       dest + x * dstride + h - BlockSize - y, dstride);
+                    }
+                }
+            }
+        }
+    }
+
+    for (int y = 0; y < blockedHeight; ++y) {
+        for (int x = blockedWidth; x < w; ++x)
+            rotatePixel(x, y);
+    }
+    for (int y = blockedHeight; y < h; ++y) {
+        for (int x = 0; x < w; ++x)
+            rotatePixel(x, y);
+    }
+}
+
 QT_END_NAMESPACE
 
 #endif // QMEMROTATE_P_H
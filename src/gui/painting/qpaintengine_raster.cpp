@@ -1084,7 +1084,8 @@ void QRasterPaintEnginePrivate::systemStateChanged()
 
     if (!systemClip.isEmpty()) {
         QRegion clippedDeviceRgn = systemClip & deviceRectUnclipped;
-        deviceRect = clippedDeviceRgn.boundingRect();
+        deviceRect = deviceRectIgnoresSystemClip ? deviceRectUnclipped
+                                                 : clippedDeviceRgn.boundingRect();
         baseClip->setClipRegion(clippedDeviceRgn);
     } else {
         deviceRect = deviceRectUnclipped;
@@ -3563,9 +3564,13 @@ void QRasterPaintEnginePrivate::initializeRasterizer(QSpanData *data)
 
     const QClipData *c = clip();
     if (c) {
-        const QRect r(QPoint(c->xmin, c->ymin),
-                      QSize(c->xmax - c->xmin, c->ymax - c->ymin));
-        clipRect = clipRect.intersected(r);
+        // A band rasterized like the whole device leaves the system clip
+        // to the clipping blend function
+        if (!deviceRectIgnoresSystemClip || c != baseClip.data()) {
+            const QRect r(QPoint(c->xmin, c->ymin),
+                          QSize(c->xmax - c->xmin, c->ymax - c->ymin));
+            clipRect = clipRect.intersected(r);
+        }
         blend = data->blend;
     } else {
         blend = data->unclipped_blend;
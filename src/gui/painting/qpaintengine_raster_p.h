@@ -318,6 +318,9 @@ public:
 
     QRect deviceRect;
     QRect deviceRectUnclipped;
+    // When set, the system clip is only applied when blending, and
+    // rasterization is done exactly as without a system clip
+    bool deviceRectIgnoresSystemClip = false;
 
     QStroker basicStroker;
     QScopedPointer<QDashStroker> dashStroker;
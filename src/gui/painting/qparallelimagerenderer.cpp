@@ -0,0 +1,277 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtGui module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qparallelimagerenderer.h"
+
+#ifndef QT_NO_PICTURE
+
+#include <qimage.h>
+#include <qpaintengine.h>
+#include <qpainter.h>
+#include <qpicture.h>
+#include <qregion.h>
+#include <private/qpaintengine_raster_p.h>
+
+#if QT_CONFIG(thread)
+#include <qatomic.h>
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+#if QT_CONFIG(thread)
+#ifdef Q_OS_WASM
+// WebAssembly has threads; however we can't block the main thread.
+#else
+#define QT_USE_THREAD_PARALLEL_RENDERING
+#endif
+#endif
+
+// Every band replays the complete picture, so bands that are too thin spend
+// more time on parsing and transforming the commands than on rasterizing.
+static const int MinimumBandHeight = 64;
+
+class QParallelImageRendererPrivate
+{
+public:
+    int bandCount = 0;
+    QThreadPool *threadPool = nullptr;
+};
+
+/*!
+    \class QParallelImageRenderer
+    \inmodule QtGui
+    \since 6.0
+    \ingroup painting
+
+    \brief The QParallelImageRenderer class renders recorded painter commands
+    into a QImage using multiple threads.
+
+    Rasterizing into a large QImage with QPainter uses a single thread, no
+    matter how many cores are available. QParallelImageRenderer splits the
+    image into horizontal bands, and replays a QPicture into each band on a
+    thread of a QThreadPool. Each band is rasterized and blended with the
+    regular raster paint engine, clipped to the band, so the result is the
+    same as when painting the picture with a single QPainter:
+
+    \snippet code/src_gui_painting_qparallelimagerenderer.cpp 0
+
+    Since every band replays all the commands of the picture, the speedup
+    depends on the ratio of the time spent rasterizing pixels to the time
+    spent processing commands. It is largest for big images with large,
+    antialiased, or transformed primitives.
+
+    The commands are replayed in worker threads, so the picture should not
+    contain QPixmap based commands such as QPainter::drawPixmap() on
+    platforms that do not support pixmaps outside of the GUI thread; use
+    QPainter::drawImage() instead.
+
+    \sa QPicture, QPainter, QImage
+*/
+
+/*!
+    Constructs a renderer that uses an automatic number of bands and the
+    global thread pool.
+*/
+QParallelImageRenderer::QParallelImageRenderer()
+    : d_ptr(new QParallelImageRendererPrivate)
+{
+}
+
+/*!
+    Destroys the renderer.
+*/
+QParallelImageRenderer::~QParallelImageRenderer()
+{
+}
+
+/*!
+    Sets the number of bands the image is split into to \a count.
+
+    If \a count is 0, which is the default, one band per thread of the
+    threadPool() is used. Bands are never made lower than 64 pixels; if the
+    image is too small to be split, it is rendered in the calling thread.
+
+    \sa bandCount()
+*/
+void QParallelImageRenderer::setBandCount(int count)
+{
+    Q_D(QParallelImageRenderer);
+    d->bandCount = qMax(count, 0);
+}
+
+/*!
+    Returns the number of bands the image is split into, or 0 if it is
+    chosen automatically.
+
+    \sa setBandCount()
+*/
+int QParallelImageRenderer::bandCount() const
+{
+    Q_D(const QParallelImageRenderer);
+    return d->bandCount;
+}
+
+/*!
+    Sets the thread pool that renders the bands to \a pool. If \a pool is
+    \nullptr, which is the default, QThreadPool::globalInstance() is used.
+
+    \sa threadPool()
+*/
+void QParallelImageRenderer::setThreadPool(QThreadPool *pool)
+{
+    Q_D(QParallelImageRenderer);
+    d->threadPool = pool;
+}
+
+/*!
+    Returns the thread pool that renders the bands, or \nullptr if the
+    global thread pool is used.
+
+    \sa setThreadPool()
+*/
+QThreadPool *QParallelImageRenderer::threadPool() const
+{
+    Q_D(const QParallelImageRenderer);
+    return d->threadPool;
+}
+
+static bool playPicture(QImage *image, const QPicture &picture)
+{
+    QPainter painter(image);
+    QPicture player = picture;
+    return player.play(&painter);
+}
+
+#ifdef QT_USE_THREAD_PARALLEL_RENDERING
+static bool playPictureInBand(const QImage &image, uchar *bits,
+                              const QPicture &picture, const QRect &band)
+{
+    // All bands share the pixels of the image, but each of them gets its own
+    // paint device and engine, restricted to the band by a system clip that
+    // the clipping in the picture cannot extend. The raster engine is told to
+    // rasterize as for the whole image, as primitives crossing the band
+    // borders would otherwise be rounded differently than when painted
+    // serially.
+    QImage device(bits, image.width(), image.height(), image.bytesPerLine(), image.format());
+    if (image.colorCount() > 0)
+        device.setColorTable(image.colorTable());
+    device.setDotsPerMeterX(image.dotsPerMeterX());
+    device.setDotsPerMeterY(image.dotsPerMeterY());
+    device.setDevicePixelRatio(image.devicePixelRatio());
+    QPaintEngine *engine = device.paintEngine();
+    if (engine->type() == QPaintEngine::Raster)
+        static_cast<QRasterPaintEnginePrivate *>(QPaintEnginePrivate::get(engine))->deviceRectIgnoresSystemClip = true;
+    engine->setSystemClip(QRegion(band));
+
+    // QPicture::play() is not reentrant, so each band parses its own copy
+    QPicture player;
+    player.setData(picture.data(), picture.size());
+    player.setBoundingRect(picture.boundingRect());
+    QPainter painter(&device);
+    return player.play(&painter);
+}
+#endif
+
+/*!
+    Renders \a picture into \a image, and returns \c true on success;
+    otherwise returns \c false.
+
+    The result is the same as when the picture is played on a QPainter that
+    is opened on the image:
+
+    \snippet code/src_gui_painting_qparallelimagerenderer.cpp 1
+
+    This function returns once all the bands are rendered. If it is called
+    from a thread of the threadPool(), the image is rendered in the calling
+    thread.
+*/
+bool QParallelImageRenderer::render(QImage *image, const QPicture &picture)
+{
+    Q_D(const QParallelImageRenderer);
+    if (!image || image->isNull())
+        return false;
+    if (picture.isNull())
+        return true;
+
+#ifdef QT_USE_THREAD_PARALLEL_RENDERING
+    QThreadPool *threadPool = d->threadPool ? d->threadPool : QThreadPool::globalInstance();
+    int bands = d->bandCount;
+    if (bands == 0 && threadPool)
+        bands = threadPool->maxThreadCount();
+    bands = qMin(bands, image->height() / MinimumBandHeight);
+
+    // let QPainter report the images it cannot paint on
+    if (bands <= 1 || !threadPool || threadPool->contains(QThread::currentThread())
+        || image->format() == QImage::Format_Indexed8 || image->paintingActive()) {
+        return playPicture(image, picture);
+    }
+
+    uchar *bits = image->bits(); // detach before the bands share the pixels
+    QAtomicInt failures;
+    QSemaphore semaphore;
+    QList<QRect> rects;
+    rects.reserve(bands);
+    for (int i = 0, y = 0; i < bands; ++i) {
+        const int yn = (image->height() - y) / (bands - i);
+        rects.append(QRect(0, y, image->width(), yn));
+        y += yn;
+    }
+    for (int i = 1; i < bands; ++i) {
+        threadPool->start([&, i]() {
+            if (!playPictureInBand(*image, bits, picture, rects.at(i)))
+                failures.ref();
+            semaphore.release(1);
+        });
+    }
+    if (!playPictureInBand(*image, bits, picture, rects.at(0)))
+        failures.ref();
+    semaphore.acquire(bands - 1);
+    return failures.loadRelaxed() == 0;
+#else
+    Q_UNUSED(d);
+    return playPicture(image, picture);
+#endif
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_PICTURE
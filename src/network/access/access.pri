@@ -89,7 +89,8 @@ qtConfig(http) {
         access/qhttpprotocolhandler.cpp \
         access/qhttpthreaddelegate.cpp \
         access/qnetworkreplyhttpimpl.cpp \
-        access/qhttp2configuration.cpp
+        access/qhttp2configuration.cpp \
+        access/qhttpconnectionpoolconfiguration.cpp
 
     HEADERS += \
         access/qdecompresshelper_p.h \
@@ -105,7 +106,8 @@ qtConfig(http) {
         access/qhttpprotocolhandler_p.h \
         access/qhttpthreaddelegate_p.h \
         access/qnetworkreplyhttpimpl_p.h \
-        access/qhttp2configuration.h
+        access/qhttp2configuration.h \
+        access/qhttpconnectionpoolconfiguration.h
 
     qtConfig(brotli) {
         QMAKE_USE_PRIVATE += brotli
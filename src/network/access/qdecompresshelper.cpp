@@ -391,6 +391,38 @@ qsizetype QDecompressHelper::read(char *data, qsizetype maxSize)
     return bytesRead;
 }
 
+/*!
+    \internal
+    Decompresses all the data currently available and appends it to \a out
+    in chunks of up to 64 KiB, which avoids the per-block overhead of
+    repeatedly calling read() with a small buffer.
+
+    Returns the number of decompressed bytes appended to \a out, or -1 if an
+    error occurred or the data looks like an archive bomb.
+*/
+qint64 QDecompressHelper::readAll(QByteDataBuffer *out)
+{
+    Q_ASSERT(out);
+    constexpr qsizetype ChunkSize = 64 * 1024;
+
+    qint64 total = 0;
+    while (hasData()) {
+        QByteArray output(ChunkSize, Qt::Uninitialized);
+        const qsizetype bytesRead = read(output.data(), output.size());
+        if (bytesRead < 0)
+            return -1;
+        if (bytesRead == 0)
+            break;
+        output.resize(bytesRead);
+        // Don't keep a mostly empty chunk alive in the reply's buffer
+        if (bytesRead < ChunkSize / 4)
+            output.squeeze();
+        out->append(std::move(output));
+        total += bytesRead;
+    }
+    return total;
+}
+
 /*!
     \internal
     Disables or enables checking the decompression ratio of archives
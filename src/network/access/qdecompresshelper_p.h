@@ -86,6 +86,7 @@ public:
     void feed(const QByteDataBuffer &buffer);
     void feed(QByteDataBuffer &&buffer);
     qsizetype read(char *data, qsizetype maxSize);
+    qint64 readAll(QByteDataBuffer *out);
 
     bool isValid() const;
 
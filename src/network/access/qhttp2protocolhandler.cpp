@@ -407,6 +407,7 @@ bool QHttp2ProtocolHandler::sendRequest()
             deleteActiveStream(newStreamID);
             continue;
         }
+        m_channel->countSentRequest();
 
         if (newStream.data() && !sendDATA(newStream)) {
             finishStreamWithError(newStream, QNetworkReply::UnknownNetworkError,
@@ -615,7 +616,12 @@ void QHttp2ProtocolHandler::handleDATA()
             // Uncompress data if needed and append it ...
             updateStream(stream, inboundFrame);
 
-            if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM)) {
+            if (stream.state == Stream::closed) {
+                // Decompressing the body failed, the reply is already finished.
+                sendRST_STREAM(streamID, INTERNAL_ERROR);
+                markAsReset(streamID);
+                deleteActiveStream(streamID);
+            } else if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM)) {
                 finishStream(stream);
                 deleteActiveStream(stream.streamID);
             } else if (stream.recvWindow < streamInitialReceiveWindowSize / 2) {
@@ -1215,13 +1221,10 @@ void QHttp2ProtocolHandler::updateStream(Stream &stream, const Frame &frame,
             Q_ASSERT(replyPrivate->decompressHelper.isValid());
 
             replyPrivate->decompressHelper.feed(wrapped);
-            while (replyPrivate->decompressHelper.hasData()) {
-                QByteArray output(4 * 1024, Qt::Uninitialized);
-                qint64 read = replyPrivate->decompressHelper.read(output.data(), output.size());
-                if (read > 0) {
-                    output.resize(read);
-                    replyPrivate->responseData.append(std::move(output));
-                }
+            if (replyPrivate->decompressHelper.readAll(&replyPrivate->responseData) < 0) {
+                finishStreamWithError(stream, QNetworkReply::ProtocolFailure,
+                                      QLatin1String("data decompression failed"));
+                return;
             }
         } else {
             replyPrivate->responseData.append(wrapped);
@@ -1553,10 +1556,17 @@ void QHttp2ProtocolHandler::initReplyFromPushPromise(const HttpMessagePair &mess
     if (!promise.responseHeader.empty())
         updateStream(*promisedStream, promise.responseHeader, Qt::QueuedConnection);
 
-    for (const auto &frame : promise.dataFrames)
+    for (const auto &frame : promise.dataFrames) {
         updateStream(*promisedStream, frame, Qt::QueuedConnection);
+        if (promisedStream->state == Stream::closed)
+            break;
+    }
 
-    if (replyFinished) {
+    if (promisedStream->state == Stream::closed) {
+        if (!replyFinished)
+            sendRST_STREAM(promisedStream->streamID, INTERNAL_ERROR);
+        deleteActiveStream(promisedStream->streamID);
+    } else if (replyFinished) {
         // Good, we already have received ALL the frames of that PUSH_PROMISE,
         // nothing more to do.
         finishStream(*promisedStream, Qt::QueuedConnection);
@@ -0,0 +1,438 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtNetwork module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qhttpconnectionpoolconfiguration.h"
+
+#include "qdebug.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QHttpConnectionPoolConfiguration
+    \brief The QHttpConnectionPoolConfiguration class controls how
+    QNetworkAccessManager pools its HTTP connections.
+    \since 6.0
+
+    \reentrant
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    QNetworkAccessManager keeps the TCP connections it opens for HTTP and
+    HTTPS requests alive after a reply has finished, so that subsequent
+    requests to the same host can reuse them. QHttpConnectionPoolConfiguration
+    controls the size and the lifetime of this pool:
+
+    \list
+      \li The maximum number of parallel connections per host. Requests
+         to a host are distributed over up to this many HTTP/1.1
+         connections; additional requests are queued until one of the
+         connections becomes available.
+      \li The maximum number of connections the manager has open in
+         total, across all hosts.
+      \li The idle timeout. Once no request to a host is in progress or
+         queued, the connections to that host are kept open for this long
+         before they are closed.
+      \li The number of connections that
+         QNetworkAccessManager::connectToHost() and
+         QNetworkAccessManager::connectToHostEncrypted() open in advance.
+    \endlist
+
+    \note HTTP/2 multiplexes all requests to a host over a single
+    connection, so the limits on the number of connections per host and
+    the pre-connect count only apply to HTTP/1.1.
+
+    \note The configuration is applied to connections to hosts the manager
+    has not yet connected to. Call QNetworkAccessManager::clearConnectionCache()
+    to have it applied to all hosts.
+
+    \sa QNetworkAccessManager::setConnectionPoolConfiguration(),
+        QHttpConnectionPoolStatistics
+*/
+
+class QHttpConnectionPoolConfigurationPrivate : public QSharedData
+{
+public:
+    int maximumConnectionsPerHost = 6;
+    int maximumConnections = 0;
+    int idleTimeout = 120 * 1000;
+    int preConnectCount = 1;
+};
+
+/*!
+    Default constructs a QHttpConnectionPoolConfiguration object.
+
+    Such a configuration has the following values:
+    \list
+        \li At most 6 connections per host
+        \li No limit on the total number of connections
+        \li Idle connections are closed after 120 seconds
+        \li Pre-connecting to a host opens a single connection
+    \endlist
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration()
+    : d(new QHttpConnectionPoolConfigurationPrivate)
+{
+}
+
+/*!
+    Copy-constructs this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration(const QHttpConnectionPoolConfiguration &) = default;
+
+/*!
+    Move-constructs this QHttpConnectionPoolConfiguration from \a other
+*/
+QHttpConnectionPoolConfiguration::QHttpConnectionPoolConfiguration(QHttpConnectionPoolConfiguration &&other) noexcept
+{
+    swap(other);
+}
+
+/*!
+    Copy-assigns \a other to this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration &QHttpConnectionPoolConfiguration::operator=(const QHttpConnectionPoolConfiguration &) = default;
+
+/*!
+    Move-assigns \a other to this QHttpConnectionPoolConfiguration.
+*/
+QHttpConnectionPoolConfiguration &QHttpConnectionPoolConfiguration::operator=(QHttpConnectionPoolConfiguration &&) noexcept = default;
+
+/*!
+    Destructor.
+*/
+QHttpConnectionPoolConfiguration::~QHttpConnectionPoolConfiguration()
+{
+}
+
+/*!
+    Sets the maximum number of HTTP/1.1 connections QNetworkAccessManager
+    opens in parallel to a single host to \a count. \a count must be at
+    least 1.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa maximumConnectionsPerHost
+*/
+bool QHttpConnectionPoolConfiguration::setMaximumConnectionsPerHost(int count)
+{
+    if (count < 1 || count > 0xffff) {
+        qWarning("QHttpConnectionPoolConfiguration: invalid number of connections per host");
+        return false;
+    }
+
+    d->maximumConnectionsPerHost = count;
+    return true;
+}
+
+/*!
+    Returns the maximum number of HTTP/1.1 connections opened in parallel
+    to a single host. The default value is 6.
+
+    \sa setMaximumConnectionsPerHost
+*/
+int QHttpConnectionPoolConfiguration::maximumConnectionsPerHost() const
+{
+    return d->maximumConnectionsPerHost;
+}
+
+/*!
+    Sets the maximum number of connections QNetworkAccessManager keeps
+    open in total, across all hosts, to \a count. A value of 0 means that
+    the total number of connections is not limited. \a count cannot be
+    negative.
+
+    When the limit is reached, requests that would need an additional
+    connection are queued until another connection has been closed. A
+    host the manager has no open connection to is always allowed one
+    connection, so that requests to it are not starved by busy
+    connections to other hosts.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa maximumConnections
+*/
+bool QHttpConnectionPoolConfiguration::setMaximumConnections(int count)
+{
+    if (count < 0) {
+        qWarning("QHttpConnectionPoolConfiguration: invalid maximum number of connections");
+        return false;
+    }
+
+    d->maximumConnections = count;
+    return true;
+}
+
+/*!
+    Returns the maximum number of connections kept open in total, or 0 if
+    the number is not limited, which is the default.
+
+    \sa setMaximumConnections
+*/
+int QHttpConnectionPoolConfiguration::maximumConnections() const
+{
+    return d->maximumConnections;
+}
+
+/*!
+    Sets the time, in milliseconds, for which the connections to a host are
+    kept open after the last request to it has finished to \a msecs. A
+    value of 0 closes connections as soon as they become idle. \a msecs
+    cannot be negative.
+
+    \note Servers may close idle connections earlier than that.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa idleTimeout
+*/
+bool QHttpConnectionPoolConfiguration::setIdleTimeout(int msecs)
+{
+    if (msecs < 0) {
+        qWarning("QHttpConnectionPoolConfiguration: invalid idle timeout");
+        return false;
+    }
+
+    d->idleTimeout = msecs;
+    return true;
+}
+
+/*!
+    Returns the time, in milliseconds, for which idle connections are kept
+    open. The default value is 120000 milliseconds.
+
+    \sa setIdleTimeout
+*/
+int QHttpConnectionPoolConfiguration::idleTimeout() const
+{
+    return d->idleTimeout;
+}
+
+/*!
+    Sets the number of connections that QNetworkAccessManager::connectToHost()
+    and QNetworkAccessManager::connectToHostEncrypted() open to \a count.
+    \a count must be at least 1; it is bounded by maximumConnectionsPerHost().
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa preConnectCount
+*/
+bool QHttpConnectionPoolConfiguration::setPreConnectCount(int count)
+{
+    if (count < 1) {
+        qWarning("QHttpConnectionPoolConfiguration: invalid pre-connect count");
+        return false;
+    }
+
+    d->preConnectCount = count;
+    return true;
+}
+
+/*!
+    Returns the number of connections opened when pre-connecting to a
+    host. The default value is 1.
+
+    \sa setPreConnectCount
+*/
+int QHttpConnectionPoolConfiguration::preConnectCount() const
+{
+    return d->preConnectCount;
+}
+
+/*!
+    Swaps this configuration with the \a other configuration.
+*/
+void QHttpConnectionPoolConfiguration::swap(QHttpConnectionPoolConfiguration &other) noexcept
+{
+    d.swap(other.d);
+}
+
+/*!
+    Returns \c true if \a lhs and \a rhs have the same set of connection
+    pool parameters.
+*/
+bool operator==(const QHttpConnectionPoolConfiguration &lhs, const QHttpConnectionPoolConfiguration &rhs)
+{
+    if (lhs.d == rhs.d)
+        return true;
+
+    return lhs.d->maximumConnectionsPerHost == rhs.d->maximumConnectionsPerHost
+           && lhs.d->maximumConnections == rhs.d->maximumConnections
+           && lhs.d->idleTimeout == rhs.d->idleTimeout
+           && lhs.d->preConnectCount == rhs.d->preConnectCount;
+}
+
+/*!
+    \fn bool operator!=(const QHttpConnectionPoolConfiguration &lhs, const QHttpConnectionPoolConfiguration &rhs)
+    \relates QHttpConnectionPoolConfiguration
+
+    Returns \c true if \a lhs and \a rhs differ in any of the connection
+    pool parameters.
+*/
+
+/*!
+    \class QHttpConnectionPoolStatistics
+    \brief The QHttpConnectionPoolStatistics class holds usage statistics
+    of QNetworkAccessManager's HTTP connection pool.
+    \since 6.0
+
+    \reentrant
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    A QHttpConnectionPoolStatistics object is a snapshot taken by
+    QNetworkAccessManager::connectionPoolStatistics(). Comparing
+    requestsOnReusedConnections() with requestsSent() tells how well
+    keep-alive connections are reused; openConnections() tells how close
+    the pool is to the limits set with QHttpConnectionPoolConfiguration.
+
+    \sa QNetworkAccessManager::connectionPoolStatistics()
+*/
+
+class QHttpConnectionPoolStatisticsPrivate : public QSharedData
+{
+public:
+    int openConnections = 0;
+    qint64 connectionsOpened = 0;
+    qint64 requestsSent = 0;
+    qint64 requestsOnReusedConnections = 0;
+};
+
+/*!
+    Constructs an empty statistics object, all of whose values are 0.
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics()
+    : d(new QHttpConnectionPoolStatisticsPrivate)
+{
+}
+
+/*!
+    \internal
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics(int openConnections,
+                                                             qint64 connectionsOpened,
+                                                             qint64 requestsSent,
+                                                             qint64 requestsOnReusedConnections)
+    : d(new QHttpConnectionPoolStatisticsPrivate)
+{
+    d->openConnections = openConnections;
+    d->connectionsOpened = connectionsOpened;
+    d->requestsSent = requestsSent;
+    d->requestsOnReusedConnections = requestsOnReusedConnections;
+}
+
+/*!
+    Copy-constructs this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics(const QHttpConnectionPoolStatistics &) = default;
+
+/*!
+    Move-constructs this QHttpConnectionPoolStatistics from \a other
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics(QHttpConnectionPoolStatistics &&other) noexcept
+{
+    swap(other);
+}
+
+/*!
+    Copy-assigns \a other to this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics &QHttpConnectionPoolStatistics::operator=(const QHttpConnectionPoolStatistics &) = default;
+
+/*!
+    Move-assigns \a other to this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics &QHttpConnectionPoolStatistics::operator=(QHttpConnectionPoolStatistics &&) noexcept = default;
+
+/*!
+    Destructor.
+*/
+QHttpConnectionPoolStatistics::~QHttpConnectionPoolStatistics()
+{
+}
+
+/*!
+    Returns the number of connections that were open, or being opened,
+    when the snapshot was taken.
+*/
+int QHttpConnectionPoolStatistics::openConnections() const
+{
+    return d->openConnections;
+}
+
+/*!
+    Returns the number of connections the manager has opened since it was
+    created.
+*/
+qint64 QHttpConnectionPoolStatistics::connectionsOpened() const
+{
+    return d->connectionsOpened;
+}
+
+/*!
+    Returns the number of HTTP requests the manager has sent since it was
+    created. Pre-connect requests are not counted.
+*/
+qint64 QHttpConnectionPoolStatistics::requestsSent() const
+{
+    return d->requestsSent;
+}
+
+/*!
+    Returns the number of HTTP requests that were sent over a connection
+    that had already been used for an earlier request, instead of over a
+    newly opened one.
+
+    \sa requestsSent()
+*/
+qint64 QHttpConnectionPoolStatistics::requestsOnReusedConnections() const
+{
+    return d->requestsOnReusedConnections;
+}
+
+/*!
+    Swaps this statistics object with \a other.
+*/
+void QHttpConnectionPoolStatistics::swap(QHttpConnectionPoolStatistics &other) noexcept
+{
+    d.swap(other.d);
+}
+
+QT_END_NAMESPACE
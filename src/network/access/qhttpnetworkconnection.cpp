@@ -73,6 +73,58 @@ const int QHttpNetworkConnectionPrivate::defaultPipelineLength = 3;
 // This means that there are 2 requests in flight and 2 slots free that will be re-filled.
 const int QHttpNetworkConnectionPrivate::defaultRePipelineLength = 2;
 
+void QHttpConnectionPool::setMaximumConnections(int count)
+{
+    QMutexLocker locker(&mutex);
+    maximumConnections = count;
+}
+
+bool QHttpConnectionPool::acquireConnection(QHttpNetworkConnection *waiter, bool force)
+{
+    QMutexLocker locker(&mutex);
+    if (!force && maximumConnections > 0 && openConnections >= maximumConnections) {
+        if (!waiters.contains(waiter))
+            waiters.append(waiter);
+        return false;
+    }
+    ++openConnections;
+    ++connectionsOpened;
+    return true;
+}
+
+void QHttpConnectionPool::releaseConnection()
+{
+    QMutexLocker locker(&mutex);
+    Q_ASSERT(openConnections > 0);
+    --openConnections;
+    // All waiters get to retry; those that lose the race queue up again.
+    // The mutex keeps them alive, see removeWaiter().
+    const auto toWake = qExchange(waiters, {});
+    for (QHttpNetworkConnection *waiter : toWake)
+        QMetaObject::invokeMethod(waiter, "_q_startNextRequest", Qt::QueuedConnection);
+}
+
+void QHttpConnectionPool::removeWaiter(QHttpNetworkConnection *waiter)
+{
+    QMutexLocker locker(&mutex);
+    waiters.removeOne(waiter);
+}
+
+void QHttpConnectionPool::requestSent(bool reusedConnection)
+{
+    requestsSent.fetchAndAddRelaxed(1);
+    if (reusedConnection)
+        requestsOnReusedConnections.fetchAndAddRelaxed(1);
+}
+
+QHttpConnectionPoolStatistics QHttpConnectionPool::statistics() const
+{
+    QMutexLocker locker(&mutex);
+    return QHttpConnectionPoolStatistics(openConnections, connectionsOpened,
+                                         requestsSent.loadRelaxed(),
+                                         requestsOnReusedConnections.loadRelaxed());
+}
+
 
 QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(const QString &hostName,
                                                              quint16 port, bool encrypt,
@@ -102,7 +154,10 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(quint16 connectionC
                                                              QHttpNetworkConnection::ConnectionType type)
 : state(RunningState), networkLayerState(Unknown),
   hostName(hostName), port(port), encrypt(encrypt), delayIpv4(true),
-  activeChannelCount(connectionCount), channelCount(connectionCount)
+  activeChannelCount(type == QHttpNetworkConnection::ConnectionTypeHTTP2
+                     || type == QHttpNetworkConnection::ConnectionTypeHTTP2Direct
+                     ? 1 : connectionCount),
+  channelCount(connectionCount)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
@@ -122,6 +177,9 @@ QHttpNetworkConnectionPrivate::~QHttpNetworkConnectionPrivate()
             channels[i].socket->close();
             delete channels[i].socket;
         }
+        // the channels cannot reach us through their connection pointer anymore
+        if (channels[i].holdsPoolConnection && connectionPool)
+            connectionPool->releaseConnection();
     }
     delete []channels;
 }
@@ -1332,6 +1390,9 @@ QHttpNetworkConnection::QHttpNetworkConnection(quint16 connectionCount, const QS
 
 QHttpNetworkConnection::~QHttpNetworkConnection()
 {
+    Q_D(QHttpNetworkConnection);
+    if (d->connectionPool)
+        d->connectionPool->removeWaiter(this);
 }
 
 QString QHttpNetworkConnection::hostName() const
@@ -1427,6 +1488,18 @@ void QHttpNetworkConnection::setHttp2Parameters(const QHttp2Configuration &param
     d->http2Parameters = params;
 }
 
+QSharedPointer<QHttpConnectionPool> QHttpNetworkConnection::connectionPool() const
+{
+    Q_D(const QHttpNetworkConnection);
+    return d->connectionPool;
+}
+
+void QHttpNetworkConnection::setConnectionPool(const QSharedPointer<QHttpConnectionPool> &pool)
+{
+    Q_D(QHttpNetworkConnection);
+    d->connectionPool = pool;
+}
+
 // SSL support below
 #ifndef QT_NO_SSL
 void QHttpNetworkConnection::setSslConfiguration(const QSslConfiguration &config)
@@ -57,6 +57,7 @@
 #include <QtNetwork/qabstractsocket.h>
 
 #include <qhttp2configuration.h>
+#include <qhttpconnectionpoolconfiguration.h>
 
 #include <private/qobject_p.h>
 #include <qauthenticator.h>
@@ -64,6 +65,7 @@
 #include <qbuffer.h>
 #include <qtimer.h>
 #include <qsharedpointer.h>
+#include <qmutex.h>
 
 #include <private/qhttpnetworkheader_p.h>
 #include <private/qhttpnetworkrequest_p.h>
@@ -87,6 +89,37 @@ class QSslConfiguration;
 class QSslContext;
 #endif // !QT_NO_SSL
 
+class QHttpNetworkConnection;
+
+// Shared by all QHttpNetworkConnection objects created on behalf of one
+// QNetworkAccessManager, which may live in different threads: enforces the
+// manager-wide connection limit and collects the pool statistics.
+class Q_AUTOTEST_EXPORT QHttpConnectionPool
+{
+public:
+    void setMaximumConnections(int count);
+
+    // Returns false if the limit is reached; the waiter is then woken up
+    // through _q_startNextRequest() once a connection has been released.
+    bool acquireConnection(QHttpNetworkConnection *waiter, bool force);
+    void releaseConnection();
+    void removeWaiter(QHttpNetworkConnection *waiter);
+
+    void requestSent(bool reusedConnection);
+
+    QHttpConnectionPoolStatistics statistics() const;
+
+private:
+    mutable QMutex mutex;
+    int maximumConnections = 0;
+    int openConnections = 0;
+    qint64 connectionsOpened = 0;
+    QList<QHttpNetworkConnection *> waiters;
+
+    QAtomicInteger<qint64> requestsSent;
+    QAtomicInteger<qint64> requestsOnReusedConnections;
+};
+
 class QHttpNetworkConnectionPrivate;
 class Q_AUTOTEST_EXPORT QHttpNetworkConnection : public QObject
 {
@@ -134,6 +167,9 @@ public:
     QHttp2Configuration http2Parameters() const;
     void setHttp2Parameters(const QHttp2Configuration &params);
 
+    QSharedPointer<QHttpConnectionPool> connectionPool() const;
+    void setConnectionPool(const QSharedPointer<QHttpConnectionPool> &pool);
+
 #ifndef QT_NO_SSL
     void setSslConfiguration(const QSslConfiguration &config);
     void ignoreSslErrors(int channel = -1);
@@ -280,6 +316,8 @@ public:
 
     QHttp2Configuration http2Parameters;
 
+    QSharedPointer<QHttpConnectionPool> connectionPool;
+
     QString peerVerifyName;
     // If network status monitoring is enabled, we activate connectionMonitor
     // as soons as one of channels managed to connect to host (and we
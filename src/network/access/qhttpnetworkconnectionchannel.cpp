@@ -150,6 +150,9 @@ void QHttpNetworkConnectionChannel::init()
     QObject::connect(socket, SIGNAL(errorOccurred(QAbstractSocket::SocketError)),
                      this, SLOT(_q_error(QAbstractSocket::SocketError)),
                      Qt::DirectConnection);
+    QObject::connect(socket, SIGNAL(stateChanged(QAbstractSocket::SocketState)),
+                     this, SLOT(_q_stateChanged(QAbstractSocket::SocketState)),
+                     Qt::DirectConnection);
 
 
 #ifndef QT_NO_NETWORKPROXY
@@ -327,6 +330,12 @@ bool QHttpNetworkConnectionChannel::ensureConnection()
     // make sure that this socket is in a connected state, if not initiate
     // connection to the host.
     if (socketState != QAbstractSocket::ConnectedState) {
+        // stay within the manager-wide connection limit; we are woken up
+        // through _q_startNextRequest once another connection got closed
+        if (!acquirePoolConnection())
+            return false;
+        requestsOnSocket = 0;
+
         // connect to the host if not already connected.
         state = QHttpNetworkConnectionChannel::ConnectingState;
         pendingEncrypt = ssl;
@@ -764,6 +773,7 @@ void QHttpNetworkConnectionChannel::pipelineInto(HttpMessagePair &pair)
 #endif
 
     alreadyPipelinedRequests.append(pair);
+    countSentRequest();
 
     // pipelineFlush() needs to be called at some point afterwards
 }
@@ -822,6 +832,57 @@ bool QHttpNetworkConnectionChannel::isSocketReading() const
     return (state & QHttpNetworkConnectionChannel::ReadingState);
 }
 
+bool QHttpNetworkConnectionChannel::acquirePoolConnection()
+{
+    if (holdsPoolConnection)
+        return true;
+    QHttpConnectionPool *pool = connection->d_func()->connectionPool.data();
+    if (!pool)
+        return true;
+
+    // The limit only holds back additional connections to a host: a channel
+    // that already carries a request, or that would be the only connection
+    // to its host, is always let through so that nothing can starve.
+    bool force = reply || !h2RequestsToSend.isEmpty();
+    if (!force) {
+        force = true;
+        const QHttpNetworkConnectionPrivate *d = connection->d_func();
+        for (int i = 0; i < d->activeChannelCount; ++i) {
+            if (d->channels[i].holdsPoolConnection) {
+                force = false;
+                break;
+            }
+        }
+    }
+
+    if (!pool->acquireConnection(connection, force))
+        return false;
+    holdsPoolConnection = true;
+    return true;
+}
+
+void QHttpNetworkConnectionChannel::releasePoolConnection()
+{
+    if (!holdsPoolConnection)
+        return;
+    holdsPoolConnection = false;
+    if (connection && connection->d_func()->connectionPool)
+        connection->d_func()->connectionPool->releaseConnection();
+}
+
+void QHttpNetworkConnectionChannel::countSentRequest()
+{
+    if (connection && connection->d_func()->connectionPool)
+        connection->d_func()->connectionPool->requestSent(requestsOnSocket > 0);
+    ++requestsOnSocket;
+}
+
+void QHttpNetworkConnectionChannel::_q_stateChanged(QAbstractSocket::SocketState socketState)
+{
+    if (socketState == QAbstractSocket::UnconnectedState)
+        releasePoolConnection();
+}
+
 void QHttpNetworkConnectionChannel::_q_bytesWritten(qint64 bytes)
 {
     Q_UNUSED(bytes);
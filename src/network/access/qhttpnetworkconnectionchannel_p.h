@@ -186,6 +186,13 @@ public:
     bool isSocketWaiting() const;
     bool isSocketReading() const;
 
+    // accounting for the manager-wide QHttpConnectionPool
+    bool holdsPoolConnection = false;
+    qint64 requestsOnSocket = 0;
+    bool acquirePoolConnection();
+    void releasePoolConnection();
+    void countSentRequest();
+
     protected slots:
     void _q_receiveReply();
     void _q_bytesWritten(qint64 bytes); // proceed sending
@@ -193,6 +200,7 @@ public:
     void _q_disconnected(); // disconnected from host
     void _q_connected(); // start sending request
     void _q_error(QAbstractSocket::SocketError); // error from socket
+    void _q_stateChanged(QAbstractSocket::SocketState state); // socket state change
 #ifndef QT_NO_NETWORKPROXY
     void _q_proxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *auth); // from transparent proxy
 #endif
@@ -710,16 +710,8 @@ qint64 QHttpNetworkReplyPrivate::readBody(QAbstractSocket *socket, QByteDataBuff
             return -1;
 
         decompressHelper.feed(std::move(*tempOutDataBuffer));
-        while (decompressHelper.hasData()) {
-            QByteArray output(4 * 1024, Qt::Uninitialized);
-            qint64 read = decompressHelper.read(output.data(), output.size());
-            if (read < 0) {
-                return -1;
-            } else if (read > 0) {
-                output.resize(read);
-                out->append(std::move(output));
-            }
-        }
+        if (decompressHelper.readAll(out) < 0)
+            return -1;
     }
 
     contentRead += bytes;
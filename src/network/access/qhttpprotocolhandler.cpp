@@ -282,6 +282,7 @@ bool QHttpProtocolHandler::sendRequest()
             return true; // we have a working connection and are done
         }
 
+        m_channel->countSentRequest();
         m_channel->written = 0; // excluding the header
         m_channel->bytesTotal = 0;
 
@@ -181,12 +181,15 @@ class QNetworkAccessCachedHttpConnection: public QHttpNetworkConnection,
 {
     // Q_OBJECT
 public:
-    QNetworkAccessCachedHttpConnection(const QString &hostName, quint16 port, bool encrypt,
+    QNetworkAccessCachedHttpConnection(const QHttpConnectionPoolConfiguration &poolConfiguration,
+                                       const QString &hostName, quint16 port, bool encrypt,
                                        QHttpNetworkConnection::ConnectionType connectionType)
-        : QHttpNetworkConnection(hostName, port, encrypt, connectionType)
+        : QHttpNetworkConnection(quint16(poolConfiguration.maximumConnectionsPerHost()),
+                                 hostName, port, encrypt, nullptr, connectionType)
     {
         setExpires(true);
         setShareable(true);
+        setExpiryTimeout(poolConfiguration.idleTimeout());
     }
 
     virtual void dispose() override
@@ -326,8 +329,10 @@ void QHttpThreadDelegate::startRequest()
     if (!httpConnection) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
-        httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
+        httpConnection = new QNetworkAccessCachedHttpConnection(connectionPoolConfiguration,
+                                                                urlCopy.host(), urlCopy.port(), ssl,
                                                                 connectionType);
+        httpConnection->setConnectionPool(connectionPool);
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             || connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
             httpConnection->setHttp2Parameters(http2Parameters);
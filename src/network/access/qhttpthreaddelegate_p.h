@@ -63,6 +63,7 @@
 #include "qhttpnetworkrequest_p.h"
 #include "qhttpnetworkconnection_p.h"
 #include "qhttp2configuration.h"
+#include "qhttpconnectionpoolconfiguration.h"
 #include <QSharedPointer>
 #include <QScopedPointer>
 #include "private/qnoncontiguousbytedevice_p.h"
@@ -104,6 +105,8 @@ public:
     QNetworkProxy transparentProxy;
 #endif
     QSharedPointer<QNetworkAccessAuthenticationManager> authenticationManager;
+    // Keeps a memory mapped upload device alive while the HTTP thread reads from it
+    QSharedPointer<QNonContiguousByteDevice> sharedUploadByteDevice;
     bool synchronous;
 
     // outgoing, Retrieved in the synchronous HTTP case
@@ -118,6 +121,8 @@ public:
     QNetworkReply::NetworkError incomingErrorCode;
     QString incomingErrorDetail;
     QHttp2Configuration http2Parameters;
+    QHttpConnectionPoolConfiguration connectionPoolConfiguration;
+    QSharedPointer<QHttpConnectionPool> connectionPool;
 
 protected:
     // The zerocopy download buffer, if used:
@@ -44,6 +44,7 @@
 #include "qnetworkreply_p.h"
 #include "qnetworkrequest.h"
 
+#include <limits>
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -78,8 +79,9 @@ struct QNetworkAccessCache::Node
 };
 
 QNetworkAccessCache::CacheableObject::CacheableObject()
+    : expiryTimeout(ExpiryTime * 1000)
 {
-    // leave the members uninitialized
+    // leave the other members uninitialized
     // they must be initialized by the derived class's constructor
 }
 
@@ -102,6 +104,11 @@ void QNetworkAccessCache::CacheableObject::setShareable(bool enable)
     shareable = enable;
 }
 
+void QNetworkAccessCache::CacheableObject::setExpiryTimeout(qint64 msecs)
+{
+    expiryTimeout = msecs;
+}
+
 QNetworkAccessCache::QNetworkAccessCache()
     : oldest(nullptr), newest(nullptr)
 {
@@ -148,18 +155,27 @@ void QNetworkAccessCache::linkEntry(const QByteArray &key)
     Q_ASSERT(node->older == nullptr && node->newer == nullptr);
     Q_ASSERT(node->useCount == 0);
 
-    if (newest) {
-        Q_ASSERT(newest->newer == nullptr);
-        newest->newer = node;
-        node->older = newest;
-    }
-    if (!oldest) {
-        // there are no entries, so this is the oldest one too
+    node->timestamp = QDateTime::currentDateTimeUtc().addMSecs(node->object->expiryTimeout);
+
+    // keep the list sorted by expiry time; as long as all objects use the
+    // same timeout, this always makes the node the newest one
+    Node *older = newest;
+    while (older && node->timestamp < older->timestamp)
+        older = older->older;
+
+    node->older = older;
+    if (older) {
+        node->newer = older->newer;
+        older->newer = node;
+    } else {
+        // expires before all other entries, so this is the oldest one
+        node->newer = oldest;
         oldest = node;
     }
-
-    node->timestamp = QDateTime::currentDateTimeUtc().addSecs(ExpiryTime);
-    newest = node;
+    if (node->newer)
+        node->newer->older = node;
+    else
+        newest = node;
 }
 
 /*!
@@ -195,15 +211,15 @@ void QNetworkAccessCache::updateTimer()
     if (!oldest)
         return;
 
-    int interval = QDateTime::currentDateTimeUtc().secsTo(oldest->timestamp);
+    qint64 interval = QDateTime::currentDateTimeUtc().msecsTo(oldest->timestamp);
     if (interval <= 0) {
         interval = 0;
     } else {
-        // round up the interval
-        interval = (interval + 15) & ~16;
+        // round up the interval to full seconds
+        interval = qMin((interval + 999) / 1000 * 1000, qint64(std::numeric_limits<int>::max()));
     }
 
-    timer.start(interval * 1000, this);
+    timer.start(int(interval), this);
 }
 
 bool QNetworkAccessCache::emitEntryReady(Node *node, QObject *target, const char *member)
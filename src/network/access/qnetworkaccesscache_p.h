@@ -79,6 +79,7 @@ public:
         QByteArray key;
         bool expires;
         bool shareable;
+        qint64 expiryTimeout;
     public:
         CacheableObject();
         virtual ~CacheableObject();
@@ -88,6 +89,7 @@ public:
     protected:
         void setExpires(bool enable);
         void setShareable(bool enable);
+        void setExpiryTimeout(qint64 msecs);
     };
 
     QNetworkAccessCache();
@@ -73,6 +73,7 @@
 #if QT_CONFIG(http)
 #include "qhttpmultipart.h"
 #include "qhttpmultipart_p.h"
+#include "qhttpnetworkconnection_p.h"
 #include "qnetworkreplyhttpimpl_p.h"
 #endif
 
@@ -420,6 +421,7 @@ QNetworkAccessManager::QNetworkAccessManager(QObject *parent)
     qRegisterMetaType<QList<QPair<QByteArray,QByteArray> > >();
 #if QT_CONFIG(http)
     qRegisterMetaType<QHttpNetworkRequest>();
+    d_func()->connectionPool = QSharedPointer<QHttpConnectionPool>::create();
 #endif
     qRegisterMetaType<QNetworkReply::NetworkError>();
     qRegisterMetaType<QSharedPointer<char> >();
@@ -798,6 +800,10 @@ QNetworkReply *QNetworkAccessManager::get(const QNetworkRequest &request)
     \a data must be open for reading and must remain valid until the
     finished() signal is emitted for this reply.
 
+    If \a data is a QFile that can be mapped into memory, its contents
+    are sent straight from the mapping instead of being read through
+    intermediate buffers.
+
     \note Sending a POST request on protocols other than HTTP and
     HTTPS is undefined and will probably fail.
 
@@ -875,6 +881,10 @@ QNetworkReply *QNetworkAccessManager::put(const QNetworkRequest &request, QHttpM
     and must remain valid until the finished() signal is emitted for
     this reply.
 
+    If \a data is a QFile that can be mapped into memory, its contents
+    are sent straight from the mapping instead of being read through
+    intermediate buffers.
+
     Whether anything will be available for reading from the returned
     object is protocol dependent. For HTTP, the server may send a
     small HTML page indicating the upload was successful (or not).
@@ -937,9 +947,13 @@ QNetworkReply *QNetworkAccessManager::deleteResource(const QNetworkRequest &requ
     enough, i.e. calling this method multiple times per host will not result in faster
     network transactions.
 
+    Without HTTP/2, QHttpConnectionPoolConfiguration::preConnectCount()
+    connections are opened.
+
     \note This function has no possibility to report errors.
 
-    \sa connectToHost(), get(), post(), put(), deleteResource()
+    \sa connectToHost(), get(), post(), put(), deleteResource(),
+        setConnectionPoolConfiguration()
 */
 
 void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quint16 port,
@@ -963,9 +977,13 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
     enough, i.e. calling this method multiple times per host will not result in faster
     network transactions.
 
+    Without HTTP/2, QHttpConnectionPoolConfiguration::preConnectCount()
+    connections are opened.
+
     \note This function has no possibility to report errors.
 
-    \sa connectToHost(), get(), post(), put(), deleteResource()
+    \sa connectToHost(), get(), post(), put(), deleteResource(),
+        setConnectionPoolConfiguration()
 */
 
 void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quint16 port,
@@ -982,11 +1000,12 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
 
     // There is no way to enable HTTP2 via a request after having established the connection,
     // so we need to check the ssl configuration whether HTTP2 is allowed here.
-    if (!sslConfiguration.allowedNextProtocols().contains(QSslConfiguration::ALPNProtocolHTTP2))
+    const bool http2 = sslConfiguration.allowedNextProtocols().contains(QSslConfiguration::ALPNProtocolHTTP2);
+    if (!http2)
         request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
 
     request.setPeerVerifyName(peerName);
-    get(request);
+    d_func()->preConnect(request, http2);
 }
 #endif
 
@@ -997,9 +1016,15 @@ void QNetworkAccessManager::connectToHostEncrypted(const QString &hostName, quin
     This function is useful to complete the TCP handshake
     to a host before the HTTP request is made, resulting in a lower network latency.
 
+    If QHttpConnectionPoolConfiguration::preConnectCount() is larger than 1,
+    that many HTTP/1.1 connections are opened, so that as many requests can
+    be sent without delay. They are used by requests that do not allow
+    HTTP/2, see QNetworkRequest::Http2AllowedAttribute.
+
     \note This function has no possibility to report errors.
 
-    \sa connectToHostEncrypted(), get(), post(), put(), deleteResource()
+    \sa connectToHostEncrypted(), get(), post(), put(), deleteResource(),
+        setConnectionPoolConfiguration()
 */
 void QNetworkAccessManager::connectToHost(const QString &hostName, quint16 port)
 {
@@ -1008,7 +1033,15 @@ void QNetworkAccessManager::connectToHost(const QString &hostName, quint16 port)
     url.setPort(port);
     url.setScheme(QLatin1String("preconnect-http"));
     QNetworkRequest request(url);
-    get(request);
+#if QT_CONFIG(http)
+    // Several connections can only be opened without an attempt to upgrade to HTTP/2
+    const bool http2 = d_func()->connectionPoolConfiguration.preConnectCount() == 1;
+    if (!http2)
+        request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+#else
+    const bool http2 = false;
+#endif
+    d_func()->preConnect(request, http2);
 }
 
 /*!
@@ -1425,6 +1458,81 @@ void QNetworkAccessManager::setTransferTimeout(int timeout)
     d_func()->transferTimeout = timeout;
 }
 
+#if QT_CONFIG(http)
+/*!
+    \since 6.0
+
+    Returns the configuration of the pool of HTTP connections this manager
+    keeps open.
+
+    \sa setConnectionPoolConfiguration(), connectionPoolStatistics()
+*/
+QHttpConnectionPoolConfiguration QNetworkAccessManager::connectionPoolConfiguration() const
+{
+    return d_func()->connectionPoolConfiguration;
+}
+
+/*!
+    \since 6.0
+
+    Sets the configuration of the pool of HTTP connections this manager
+    keeps open to \a configuration. The configuration controls how many
+    connections are opened in parallel, per host and in total, and for how
+    long idle connections are kept alive.
+
+    Raising QHttpConnectionPoolConfiguration::maximumConnectionsPerHost()
+    above its default value of 6 lets more than 6 HTTP/1.1 requests to the
+    same host run concurrently:
+
+    \snippet code/src_network_access_qnetworkaccessmanager.cpp 2
+
+    \note The per-host limit and the idle timeout are applied when the
+    manager first connects to a host; call clearConnectionCache() to apply
+    a new configuration to hosts that are already connected. The limit on
+    the total number of connections takes effect immediately.
+
+    \sa connectionPoolConfiguration(), connectionPoolStatistics(),
+        connectToHost(), connectToHostEncrypted()
+*/
+void QNetworkAccessManager::setConnectionPoolConfiguration(const QHttpConnectionPoolConfiguration &configuration)
+{
+    Q_D(QNetworkAccessManager);
+    d->connectionPoolConfiguration = configuration;
+    d->connectionPool->setMaximumConnections(configuration.maximumConnections());
+}
+
+/*!
+    \since 6.0
+
+    Returns a snapshot of the usage statistics of the pool of HTTP
+    connections this manager keeps open.
+
+    \sa connectionPoolConfiguration()
+*/
+QHttpConnectionPoolStatistics QNetworkAccessManager::connectionPoolStatistics() const
+{
+    return d_func()->connectionPool->statistics();
+}
+#endif // QT_CONFIG(http)
+
+void QNetworkAccessManagerPrivate::preConnect(const QNetworkRequest &request, bool http2)
+{
+    Q_Q(QNetworkAccessManager);
+    int count = 1;
+#if QT_CONFIG(http)
+    // HTTP/2 multiplexes all requests over a single connection anyway
+    if (!http2) {
+        count = qMin(connectionPoolConfiguration.preConnectCount(),
+                     connectionPoolConfiguration.maximumConnectionsPerHost());
+    }
+#else
+    Q_UNUSED(http2);
+#endif
+    // each pre-connect request makes the connection open one more channel
+    for (int i = 0; i < count; ++i)
+        q->get(request);
+}
+
 void QNetworkAccessManagerPrivate::_q_replyFinished(QNetworkReply *reply)
 {
     Q_Q(QNetworkAccessManager);
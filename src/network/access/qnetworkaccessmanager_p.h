@@ -66,12 +66,17 @@
 #include "qhstsstore_p.h"
 #endif // QT_CONFIG(settings)
 
+#if QT_CONFIG(http)
+#include "qhttpconnectionpoolconfiguration.h"
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QAuthenticator;
 class QAbstractNetworkCache;
 class QNetworkAuthenticationCredential;
 class QNetworkCookieJar;
+class QHttpConnectionPool;
 
 class QNetworkAccessManagerPrivate: public QObjectPrivate
 {
@@ -100,6 +105,7 @@ public:
     void _q_replyPreSharedKeyAuthenticationRequired(QSslPreSharedKeyAuthenticator *authenticator);
     QNetworkReply *postProcess(QNetworkReply *reply);
     void createCookieJar() const;
+    void preConnect(const QNetworkRequest &request, bool http2);
 
     void authenticationRequired(QAuthenticator *authenticator,
                                 QNetworkReply *reply,
@@ -169,6 +175,12 @@ public:
 
     int transferTimeout = 0;
 
+#if QT_CONFIG(http)
+    QHttpConnectionPoolConfiguration connectionPoolConfiguration;
+    // Shared with the QHttpNetworkConnection objects in the HTTP thread
+    QSharedPointer<QHttpConnectionPool> connectionPool;
+#endif
+
     Q_DECLARE_PUBLIC(QNetworkAccessManager)
 };
 
@@ -49,6 +49,7 @@
 #include <qdatastream.h>
 #include <qdatetime.h>
 #include <qdiriterator.h>
+#include <qsavefile.h>
 #include <qurl.h>
 #include <qcryptographichash.h>
 #include <qdebug.h>
@@ -57,6 +58,7 @@
 #define PREPARED_SLASH QLatin1String("prepared/")
 #define CACHE_VERSION 8
 #define DATA_DIR QLatin1String("data")
+#define INDEX_FILE QLatin1String("index")
 
 #define MAX_COMPRESSION_SIZE (1024 * 1024 * 3)
 
@@ -77,6 +79,12 @@ QT_BEGIN_NAMESPACE
     Currently you cannot share the same cache files with more than
     one disk cache.
 
+    Since Qt 6.0, QNetworkDiskCache keeps an index file in the cache directory
+    that records the size of every cache file and the order in which they were
+    last used. The index is updated in the background as items are inserted,
+    read and removed, so expire() no longer needs to scan the whole cache
+    directory.
+
     QNetworkDiskCache by default limits the amount of space that the cache will
     use on the system to 50MB.
 
@@ -112,6 +120,7 @@ QNetworkDiskCache::QNetworkDiskCache(QObject *parent)
 QNetworkDiskCache::~QNetworkDiskCache()
 {
     Q_D(QNetworkDiskCache);
+    d->flushIndex();
     qDeleteAll(d->inserting);
 }
 
@@ -142,6 +151,8 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
     Q_D(QNetworkDiskCache);
     if (cacheDir.isEmpty())
         return;
+    d->flushIndex();
+    d->resetIndex();
     d->cacheDirectory = cacheDir;
     QDir dir(d->cacheDirectory);
     d->cacheDirectory = dir.absolutePath();
@@ -270,11 +281,13 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
     QString fileName = cacheFileName(cacheItem->metaData.url());
     Q_ASSERT(!fileName.isEmpty());
 
+    loadIndex();
     if (QFile::exists(fileName)) {
         if (!QFile::remove(fileName)) {
             qWarning() << "QNetworkDiskCache: couldn't remove the cache file " << fileName;
             return;
         }
+        updateIndex(fileName, IndexRemove);
     }
 
     if (currentCacheSize > 0)
@@ -294,10 +307,12 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
         && cacheItem->file->error() == QFile::NoError) {
         cacheItem->file->setAutoRemove(false);
         // ### use atomic rename rather then remove & rename
-        if (cacheItem->file->rename(fileName))
+        if (cacheItem->file->rename(fileName)) {
             currentCacheSize += cacheItem->file->size();
-        else
+            updateIndex(fileName, IndexAccess, cacheItem->file->size());
+        } else {
             cacheItem->file->setAutoRemove(true);
+        }
     }
     if (cacheItem->metaData.url() == lastItem.metaData.url())
         lastItem.reset();
@@ -345,6 +360,7 @@ bool QNetworkDiskCachePrivate::removeFile(const QString &file)
     qint64 size = info.size();
     if (QFile::remove(file)) {
         currentCacheSize -= size;
+        updateIndex(file, IndexRemove);
         return true;
     }
     return false;
@@ -402,15 +418,19 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
         buffer.reset(new QBuffer);
         buffer->setData(d->lastItem.data.data());
     } else {
-        QScopedPointer<QFile> file(new QFile(d->cacheFileName(url)));
-        if (!file->open(QFile::ReadOnly | QIODevice::Unbuffered))
+        const QString fileName = d->cacheFileName(url);
+        QScopedPointer<QFile> file(new QFile(fileName));
+        if (!file->open(QFile::ReadOnly | QIODevice::Unbuffered)) {
+            d->updateIndex(fileName, QNetworkDiskCachePrivate::IndexRemove);
             return nullptr;
+        }
 
         if (!d->lastItem.read(file.data(), true)) {
             file->close();
             remove(url);
             return nullptr;
         }
+        d->updateIndex(fileName, QNetworkDiskCachePrivate::IndexAccess, file->size());
         if (d->lastItem.data.isOpen()) {
             // compressed
             buffer.reset(new QBuffer);
@@ -500,9 +520,9 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
     Returns the current size of the cache.
 
     When the current size of the cache is greater than the maximumCacheSize()
-    older cache files are removed until the total size is less then 90% of
-    maximumCacheSize() starting with the oldest ones first using the file
-    creation date to determine how old a cache file is.
+    cache files are removed until the total size is less then 90% of
+    maximumCacheSize(), starting with the ones that were least recently
+    inserted or read with data().
 
     Subclasses can reimplement this function to change the order that cache
     files are removed taking into account information in the application
@@ -526,57 +546,24 @@ qint64 QNetworkDiskCache::expire()
 
     // close file handle to prevent "in use" error when QFile::remove() is called
     d->lastItem.reset();
-
-    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
-    QDirIterator it(cacheDirectory(), filters, QDirIterator::Subdirectories);
-
-    QMultiMap<QDateTime, QString> cacheItems;
-    qint64 totalSize = 0;
-    while (it.hasNext()) {
-        QString path = it.next();
-        QFileInfo info = it.fileInfo();
-        QString fileName = info.fileName();
-        if (fileName.endsWith(CACHE_POSTFIX)) {
-            const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
-            cacheItems.insert(birthTime.isValid() ? birthTime
-                              : info.fileTime(QFile::FileMetadataChangeTime), path);
-            totalSize += info.size();
-        }
-    }
+    d->loadIndex();
 
     int removedFiles = 0;
     qint64 goal = (maximumCacheSize() * 9) / 10;
-    QMultiMap<QDateTime, QString>::const_iterator i = cacheItems.constBegin();
-    while (i != cacheItems.constEnd()) {
-        if (totalSize < goal)
-            break;
-        QString name = i.value();
-        QFile file(name);
-
-        if (name.contains(PREPARED_SLASH)) {
-            for (QCacheItem *item : qAsConst(d->inserting)) {
-                if (item && item->file && item->file->fileName() == name) {
-                    delete item->file;
-                    item->file = nullptr;
-                    break;
-                }
-            }
-        }
-
-        qint64 size = file.size();
-        file.remove();
-        totalSize -= size;
+    while (d->indexedSize >= goal && !d->indexLru.isEmpty()) {
+        const qint64 key = d->indexLru.first();
+        QFile::remove(d->fileNameForIndexKey(key));
+        d->recordIndexChange(QNetworkDiskCachePrivate::IndexRemove, key);
         ++removedFiles;
-        ++i;
     }
 #if defined(QNETWORKDISKCACHE_DEBUG)
     if (removedFiles > 0) {
         qDebug() << "QNetworkDiskCache::expire()"
                 << "Removed:" << removedFiles
-                << "Kept:" << cacheItems.count() - removedFiles;
+                << "Kept:" << d->index.count();
     }
 #endif
-    return totalSize;
+    return d->indexedSize;
 }
 
 /*!
@@ -594,6 +581,16 @@ void QNetworkDiskCache::clear()
     d->maximumCacheSize = size;
 }
 
+/*!
+    Given the id of a cache file, generates its filename and subdirectory
+ */
+static QString cacheFileFragment(const QByteArray &id)
+{
+    // generates <one-char subdir>/<8-char filname.d>
+    uint code = (uint)id.at(id.length()-1) % 16;
+    return QString::number(code, 16) + QLatin1Char('/') + QLatin1String(id) + CACHE_POSTFIX;
+}
+
 /*!
     Given a URL, generates a unique enough filename (and subdirectory)
  */
@@ -607,12 +604,7 @@ QString QNetworkDiskCachePrivate::uniqueFileName(const QUrl &url)
     hash.addData(cleanUrl.toEncoded());
     // convert sha1 to base36 form and return first 8 bytes for use as string
     const QByteArray id = QByteArray::number(*(qlonglong*)hash.result().constData(), 36).left(8);
-    // generates <one-char subdir>/<8-char filname.d>
-    uint code = (uint)id.at(id.length()-1) % 16;
-    QString pathFragment = QString::number(code, 16) + QLatin1Char('/')
-                             + QLatin1String(id) + CACHE_POSTFIX;
-
-    return pathFragment;
+    return cacheFileFragment(id);
 }
 
 QString QNetworkDiskCachePrivate::tmpCacheFileName() const
@@ -633,6 +625,238 @@ QString QNetworkDiskCachePrivate::cacheFileName(const QUrl &url) const
     return  fullpath;
 }
 
+enum
+{
+    IndexMagic = 0xe9,
+    IndexVersion = 1
+};
+
+QString QNetworkDiskCachePrivate::indexFileName() const
+{
+    return dataDirectory + INDEX_FILE;
+}
+
+/*!
+    Sets \a key to the index key of the cache file \a fileName and returns
+    \c true, or returns \c false if \a fileName is not named like a file
+    that cacheFileName() generates.
+ */
+bool QNetworkDiskCachePrivate::indexKey(const QString &fileName, qint64 *key) const
+{
+    if (!fileName.startsWith(dataDirectory) || !fileName.endsWith(CACHE_POSTFIX))
+        return false;
+    const QStringView fragment = QStringView(fileName).mid(dataDirectory.size());
+    if (fragment.size() <= 2 + CACHE_POSTFIX.size() || fragment.at(1) != QLatin1Char('/'))
+        return false;
+
+    bool ok = false;
+    *key = fragment.mid(2, fragment.size() - 2 - CACHE_POSTFIX.size()).toLongLong(&ok, 36);
+    return ok && fileNameForIndexKey(*key) == fileName;
+}
+
+QString QNetworkDiskCachePrivate::fileNameForIndexKey(qint64 key) const
+{
+    return dataDirectory + cacheFileFragment(QByteArray::number(key, 36));
+}
+
+/*!
+    Reads the index of the cache directory, or rebuilds it if it is missing
+    or unreadable. Also removes prepared files left behind by a previous
+    process.
+ */
+void QNetworkDiskCachePrivate::loadIndex()
+{
+    if (indexLoaded || cacheDirectory.isEmpty())
+        return;
+    indexLoaded = true;
+
+    bool valid = false;
+    bool complete = true;
+    QFile file(indexFileName());
+    if (file.open(QIODevice::ReadOnly)) {
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_6_0);
+        qint32 magic;
+        qint32 version;
+        in >> magic >> version;
+        valid = in.status() == QDataStream::Ok && magic == IndexMagic && version == IndexVersion;
+        qint64 records = 0;
+        while (valid && !in.atEnd()) {
+            quint8 type;
+            qint64 key;
+            qint64 size = 0;
+            in >> type >> key;
+            if (type == IndexAccess)
+                in >> size;
+            // A record may have been cut short when the process died
+            if (in.status() != QDataStream::Ok || (type != IndexAccess && type != IndexRemove)) {
+                complete = false;
+                break;
+            }
+            applyIndexRecord(IndexRecord(type), key, size);
+            ++records;
+        }
+        indexJournalRecords = records - index.size();
+    }
+
+    if (!valid)
+        rebuildIndex();
+    if (!valid || !complete)
+        writeIndexSnapshot();
+
+    QDirIterator it(cacheDirectory + PREPARED_SLASH, QDir::Files);
+    while (it.hasNext()) {
+        const QString name = it.next();
+        if (!name.endsWith(CACHE_POSTFIX))
+            continue;
+        bool pending = false;
+        for (const QCacheItem *item : qAsConst(inserting)) {
+            if (item && item->file && QFileInfo(*item->file) == it.fileInfo()) {
+                pending = true;
+                break;
+            }
+        }
+        if (!pending)
+            QFile::remove(name);
+    }
+}
+
+/*!
+    Scans the data directory for cache files, for when there is no index
+    yet. Files are ordered by their creation time.
+ */
+void QNetworkDiskCachePrivate::rebuildIndex()
+{
+    QMultiMap<QDateTime, QPair<qint64, qint64>> cacheItems;
+    QDirIterator it(dataDirectory, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString path = it.next();
+        qint64 key;
+        if (!indexKey(path, &key))
+            continue;
+        const QFileInfo info = it.fileInfo();
+        const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
+        cacheItems.insert(birthTime.isValid() ? birthTime
+                          : info.fileTime(QFile::FileMetadataChangeTime),
+                          qMakePair(key, info.size()));
+    }
+    for (auto i = cacheItems.cbegin(), end = cacheItems.cend(); i != end; ++i)
+        applyIndexRecord(IndexAccess, i.value().first, i.value().second);
+}
+
+void QNetworkDiskCachePrivate::resetIndex()
+{
+    index.clear();
+    indexLru.clear();
+    indexTick = 0;
+    indexedSize = 0;
+    indexJournal.clear();
+    indexJournalRecords = 0;
+    indexLoaded = false;
+    currentCacheSize = -1;
+}
+
+/*!
+    Updates the in-memory index; returns \c false if nothing changed.
+ */
+bool QNetworkDiskCachePrivate::applyIndexRecord(IndexRecord type, qint64 key, qint64 size)
+{
+    auto it = index.find(key);
+    if (it != index.end()) {
+        indexedSize -= it->size;
+        indexLru.remove(it->tick);
+        if (type == IndexRemove) {
+            index.erase(it);
+            return true;
+        }
+    } else if (type == IndexRemove) {
+        return false;
+    } else {
+        it = index.insert(key, IndexEntry());
+    }
+
+    it->size = size;
+    it->tick = ++indexTick;
+    indexLru.insert(it->tick, key);
+    indexedSize += size;
+    return true;
+}
+
+/*!
+    Updates the index and queues the change to be appended to the index file.
+ */
+void QNetworkDiskCachePrivate::recordIndexChange(IndexRecord type, qint64 key, qint64 size)
+{
+    if (!applyIndexRecord(type, key, size))
+        return;
+
+    QDataStream out(&indexJournal, QIODevice::WriteOnly | QIODevice::Append);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << quint8(type) << key;
+    if (type == IndexAccess)
+        out << size;
+    ++indexJournalRecords;
+
+    if (indexJournal.size() >= 64 * 1024)
+        flushIndex();
+    else
+        scheduleIndexFlush();
+}
+
+void QNetworkDiskCachePrivate::updateIndex(const QString &fileName, IndexRecord type, qint64 size)
+{
+    loadIndex();
+    qint64 key;
+    if (indexLoaded && indexKey(fileName, &key))
+        recordIndexChange(type, key, size);
+}
+
+void QNetworkDiskCachePrivate::scheduleIndexFlush()
+{
+    Q_Q(QNetworkDiskCache);
+    if (indexFlushScheduled)
+        return;
+    indexFlushScheduled = true;
+    QMetaObject::invokeMethod(q, [this] { flushIndex(); }, Qt::QueuedConnection);
+}
+
+/*!
+    Appends the queued records to the index file, or rewrites it if it
+    mostly consists of records that have been superseded.
+ */
+void QNetworkDiskCachePrivate::flushIndex()
+{
+    indexFlushScheduled = false;
+    if (indexJournal.isEmpty())
+        return;
+
+    if (indexJournalRecords <= qMax<qint64>(index.size(), 1024)) {
+        QFile file(indexFileName());
+        if (file.open(QIODevice::WriteOnly | QIODevice::Append) && file.size() > 0
+            && file.write(indexJournal) == indexJournal.size()) {
+            indexJournal.clear();
+            return;
+        }
+    }
+    writeIndexSnapshot();
+}
+
+void QNetworkDiskCachePrivate::writeIndexSnapshot()
+{
+    QSaveFile file(indexFileName());
+    if (file.open(QIODevice::WriteOnly)) {
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << qint32(IndexMagic) << qint32(IndexVersion);
+        for (auto it = indexLru.cbegin(), end = indexLru.cend(); it != end; ++it)
+            out << quint8(IndexAccess) << it.value() << index.value(it.value()).size;
+        if (!file.commit())
+            qWarning() << "QNetworkDiskCache: couldn't write the index file" << file.fileName();
+    }
+    indexJournal.clear();
+    indexJournalRecords = 0;
+}
+
 /*!
     We compress small text and JavaScript files.
  */
@@ -56,6 +56,7 @@
 
 #include <qbuffer.h>
 #include <qhash.h>
+#include <qmap.h>
 #include <qtemporaryfile.h>
 
 QT_REQUIRE_CONFIG(networkdiskcache);
@@ -111,6 +112,28 @@ public:
     void prepareLayout();
     static quint32 crc32(const char *data, uint len);
 
+    enum IndexRecord : quint8 {
+        IndexAccess = 1,
+        IndexRemove
+    };
+    struct IndexEntry {
+        qint64 size;
+        quint64 tick;
+    };
+
+    QString indexFileName() const;
+    bool indexKey(const QString &fileName, qint64 *key) const;
+    QString fileNameForIndexKey(qint64 key) const;
+    void loadIndex();
+    void rebuildIndex();
+    void resetIndex();
+    bool applyIndexRecord(IndexRecord type, qint64 key, qint64 size);
+    void recordIndexChange(IndexRecord type, qint64 key, qint64 size = 0);
+    void updateIndex(const QString &fileName, IndexRecord type, qint64 size = 0);
+    void scheduleIndexFlush();
+    void flushIndex();
+    void writeIndexSnapshot();
+
     mutable QCacheItem lastItem;
     QString cacheDirectory;
     QString dataDirectory;
@@ -118,6 +141,18 @@ public:
     qint64 currentCacheSize;
 
     QHash<QIODevice*, QCacheItem*> inserting;
+
+    // Every file in dataDirectory, keyed by the base 36 id uniqueFileName()
+    // puts in its name, and ordered from least to most recently used.
+    QHash<qint64, IndexEntry> index;
+    QMap<quint64, qint64> indexLru;
+    quint64 indexTick = 0;
+    qint64 indexedSize = 0;
+    // Records not yet appended to the index file
+    QByteArray indexJournal;
+    qint64 indexJournalRecords = 0;
+    bool indexLoaded = false;
+    bool indexFlushScheduled = false;
     Q_DECLARE_PUBLIC(QNetworkDiskCache)
 };
 
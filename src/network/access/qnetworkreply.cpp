@@ -527,6 +527,69 @@ void QNetworkReply::setReadBufferSize(qint64 size)
     d->readBufferMaxSize = size;
 }
 
+/*!
+    \since 6.0
+
+    Sets \a sink as the download sink of this reply. Downloaded data is
+    then written to \a sink as it arrives instead of being buffered in
+    the reply, and readyRead() is not emitted for it. Data that was
+    already buffered when the sink is set is written to it immediately.
+
+    For HTTP and HTTPS the data is handed to the sink in the chunks it
+    was received in, without copying it into the reply's read buffer
+    first. A QIODevice subclass that reimplements
+    QIODevice::writeData() can therefore be used to process downloads
+    of any size chunk by chunk, without the reply buffering them. If a
+    read buffer size was set, the download is throttled based on the
+    data that was not yet handed to the sink.
+
+    The reply does not take ownership of \a sink, which must be open
+    for writing. Passing \nullptr restores the default behavior.
+
+    The sink should be set right after the request has been issued,
+    before control returns to the event loop.
+
+    \snippet code/src_network_access_qnetworkreply.cpp 1
+
+    \sa downloadSink(), setReadBufferSize()
+*/
+void QNetworkReply::setDownloadSink(QIODevice *sink)
+{
+    Q_D(QNetworkReply);
+    disconnect(d->downloadSinkConnection);
+    d->downloadSink = sink;
+    if (!sink)
+        return;
+
+    d->downloadSinkConnection = connect(this, &QIODevice::readyRead, this,
+                                        [d]() { d->writeToDownloadSink(); });
+    d->writeToDownloadSink();
+}
+
+/*!
+    \since 6.0
+
+    Returns the download sink of this reply, or \nullptr if the
+    downloaded data is buffered in the reply.
+
+    \sa setDownloadSink()
+*/
+QIODevice *QNetworkReply::downloadSink() const
+{
+    return d_func()->downloadSink;
+}
+
+void QNetworkReplyPrivate::writeToDownloadSink()
+{
+    Q_Q(QNetworkReply);
+    if (!downloadSink)
+        return;
+
+    const QByteArray data = q->readAll();
+    if (!data.isEmpty())
+        downloadSink->write(data);
+}
+
 /*!
     Returns the QNetworkAccessManager that was used to create this
     QNetworkReply object. Initially, it is also the parent object.
@@ -121,6 +121,9 @@ public:
     qint64 readBufferSize() const;
     virtual void setReadBufferSize(qint64 size);
 
+    void setDownloadSink(QIODevice *sink);
+    QIODevice *downloadSink() const;
+
     QNetworkAccessManager *manager() const;
     QNetworkAccessManager::Operation operation() const;
     QNetworkRequest request() const;
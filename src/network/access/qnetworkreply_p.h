@@ -85,6 +85,10 @@ public:
     QNetworkAccessManager::Operation operation;
     QNetworkReply::NetworkError errorCode;
     bool isFinished;
+    QPointer<QIODevice> downloadSink;
+    QMetaObject::Connection downloadSinkConnection;
+
+    void writeToDownloadSink();
 
     static inline void setManager(QNetworkReply *reply, QNetworkAccessManager *manager)
     { reply->d_func()->manager = manager; }
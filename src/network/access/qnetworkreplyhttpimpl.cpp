@@ -812,6 +812,10 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     // from HTTP thread to user thread in some cases.
     delegate->authenticationManager = managerPrivate->authenticationManager;
 
+    // Connection pool limits and statistics are shared by all requests of the manager
+    delegate->connectionPoolConfiguration = managerPrivate->connectionPoolConfiguration;
+    delegate->connectionPool = managerPrivate->connectionPool;
+
     if (!synchronous) {
         // Tell our zerocopy policy to the delegate
         QVariant downloadBufferMaximumSizeAttribute = newHttpRequest.attribute(QNetworkRequest::MaximumDownloadBufferSizeAttribute);
@@ -889,7 +893,13 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
         QObject::connect(q, SIGNAL(readBufferSizeChanged(qint64)), delegate, SLOT(readBufferSizeChanged(qint64)));
         QObject::connect(q, SIGNAL(readBufferFreed(qint64)), delegate, SLOT(readBufferFreed(qint64)));
 
-        if (uploadByteDevice) {
+        if (qobject_cast<QNonContiguousByteDeviceMappedFileImpl *>(uploadByteDevice.data())) {
+            // A memory mapped file can be read from any thread, so the HTTP thread
+            // sends straight from the mapping instead of having every chunk copied
+            // and forwarded to it from this thread.
+            delegate->sharedUploadByteDevice = uploadByteDevice;
+            delegate->httpRequest.setUploadByteDevice(uploadByteDevice.data());
+        } else if (uploadByteDevice) {
             QNonContiguousByteDeviceThreadForwardImpl *forwardUploadDevice =
                     new QNonContiguousByteDeviceThreadForwardImpl(uploadByteDevice->atEnd(), uploadByteDevice->size());
             forwardUploadDevice->setParent(delegate); // needed to make sure it is moved on moveToThread()
@@ -1048,12 +1058,22 @@ void QNetworkReplyHttpImplPrivate::replyDownloadData(QByteArray d)
     if (cacheSaveDevice)
         cacheSaveDevice->write(d);
 
-    if (!isHttpRedirectResponse()) {
-        buffer.append(d);
+    if (downloadSink && !isHttpRedirectResponse()) {
+        // Hand the data to the sink right away, it is neither buffered
+        // nor announced with readyRead()
+        downloadSink->write(d);
         bytesDownloaded += d.size();
         setupTransferTimeout();
+        if (readBufferMaxSize)
+            emit q->readBufferFreed(d.size());
+    } else {
+        if (!isHttpRedirectResponse()) {
+            buffer.append(d);
+            bytesDownloaded += d.size();
+            setupTransferTimeout();
+        }
+        bytesBuffered += d.size();
     }
-    bytesBuffered += d.size();
 
     int pendingSignals = pendingDownloadDataEmissions->fetchAndSubAcquire(1) - 1;
     if (pendingSignals > 0) {
@@ -1069,7 +1089,8 @@ void QNetworkReplyHttpImplPrivate::replyDownloadData(QByteArray d)
 
     QVariant totalSize = cookedHeaders.value(QNetworkRequest::ContentLengthHeader);
 
-    emit q->readyRead();
+    if (!downloadSink)
+        emit q->readyRead();
     // emit readyRead before downloadProgress incase this will cause events to be
     // processed and we get into a recursive call (as in QProgressDialog).
     if (downloadProgressSignalChoke.elapsed() >= progressSignalInterval) {
@@ -1381,11 +1402,17 @@ void QNetworkReplyHttpImplPrivate::replyDownloadProgressSlot(qint64 bytesReceive
 
     downloadBufferCurrentSize = bytesReceived;
 
-    // Only emit readyRead when actual data is there
-    // emit readyRead before downloadProgress incase this will cause events to be
-    // processed and we get into a recursive call (as in QProgressDialog).
-    if (bytesDownloaded > 0)
+    if (downloadSink) {
+        // Write straight out of the zerocopy buffer
+        downloadSink->write(downloadZerocopyBuffer + downloadBufferReadPosition,
+                            downloadBufferCurrentSize - downloadBufferReadPosition);
+        downloadBufferReadPosition = downloadBufferCurrentSize;
+    } else if (bytesDownloaded > 0) {
+        // Only emit readyRead when actual data is there
+        // emit readyRead before downloadProgress incase this will cause events to be
+        // processed and we get into a recursive call (as in QProgressDialog).
         emit q->readyRead();
+    }
     if (downloadProgressSignalChoke.elapsed() >= progressSignalInterval) {
         downloadProgressSignalChoke.restart();
         emit q->downloadProgress(bytesDownloaded, bytesTotal);
@@ -69,3 +69,17 @@ connect(reply, &QNetworkReply::errorOccurred,
 connect(reply, &QNetworkReply::sslErrors,
         this, &MyClass::slotSslErrors);
 //! [1]
+
+
+//! [2]
+QHttpConnectionPoolConfiguration pool;
+pool.setMaximumConnectionsPerHost(32);
+pool.setMaximumConnections(256);
+pool.setIdleTimeout(30 * 1000);
+pool.setPreConnectCount(8);
+manager->setConnectionPoolConfiguration(pool);
+
+QSslConfiguration sslConfiguration = QSslConfiguration::defaultConfiguration();
+sslConfiguration.setAllowedNextProtocols({QSslConfiguration::NextProtocolHttp1_1});
+manager->connectToHostEncrypted("qt-project.org", 443, sslConfiguration);
+//! [2]
@@ -58,3 +58,14 @@ QNetworkReply *reply = manager.get(QNetworkRequest(QUrl("https://server.tld/inde
 reply->ignoreSslErrors(expectedSslErrors);
 // here connect signals etc.
 //! [0]
+
+
+//! [1]
+QFile *file = new QFile("image.iso");
+file->open(QIODevice::WriteOnly);
+
+QNetworkReply *reply = manager.get(QNetworkRequest(QUrl("https://server.tld/image.iso")));
+reply->setReadBufferSize(1024 * 1024);
+reply->setDownloadSink(file);
+connect(reply, &QNetworkReply::finished, file, &QFile::close);
+//! [1]
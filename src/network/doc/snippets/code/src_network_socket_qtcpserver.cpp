@@ -51,3 +51,20 @@
 //! [0]
 server->setProxy(QNetworkProxy::NoProxy);
 //! [0]
+
+//! [1]
+const quint16 port = 8080;
+for (int i = 0; i < QThread::idealThreadCount(); ++i) {
+    QThread *thread = new QThread;
+    MyServer *server = new MyServer;    // handles its connections in its own thread
+    server->setPortSharingEnabled(true);
+    server->moveToThread(thread);
+    QObject::connect(thread, &QThread::finished, server, &QObject::deleteLater);
+    thread->start();
+
+    QMetaObject::invokeMethod(server, [server, port] {
+        if (!server->listen(QHostAddress::Any, port))
+            qWarning() << "Cannot listen:" << server->errorString();
+    });
+}
+//! [1]
@@ -2523,6 +2523,48 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     return written;
 }
 
+/*! \reimp
+    \since 6.0
+
+    On an unbuffered TCP socket with nothing left to write, the buffers are
+    passed to the operating system with one system call, without being
+    copied; what could not be written is buffered.
+*/
+qint64 QAbstractSocket::writeDataVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_D(QAbstractSocket);
+    if (d->state == QAbstractSocket::UnconnectedState || d->isBuffered
+        || d->socketType != TcpSocket || !d->socketEngine || !d->writeBuffer.isEmpty()) {
+        return QIODevice::writeDataVectored(buffers, count);
+    }
+
+    qint64 size = 0;
+    for (qsizetype i = 0; i < count; ++i)
+        size += buffers[i].size();
+
+    qint64 written = size ? d->socketEngine->writeVectored(buffers, count) : Q_INT64_C(0);
+    if (written < 0) {
+        d->setError(d->socketEngine->error(), d->socketEngine->errorString());
+    } else if (written < size) {
+        // Buffer what was not written yet
+        qint64 skip = written;
+        for (qsizetype i = 0; i < count; ++i) {
+            const qint64 bufferSize = buffers[i].size();
+            if (skip < bufferSize)
+                d->writeBuffer.append(buffers[i].data() + skip, bufferSize - skip);
+            skip = qMax(Q_INT64_C(0), skip - bufferSize);
+        }
+        written = size;
+        d->socketEngine->setWriteNotificationEnabled(true);
+    }
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocket::writeDataVectored(%p, %lld) == %lli", buffers,
+           qlonglong(count), written);
+#endif
+    return written; // written = actually written + what has been buffered
+}
+
 /*!
     \since 4.1
 
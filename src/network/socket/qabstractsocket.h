@@ -214,6 +214,7 @@ protected:
     qint64 readLineData(char *data, qint64 maxlen) override;
     qint64 skipData(qint64 maxSize) override;
     qint64 writeData(const char *data, qint64 len) override;
+    qint64 writeDataVectored(const QByteArrayView *buffers, qsizetype count) override;
 
     void setSocketState(SocketState state);
     void setSocketError(SocketError socketError);
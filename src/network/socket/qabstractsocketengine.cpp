@@ -259,6 +259,76 @@ void QAbstractSocketEngine::setPeerPort(quint16 port)
     d_func()->peerPort = port;
 }
 
+/*
+    Writes the \a count buffers in \a buffers to the socket as one block of
+    data and returns the number of bytes written, or -1 if an error occurred.
+    Engines that can do this with one system call reimplement this; the
+    default writes the buffers one at a time until one is not written
+    completely.
+*/
+qint64 QAbstractSocketEngine::writeVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    qint64 written = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 ret = write(buffers[i].data(), buffers[i].size());
+        if (ret < 0)
+            return written ? written : ret;
+        written += ret;
+        if (ret < buffers[i].size())
+            break;
+    }
+    return written;
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*
+    Reads up to \a maxCount pending datagrams into consecutive slots of
+    \a maxlen bytes starting at \a data, storing the size of each one in
+    \a lengths and, unless \a options is WantNone, its header in \a headers.
+
+    Returns the number of datagrams read, which is 0 if none was pending, or
+    -1 if an error occurred before any datagram could be read. Engines that
+    can receive several datagrams with one system call reimplement this;
+    the default reads them one at a time.
+*/
+int QAbstractSocketEngine::readDatagrams(char *data, qint64 maxlen, int maxCount, qint64 *lengths,
+                                         QIpPacketHeader *headers, PacketHeaderOptions options)
+{
+    int count = 0;
+    while (count < maxCount && hasPendingDatagrams()) {
+        const qint64 readBytes = readDatagram(data + count * maxlen, maxlen,
+                                              headers ? headers + count : nullptr, options);
+        if (readBytes == -2)
+            break;
+        if (readBytes < 0)
+            return count ? count : -1;
+        lengths[count++] = readBytes;
+    }
+    return count;
+}
+
+/*
+    Sends \a count datagrams, the i-th one being \a lengths[i] bytes from
+    \a data[i] to the destination in \a headers[i].
+
+    Returns the number of datagrams sent, which is less than \a count if the
+    send buffer filled up, or -1 if an error occurred before any datagram
+    could be sent. The default implementation sends them one at a time.
+*/
+int QAbstractSocketEngine::writeDatagrams(const char *const *data, const qint64 *lengths,
+                                          const QIpPacketHeader *const *headers, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const qint64 sent = writeDatagram(data[i], lengths[i], *headers[i]);
+        if (sent == -2)
+            return i;
+        if (sent < 0)
+            return i ? i : -1;
+    }
+    return count;
+}
+#endif // QT_NO_UDPSOCKET
+
 int QAbstractSocketEngine::inboundStreamCount() const
 {
     return d_func()->inboundStreamCount;
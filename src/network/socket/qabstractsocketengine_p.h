@@ -107,7 +107,8 @@ public:
         ReceivePacketInformation,
         ReceiveHopLimit,
         MaxStreamsSocketOption,
-        PathMtuInformation
+        PathMtuInformation,
+        ReusePortOption
     };
 
     enum PacketHeaderOption {
@@ -141,6 +142,7 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 writeVectored(const QByteArrayView *buffers, qsizetype count);
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -159,6 +161,12 @@ public:
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = nullptr,
                                 PacketHeaderOptions = WantNone) = 0;
     virtual qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &header) = 0;
+#ifndef QT_NO_UDPSOCKET
+    virtual int readDatagrams(char *data, qint64 maxlen, int maxCount, qint64 *lengths,
+                              QIpPacketHeader *headers = nullptr, PacketHeaderOptions = WantNone);
+    virtual int writeDatagrams(const char *const *data, const qint64 *lengths,
+                               const QIpPacketHeader *const *headers, int count);
+#endif
     virtual qint64 bytesToWrite() const = 0;
 
     virtual int option(SocketOption option) const = 0;
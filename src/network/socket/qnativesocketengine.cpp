@@ -902,6 +902,61 @@ qint64 QNativeSocketEngine::writeDatagram(const char *data, qint64 size, const Q
     return d->nativeSendDatagram(data, size, header);
 }
 
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a maxCount datagrams of at most \a maxSize bytes each into
+    consecutive slots of \a data. The size of each datagram is stored in
+    \a lengths and, if \a options is not WantNone, its header in \a headers.
+
+    On Linux, all of them are received with a single system call.
+
+    Returns the number of datagrams read, 0 if none was pending, or -1 if an
+    error occurred.
+
+    \sa readDatagram()
+*/
+int QNativeSocketEngine::readDatagrams(char *data, qint64 maxSize, int maxCount, qint64 *lengths,
+                                       QIpPacketHeader *headers, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+    if (maxSize > 0 && maxCount > 0)
+        return d->nativeReceiveDatagrams(data, maxSize, maxCount, lengths, headers, options);
+#endif
+    return QAbstractSocketEngine::readDatagrams(data, maxSize, maxCount, lengths, headers, options);
+}
+
+/*!
+    Writes \a count datagrams, the i-th one being \a lengths[i] bytes from
+    \a data[i] to the destination contained in \a headers[i].
+
+    On Linux, they are sent with as few system calls as possible.
+
+    Returns the number of datagrams written, which is less than \a count if
+    the socket's send buffer is full, or -1 if an error occurred.
+
+    \sa writeDatagram()
+*/
+int QNativeSocketEngine::writeDatagrams(const char *const *data, const qint64 *lengths,
+                                        const QIpPacketHeader *const *headers, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+    if (count > 0)
+        return d->nativeSendDatagrams(data, lengths, headers, count);
+#endif
+    return QAbstractSocketEngine::writeDatagrams(data, lengths, headers, count);
+}
+#endif // QT_NO_UDPSOCKET
+
 /*!
     Writes a block of \a size bytes from \a data to the socket.
     Returns the number of bytes written, or -1 if an error occurred.
@@ -918,6 +973,23 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+/*!
+    Writes the \a count buffers in \a buffers to the socket as one block of
+    data, with a single system call where possible. Returns the number of
+    bytes written, or -1 if an error occurred.
+*/
+qint64 QNativeSocketEngine::writeVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeVectored(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeVectored(), QAbstractSocket::ConnectedState, -1);
+#ifndef Q_OS_WIN
+    return d->nativeWriteVectored(buffers, count);
+#else
+    return QAbstractSocketEngine::writeVectored(buffers, count);
+#endif
+}
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
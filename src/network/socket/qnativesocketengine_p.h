@@ -100,6 +100,11 @@ typedef INT (WSAAPI *LPFN_WSASENDMSG)(SOCKET s, LPWSAMSG lpMsg, DWORD dwFlags,
 #  endif // !WSAID_WSASENDMSG
 #endif // Q_OS_WIN
 
+// recvmmsg() and sendmmsg() transfer several datagrams in one system call
+#if defined(Q_OS_LINUX) && !defined(QT_NO_UDPSOCKET)
+#  define QT_NATIVESOCKETENGINE_MMSG
+#endif
+
 union qt_sockaddr {
     sockaddr a;
     sockaddr_in a4;
@@ -146,6 +151,7 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 writeVectored(const QByteArrayView *buffers, qsizetype count) override;
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -164,6 +170,12 @@ public:
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
                         PacketHeaderOptions = WantNone) override;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) override;
+#ifndef QT_NO_UDPSOCKET
+    int readDatagrams(char *data, qint64 maxlen, int maxCount, qint64 *lengths,
+                      QIpPacketHeader *headers = nullptr, PacketHeaderOptions = WantNone) override;
+    int writeDatagrams(const char *const *data, const qint64 *lengths,
+                       const QIpPacketHeader *const *headers, int count) override;
+#endif
     qint64 bytesToWrite() const override;
 
 #if 0   // currently unused
@@ -277,8 +289,18 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+    int nativeReceiveDatagrams(char *data, qint64 maxLength, int maxCount, qint64 *lengths,
+                               QIpPacketHeader *headers,
+                               QAbstractSocketEngine::PacketHeaderOptions options);
+    int nativeSendDatagrams(const char *const *data, const qint64 *lengths,
+                            const QIpPacketHeader *const *headers, int count);
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifndef Q_OS_WIN
+    qint64 nativeWriteVectored(const QByteArrayView *buffers, qsizetype count);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -240,6 +240,15 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
 #endif
         }
         break;
+
+    case QNativeSocketEngine::ReusePortOption:
+#if defined(SO_REUSEPORT_LB)
+        // FreeBSD only balances connections between the sockets with this one
+        n = SO_REUSEPORT_LB;
+#elif defined(SO_REUSEPORT)
+        n = SO_REUSEPORT;
+#endif
+        break;
     }
 }
 
@@ -935,11 +944,12 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+namespace {
+// Room for the ancillary data received or sent along with a datagram; we use
+// quintptr to force the alignment
+struct ReceiveControlBuffer
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
                    + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
@@ -947,7 +957,112 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
                    + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
                    + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
+
+struct SendControlBuffer
+{
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+#ifndef QT_NO_SCTP
+                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+#endif
+                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
+} // unnamed namespace
+
+/*
+    Sets up \a msg to receive the sender address into \a aa and the ancillary
+    data into \a control, as requested by \a options.
+*/
+static void qt_prepareReceiveHeader(msghdr *msg, qt_sockaddr *aa, ReceiveControlBuffer *control,
+                                    QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    if (options & QAbstractSocketEngine::WantDatagramSender) {
+        msg->msg_name = aa;
+        msg->msg_namelen = sizeof(*aa);
+    }
+    if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
+                   | QAbstractSocketEngine::WantStreamNumber)) {
+        msg->msg_control = control;
+        msg->msg_controllen = sizeof(*control);
+    }
+}
+
+/*
+    Fills \a header from the sender address \a aa and the ancillary data of
+    the datagram received with \a msg.
+*/
+static void qt_parseReceivedHeader(msghdr *msg, const qt_sockaddr *aa, quint16 localPort,
+                                   QIpPacketHeader *header)
+{
+    qt_socket_getPortAndAddress(aa, &header->senderPort, &header->senderAddress);
+    header->destinationPort = localPort;
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_CLANG("-Wsign-compare")
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != nullptr;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        QT_WARNING_POP
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
+        }
+
+#ifdef IP_PKTINFO
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
+#else
+#  ifdef IP_RECVDSTADDR
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
 
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
+#  endif
+#  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
+#  endif
+#endif
+
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            static_assert(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
+
+#ifndef QT_NO_SCTP
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+
+            header->streamNumber = int(rcvInfo->sinfo_stream);
+        }
+#endif
+    }
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    ReceiveControlBuffer cbuf;
     struct msghdr msg;
     struct iovec vec;
     qt_sockaddr aa;
@@ -960,15 +1075,7 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     vec.iov_len = maxSize ? maxSize : 1;
     msg.msg_iov = &vec;
     msg.msg_iovlen = 1;
-    if (options & QAbstractSocketEngine::WantDatagramSender) {
-        msg.msg_name = &aa;
-        msg.msg_namelen = sizeof(aa);
-    }
-    if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
-                   | QAbstractSocketEngine::WantStreamNumber)) {
-        msg.msg_control = cbuf;
-        msg.msg_controllen = sizeof(cbuf);
-    }
+    qt_prepareReceiveHeader(&msg, &aa, &cbuf, options);
 
     ssize_t recvResult = 0;
     do {
@@ -994,69 +1101,7 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
             header->clear();
     } else if (options != QAbstractSocketEngine::WantNone) {
         Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        QT_WARNING_PUSH
-        QT_WARNING_DISABLE_CLANG("-Wsign-compare")
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            QT_WARNING_POP
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
-
-#ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
-#else
-#  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
-#  endif
-#  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
-#  endif
-#endif
-
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                static_assert(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
-
-#ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
-
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
-        }
+        qt_parseReceivedHeader(&msg, &aa, localPort, header);
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
@@ -1071,37 +1116,25 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
 }
 
-qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+/*
+    Sets up \a msg to send a datagram to the destination in \a header, with
+    the other fields of \a header passed as ancillary data in \a control.
+*/
+static void qt_prepareSendHeader(QNativeSocketEnginePrivate *d, msghdr *msg, qt_sockaddr *aa,
+                                 SendControlBuffer *control, const QIpPacketHeader &header)
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
-#ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
-#endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
-
-    struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(cbuf);
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
-
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
-    vec.iov_base = const_cast<char *>(data);
-    vec.iov_len = len;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
-    msg.msg_control = &cbuf;
+    struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(control);
+    msg->msg_control = control;
 
     if (header.destinationPort != 0) {
-        msg.msg_name = &aa.a;
-        setPortAndAddress(header.destinationPort, header.destinationAddress,
-                          &aa, &msg.msg_namelen);
+        msg->msg_name = &aa->a;
+        d->setPortAndAddress(header.destinationPort, header.destinationAddress,
+                             aa, &msg->msg_namelen);
     }
 
-    if (msg.msg_namelen == sizeof(aa.a6)) {
+    if (msg->msg_namelen == sizeof(aa->a6)) {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_HOPLIMIT;
@@ -1111,7 +1144,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         if (header.ifindex != 0 || !header.senderAddress.isNull()) {
             struct in6_pktinfo *data = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
             memset(data, 0, sizeof(*data));
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_PKTINFO;
@@ -1123,7 +1156,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         }
     } else {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IP;
             cmsgptr->cmsg_type = IP_TTL;
@@ -1145,7 +1178,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
             data->s_addr = htonl(header.senderAddress.toIPv4Address());
 #  endif
             cmsgptr->cmsg_level = IPPROTO_IP;
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr = reinterpret_cast<cmsghdr *>(reinterpret_cast<char *>(cmsgptr) + CMSG_SPACE(sizeof(*data)));
         }
@@ -1156,7 +1189,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     if (header.streamNumber != -1) {
         struct sctp_sndrcvinfo *data = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
         memset(data, 0, sizeof(*data));
-        msg.msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
+        msg->msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_len = CMSG_LEN(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_level = IPPROTO_SCTP;
         cmsgptr->cmsg_type =  SCTP_SNDRCV;
@@ -1165,8 +1198,25 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     }
 #endif
 
-    if (msg.msg_controllen == 0)
-        msg.msg_control = nullptr;
+    if (msg->msg_controllen == 0)
+        msg->msg_control = nullptr;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+{
+    SendControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+
+    memset(&msg, 0, sizeof(msg));
+    memset(&aa, 0, sizeof(aa));
+    vec.iov_base = const_cast<char *>(data);
+    vec.iov_len = len;
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    qt_prepareSendHeader(this, &msg, &aa, &cbuf, header);
+
     ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
 
     if (sentBytes < 0) {
@@ -1198,6 +1248,125 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return qint64(sentBytes);
 }
 
+#ifdef QT_NATIVESOCKETENGINE_MMSG
+int QNativeSocketEnginePrivate::nativeReceiveDatagrams(char *data, qint64 maxSize, int maxCount,
+                                                       qint64 *lengths, QIpPacketHeader *headers,
+                                                       QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    Q_ASSERT(maxSize > 0);
+    Q_ASSERT(maxCount > 0);
+    const bool wantControl = options & (QAbstractSocketEngine::WantDatagramHopLimit
+                                        | QAbstractSocketEngine::WantDatagramDestination
+                                        | QAbstractSocketEngine::WantStreamNumber);
+
+    QVarLengthArray<struct mmsghdr, 64> msgs(maxCount);
+    QVarLengthArray<struct iovec, 64> vecs(maxCount);
+    QVarLengthArray<qt_sockaddr, 64> addresses(options & QAbstractSocketEngine::WantDatagramSender
+                                               ? maxCount : 0);
+    QVarLengthArray<ReceiveControlBuffer, 64> controls(wantControl ? maxCount : 0);
+    memset(msgs.data(), 0, maxCount * sizeof(struct mmsghdr));
+    memset(addresses.data(), 0, addresses.size() * sizeof(qt_sockaddr));
+
+    for (int i = 0; i < maxCount; ++i) {
+        vecs[i].iov_base = data + i * maxSize;
+        vecs[i].iov_len = maxSize;
+        msgs[i].msg_hdr.msg_iov = &vecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        qt_prepareReceiveHeader(&msgs[i].msg_hdr, addresses.data() + i, controls.data() + i,
+                                options);
+    }
+
+    int received;
+    EINTR_LOOP(received, ::recvmmsg(socketDescriptor, msgs.data(), maxCount, 0, nullptr));
+    if (received == -1) {
+        switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EAGAIN:
+            // No datagram was available for reading
+            return 0;
+        case ECONNREFUSED:
+            setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
+            break;
+        default:
+            setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+        }
+        return -1;
+    }
+
+    for (int i = 0; i < received; ++i) {
+        lengths[i] = msgs[i].msg_len;
+        if (options != QAbstractSocketEngine::WantNone) {
+            headers[i].clear();
+            qt_parseReceivedHeader(&msgs[i].msg_hdr, addresses.data() + i, localPort, headers + i);
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagrams(%p, %lli, %i) == %i",
+           data, maxSize, maxCount, received);
+#endif
+
+    return received;
+}
+
+int QNativeSocketEnginePrivate::nativeSendDatagrams(const char *const *data, const qint64 *lengths,
+                                                    const QIpPacketHeader *const *headers, int count)
+{
+    QVarLengthArray<struct mmsghdr, 64> msgs(count);
+    QVarLengthArray<struct iovec, 64> vecs(count);
+    QVarLengthArray<qt_sockaddr, 64> addresses(count);
+    QVarLengthArray<SendControlBuffer, 64> controls(count);
+    memset(msgs.data(), 0, count * sizeof(struct mmsghdr));
+    memset(addresses.data(), 0, count * sizeof(qt_sockaddr));
+
+    for (int i = 0; i < count; ++i) {
+        vecs[i].iov_base = const_cast<char *>(data[i]);
+        vecs[i].iov_len = lengths[i];
+        msgs[i].msg_hdr.msg_iov = &vecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        qt_prepareSendHeader(this, &msgs[i].msg_hdr, addresses.data() + i, controls.data() + i,
+                             *headers[i]);
+    }
+
+    // The kernel sends at most UIO_MAXIOV datagrams per call
+    int sent = 0;
+    while (sent < count) {
+        const int result = qt_safe_sendmmsg(socketDescriptor, msgs.data() + sent, count - sent, 0);
+        if (result > 0) {
+            sent += result;
+            continue;
+        }
+
+        switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EAGAIN:
+            return sent;
+        case EMSGSIZE:
+            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+            break;
+        case ECONNRESET:
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            break;
+        default:
+            setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
+        }
+        // Report the datagrams that did go out; the error is reported again
+        // when sending the next one
+        return sent ? sent : -1;
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendDatagrams(%i) == %i", count, sent);
+#endif
+
+    return sent;
+}
+#endif // QT_NATIVESOCKETENGINE_MMSG
+
 bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 {
     localPort = 0;
@@ -1363,6 +1532,53 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+qint64 QNativeSocketEnginePrivate::nativeWriteVectored(const QByteArrayView *buffers, qsizetype count)
+{
+    Q_Q(QNativeSocketEngine);
+
+#ifdef IOV_MAX
+    count = qMin<qsizetype>(count, IOV_MAX);
+#endif
+    QVarLengthArray<struct iovec, 16> vec(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        vec[i].iov_base = const_cast<char *>(buffers[i].data());
+        vec[i].iov_len = size_t(buffers[i].size());
+    }
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = vec.data();
+    msg.msg_iovlen = count;
+
+    ssize_t writtenBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        case EMSGSIZE:
+            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+            break;
+        default:
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteVectored(%p, %lld) == %zd",
+           buffers, qlonglong(count), writtenBytes);
+#endif
+
+    return qint64(writtenBytes);
+}
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
@@ -285,6 +285,7 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
         break;
 
     case QAbstractSocketEngine::PathMtuInformation:
+    case QAbstractSocketEngine::ReusePortOption:
         break;          // not supported on Windows
     }
 }
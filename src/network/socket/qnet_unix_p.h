@@ -192,6 +192,17 @@ static inline int qt_safe_recvmsg(int sockfd, struct msghdr *msg, int flags)
     return ret;
 }
 
+#ifdef Q_OS_LINUX
+static inline int qt_safe_sendmmsg(int sockfd, struct mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+    flags |= MSG_NOSIGNAL;
+
+    int ret;
+    EINTR_LOOP(ret, ::sendmmsg(sockfd, msgvec, vlen, flags));
+    return ret;
+}
+#endif
+
 QT_END_NAMESPACE
 
 #endif // QNET_UNIX_P_H
@@ -124,6 +124,7 @@ QTcpServerPrivate::QTcpServerPrivate()
  , socketEngine(nullptr)
  , serverSocketError(QAbstractSocket::UnknownSocketError)
  , maxConnections(30)
+ , portSharing(false)
 {
 }
 
@@ -325,6 +326,12 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
 
     d->configureCreatedSocket();
 
+    if (d->portSharing && !d->socketEngine->setOption(QAbstractSocketEngine::ReusePortOption, 1)) {
+        d->serverSocketError = QAbstractSocket::UnsupportedSocketOperationError;
+        d->serverSocketErrorString = tr("Port sharing is not supported on this platform");
+        return false;
+    }
+
     if (!d->socketEngine->bind(addr, port)) {
         d->serverSocketError = d->socketEngine->error();
         d->serverSocketErrorString = d->socketEngine->errorString();
@@ -649,6 +656,50 @@ int QTcpServer::maxPendingConnections() const
     return d_func()->maxConnections;
 }
 
+/*!
+    \since 6.0
+
+    If \a enable is \c true, the next call to listen() allows other
+    QTcpServer objects that also enable port sharing to listen on the same
+    address and port at the same time. The operating system then distributes
+    incoming connections between all of them.
+
+    This makes it possible to accept and handle connections on several
+    threads without passing socket descriptors between them: create one
+    server per thread, each living in its thread and listening on the same
+    port, so that every connection is accepted and serviced by the thread
+    whose server accepted it.
+
+    \snippet code/src_network_socket_qtcpserver.cpp 1
+
+    Port sharing is implemented with the \c SO_REUSEPORT socket option
+    (\c SO_REUSEPORT_LB on FreeBSD). It is not available on Windows, in
+    which case listen() fails with QAbstractSocket::UnsupportedSocketOperationError.
+    On most systems, only servers run by the same user can share a port.
+
+    The default is \c false. Changing this setting has no effect on a
+    server that is already listening.
+
+    \sa isPortSharingEnabled(), listen()
+*/
+void QTcpServer::setPortSharingEnabled(bool enable)
+{
+    d_func()->portSharing = enable;
+}
+
+/*!
+    \since 6.0
+
+    Returns \c true if listen() allows other servers to share the port;
+    otherwise returns \c false.
+
+    \sa setPortSharingEnabled()
+*/
+bool QTcpServer::isPortSharingEnabled() const
+{
+    return d_func()->portSharing;
+}
+
 /*!
     Returns an error code for the last error that occurred.
 
@@ -102,6 +102,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -125,6 +126,9 @@ public:
 
     inline bool ensureInitialized(const QHostAddress &remoteAddress)
     { return doEnsureInitialized(QHostAddress(), 0, remoteAddress); }
+
+    // scratch space for receiveDatagrams(), kept to avoid reallocating it
+    QByteArray datagramBuffer;
 };
 
 bool QUdpSocketPrivate::doEnsureInitialized(const QHostAddress &bindAddress, quint16 bindPort,
@@ -476,6 +480,137 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 6.0
+
+    Receives up to \a maxCount pending datagrams, each no larger than
+    \a maxSize bytes, and returns them in the order in which they arrived.
+    Each QNetworkDatagram carries the sender's host address and port and, if
+    possible, the destination address and port, and the hop count.
+
+    Returns an empty list if no datagram is pending or if an error occurred.
+
+    This is equivalent to calling receiveDatagram() while
+    hasPendingDatagrams() returns \c true, but on platforms that support it
+    several datagrams are received with each system call, which is
+    considerably faster when many small datagrams arrive in a burst.
+
+    If \a maxSize is too small, the rest of each larger datagram will be
+    lost. If \a maxSize is -1 (the default), datagrams of up to 65535 bytes
+    are received in full.
+
+    \sa receiveDatagram(), writeDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(int maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%d, %lld)", maxCount, maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    QList<QNetworkDatagram> result;
+    if (maxCount <= 0)
+        return result;
+    if (maxSize < 0)
+        maxSize = 65535;
+    // the kernel needs room for at least one byte of each datagram
+    const qint64 slotSize = qMax<qint64>(maxSize, 1);
+
+    // Receive in batches whose scratch buffer stays reasonably small
+    const int batchSize = int(qBound(qint64(1), (1 << 20) / slotSize, qint64(64)));
+    QVarLengthArray<qint64, 64> lengths(batchSize);
+    QVarLengthArray<QIpPacketHeader, 64> headers(batchSize);
+    if (d->datagramBuffer.size() < batchSize * slotSize)
+        d->datagramBuffer.resize(batchSize * slotSize);
+    char *buffer = d->datagramBuffer.data();
+
+    while (result.size() < maxCount) {
+        const int wanted = qMin(batchSize, maxCount - int(result.size()));
+        const int count = d->socketEngine->readDatagrams(buffer, slotSize, wanted,
+                                                         lengths.data(), headers.data(),
+                                                         QAbstractSocketEngine::WantAll);
+        if (count < 0) {
+            d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+            break;
+        }
+
+        result.reserve(result.size() + count);
+        for (int i = 0; i < count; ++i) {
+            const QByteArray data(buffer + i * slotSize, qMin(lengths[i], maxSize));
+            result.append(QNetworkDatagram(*new QNetworkDatagramPrivate(data, headers[i])));
+        }
+        if (count < wanted)
+            break;
+    }
+
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    return result;
+}
+
+/*!
+    \since 6.0
+
+    Sends the \a datagrams, each to the destination and with the options it
+    carries, and returns the number of datagrams sent, or -1 if an error
+    occurred before any of them could be sent. bytesWritten() is emitted
+    once with the total size of the datagrams that were sent.
+
+    This is equivalent to calling writeDatagram() for each element of
+    \a datagrams, but on platforms that support it several datagrams are
+    passed to the operating system with each system call.
+
+    If fewer datagrams than requested were sent, the send buffer was full or
+    an error occurred while sending the first datagram that was not sent.
+    The caller may try again later with the remaining ones.
+
+    \warning As with writeDatagram(), calling this function on a connected
+    UDP socket may result in an error and no packet being sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qsizetype QUdpSocket::writeDatagrams(const QList<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lld)", qlonglong(datagrams.size()));
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.constFirst().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    const int count = int(qMin<qsizetype>(datagrams.size(), std::numeric_limits<int>::max()));
+    QVarLengthArray<const char *, 64> data(count);
+    QVarLengthArray<qint64, 64> lengths(count);
+    QVarLengthArray<const QIpPacketHeader *, 64> headers(count);
+    for (int i = 0; i < count; ++i) {
+        const QNetworkDatagramPrivate *dd = datagrams.at(i).d;
+        data[i] = dd->data.constData();
+        lengths[i] = dd->data.size();
+        headers[i] = &dd->header;
+    }
+
+    const int sent = d->socketEngine->writeDatagrams(data.constData(), lengths.constData(),
+                                                     headers.constData(), count);
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent < 0) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        return -1;
+    }
+    qint64 written = 0;
+    for (int i = 0; i < sent; ++i)
+        written += lengths[i];
+    if (sent > 0)
+        emit bytesWritten(written);
+    return sent;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
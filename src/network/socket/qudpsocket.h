@@ -75,9 +75,11 @@ public:
     bool hasPendingDatagrams() const;
     qint64 pendingDatagramSize() const;
     QNetworkDatagram receiveDatagram(qint64 maxSize = -1);
+    QList<QNetworkDatagram> receiveDatagrams(int maxCount, qint64 maxSize = -1);
     qint64 readDatagram(char *data, qint64 maxlen, QHostAddress *host = nullptr, quint16 *port = nullptr);
 
     qint64 writeDatagram(const QNetworkDatagram &datagram);
+    qsizetype writeDatagrams(const QList<QNetworkDatagram> &datagrams);
     qint64 writeDatagram(const char *data, qint64 len, const QHostAddress &host, quint16 port);
     inline qint64 writeDatagram(const QByteArray &datagram, const QHostAddress &host, quint16 port)
         { return writeDatagram(datagram.constData(), datagram.size(), host, port); }
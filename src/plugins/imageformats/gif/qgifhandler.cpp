@@ -73,6 +73,7 @@ public:
     int decode(QImage *image, const uchar* buffer, int length,
                int *nextFrameDelay, int *loopCount);
     static void scan(QIODevice *device, QList<QSize> *imageSizes, int *loopCount);
+    QRect takeChangedRect();
 
     bool newFrame;
     bool partialNewFrame;
@@ -144,6 +145,7 @@ private:
     int frame;
     bool out_of_bounds;
     bool digress;
+    QRect changedRect;
     void nextY(unsigned char *bits, int bpl);
     void disposePrevious(QImage *image);
 };
@@ -185,7 +187,7 @@ void QGIFFormat::disposePrevious(QImage *image)
 {
     if (out_of_bounds) {
         // flush anything that survived
-        // ### Changed: QRect(0, 0, swidth, sheight)
+        changedRect |= QRect(0, 0, swidth, sheight);
     }
 
     // Handle disposal of previous image before processing next one
@@ -214,7 +216,7 @@ void QGIFFormat::disposePrevious(QImage *image)
             const QRgb *bits = reinterpret_cast<const QRgb *>(image->constBits());
             fillRect(image, l, t, r-l+1, b-t+1, bits[0]);
         }
-        // ### Changed: QRect(l, t, r-l+1, b-t+1)
+        changedRect |= QRect(l, t, r-l+1, b-t+1);
         break;
       case RestoreImage: {
         if (frame >= 0) {
@@ -223,7 +225,7 @@ void QGIFFormat::disposePrevious(QImage *image)
                     backingstore.constScanLine(ln-t),
                     (r-l+1)*sizeof(QRgb));
             }
-            // ### Changed: QRect(l, t, r-l+1, b-t+1)
+            changedRect |= QRect(l, t, r-l+1, b-t+1);
         }
       }
     }
@@ -326,7 +328,7 @@ int QGIFFormat::decode(QImage *image, const uchar *buffer, int length,
                 state=ExtensionLabel;
                 break;
               case ';':
-                  // ### Changed: QRect(0, 0, swidth, sheight)
+                changedRect |= QRect(0, 0, swidth, sheight);
                 state=Done;
                 break;
               default:
@@ -407,10 +409,10 @@ int QGIFFormat::decode(QImage *image, const uchar *buffer, int length,
                         // Not full-size image - erase with bg or transparent
                         if (trans_index >= 0) {
                             fillRect(image, 0, 0, swidth, sheight, color(trans_index));
-                            // ### Changed: QRect(0, 0, swidth, sheight)
+                            changedRect |= QRect(0, 0, swidth, sheight);
                         } else if (bgcol>=0) {
                             fillRect(image, 0, 0, swidth, sheight, color(bgcol));
-                            // ### Changed: QRect(0, 0, swidth, sheight)
+                            changedRect |= QRect(0, 0, swidth, sheight);
                         }
                     }
                 }
@@ -958,6 +960,19 @@ void QGIFFormat::scan(QIODevice *device, QList<QSize> *imageSizes, int *loopCoun
     return;
 }
 
+/*!
+    Returns the area of the image changed since the last call, including
+    the part of the current row decoded so far.
+*/
+QRect QGIFFormat::takeChangedRect()
+{
+    QRect rect = changedRect;
+    if (state == ImageDataBlock && !out_of_bounds && x > left)
+        rect |= QRect(left, y, x - left, 1);
+    changedRect = QRect();
+    return rect;
+}
+
 void QGIFFormat::fillRect(QImage *image, int col, int row, int w, int h, QRgb color)
 {
     if (w>0) {
@@ -976,9 +991,7 @@ void QGIFFormat::nextY(unsigned char *bits, int bpl)
     int my;
     switch (interlace) {
     case 0: // Non-interlaced
-        // if (!out_of_bounds) {
-        //     ### Changed: QRect(left, y, right - left + 1, 1);
-        // }
+        changedRect |= QRect(left, y, right - left + 1, 1);
         y++;
         break;
     case 1: {
@@ -992,11 +1005,7 @@ void QGIFFormat::nextY(unsigned char *bits, int bpl)
             }
         }
 
-        // if (!out_of_bounds) {
-        //     ### Changed: QRect(left, y, right - left + 1, my + 1);
-        // }
-//        if (!out_of_bounds)
-//            qDebug("consumer->changed(QRect(%d, %d, %d, %d))", left, y, right-left+1, my+1);
+        changedRect |= QRect(left, y, right - left + 1, my + 1);
         y+=8;
         if (y>bottom) {
             interlace++; y=top+4;
@@ -1021,9 +1030,7 @@ void QGIFFormat::nextY(unsigned char *bits, int bpl)
             }
         }
 
-        // if (!out_of_bounds) {
-        //     ### Changed: QRect(left, y, right - left + 1, my + 1);
-        // }
+        changedRect |= QRect(left, y, right - left + 1, my + 1);
         y+=8;
         if (y>bottom) {
             interlace++; y=top+2;
@@ -1044,16 +1051,12 @@ void QGIFFormat::nextY(unsigned char *bits, int bpl)
                        (right-left+1)*sizeof(QRgb));
             }
         }
-        // if (!out_of_bounds) {
-        //     ### Changed: QRect(left, y, right - left + 1, my + 1);
-        // }
+        changedRect |= QRect(left, y, right - left + 1, my + 1);
         y+=4;
         if (y>bottom) { interlace++; y=top+1; }
     } break;
     case 4:
-        // if (!out_of_bounds) {
-        //     ### Changed: QRect(left, y, right - left + 1, 1);
-        // }
+        changedRect |= QRect(left, y, right - left + 1, 1);
         y+=2;
     }
 
@@ -1163,6 +1166,27 @@ bool QGifHandler::read(QImage *image)
     return false;
 }
 
+bool QGifHandler::supportsProgressiveDecoding() const
+{
+    return true;
+}
+
+bool QGifHandler::decodeProgressively(const QByteArray &data, QImage *image,
+                                      QRect *updatedRect, bool *finished)
+{
+    buffer += data;
+    while (!gifFormat->newFrame && !buffer.isEmpty()) {
+        int decoded = gifFormat->decode(image, (const uchar *)buffer.constData(), buffer.size(),
+                                        &nextDelay, &loopCnt);
+        if (decoded == -1)
+            return false;
+        buffer.remove(0, decoded);
+    }
+    *updatedRect = gifFormat->takeChangedRect() & image->rect();
+    *finished = gifFormat->newFrame;
+    return true;
+}
+
 bool QGifHandler::write(const QImage &image)
 {
     Q_UNUSED(image);
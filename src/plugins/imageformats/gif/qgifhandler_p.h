@@ -84,6 +84,10 @@ public:
     int nextImageDelay() const override;
     int currentImageNumber() const override;
 
+    bool supportsProgressiveDecoding() const override;
+    bool decodeProgressively(const QByteArray &data, QImage *image,
+                             QRect *updatedRect, bool *finished) override;
+
 private:
     bool imageIsComing() const;
     QGIFFormat *gifFormat;
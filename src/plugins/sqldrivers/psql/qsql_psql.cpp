@@ -43,6 +43,7 @@
 #include <qvariant.h>
 #include <qdatetime.h>
 #include <qregularexpression.h>
+#include <qsqlbatch.h>
 #include <qsqlerror.h>
 #include <qsqlfield.h>
 #include <qsqlindex.h>
@@ -54,6 +55,7 @@
 #include <QtSql/private/qsqlresult_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <QtCore/private/qlocale_tools_p.h>
+#include <QtCore/private/qtools_p.h>
 
 #include <queue>
 
@@ -61,6 +63,7 @@
 #include <pg_config.h>
 
 #include <cmath>
+#include <cstdlib>
 
 // workaround for postgres defining their OIDs in a private header file
 #define QBOOLOID 16
@@ -143,6 +146,12 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+    bool execBatch(bool arrayBind) override;
+    QSqlBatch fetchBatch(int maxRows) override;
+
+private:
+    bool execCopy(const QList<QVariantList> &columns, qsizetype rowCount);
+    bool execPipelined(const QList<QVariantList> &columns, qsizetype rowCount);
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -262,8 +271,18 @@ void QPSQLDriverPrivate::finishQuery(StatementId stmtId)
 
 void QPSQLDriverPrivate::discardResults() const
 {
-    while (PGresult *result = PQgetResult(connection))
+    while (PGresult *result = PQgetResult(connection)) {
+        // PQgetResult() does not leave the COPY state on its own
+        const ExecStatusType status = PQresultStatus(result);
         PQclear(result);
+        if (status == PGRES_COPY_IN) {
+            PQputCopyEnd(connection, "COPY discarded");
+        } else if (status == PGRES_COPY_OUT) {
+            char *buffer = nullptr;
+            while (PQgetCopyData(connection, &buffer, 0) > 0)
+                qPQfreemem(buffer);
+        }
+    }
 }
 
 StatementId QPSQLDriverPrivate::generateStatementId()
@@ -301,7 +320,18 @@ public:
     bool canFetchMoreRows = false;
     bool preparedQueriesEnabled = false;
 
+    // COPY statements are never prepared; the rows of COPY ... TO STDOUT
+    // come from PQgetCopyData() instead of from the PGresult
+    QList<QByteArray> copyRows;
+    mutable QList<QByteArray> copyFields;
+    mutable int copyFieldsRow = -1;
+    bool isCopyStatement = false;
+    bool copyOut = false;
+
     bool processResults();
+    void copyIn(const QList<QVariantList> &columns, qsizetype rowCount);
+    bool readCopyRow();
+    const QByteArray &copyField(int row, int column) const;
 };
 
 static QSqlError qMakeError(const QString &err, QSqlError::ErrorType type,
@@ -352,6 +382,23 @@ bool QPSQLResultPrivate::processResults()
         currentSize = -1;
         canFetchMoreRows = false;
         return true;
+    case PGRES_COPY_IN:
+        // COPY ... FROM STDIN executed without any values
+        copyIn({}, 0);
+        return processResults();
+    case PGRES_COPY_OUT:
+        q->setSelect(true);
+        q->setActive(true);
+        copyOut = true;
+        currentSize = -1;
+        canFetchMoreRows = true;
+        if (!q->isForwardOnly()) {
+            while (readCopyRow()) {}
+            if (q->lastError().isValid())
+                break;
+            currentSize = copyRows.size();
+        }
+        return true;
     default:
         break;
     }
@@ -364,6 +411,231 @@ bool QPSQLResultPrivate::processResults()
     return false;
 }
 
+static bool qIsCopyStatement(const QString &query)
+{
+    return QStringView(query).trimmed().startsWith(QLatin1String("COPY"), Qt::CaseInsensitive);
+}
+
+static bool qIsCopyResult(const PGresult *result)
+{
+    const ExecStatusType status = PQresultStatus(result);
+    return status == PGRES_COPY_IN || status == PGRES_COPY_OUT || status == PGRES_COPY_BOTH;
+}
+
+// appends value in the text format of COPY, see
+// https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.2
+static void qAppendCopyValue(QByteArray *row, const QVariant &value, const QPSQLDriverPrivate *driver)
+{
+    if (value.isNull()) {
+        row->append("\\N");
+        return;
+    }
+
+    QByteArray text;
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        text = value.toBool() ? "t" : "f";
+        break;
+    case QMetaType::Float:
+    case QMetaType::Double: {
+        const double dbl = value.toDouble();
+        if (qIsNaN(dbl))
+            text = "NaN";
+        else if (qIsInf(dbl))
+            text = dbl < 0 ? "-Infinity" : "Infinity";
+        else
+            text = QByteArray::number(dbl, 'g', QLocale::FloatingPointShortest);
+        break;
+    }
+    case QMetaType::QByteArray: {
+        // bytea input, with the backslash itself escaped for COPY
+        const QByteArray ba = value.toByteArray();
+        if (driver->pro >= QPSQLDriver::Version9) {
+            row->append("\\\\x").append(ba.toHex());
+        } else {
+            for (char c : ba)
+                row->append("\\\\").append(QByteArray::number(uchar(c), 8).rightJustified(3, '0'));
+        }
+        return;
+    }
+#if QT_CONFIG(datestring)
+    case QMetaType::QDateTime: {
+        const QDateTime dateTime = value.toDateTime();
+        if (!dateTime.isValid()) {
+            row->append("\\N");
+            return;
+        }
+        text = QLocale::c().toString(dateTime.toUTC(), u"yyyy-MM-ddThh:mm:ss.zzz").toLatin1() + 'Z';
+        break;
+    }
+    case QMetaType::QTime: {
+        const QTime time = value.toTime();
+        if (!time.isValid()) {
+            row->append("\\N");
+            return;
+        }
+        text = time.toString(u"hh:mm:ss.zzz").toLatin1();
+        break;
+    }
+#endif
+    default: {
+        const QString str = value.toString();
+        text = driver->isUtf8 ? str.toUtf8() : str.toLocal8Bit();
+        break;
+    }
+    }
+
+    for (char c : qAsConst(text)) {
+        switch (c) {
+        case '\\':
+            row->append("\\\\");
+            break;
+        case '\t':
+            row->append("\\t");
+            break;
+        case '\n':
+            row->append("\\n");
+            break;
+        case '\r':
+            row->append("\\r");
+            break;
+        default:
+            row->append(c);
+            break;
+        }
+    }
+}
+
+// splits a line of COPY text output into its fields, a null QByteArray
+// stands for NULL
+static QList<QByteArray> qSplitCopyRow(const QByteArray &line)
+{
+    QList<QByteArray> fields;
+    for (const QByteArray &field : line.split('\t')) {
+        if (field == "\\N") {
+            fields.append(QByteArray());
+            continue;
+        }
+        QByteArray value(field.size(), Qt::Uninitialized);
+        value.truncate(0);
+        for (qsizetype i = 0; i < field.size(); ++i) {
+            char c = field.at(i);
+            if (c == '\\' && i + 1 < field.size()) {
+                c = field.at(++i);
+                switch (c) {
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                case 'v': c = '\v'; break;
+                case 'x': {
+                    int code = 0;
+                    int digits = 0;
+                    for (int digit; digits < 2 && i + 1 < field.size()
+                         && (digit = QtMiscUtils::fromHex(uchar(field.at(i + 1)))) >= 0; ++digits) {
+                        code = code * 16 + digit;
+                        ++i;
+                    }
+                    if (digits)
+                        c = char(code);
+                    break;
+                }
+                default:
+                    if (c >= '0' && c <= '7') {
+                        int code = c - '0';
+                        for (int digits = 1; digits < 3 && i + 1 < field.size()
+                             && field.at(i + 1) >= '0' && field.at(i + 1) <= '7'; ++digits) {
+                            code = code * 8 + (field.at(++i) - '0');
+                        }
+                        c = char(code);
+                    }
+                    break;
+                }
+            }
+            value.append(c);
+        }
+        fields.append(value);
+    }
+    return fields;
+}
+
+// sends the rows of a COPY ... FROM STDIN and replaces result with the
+// result of the COPY command itself
+void QPSQLResultPrivate::copyIn(const QList<QVariantList> &columns, qsizetype rowCount)
+{
+    PGconn *connection = drv_d_func()->connection;
+    // flush in chunks of about the size libpq sends at once anyway
+    constexpr qsizetype ChunkSize = 64 * 1024;
+    QByteArray buffer;
+    buffer.reserve(ChunkSize + 1024);
+    bool ok = true;
+    for (qsizetype row = 0; ok && row < rowCount; ++row) {
+        for (int i = 0; i < columns.count(); ++i) {
+            if (i > 0)
+                buffer.append('\t');
+            qAppendCopyValue(&buffer, columns.at(i).at(row), drv_d_func());
+        }
+        buffer.append('\n');
+        if (buffer.size() >= ChunkSize || row == rowCount - 1) {
+            ok = PQputCopyData(connection, buffer.constData(), int(buffer.size())) == 1;
+            buffer.truncate(0);
+        }
+    }
+    PQputCopyEnd(connection, ok ? nullptr : "Unable to send data");
+
+    PQclear(result);
+    result = drv_d_func()->getResult(stmtId);
+}
+
+// reads the next row of a COPY ... TO STDOUT, for forward-only queries only
+// the current row is kept
+bool QPSQLResultPrivate::readCopyRow()
+{
+    Q_Q(QPSQLResult);
+    if (!canFetchMoreRows)
+        return false;
+    if (stmtId != drv_d_func()->currentStmtId) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Query results lost - probably discarded on executing "
+                        "another SQL query."), QSqlError::StatementError, drv_d_func()));
+        canFetchMoreRows = false;
+        return false;
+    }
+
+    char *buffer = nullptr;
+    const int size = PQgetCopyData(drv_d_func()->connection, &buffer, 0);
+    if (size > 0) {
+        QByteArray line(buffer, buffer[size - 1] == '\n' ? size - 1 : size);
+        qPQfreemem(buffer);
+        if (q->isForwardOnly())
+            copyRows.clear();
+        copyRows.append(line);
+        copyFieldsRow = -1;
+        return true;
+    }
+
+    // -1 marks the end of the data, followed by the result of the COPY command
+    canFetchMoreRows = false;
+    PGresult *end = drv_d_func()->getResult(stmtId);
+    if (size != -1 || PQresultStatus(end) != PGRES_COMMAND_OK) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to get result"), QSqlError::StatementError, drv_d_func(), end));
+    }
+    PQclear(end);
+    return false;
+}
+
+const QByteArray &QPSQLResultPrivate::copyField(int row, int column) const
+{
+    static const QByteArray null;
+    if (copyFieldsRow != row) {
+        copyFields = qSplitCopyRow(copyRows.value(row));
+        copyFieldsRow = row;
+    }
+    return column < copyFields.size() ? copyFields.at(column) : null;
+}
+
 static QVariant::Type qDecodePSQLType(int t)
 {
     QVariant::Type type = QVariant::Invalid;
@@ -410,6 +682,23 @@ static QVariant::Type qDecodePSQLType(int t)
     return type;
 }
 
+static bool qDecodePSQLDouble(const char *val, double *dbl)
+{
+    bool ok;
+    *dbl = qstrtod(val, nullptr, &ok);
+    if (!ok) {
+        if (qstricmp(val, "NaN") == 0)
+            *dbl = qQNaN();
+        else if (qstricmp(val, "Infinity") == 0)
+            *dbl = qInf();
+        else if (qstricmp(val, "-Infinity") == 0)
+            *dbl = -qInf();
+        else
+            return false;
+    }
+    return true;
+}
+
 void QPSQLResultPrivate::deallocatePreparedStmt()
 {
     if (drv_d_func()) {
@@ -463,6 +752,9 @@ void QPSQLResult::cleanup()
     setAt(QSql::BeforeFirstRow);
     d->currentSize = -1;
     d->canFetchMoreRows = false;
+    d->copyOut = false;
+    d->copyRows.clear();
+    d->copyFieldsRow = -1;
     setActive(false);
 }
 
@@ -493,7 +785,7 @@ bool QPSQLResult::fetch(int i)
 
 bool QPSQLResult::fetchFirst()
 {
-    Q_D(const QPSQLResult);
+    Q_D(QPSQLResult);
     if (!isActive())
         return false;
     if (at() == 0)
@@ -501,6 +793,12 @@ bool QPSQLResult::fetchFirst()
 
     if (isForwardOnly()) {
         if (at() == QSql::BeforeFirstRow) {
+            if (d->copyOut) {
+                if (!d->readCopyRow())
+                    return false;
+                setAt(0);
+                return true;
+            }
             // First result has been already fetched by exec() or
             // nextResult(), just check it has at least one row.
             if (d->result && PQntuples(d->result) > 0) {
@@ -551,6 +849,12 @@ bool QPSQLResult::fetchNext()
     if (isForwardOnly()) {
         if (!d->canFetchMoreRows)
             return false;
+        if (d->copyOut) {
+            if (!d->readCopyRow())
+                return false;
+            setAt(currentRow + 1);
+            return true;
+        }
         PQclear(d->result);
         d->result = d->drv_d_func()->getResult(d->stmtId);
         if (!d->result) {
@@ -631,6 +935,12 @@ QVariant QPSQLResult::data(int i)
         return QVariant();
     }
     const int currentRow = isForwardOnly() ? 0 : at();
+    if (d->copyOut) {
+        const QByteArray &field = d->copyField(currentRow, i);
+        if (field.isNull())
+            return QVariant(QMetaType::fromType<QString>(), nullptr);
+        return d->drv_d_func()->isUtf8 ? QString::fromUtf8(field) : QString::fromLatin1(field);
+    }
     int ptype = PQftype(d->result, i);
     QVariant::Type type = qDecodePSQLType(ptype);
     if (PQgetisnull(d->result, currentRow, i))
@@ -653,18 +963,9 @@ QVariant QPSQLResult::data(int i)
             if (numericalPrecisionPolicy() == QSql::HighPrecision)
                 return QString::fromLatin1(val);
         }
-        bool ok;
-        double dbl = qstrtod(val, nullptr, &ok);
-        if (!ok) {
-            if (qstricmp(val, "NaN") == 0)
-                dbl = qQNaN();
-            else if (qstricmp(val, "Infinity") == 0)
-                dbl = qInf();
-            else if (qstricmp(val, "-Infinity") == 0)
-                dbl = -qInf();
-            else
-                return QVariant();
-        }
+        double dbl;
+        if (!qDecodePSQLDouble(val, &dbl))
+            return QVariant();
         if (ptype == QNUMERICOID) {
             if (numericalPrecisionPolicy() == QSql::LowPrecisionInt64)
                 return QVariant((qlonglong)dbl);
@@ -712,9 +1013,70 @@ bool QPSQLResult::isNull(int field)
 {
     Q_D(const QPSQLResult);
     const int currentRow = isForwardOnly() ? 0 : at();
+    if (d->copyOut)
+        return d->copyField(currentRow, field).isNull();
     return PQgetisnull(d->result, currentRow, field);
 }
 
+QSqlBatch QPSQLResult::fetchBatch(int maxRows)
+{
+    Q_D(QPSQLResult);
+    if (d->copyOut)
+        return QSqlResult::fetchBatch(maxRows);
+
+    QSqlBatch batch(record());
+    const int columns = batch.columnCount();
+    const bool isUtf8 = d->drv_d_func()->isUtf8;
+    while (batch.rowCount() < maxRows && at() != QSql::AfterLastRow) {
+        if (!(at() == QSql::BeforeFirstRow ? fetchFirst() : fetchNext())) {
+            setAt(QSql::AfterLastRow);
+            break;
+        }
+        // decode the text representation of the values straight into the batch
+        const int currentRow = isForwardOnly() ? 0 : at();
+        for (int i = 0; i < columns; ++i) {
+            if (PQgetisnull(d->result, currentRow, i)) {
+                batch.appendNull(i);
+                continue;
+            }
+            const char *val = PQgetvalue(d->result, currentRow, i);
+            switch (batch.columnType(i)) {
+            case QSqlBatch::Int64:
+                if (PQftype(d->result, i) == QBOOLOID)
+                    batch.appendInt64(i, val[0] == 't');
+                else
+                    batch.appendInt64(i, std::strtoll(val, nullptr, 10));
+                break;
+            case QSqlBatch::Double: {
+                double dbl;
+                if (qDecodePSQLDouble(val, &dbl))
+                    batch.appendDouble(i, dbl);
+                else
+                    batch.appendNull(i);
+                break;
+            }
+            case QSqlBatch::Text:
+                if (isUtf8)
+                    batch.appendBytes(i, QByteArrayView(val, PQgetlength(d->result, currentRow, i)));
+                else
+                    batch.appendBytes(i, QString::fromLatin1(val).toUtf8());
+                break;
+            case QSqlBatch::Binary: {
+                size_t len;
+                unsigned char *data = PQunescapeBytea(reinterpret_cast<const unsigned char *>(val), &len);
+                batch.appendBytes(i, QByteArrayView(reinterpret_cast<const char *>(data), qsizetype(len)));
+                qPQfreemem(data);
+                break;
+            }
+            case QSqlBatch::Variant:
+                batch.appendValue(i, data(i));
+                break;
+            }
+        }
+    }
+    return batch;
+}
+
 bool QPSQLResult::reset(const QString &query)
 {
     Q_D(QPSQLResult);
@@ -735,7 +1097,7 @@ bool QPSQLResult::reset(const QString &query)
         setForwardOnly(d->drv_d_func()->setSingleRowMode());
 
     d->result = d->drv_d_func()->getResult(d->stmtId);
-    if (!isForwardOnly()) {
+    if (!isForwardOnly() && !qIsCopyResult(d->result)) {
         // Fetch all result sets right away
         while (PGresult *nextResultSet = d->drv_d_func()->getResult(d->stmtId))
             d->nextResultSets.push(nextResultSet);
@@ -780,6 +1142,12 @@ QSqlRecord QPSQLResult::record() const
         return info;
 
     int count = PQnfields(d->result);
+    if (d->copyOut) {
+        // the text format of COPY carries neither names nor types
+        for (int i = 0; i < count; ++i)
+            info.append(QSqlField(QString(), QMetaType::fromType<QString>()));
+        return info;
+    }
     QSqlField f;
     for (int i = 0; i < count; ++i) {
         if (d->drv_d_func()->isUtf8)
@@ -878,6 +1246,7 @@ QString qMakePreparedStmtId()
 bool QPSQLResult::prepare(const QString &query)
 {
     Q_D(QPSQLResult);
+    d->isCopyStatement = qIsCopyStatement(query);
     if (!d->preparedQueriesEnabled)
         return QSqlResult::prepare(query);
 
@@ -886,6 +1255,10 @@ bool QPSQLResult::prepare(const QString &query)
     if (!d->preparedStmtId.isEmpty())
         d->deallocatePreparedStmt();
 
+    // COPY cannot be prepared, it is sent as it is by exec() and execBatch()
+    if (d->isCopyStatement)
+        return QSqlResult::prepare(query);
+
     const QString stmtId = qMakePreparedStmtId();
     const QString stmt = QStringLiteral("PREPARE %1 AS ").arg(stmtId).append(d->positionalToNamedBinding(query));
 
@@ -907,6 +1280,15 @@ bool QPSQLResult::prepare(const QString &query)
 bool QPSQLResult::exec()
 {
     Q_D(QPSQLResult);
+    if (d->isCopyStatement) {
+        // the bound values make up a single row
+        QList<QVariantList> columns;
+        const QList<QVariant> values = boundValues();
+        for (const QVariant &value : values)
+            columns.append(QVariantList{value});
+        return execCopy(columns, values.isEmpty() ? 0 : 1);
+    }
+
     if (!d->preparedQueriesEnabled)
         return QSqlResult::exec();
 
@@ -930,7 +1312,7 @@ bool QPSQLResult::exec()
         setForwardOnly(d->drv_d_func()->setSingleRowMode());
 
     d->result = d->drv_d_func()->getResult(d->stmtId);
-    if (!isForwardOnly()) {
+    if (!isForwardOnly() && !qIsCopyResult(d->result)) {
         // Fetch all result sets right away
         while (PGresult *nextResultSet = d->drv_d_func()->getResult(d->stmtId))
             d->nextResultSets.push(nextResultSet);
@@ -938,6 +1320,144 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+    Q_D(QPSQLResult);
+    const QList<QVariant> values = boundValues();
+    if (values.isEmpty())
+        return false;
+
+    QList<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : values)
+        columns.append(value.toList());
+    const qsizetype rowCount = columns.at(0).count();
+    for (const QVariantList &column : qAsConst(columns)) {
+        if (column.count() != rowCount) {
+            setLastError(QSqlError(QCoreApplication::translate("QPSQLResult",
+                                   "Parameter count mismatch"), QString(), QSqlError::StatementError));
+            return false;
+        }
+    }
+
+    if (d->isCopyStatement)
+        return execCopy(columns, rowCount);
+#ifdef LIBPQ_HAS_PIPELINING
+    if (d->preparedQueriesEnabled && !d->preparedStmtId.isEmpty())
+        return execPipelined(columns, rowCount);
+#endif
+    return QSqlResult::execBatch(arrayBind);
+}
+
+bool QPSQLResult::execCopy(const QList<QVariantList> &columns, qsizetype rowCount)
+{
+    Q_D(QPSQLResult);
+    cleanup();
+
+    d->stmtId = d->drv_d_func()->sendQuery(lastQuery());
+    if (d->stmtId == InvalidStatementId) {
+        setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                "Unable to send query"), QSqlError::StatementError, d->drv_d_func()));
+        return false;
+    }
+
+    // COPY ... TO STDOUT is read row by row in any case
+    d->result = d->drv_d_func()->getResult(d->stmtId);
+    if (PQresultStatus(d->result) == PGRES_COPY_IN)
+        d->copyIn(columns, rowCount);
+    return d->processResults();
+}
+
+// Sends the executions of the prepared statement without waiting for each
+// other's results. Every PipelineDepth executions are followed by a
+// synchronization point, which also limits how many results the server
+// has to buffer for us.
+bool QPSQLResult::execPipelined(const QList<QVariantList> &columns, qsizetype rowCount)
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    Q_D(QPSQLResult);
+    constexpr qsizetype PipelineDepth = 256;
+
+    if (rowCount == 0)
+        return true;
+
+    cleanup();
+    QPSQLDriverPrivate *drv = d->drv_d_func();
+    PGconn *connection = drv->connection;
+    drv->discardResults();
+    if (PQenterPipelineMode(connection) != 1)
+        return QSqlResult::execBatch(true);
+    d->stmtId = drv->currentStmtId = drv->generateStatementId();
+
+    PGresult *error = nullptr;
+    QList<QVariant> row(columns.count());
+    for (qsizetype first = 0; !error && first < rowCount; first += PipelineDepth) {
+        const qsizetype last = qMin(first + PipelineDepth, rowCount);
+        bool sent = true;
+        for (qsizetype i = first; sent && i < last; ++i) {
+            for (int j = 0; j < columns.count(); ++j)
+                row[j] = columns.at(j).at(i);
+            const QString params = qCreateParamString(row, driver());
+            const QString stmt = params.isEmpty()
+                    ? QStringLiteral("EXECUTE %1").arg(d->preparedStmtId)
+                    : QStringLiteral("EXECUTE %1 (%2)").arg(d->preparedStmtId, params);
+            const QByteArray encoded = drv->isUtf8 ? stmt.toUtf8() : stmt.toLocal8Bit();
+            sent = PQsendQueryParams(connection, encoded.constData(), 0, nullptr, nullptr,
+                                     nullptr, nullptr, 0) == 1;
+        }
+        if (!sent || PQpipelineSync(connection) != 1) {
+            setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                    "Unable to send query"), QSqlError::StatementError, drv));
+            break;
+        }
+
+        // the results of each execution end with a null result, the chunk
+        // ends with PGRES_PIPELINE_SYNC
+        bool synced = false;
+        for (int nullResults = 0; !synced && nullResults < 2;) {
+            PGresult *result = PQgetResult(connection);
+            if (!result) {
+                ++nullResults;
+                continue;
+            }
+            nullResults = 0;
+            const ExecStatusType status = PQresultStatus(result);
+            if (status == PGRES_PIPELINE_SYNC) {
+                PQclear(result);
+                synced = true;
+                continue;
+            }
+            if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK) {
+                PQclear(d->result);
+                d->result = result;
+            } else if (status != PGRES_PIPELINE_ABORTED && !error) {
+                error = result;
+            } else {
+                PQclear(result);
+            }
+        }
+        if (!synced && !error) {
+            setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                    "Unable to get result"), QSqlError::StatementError, drv));
+            break;
+        }
+    }
+    PQexitPipelineMode(connection);
+
+    if (error) {
+        PQclear(d->result);
+        d->result = error;
+    } else if (lastError().isValid()) {
+        return false;
+    }
+    return d->processResults();
+#else
+    Q_UNUSED(columns);
+    Q_UNUSED(rowCount);
+    return QSqlResult::execBatch(true);
+#endif
+}
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -43,6 +43,7 @@
 #include <qdatetime.h>
 #include <qdebug.h>
 #include <qlist.h>
+#include <qsqlbatch.h>
 #include <qsqlerror.h>
 #include <qsqlfield.h>
 #include <qsqlindex.h>
@@ -113,6 +114,62 @@ static QSqlError qMakeError(sqlite3 *access, const QString &descr, QSqlError::Er
                      type, QString::number(errorCode));
 }
 
+// binds \a value to the parameter \a index of \a stmt; strings and byte
+// arrays are bound without copying, so \a value has to outlive the binding
+static int qBindValue(sqlite3_stmt *stmt, int index, const QVariant &value)
+{
+    int res = SQLITE_OK;
+    if (value.isNull()) {
+        res = sqlite3_bind_null(stmt, index);
+    } else {
+        switch (value.userType()) {
+        case QVariant::ByteArray: {
+            const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
+            res = sqlite3_bind_blob(stmt, index, ba->constData(),
+                                    ba->size(), SQLITE_STATIC);
+            break; }
+        case QVariant::Int:
+        case QVariant::Bool:
+            res = sqlite3_bind_int(stmt, index, value.toInt());
+            break;
+        case QVariant::Double:
+            res = sqlite3_bind_double(stmt, index, value.toDouble());
+            break;
+        case QVariant::UInt:
+        case QVariant::LongLong:
+            res = sqlite3_bind_int64(stmt, index, value.toLongLong());
+            break;
+        case QVariant::DateTime: {
+            const QDateTime dateTime = value.toDateTime();
+            const QString str = dateTime.toString(Qt::ISODateWithMs);
+            res = sqlite3_bind_text16(stmt, index, str.utf16(),
+                                      str.size() * sizeof(ushort), SQLITE_TRANSIENT);
+            break;
+        }
+        case QVariant::Time: {
+            const QTime time = value.toTime();
+            const QString str = time.toString(u"hh:mm:ss.zzz");
+            res = sqlite3_bind_text16(stmt, index, str.utf16(),
+                                      str.size() * sizeof(ushort), SQLITE_TRANSIENT);
+            break;
+        }
+        case QVariant::String: {
+            // lifetime of string == lifetime of its qvariant
+            const QString *str = static_cast<const QString*>(value.constData());
+            res = sqlite3_bind_text16(stmt, index, str->utf16(),
+                                      (str->size()) * sizeof(QChar), SQLITE_STATIC);
+            break; }
+        default: {
+            QString str = value.toString();
+            // SQLITE_TRANSIENT makes sure that sqlite buffers the data
+            res = sqlite3_bind_text16(stmt, index, str.utf16(),
+                                      (str.size()) * sizeof(QChar), SQLITE_TRANSIENT);
+            break; }
+        }
+    }
+    return res;
+}
+
 class QSQLiteResultPrivate;
 
 class QSQLiteResult : public QSqlCachedResult
@@ -130,12 +187,14 @@ protected:
     bool reset(const QString &query) override;
     bool prepare(const QString &query) override;
     bool execBatch(bool arrayBind) override;
+    bool execBatchByName();
     bool exec() override;
     int size() override;
     int numRowsAffected() override;
     QVariant lastInsertId() const override;
     QSqlRecord record() const override;
     void detachFromResultSet() override;
+    QSqlBatch fetchBatch(int maxRows) override;
     void virtual_hook(int id, void *data) override;
 };
 
@@ -148,6 +207,7 @@ public:
     sqlite3 *access = nullptr;
     QList<QSQLiteResult *> results;
     QStringList notificationid;
+    int batchTransactionSize = 0;
 };
 
 
@@ -160,6 +220,9 @@ public:
     using QSqlCachedResultPrivate::QSqlCachedResultPrivate;
     void cleanup();
     bool fetchNext(QSqlCachedResult::ValueCache &values, int idx, bool initialFetch);
+    bool step();
+    QVariant columnValue(int column) const;
+    void appendRow(QSqlBatch &batch) const;
     // initializes the recordInfo and the cache
     void initColumns(bool emptyResultset);
     void finalize();
@@ -249,8 +312,6 @@ void QSQLiteResultPrivate::initColumns(bool emptyResultset)
 bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int idx, bool initialFetch)
 {
     Q_Q(QSQLiteResult);
-    int res;
-    int i;
 
     if (skipRow) {
         // already fetched
@@ -273,7 +334,20 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
         q->setAt(QSql::AfterLastRow);
         return false;
     }
-    res = sqlite3_step(stmt);
+    if (!step())
+        return false;
+    if (idx < 0 && !initialFetch)
+        return true;
+    for (int i = 0; i < rInf.count(); ++i)
+        values[i + idx] = columnValue(i);
+    return true;
+}
+
+// steps to the next row, and returns false at the end of the result set or on errors
+bool QSQLiteResultPrivate::step()
+{
+    Q_Q(QSQLiteResult);
+    int res = sqlite3_step(stmt);
 
     switch(res) {
     case SQLITE_ROW:
@@ -281,43 +355,6 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
         if (rInf.isEmpty())
             // must be first call.
             initColumns(false);
-        if (idx < 0 && !initialFetch)
-            return true;
-        for (i = 0; i < rInf.count(); ++i) {
-            switch (sqlite3_column_type(stmt, i)) {
-            case SQLITE_BLOB:
-                values[i + idx] = QByteArray(static_cast<const char *>(
-                            sqlite3_column_blob(stmt, i)),
-                            sqlite3_column_bytes(stmt, i));
-                break;
-            case SQLITE_INTEGER:
-                values[i + idx] = sqlite3_column_int64(stmt, i);
-                break;
-            case SQLITE_FLOAT:
-                switch(q->numericalPrecisionPolicy()) {
-                    case QSql::LowPrecisionInt32:
-                        values[i + idx] = sqlite3_column_int(stmt, i);
-                        break;
-                    case QSql::LowPrecisionInt64:
-                        values[i + idx] = sqlite3_column_int64(stmt, i);
-                        break;
-                    case QSql::LowPrecisionDouble:
-                    case QSql::HighPrecision:
-                    default:
-                        values[i + idx] = sqlite3_column_double(stmt, i);
-                        break;
-                };
-                break;
-            case SQLITE_NULL:
-                values[i + idx] = QVariant(QMetaType::fromType<QString>());
-                break;
-            default:
-                values[i + idx] = QString(reinterpret_cast<const QChar *>(
-                            sqlite3_column_text16(stmt, i)),
-                            sqlite3_column_bytes16(stmt, i) / sizeof(QChar));
-                break;
-            }
-        }
         return true;
     case SQLITE_DONE:
         if (rInf.isEmpty())
@@ -348,6 +385,67 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
     return false;
 }
 
+QVariant QSQLiteResultPrivate::columnValue(int column) const
+{
+    Q_Q(const QSQLiteResult);
+    switch (sqlite3_column_type(stmt, column)) {
+    case SQLITE_BLOB:
+        return QByteArray(static_cast<const char *>(sqlite3_column_blob(stmt, column)),
+                          sqlite3_column_bytes(stmt, column));
+    case SQLITE_INTEGER:
+        return sqlite3_column_int64(stmt, column);
+    case SQLITE_FLOAT:
+        switch(q->numericalPrecisionPolicy()) {
+            case QSql::LowPrecisionInt32:
+                return sqlite3_column_int(stmt, column);
+            case QSql::LowPrecisionInt64:
+                return sqlite3_column_int64(stmt, column);
+            case QSql::LowPrecisionDouble:
+            case QSql::HighPrecision:
+            default:
+                return sqlite3_column_double(stmt, column);
+        };
+    case SQLITE_NULL:
+        return QVariant(QMetaType::fromType<QString>());
+    default:
+        return QString(reinterpret_cast<const QChar *>(sqlite3_column_text16(stmt, column)),
+                       sqlite3_column_bytes16(stmt, column) / sizeof(QChar));
+    }
+}
+
+// appends the current row to the batch, letting SQLite convert the values
+void QSQLiteResultPrivate::appendRow(QSqlBatch &batch) const
+{
+    for (int i = 0; i < batch.columnCount(); ++i) {
+        if (sqlite3_column_type(stmt, i) == SQLITE_NULL) {
+            batch.appendNull(i);
+            continue;
+        }
+        switch (batch.columnType(i)) {
+        case QSqlBatch::Int64:
+            batch.appendInt64(i, sqlite3_column_int64(stmt, i));
+            break;
+        case QSqlBatch::Double:
+            batch.appendDouble(i, sqlite3_column_double(stmt, i));
+            break;
+        case QSqlBatch::Text: {
+            // sqlite3_column_bytes() must be called after the conversion to text
+            const char *text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, i));
+            batch.appendBytes(i, QByteArrayView(text, sqlite3_column_bytes(stmt, i)));
+            break;
+        }
+        case QSqlBatch::Binary: {
+            const char *blob = static_cast<const char *>(sqlite3_column_blob(stmt, i));
+            batch.appendBytes(i, QByteArrayView(blob, sqlite3_column_bytes(stmt, i)));
+            break;
+        }
+        case QSqlBatch::Variant:
+            batch.appendValue(i, columnValue(i));
+            break;
+        }
+    }
+}
+
 QSQLiteResult::QSQLiteResult(const QSQLiteDriver* db)
     : QSqlCachedResult(*new QSQLiteResultPrivate(this, db))
 {
@@ -412,11 +510,121 @@ bool QSQLiteResult::prepare(const QString &query)
 bool QSQLiteResult::execBatch(bool arrayBind)
 {
     Q_UNUSED(arrayBind);
+    Q_D(QSQLiteResult);
+    const QList<QVariant> values = boundValues();
+    if (values.count() == 0)
+        return false;
+
+    // reused named placeholders have to be resolved by name
+    if (!d->stmt || sqlite3_bind_parameter_count(d->stmt) != values.count())
+        return execBatchByName();
+
+    QList<QVariantList> columns;
+    columns.reserve(values.count());
+    for (const QVariant &value : values)
+        columns.append(value.toList());
+    const qsizetype rowCount = columns.at(0).count();
+    for (const QVariantList &column : qAsConst(columns)) {
+        if (column.count() != rowCount) {
+            setLastError(QSqlError(QCoreApplication::translate("QSQLiteResult",
+                            "Parameter count mismatch"), QString(), QSqlError::StatementError));
+            return false;
+        }
+    }
+
+    d->skippedStatus = false;
+    d->skipRow = false;
+    d->rInf.clear();
+    clearValues();
+    setLastError(QSqlError());
+    setSelect(false);
+    setActive(false);
+
+    sqlite3 *access = d->drv_d_func()->access;
+    int res = sqlite3_reset(d->stmt);
+    if (res != SQLITE_OK) {
+        setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                     "Unable to reset statement"), QSqlError::StatementError, res));
+        d->finalize();
+        return false;
+    }
+
+    // only open our own transactions if the user has not started one
+    const int transactionSize = d->drv_d_func()->batchTransactionSize;
+    const bool useTransactions = transactionSize > 0 && sqlite3_get_autocommit(access);
+    int rowsInTransaction = 0;
+    const auto commit = [&]() {
+        rowsInTransaction = 0;
+        res = sqlite3_exec(access, "COMMIT", nullptr, nullptr, nullptr);
+        if (res != SQLITE_OK) {
+            setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                         "Unable to commit transaction"), QSqlError::TransactionError, res));
+            return false;
+        }
+        return true;
+    };
+
+    for (qsizetype row = 0; row < rowCount; ++row) {
+        if (useTransactions && rowsInTransaction == 0) {
+            res = sqlite3_exec(access, "BEGIN", nullptr, nullptr, nullptr);
+            if (res != SQLITE_OK) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to begin transaction"), QSqlError::TransactionError, res));
+                return false;
+            }
+        }
+
+        for (int i = 0; i < columns.count(); ++i) {
+            res = qBindValue(d->stmt, i + 1, columns.at(i).at(row));
+            if (res != SQLITE_OK) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to bind parameters"), QSqlError::StatementError, res));
+                break;
+            }
+        }
+        if (res == SQLITE_OK) {
+            res = sqlite3_step(d->stmt);
+            if (res == SQLITE_DONE || res == SQLITE_ROW) {
+                res = sqlite3_reset(d->stmt);
+            } else {
+                // as in fetchNext(), the specific error code comes from sqlite3_reset()
+                res = sqlite3_reset(d->stmt);
+                if (res == SQLITE_OK)
+                    res = SQLITE_ERROR;
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to execute statement"), QSqlError::StatementError, res));
+            }
+        }
+        sqlite3_clear_bindings(d->stmt);
+
+        if (res != SQLITE_OK) {
+            // keep the rows inserted so far, like row by row execution would
+            if (useTransactions && rowsInTransaction > 0) {
+                const QSqlError error = lastError();
+                if (commit())
+                    setLastError(error);
+            } else if (useTransactions) {
+                sqlite3_exec(access, "ROLLBACK", nullptr, nullptr, nullptr);
+            }
+            return false;
+        }
+
+        if (useTransactions && ++rowsInTransaction == transactionSize && !commit())
+            return false;
+    }
+    if (useTransactions && rowsInTransaction > 0 && !commit())
+        return false;
+
+    setActive(true);
+    return true;
+}
+
+// binds every row by placeholder name and executes it on its own
+bool QSQLiteResult::execBatchByName()
+{
     Q_D(QSqlResult);
     QScopedValueRollback<QList<QVariant>> valuesScope(d->values);
     QList<QVariant> values = d->values;
-    if (values.count() == 0)
-        return false;
 
     for (int i = 0; i < values.at(0).toList().count(); ++i) {
         d->values.clear();
@@ -495,57 +703,9 @@ bool QSQLiteResult::exec()
 
     if (paramCountIsValid) {
         for (int i = 0; i < paramCount; ++i) {
-            res = SQLITE_OK;
-            const QVariant value = values.at(i);
+            const QVariant &value = values.at(i);
 
-            if (value.isNull()) {
-                res = sqlite3_bind_null(d->stmt, i + 1);
-            } else {
-                switch (value.userType()) {
-                case QVariant::ByteArray: {
-                    const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
-                    res = sqlite3_bind_blob(d->stmt, i + 1, ba->constData(),
-                                            ba->size(), SQLITE_STATIC);
-                    break; }
-                case QVariant::Int:
-                case QVariant::Bool:
-                    res = sqlite3_bind_int(d->stmt, i + 1, value.toInt());
-                    break;
-                case QVariant::Double:
-                    res = sqlite3_bind_double(d->stmt, i + 1, value.toDouble());
-                    break;
-                case QVariant::UInt:
-                case QVariant::LongLong:
-                    res = sqlite3_bind_int64(d->stmt, i + 1, value.toLongLong());
-                    break;
-                case QVariant::DateTime: {
-                    const QDateTime dateTime = value.toDateTime();
-                    const QString str = dateTime.toString(Qt::ISODateWithMs);
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              str.size() * sizeof(ushort), SQLITE_TRANSIENT);
-                    break;
-                }
-                case QVariant::Time: {
-                    const QTime time = value.toTime();
-                    const QString str = time.toString(u"hh:mm:ss.zzz");
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              str.size() * sizeof(ushort), SQLITE_TRANSIENT);
-                    break;
-                }
-                case QVariant::String: {
-                    // lifetime of string == lifetime of its qvariant
-                    const QString *str = static_cast<const QString*>(value.constData());
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str->utf16(),
-                                              (str->size()) * sizeof(QChar), SQLITE_STATIC);
-                    break; }
-                default: {
-                    QString str = value.toString();
-                    // SQLITE_TRANSIENT makes sure that sqlite buffers the data
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.utf16(),
-                                              (str.size()) * sizeof(QChar), SQLITE_TRANSIENT);
-                    break; }
-                }
-            }
+            res = qBindValue(d->stmt, i + 1, value);
             if (res != SQLITE_OK) {
                 setLastError(qMakeError(d->drv_d_func()->access, QCoreApplication::translate("QSQLiteResult",
                              "Unable to bind parameters"), QSqlError::StatementError, res));
@@ -575,6 +735,44 @@ bool QSQLiteResult::gotoNext(QSqlCachedResult::ValueCache& row, int idx)
     return d->fetchNext(row, idx, false);
 }
 
+QSqlBatch QSQLiteResult::fetchBatch(int maxRows)
+{
+    Q_D(QSQLiteResult);
+    // all rows have to go through the row cache unless it is forward-only
+    if (!isForwardOnly() || !d->stmt || at() == QSql::AfterLastRow)
+        return QSqlCachedResult::fetchBatch(maxRows);
+
+    QSqlBatch batch(d->rInf);
+    bool onRow = false;
+    while (batch.rowCount() < maxRows) {
+        if (d->skipRow) {
+            // exec() already fetched the first row
+            d->skipRow = false;
+            if (!d->skippedStatus)
+                break;
+            for (int i = 0; i < d->firstRow.count(); ++i)
+                batch.appendValue(i, d->firstRow.at(i));
+            cache() = d->firstRow;
+        } else {
+            onRow = d->step();
+            if (!onRow)
+                break;
+            d->appendRow(batch);
+        }
+        setAt(at() + 1);
+    }
+
+    if (batch.rowCount() < maxRows) {
+        d->atEnd = true;
+        setAt(QSql::AfterLastRow);
+    } else if (onRow) {
+        // keep value() working for the row the query is positioned on
+        for (int i = 0; i < d->rInf.count(); ++i)
+            cache()[i] = d->columnValue(i);
+    }
+    return batch;
+}
+
 int QSQLiteResult::size()
 {
     return -1;
@@ -719,6 +917,7 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
     bool sharedCache = false;
     bool openReadOnlyOption = false;
     bool openUriOption = false;
+    int batchTransactionSize = 0;
 #if QT_CONFIG(regularexpression)
     static const QLatin1String regexpConnectOption = QLatin1String("QSQLITE_ENABLE_REGEXP");
     bool defineRegexp = false;
@@ -742,6 +941,14 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
             openUriOption = true;
         } else if (option == QLatin1String("QSQLITE_ENABLE_SHARED_CACHE")) {
             sharedCache = true;
+        } else if (option.startsWith(QLatin1String("QSQLITE_BATCH_TRANSACTION_SIZE"))) {
+            option = option.mid(30).trimmed();
+            if (option.startsWith(QLatin1Char('='))) {
+                bool ok;
+                const int size = option.mid(1).trimmed().toInt(&ok);
+                if (ok && size >= 0)
+                    batchTransactionSize = size;
+            }
         }
 #if QT_CONFIG(regularexpression)
         else if (option.startsWith(regexpConnectOption)) {
@@ -772,6 +979,7 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
 
     if (res == SQLITE_OK) {
         sqlite3_busy_timeout(d->access, timeOut);
+        d->batchTransactionSize = batchTransactionSize;
         setOpen(true);
         setOpenError(false);
 #if QT_CONFIG(regularexpression)
@@ -5,6 +5,7 @@ QT = core sql
 SOURCES = \
     doc_src_sql-driver.cpp \
     src_sql_kernel_qsqldatabase.cpp \
+    src_sql_kernel_qsqlbatch.cpp \
     src_sql_kernel_qsqlerror.cpp \
     src_sql_kernel_qsqlresult.cpp \
     src_sql_kernel_qsqldriver.cpp \
@@ -149,3 +149,23 @@ QString connectString = QStringLiteral(
 db.setDatabaseName(connectString);
 //! [39]
 }
+
+
+void psqlCopy()
+{
+QVariantList sensors;
+QVariantList values;
+//! [42]
+QSqlQuery query;
+query.prepare("COPY measurements (sensor, value) FROM STDIN");
+query.addBindValue(sensors);
+query.addBindValue(values);
+if (!query.execBatch())
+    qDebug() << query.lastError();
+
+query.setForwardOnly(true);
+query.exec("COPY (SELECT sensor, value FROM measurements) TO STDOUT");
+while (query.next())
+    qDebug() << query.value(0).toString() << query.value(1).toString();
+//! [42]
+}
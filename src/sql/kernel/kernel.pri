@@ -1,5 +1,6 @@
 HEADERS +=      kernel/qtsqlglobal.h \
                 kernel/qtsqlglobal_p.h \
+                kernel/qsqlbatch.h \
                 kernel/qsqlquery.h \
                 kernel/qsqldatabase.h \
                 kernel/qsqlfield.h \
@@ -15,6 +16,7 @@ HEADERS +=      kernel/qtsqlglobal.h \
                 kernel/qsqlindex.h
 
 SOURCES +=      kernel/qsqlquery.cpp \
+                kernel/qsqlbatch.cpp \
                 kernel/qsqldatabase.cpp \
                 kernel/qsqlfield.cpp \
                 kernel/qsqlrecord.cpp \
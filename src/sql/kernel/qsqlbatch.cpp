@@ -0,0 +1,443 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsqlbatch.h"
+
+#include "qsqlfield.h"
+#include "qsqlrecord.h"
+#include "qvariant.h"
+
+QT_BEGIN_NAMESPACE
+
+struct QSqlBatchColumn
+{
+    QSqlBatch::ColumnType type = QSqlBatch::Variant;
+    int count = 0;
+    QByteArray nulls; // one bit per row
+    QList<qint64> int64s;
+    QList<double> doubles;
+    QByteArray arena; // the bytes of all rows of a Text or Binary column
+    QList<qsizetype> offsets; // start of each row in arena, plus the end
+    QList<QVariant> variants;
+
+    void appendRow(bool isNull)
+    {
+        if ((count & 7) == 0)
+            nulls.append('\0');
+        if (isNull)
+            nulls.data()[count >> 3] |= char(1 << (count & 7));
+        ++count;
+    }
+};
+
+class QSqlBatchPrivate : public QSharedData
+{
+public:
+    QList<QSqlBatchColumn> columns;
+
+    void setColumnTypes(const QList<QSqlBatch::ColumnType> &types)
+    {
+        columns.resize(types.size());
+        for (int i = 0; i < types.size(); ++i) {
+            columns[i].type = types.at(i);
+            if (types.at(i) == QSqlBatch::Text || types.at(i) == QSqlBatch::Binary)
+                columns[i].offsets.append(0);
+        }
+    }
+};
+
+/*!
+    \class QSqlBatch
+    \brief The QSqlBatch class holds a block of rows of a query result in
+    typed columns.
+
+    \ingroup database
+    \inmodule QtSql
+    \since 6.0
+
+    QSqlQuery::value() returns every value of a result set as a QVariant.
+    When a large result set is read, constructing these variants can take
+    more time than fetching the data itself. QSqlQuery::fetchBatch()
+    returns the following rows of the result at once in a QSqlBatch, which
+    stores every column in a contiguous buffer of the column's type:
+
+    \list
+    \li Integer and boolean fields are stored as an array of \c qint64,
+        returned by int64Data().
+    \li Floating point fields are stored as an array of \c double, returned
+        by doubleData().
+    \li String fields are stored as UTF-8, and binary fields as raw bytes,
+        in one buffer per column. bytes() returns the data of a single
+        value.
+    \li All other fields, such as dates and times, are stored as QVariant.
+    \endlist
+
+    Whether a value is null is stored in a bitmap per column, and returned
+    by isNull(). The values of null fields in the typed arrays are 0.
+
+    \snippet code/src_sql_kernel_qsqlbatch.cpp 0
+
+    Drivers that implement batches natively fill the buffers without
+    creating a QVariant for each value; for other drivers, the values are
+    converted from the QVariant returned by the driver.
+
+    QSqlBatch is \l{implicitly shared}.
+
+    \sa QSqlQuery::fetchBatch()
+*/
+
+/*!
+    \enum QSqlBatch::ColumnType
+
+    This enum describes how the values of a column are stored.
+
+    \value Int64 The values are stored as an array of \c qint64.
+    \value Double The values are stored as an array of \c double.
+    \value Text The values are stored as UTF-8 encoded strings.
+    \value Binary The values are stored as byte arrays.
+    \value Variant The values are stored as QVariant.
+*/
+
+/*!
+    Constructs an empty batch without columns.
+*/
+QSqlBatch::QSqlBatch()
+    : d(new QSqlBatchPrivate)
+{
+}
+
+/*!
+    Constructs an empty batch with columns of the types \a columnTypes.
+*/
+QSqlBatch::QSqlBatch(const QList<ColumnType> &columnTypes)
+    : d(new QSqlBatchPrivate)
+{
+    d->setColumnTypes(columnTypes);
+}
+
+/*!
+    Constructs an empty batch with one column for each field of \a record.
+    The type of each column is chosen with columnTypeFor().
+*/
+QSqlBatch::QSqlBatch(const QSqlRecord &record)
+    : d(new QSqlBatchPrivate)
+{
+    QList<ColumnType> types;
+    types.reserve(record.count());
+    for (int i = 0; i < record.count(); ++i)
+        types.append(columnTypeFor(record.field(i).metaType()));
+    d->setColumnTypes(types);
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QSqlBatch::QSqlBatch(const QSqlBatch &other) = default;
+
+/*!
+    Move-constructs a batch from \a other.
+*/
+QSqlBatch::QSqlBatch(QSqlBatch &&other) noexcept = default;
+
+/*!
+    Assigns \a other to this batch.
+*/
+QSqlBatch &QSqlBatch::operator=(const QSqlBatch &other) = default;
+
+/*!
+    \fn QSqlBatch &QSqlBatch::operator=(QSqlBatch &&other)
+
+    Move-assigns \a other to this batch.
+*/
+
+/*!
+    \fn void QSqlBatch::swap(QSqlBatch &other)
+
+    Swaps this batch with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Destroys the batch.
+*/
+QSqlBatch::~QSqlBatch() = default;
+
+/*!
+    Returns \c true if the batch contains no rows; otherwise returns
+    \c false.
+*/
+bool QSqlBatch::isEmpty() const
+{
+    return rowCount() == 0;
+}
+
+/*!
+    Returns the number of rows in the batch.
+*/
+int QSqlBatch::rowCount() const
+{
+    return d->columns.isEmpty() ? 0 : d->columns.first().count;
+}
+
+/*!
+    Returns the number of columns in the batch.
+*/
+int QSqlBatch::columnCount() const
+{
+    return d->columns.count();
+}
+
+/*!
+    Returns how the values of \a column are stored.
+*/
+QSqlBatch::ColumnType QSqlBatch::columnType(int column) const
+{
+    return d->columns.at(column).type;
+}
+
+/*!
+    Returns \c true if the value at \a row and \a column is null; otherwise
+    returns \c false.
+*/
+bool QSqlBatch::isNull(int row, int column) const
+{
+    const QSqlBatchColumn &c = d->columns.at(column);
+    Q_ASSERT(row >= 0 && row < c.count);
+    return c.nulls.at(row >> 3) & (1 << (row & 7));
+}
+
+/*!
+    Returns a pointer to the rowCount() values of \a column, if it is
+    stored as \l Int64; otherwise returns \nullptr.
+
+    The pointer remains valid as long as the batch is not modified.
+*/
+const qint64 *QSqlBatch::int64Data(int column) const
+{
+    const QSqlBatchColumn &c = d->columns.at(column);
+    return c.type == Int64 ? c.int64s.constData() : nullptr;
+}
+
+/*!
+    Returns a pointer to the rowCount() values of \a column, if it is
+    stored as \l Double; otherwise returns \nullptr.
+
+    The pointer remains valid as long as the batch is not modified.
+*/
+const double *QSqlBatch::doubleData(int column) const
+{
+    const QSqlBatchColumn &c = d->columns.at(column);
+    return c.type == Double ? c.doubles.constData() : nullptr;
+}
+
+/*!
+    Returns the bytes of the value at \a row and \a column, if the column is
+    stored as \l Text or \l Binary; otherwise returns an empty view. Text
+    is encoded in UTF-8, and not null-terminated.
+
+    The view remains valid as long as the batch is not modified.
+*/
+QByteArrayView QSqlBatch::bytes(int row, int column) const
+{
+    const QSqlBatchColumn &c = d->columns.at(column);
+    if (c.type != Text && c.type != Binary)
+        return QByteArrayView();
+    Q_ASSERT(row >= 0 && row < c.count);
+    const qsizetype begin = c.offsets.at(row);
+    return QByteArrayView(c.arena.constData() + begin, c.offsets.at(row + 1) - begin);
+}
+
+/*!
+    Returns the value at \a row and \a column as a QVariant.
+
+    For null values, a null QVariant of the column's type is returned.
+*/
+QVariant QSqlBatch::value(int row, int column) const
+{
+    const QSqlBatchColumn &c = d->columns.at(column);
+    Q_ASSERT(row >= 0 && row < c.count);
+    switch (c.type) {
+    case Int64:
+        if (isNull(row, column))
+            return QVariant(QMetaType::fromType<qlonglong>());
+        return qlonglong(c.int64s.at(row));
+    case Double:
+        if (isNull(row, column))
+            return QVariant(QMetaType::fromType<double>());
+        return c.doubles.at(row);
+    case Text:
+        if (isNull(row, column))
+            return QVariant(QMetaType::fromType<QString>());
+        return QString::fromUtf8(bytes(row, column));
+    case Binary:
+        if (isNull(row, column))
+            return QVariant(QMetaType::fromType<QByteArray>());
+        return bytes(row, column).toByteArray();
+    case Variant:
+        break;
+    }
+    return c.variants.at(row);
+}
+
+/*!
+    Appends a null value to \a column.
+
+    Drivers fill a batch by appending one value to every column for each
+    row, in column order.
+*/
+void QSqlBatch::appendNull(int column)
+{
+    QSqlBatchColumn &c = d->columns[column];
+    switch (c.type) {
+    case Int64:
+        c.int64s.append(0);
+        break;
+    case Double:
+        c.doubles.append(0);
+        break;
+    case Text:
+    case Binary:
+        c.offsets.append(c.arena.size());
+        break;
+    case Variant:
+        c.variants.append(QVariant());
+        break;
+    }
+    c.appendRow(true);
+}
+
+/*!
+    Appends \a value to \a column, which must be stored as \l Int64.
+*/
+void QSqlBatch::appendInt64(int column, qint64 value)
+{
+    QSqlBatchColumn &c = d->columns[column];
+    Q_ASSERT(c.type == Int64);
+    c.int64s.append(value);
+    c.appendRow(false);
+}
+
+/*!
+    Appends \a value to \a column, which must be stored as \l Double.
+*/
+void QSqlBatch::appendDouble(int column, double value)
+{
+    QSqlBatchColumn &c = d->columns[column];
+    Q_ASSERT(c.type == Double);
+    c.doubles.append(value);
+    c.appendRow(false);
+}
+
+/*!
+    Appends \a value to \a column, which must be stored as \l Text or
+    \l Binary. For text columns, \a value must be encoded in UTF-8.
+*/
+void QSqlBatch::appendBytes(int column, QByteArrayView value)
+{
+    QSqlBatchColumn &c = d->columns[column];
+    Q_ASSERT(c.type == Text || c.type == Binary);
+    c.arena.append(value.data(), value.size());
+    c.offsets.append(c.arena.size());
+    c.appendRow(false);
+}
+
+/*!
+    Appends \a value to \a column, converting it to the type the column is
+    stored as. If \a value is null, a null value is appended.
+*/
+void QSqlBatch::appendValue(int column, const QVariant &value)
+{
+    QSqlBatchColumn &c = d->columns[column];
+    if (value.isNull()) {
+        appendNull(column);
+        return;
+    }
+    switch (c.type) {
+    case Int64:
+        appendInt64(column, value.toLongLong());
+        break;
+    case Double:
+        appendDouble(column, value.toDouble());
+        break;
+    case Text:
+        appendBytes(column, value.toString().toUtf8());
+        break;
+    case Binary:
+        appendBytes(column, value.toByteArray());
+        break;
+    case Variant:
+        c.variants.append(value);
+        c.appendRow(false);
+        break;
+    }
+}
+
+/*!
+    Returns the column type that values of the meta type \a type are stored
+    as in a batch.
+*/
+QSqlBatch::ColumnType QSqlBatch::columnTypeFor(QMetaType type)
+{
+    switch (type.id()) {
+    case QMetaType::Bool:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        return Int64;
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return Double;
+    case QMetaType::QString:
+        return Text;
+    case QMetaType::QByteArray:
+        return Binary;
+    default:
+        return Variant;
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtSql module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSQLBATCH_H
+#define QSQLBATCH_H
+
+#include <QtSql/qtsqlglobal.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmetatype.h>
+#include <QtCore/qshareddata.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class QSqlRecord;
+class QVariant;
+class QSqlBatchPrivate;
+
+class Q_SQL_EXPORT QSqlBatch
+{
+public:
+    enum ColumnType {
+        Int64,
+        Double,
+        Text,
+        Binary,
+        Variant
+    };
+
+    QSqlBatch();
+    explicit QSqlBatch(const QList<ColumnType> &columnTypes);
+    explicit QSqlBatch(const QSqlRecord &record);
+    QSqlBatch(const QSqlBatch &other);
+    QSqlBatch(QSqlBatch &&other) noexcept;
+    QSqlBatch &operator=(const QSqlBatch &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QSqlBatch)
+    ~QSqlBatch();
+
+    void swap(QSqlBatch &other) noexcept { d.swap(other.d); }
+
+    bool isEmpty() const;
+    int rowCount() const;
+    int columnCount() const;
+    ColumnType columnType(int column) const;
+
+    bool isNull(int row, int column) const;
+    const qint64 *int64Data(int column) const;
+    const double *doubleData(int column) const;
+    QByteArrayView bytes(int row, int column) const;
+    QVariant value(int row, int column) const;
+
+    void appendNull(int column);
+    void appendInt64(int column, qint64 value);
+    void appendDouble(int column, double value);
+    void appendBytes(int column, QByteArrayView value);
+    void appendValue(int column, const QVariant &value);
+
+    static ColumnType columnTypeFor(QMetaType type);
+
+private:
+    QSharedDataPointer<QSqlBatchPrivate> d;
+};
+
+Q_DECLARE_SHARED(QSqlBatch)
+
+QT_END_NAMESPACE
+
+#endif // QSQLBATCH_H
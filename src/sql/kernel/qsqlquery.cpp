@@ -42,6 +42,7 @@
 //#define QT_DEBUG_SQL
 
 #include "qatomic.h"
+#include "qsqlbatch.h"
 #include "qdebug.h"
 #include "qelapsedtimer.h"
 #include "qmap.h"
@@ -666,6 +667,36 @@ bool QSqlQuery::next()
     }
 }
 
+/*!
+  \since 6.0
+
+  Retrieves up to \a maxRows records following the current one, and
+  returns them in typed columns. The query is positioned on the last
+  retrieved record, so that the next call continues after it; if there are
+  no more records, the query is positioned after the last record and an
+  empty batch is returned.
+
+  Reading a large result set in batches avoids creating a QVariant for
+  every value. The SQLite and PostgreSQL drivers fill the batch directly,
+  the other drivers convert the values returned by value(). Values are
+  converted to the type of their column as described in QSqlBatch; the
+  numericalPrecisionPolicy() does not apply.
+
+  The result must be \l{isActive()}{active} and isSelect() must return
+  true; otherwise an empty batch is returned. For the best performance,
+  call setForwardOnly(true) before executing the query.
+
+  \snippet code/src_sql_kernel_qsqlbatch.cpp 0
+
+  \sa next(), QSqlBatch
+*/
+QSqlBatch QSqlQuery::fetchBatch(int maxRows)
+{
+    if (!isSelect() || !isActive() || maxRows <= 0)
+        return QSqlBatch(record());
+    return d->sqlResult->fetchBatch(maxRows);
+}
+
 /*!
 
   Retrieves the previous record in the result, if available, and
@@ -48,6 +48,7 @@
 QT_BEGIN_NAMESPACE
 
 
+class QSqlBatch;
 class QSqlDriver;
 class QSqlError;
 class QSqlResult;
@@ -90,6 +91,7 @@ public:
 
     bool seek(int i, bool relative = false);
     bool next();
+    QSqlBatch fetchBatch(int maxRows);
     bool previous();
     bool first();
     bool last();
@@ -42,6 +42,7 @@
 #include "qhash.h"
 #include "qlist.h"
 #include "qpointer.h"
+#include "qsqlbatch.h"
 #include "qsqldriver.h"
 #include "qsqlerror.h"
 #include "qsqlfield.h"
@@ -991,6 +992,39 @@ bool QSqlResult::nextResult()
     return false;
 }
 
+/*!
+    \since 6.0
+
+    Fetches up to \a maxRows rows following the current row into a
+    QSqlBatch, positions the result on the last fetched row, and returns the
+    batch. If no more rows are available, the result is positioned after the
+    last row.
+
+    The default implementation fetches the rows one by one, and converts the
+    QVariant returned by data() into the type of each column. Drivers
+    reimplement this function to fill the batch directly from the rows they
+    fetched.
+
+    \sa QSqlQuery::fetchBatch()
+*/
+QSqlBatch QSqlResult::fetchBatch(int maxRows)
+{
+    QSqlBatch batch(record());
+    const int columns = batch.columnCount();
+    for (int row = 0; row < maxRows; ++row) {
+        if (at() == QSql::AfterLastRow)
+            break;
+        const bool fetched = at() == QSql::BeforeFirstRow ? fetchFirst() : fetchNext();
+        if (!fetched) {
+            setAt(QSql::AfterLastRow);
+            break;
+        }
+        for (int i = 0; i < columns; ++i)
+            batch.appendValue(i, isNull(i) ? QVariant() : data(i));
+    }
+    return batch;
+}
+
 /*!
     Returns the low-level database handle for this result set
     wrapped in a QVariant or an invalid QVariant if there is no handle.
@@ -22,6 +22,7 @@ SUBDIRS=\
     qprocess \
     qprocess-noapplication \
     qprocessenvironment \
+    qrandomaccessasyncfile \
     qresourceengine \
     qsettings \
     qsavefile \
@@ -61,6 +62,9 @@ win32:!qtConfig(private_tests): SUBDIRS -= \
 !qtConfig(processenvironment): SUBDIRS -= \
     qprocessenvironment
 
+!qtConfig(future): SUBDIRS -= \
+    qrandomaccessasyncfile
+
 !qtConfig(process): SUBDIRS -= \
     qprocess \
     qprocess-noapplication
@@ -254,6 +254,9 @@ private slots:
     void mapOpenMode();
     void mapWrittenFile_data();
     void mapWrittenFile();
+    void mapToByteArray_data();
+    void mapToByteArray();
+    void mapToByteArrayResource();
 
     void openStandardStreamsFileDescriptors();
     void openStandardStreamsBufferedStreams();
@@ -3280,6 +3283,92 @@ void tst_QFile::mapWrittenFile()
     file.remove();
 }
 
+void tst_QFile::mapToByteArray_data()
+{
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<QFile::FileError>("error");
+
+    QTest::newRow("whole file") << 0 << 3 * 4096 + 123 << QFile::NoError;
+    QTest::newRow("unaligned") << 5000 << 7000 << QFile::NoError;
+    QTest::newRow("one page") << 0 << 4096 << QFile::NoError;
+    QTest::newRow("second page") << 4096 << 4096 << QFile::NoError;
+    QTest::newRow("empty") << 100 << 0 << QFile::NoError;
+    QTest::newRow("negative offset") << -1 << 1 << QFile::UnspecifiedError;
+    QTest::newRow("negative size") << 0 << -1 << QFile::UnspecifiedError;
+    QTest::newRow("beyond end") << 4096 << 3 * 4096 << QFile::UnspecifiedError;
+}
+
+void tst_QFile::mapToByteArray()
+{
+    QFETCH(int, offset);
+    QFETCH(int, size);
+    QFETCH(QFile::FileError, error);
+
+    QByteArray pattern(3 * 4096 + 123, Qt::Uninitialized);
+    for (int i = 0; i < pattern.size(); ++i)
+        pattern[i] = char(i % 251);
+
+    QString fileName = QDir::currentPath() + '/' + "qfile_map_testfile";
+    QFile::remove(fileName);
+    QFile file(fileName);
+
+    // not open
+    QVERIFY(file.mapToByteArray(0, 1).isNull());
+    QCOMPARE(file.error(), QFile::PermissionsError);
+
+    QVERIFY2(file.open(QFile::ReadWrite), msgOpenFailed(file).constData());
+    QCOMPARE(file.write(pattern), pattern.size());
+    file.close();
+    QVERIFY2(file.open(QFile::ReadOnly), msgOpenFailed(file).constData());
+
+    QByteArray mapped = file.mapToByteArray(offset, size, QFileDevice::MapSequentialHint);
+    QCOMPARE(file.error(), error);
+    if (error != QFile::NoError) {
+        QVERIFY(mapped.isNull());
+        return;
+    }
+    QCOMPARE(mapped, pattern.mid(offset, size));
+    QCOMPARE(mapped.constData()[mapped.size()], '\0');
+
+    // the mapping outlives the file
+    file.close();
+    QVERIFY(file.remove());
+    QCOMPARE(mapped, pattern.mid(offset, size));
+
+    // copies share the data, writes detach
+    QByteArray copy = mapped;
+    QCOMPARE(copy.constData(), mapped.constData());
+    if (size > 0) {
+        copy[0] = 'Q';
+        QCOMPARE(copy.at(0), 'Q');
+        QCOMPARE(mapped, pattern.mid(offset, size));
+
+        // modifying the only reference is done in place
+        mapped[0] = 'Q';
+        QCOMPARE(mapped, copy);
+    }
+
+    // growing moves the data out of the mapping
+    mapped.append("tail");
+    mapped.prepend("head");
+    QCOMPARE(mapped, "head" + copy + "tail");
+}
+
+void tst_QFile::mapToByteArrayResource()
+{
+    QFile file(":/tst_qfileinfo/resources/file1.ext1");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    QVERIFY(!contents.isEmpty());
+    QVERIFY(file.seek(1));
+
+    QByteArray mapped = file.mapToByteArray(0, contents.size(), QFileDevice::MapWillNeedHint);
+    QCOMPARE(file.error(), QFile::NoError);
+    QCOMPARE(mapped, contents);
+    QCOMPARE(file.pos(), qint64(1));
+}
+
 void tst_QFile::openDirectory()
 {
     QFile f1(m_resourcesDir);
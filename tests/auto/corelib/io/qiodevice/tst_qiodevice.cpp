@@ -63,6 +63,9 @@ private slots:
     void transaction_data();
     void transaction();
 
+    void vectoredWriteRead_data();
+    void vectoredWriteRead();
+
 private:
     QSharedPointer<QTemporaryDir> m_tempDir;
     QString m_previousCurrent;
@@ -828,5 +831,68 @@ void tst_QIODevice::transaction()
     }
 }
 
+void tst_QIODevice::vectoredWriteRead_data()
+{
+    QTest::addColumn<bool>("useFile");
+    QTest::addColumn<bool>("unbuffered");
+
+    QTest::newRow("buffer") << false << false;
+    QTest::newRow("file") << true << false;
+    QTest::newRow("file-unbuffered") << true << true;
+}
+
+// Test writev()/readv() against the equivalent sequence of write()/read()
+void tst_QIODevice::vectoredWriteRead()
+{
+    QFETCH(bool, useFile);
+    QFETCH(bool, unbuffered);
+
+    const QByteArray header("header:");
+    const QByteArray payload(100000, 'p');
+    const QByteArray trailer("\ntrailer");
+    const QByteArray expected = header + payload + trailer;
+
+    QByteArray data;
+    QScopedPointer<QIODevice> dev(useFile ? (QIODevice *) new QFile("vectored.dat")
+                                          : (QIODevice *) new QBuffer(&data));
+    QIODevice::OpenMode mode = QIODevice::ReadWrite | QIODevice::Truncate;
+    if (unbuffered)
+        mode |= QIODevice::Unbuffered;
+    QVERIFY(dev->open(mode));
+
+    QCOMPARE(dev->writev({}), qint64(0));
+    QCOMPARE(dev->writev({ header, payload, trailer }), qint64(expected.size()));
+    QCOMPARE(dev->pos(), qint64(expected.size()));
+    QCOMPARE(dev->size(), qint64(expected.size()));
+
+    // overwrite in the middle of the data
+    QVERIFY(dev->seek(header.size()));
+    QCOMPARE(dev->writev({ "ab", "cd" }), qint64(4));
+    QCOMPARE(dev->pos(), qint64(header.size() + 4));
+    QByteArray patched = expected;
+    patched.replace(header.size(), 4, "abcd");
+
+    QVERIFY(dev->seek(0));
+    QByteArray first(header.size(), Qt::Uninitialized);
+    QByteArray second(payload.size(), Qt::Uninitialized);
+    QByteArray third(trailer.size() + 10, Qt::Uninitialized);
+    char *buffers[] = { first.data(), second.data(), third.data() };
+    const qint64 sizes[] = { first.size(), second.size(), third.size() };
+    QCOMPARE(dev->readv(buffers, sizes, 3), qint64(patched.size()));
+    QCOMPARE(dev->pos(), qint64(patched.size()));
+    QVERIFY(dev->atEnd());
+    third.truncate(trailer.size());
+    QCOMPARE(first + second + third, patched);
+
+    // a read that starts in the read buffer
+    QVERIFY(dev->seek(0));
+    char c;
+    QVERIFY(dev->getChar(&c));
+    QCOMPARE(c, 'h');
+    QCOMPARE(dev->readv(buffers, sizes, 1), qint64(first.size()));
+    QCOMPARE(first, patched.mid(1, first.size()));
+    QCOMPARE(dev->pos(), qint64(1 + first.size()));
+}
+
 QTEST_MAIN(tst_QIODevice)
 #include "tst_qiodevice.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qrandomaccessasyncfile
+QT = core testlib
+SOURCES = tst_qrandomaccessasyncfile.cpp
@@ -0,0 +1,225 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/QRandomAccessAsyncFile>
+#include <QtCore/QTemporaryFile>
+
+class tst_QRandomAccessAsyncFile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void backends_data();
+    void notOpen();
+    void readWrite_data() { backends_data(); }
+    void readWrite();
+    void readBatch_data() { backends_data(); }
+    void readBatch();
+    void readPastEnd_data() { backends_data(); }
+    void readPastEnd();
+    void writeReadOnly_data() { backends_data(); }
+    void writeReadOnly();
+    void closeWaitsForOperations_data() { backends_data(); }
+    void closeWaitsForOperations();
+
+private:
+    QByteArray content;
+    QTemporaryFile file;
+};
+
+void tst_QRandomAccessAsyncFile::initTestCase()
+{
+    content.resize(256 * 1024);
+    for (int i = 0; i < content.size(); ++i)
+        content[i] = char(i * 7 + i / 256);
+
+    QVERIFY(file.open());
+    QCOMPARE(file.write(content), qint64(content.size()));
+    QVERIFY(file.flush());
+}
+
+void tst_QRandomAccessAsyncFile::init()
+{
+    if (QTest::currentDataTag() && qstrcmp(QTest::currentDataTag(), "threadpool") == 0)
+        qputenv("QT_NO_IO_URING", "1");
+}
+
+void tst_QRandomAccessAsyncFile::cleanup()
+{
+    qunsetenv("QT_NO_IO_URING");
+}
+
+void tst_QRandomAccessAsyncFile::backends_data()
+{
+    QTest::addColumn<bool>("threadPool");
+    QTest::newRow("default") << false;
+    QTest::newRow("threadpool") << true;
+}
+
+static void checkBackend(const QRandomAccessAsyncFile &asyncFile, bool threadPool)
+{
+    if (threadPool)
+        QCOMPARE(asyncFile.backend(), QRandomAccessAsyncFile::ThreadPoolBackend);
+    else
+        QVERIFY(asyncFile.backend() != QRandomAccessAsyncFile::NoBackend);
+}
+
+void tst_QRandomAccessAsyncFile::notOpen()
+{
+    QRandomAccessAsyncFile asyncFile(file.fileName());
+    QVERIFY(!asyncFile.isOpen());
+    QCOMPARE(asyncFile.backend(), QRandomAccessAsyncFile::NoBackend);
+
+    QTest::ignoreMessage(QtWarningMsg, "QRandomAccessAsyncFile::read: File not open for reading");
+    QFuture<QByteArray> future = asyncFile.read(0, 10);
+    QVERIFY(future.isFinished());
+    QVERIFY(future.isCanceled());
+}
+
+void tst_QRandomAccessAsyncFile::readWrite()
+{
+    QFETCH(bool, threadPool);
+
+    QTemporaryFile target;
+    QVERIFY(target.open());
+
+    QRandomAccessAsyncFile asyncFile(target.fileName());
+    QVERIFY(asyncFile.open(QIODevice::ReadWrite));
+    checkBackend(asyncFile, threadPool);
+
+    QFuture<qint64> second = asyncFile.write(100, "world");
+    QFuture<qint64> first = asyncFile.write(0, "hello");
+    asyncFile.waitForFinished();
+    QVERIFY(first.isFinished());
+    QCOMPARE(first.result(), qint64(5));
+    QCOMPARE(second.result(), qint64(5));
+    QCOMPARE(asyncFile.size(), qint64(105));
+
+    // completions are delivered by the event loop, too
+    QFuture<QByteArray> hello = asyncFile.read(0, 5);
+    QFuture<QByteArray> world = asyncFile.read(100, 5);
+    QTRY_VERIFY(hello.isFinished() && world.isFinished());
+    QCOMPARE(hello.result(), QByteArray("hello"));
+    QCOMPARE(world.result(), QByteArray("world"));
+
+    QFuture<QByteArray> gap = asyncFile.read(5, 95);
+    QTRY_VERIFY(gap.isFinished());
+    QCOMPARE(gap.result(), QByteArray(95, '\0'));
+}
+
+void tst_QRandomAccessAsyncFile::readBatch()
+{
+    QFETCH(bool, threadPool);
+
+    QRandomAccessAsyncFile asyncFile(file.fileName());
+    QVERIFY(asyncFile.open(QIODevice::ReadOnly));
+    checkBackend(asyncFile, threadPool);
+
+    // many more than fit into the ring at once
+    const int count = 1000;
+    const int size = 200;
+    QList<QPair<qint64, qint64>> ranges;
+    for (int i = 0; i < count; ++i)
+        ranges.append(qMakePair(qint64(i) * 211, qint64(size)));
+
+    const QList<QFuture<QByteArray>> futures = asyncFile.readBatch(ranges);
+    QCOMPARE(futures.size(), count);
+    QTRY_VERIFY(futures.constLast().isFinished());
+    asyncFile.waitForFinished();
+
+    for (int i = 0; i < count; ++i) {
+        QVERIFY(futures.at(i).isFinished());
+        QCOMPARE(futures.at(i).result(), content.mid(i * 211, size));
+    }
+}
+
+void tst_QRandomAccessAsyncFile::readPastEnd()
+{
+    QFETCH(bool, threadPool);
+
+    QRandomAccessAsyncFile asyncFile(file.fileName());
+    QVERIFY(asyncFile.open(QIODevice::ReadOnly));
+    checkBackend(asyncFile, threadPool);
+
+    QFuture<QByteArray> tail = asyncFile.read(content.size() - 3, 100);
+    QFuture<QByteArray> beyond = asyncFile.read(content.size() + 10, 10);
+    QFuture<QByteArray> empty = asyncFile.read(0, 0);
+    asyncFile.waitForFinished();
+    QCOMPARE(tail.result(), content.right(3));
+    QCOMPARE(beyond.result(), QByteArray());
+    QCOMPARE(empty.result(), QByteArray());
+}
+
+void tst_QRandomAccessAsyncFile::writeReadOnly()
+{
+    QFETCH(bool, threadPool);
+
+    QRandomAccessAsyncFile asyncFile(file.fileName());
+    QVERIFY(asyncFile.open(QIODevice::ReadOnly));
+    checkBackend(asyncFile, threadPool);
+
+    QTest::ignoreMessage(QtWarningMsg, "QRandomAccessAsyncFile::write: File not open for writing");
+    QFuture<qint64> future = asyncFile.write(0, "data");
+    QVERIFY(future.isCanceled());
+}
+
+void tst_QRandomAccessAsyncFile::closeWaitsForOperations()
+{
+    QFETCH(bool, threadPool);
+
+    QList<QFuture<QByteArray>> futures;
+    {
+        QRandomAccessAsyncFile asyncFile(file.fileName());
+        QVERIFY(asyncFile.open(QIODevice::ReadOnly));
+        checkBackend(asyncFile, threadPool);
+        for (int i = 0; i < 300; ++i)
+            futures.append(asyncFile.read(i * 512, 512));
+        asyncFile.close();
+        QVERIFY(!asyncFile.isOpen());
+        for (const QFuture<QByteArray> &future : qAsConst(futures))
+            QVERIFY(future.isFinished());
+
+        // and once more, closing by destruction
+        QVERIFY(asyncFile.open(QIODevice::ReadOnly));
+        futures.clear();
+        for (int i = 0; i < 300; ++i)
+            futures.append(asyncFile.read(i * 512, 512));
+    }
+    for (int i = 0; i < futures.size(); ++i) {
+        QVERIFY(futures.at(i).isFinished());
+        QCOMPARE(futures.at(i).result(), content.mid(i * 512, 512));
+    }
+}
+
+QTEST_MAIN(tst_QRandomAccessAsyncFile)
+#include "tst_qrandomaccessasyncfile.moc"
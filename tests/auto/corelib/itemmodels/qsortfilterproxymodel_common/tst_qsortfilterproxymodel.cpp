@@ -5093,4 +5093,148 @@ void tst_QSortFilterProxyModel::invalidateColumnsOrRowsFilter()
     QCOMPARE(proxy.rowFiltered, 20);
 }
 
+static QStringList asyncTestStrings(int count, int offset = 0)
+{
+    QStringList strings;
+    strings.reserve(count);
+    for (int i = 0; i < count; ++i)
+        strings.append(QString::number(((i + offset) * 7919) % 100003));
+    return strings;
+}
+
+static bool isSortedAndFiltered(const QAbstractItemModel &proxy, Qt::SortOrder order,
+                                const QString &filter)
+{
+    for (int row = 0; row < proxy.rowCount(); ++row) {
+        const QString value = proxy.index(row, 0).data().toString();
+        if (!value.contains(filter))
+            return false;
+        if (row == 0)
+            continue;
+        const QString previous = proxy.index(row - 1, 0).data().toString();
+        if (order == Qt::AscendingOrder ? value < previous : previous < value)
+            return false;
+    }
+    return true;
+}
+
+void tst_QSortFilterProxyModel::asynchronousSortFilter()
+{
+#if !QT_CONFIG(future)
+    QSKIP("This test requires QFuture support");
+#else
+    const QStringList strings = asyncTestStrings(5000);
+    QStringListModel model(strings);
+    QSortFilterProxyModel proxy;
+    QSignalSpy asyncChangedSpy(&proxy, &QSortFilterProxyModel::asynchronousSortFilterChanged);
+    proxy.setAsynchronousSortFilter(true);
+    QVERIFY(proxy.asynchronousSortFilter());
+    QCOMPARE(asyncChangedSpy.count(), 1);
+    proxy.setSourceModel(&model);
+
+    QSignalSpy layoutChangedSpy(&proxy, &QAbstractItemModel::layoutChanged);
+    proxy.sort(0);
+    // the old order stays visible until the worker is done
+    QCOMPARE(proxy.index(0, 0).data().toString(), strings.first());
+    QTRY_COMPARE(layoutChangedSpy.count(), 1);
+    QCOMPARE(proxy.rowCount(), strings.count());
+    QVERIFY(isSortedAndFiltered(proxy, Qt::AscendingOrder, QString()));
+
+    // a new request supersedes the one that is still running
+    proxy.setFilterFixedString(QLatin1String("1"));
+    proxy.sort(0, Qt::DescendingOrder);
+    const int expectedRows = int(std::count_if(strings.cbegin(), strings.cend(), [](const QString &s) {
+        return s.contains(QLatin1Char('1'));
+    }));
+    QTRY_COMPARE(proxy.rowCount(), expectedRows);
+    QTRY_VERIFY(isSortedAndFiltered(proxy, Qt::DescendingOrder, QLatin1String("1")));
+
+    // persistent indexes follow the new order
+    const QPersistentModelIndex persistent = proxy.index(0, 0);
+    const QString persistentValue = persistent.data().toString();
+    proxy.sort(0, Qt::AscendingOrder);
+    QTRY_VERIFY(isSortedAndFiltered(proxy, Qt::AscendingOrder, QLatin1String("1")));
+    QVERIFY(persistent.isValid());
+    QCOMPARE(persistent.row(), proxy.rowCount() - 1);
+    QCOMPARE(persistent.data().toString(), persistentValue);
+
+    // switching back applies outstanding requests synchronously
+    proxy.setFilterFixedString(QLatin1String("2"));
+    proxy.setAsynchronousSortFilter(false);
+    QCOMPARE(asyncChangedSpy.count(), 2);
+    QVERIFY(isSortedAndFiltered(proxy, Qt::AscendingOrder, QLatin1String("2")));
+    proxy.sort(0, Qt::DescendingOrder);
+    QVERIFY(isSortedAndFiltered(proxy, Qt::DescendingOrder, QLatin1String("2")));
+#endif
+}
+
+namespace AsynchronousSortFilter {
+class StringModel : public QAbstractListModel
+{
+public:
+    explicit StringModel(const QStringList &strings) : m_strings(strings) {}
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_strings.count();
+    }
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (role != Qt::DisplayRole && role != Qt::EditRole)
+            return QVariant();
+        return m_strings.at(index.row());
+    }
+
+    void append(const QStringList &strings)
+    {
+        beginInsertRows(QModelIndex(), m_strings.count(), m_strings.count() + strings.count() - 1);
+        m_strings += strings;
+        endInsertRows();
+    }
+    void prependToAll(const QString &prefix)
+    {
+        for (QString &value : m_strings)
+            value.prepend(prefix);
+        emit dataChanged(index(0), index(m_strings.count() - 1));
+    }
+
+private:
+    QStringList m_strings;
+};
+}
+
+void tst_QSortFilterProxyModel::asynchronousSortFilterLargeChanges()
+{
+#if !QT_CONFIG(future)
+    QSKIP("This test requires QFuture support");
+#else
+    using namespace AsynchronousSortFilter;
+    StringModel model(asyncTestStrings(5000));
+    QSortFilterProxyModel proxy;
+    proxy.setAsynchronousSortFilter(true);
+    proxy.setFilterFixedString(QLatin1String("3"));
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+    QTRY_VERIFY(proxy.rowCount() > 0
+                && isSortedAndFiltered(proxy, Qt::AscendingOrder, QLatin1String("3")));
+
+    // a large batch of inserted rows is merged into the sorted rows at once
+    const QStringList inserted = asyncTestStrings(2000, 5000);
+    const int expectedInserted = int(std::count_if(inserted.cbegin(), inserted.cend(), [](const QString &s) {
+        return s.contains(QLatin1Char('3'));
+    }));
+    const int oldRowCount = proxy.rowCount();
+    QSignalSpy rowsInsertedSpy(&proxy, &QAbstractItemModel::rowsInserted);
+    model.append(inserted);
+    QCOMPARE(rowsInsertedSpy.count(), 1);
+    QCOMPARE(proxy.rowCount(), oldRowCount + expectedInserted);
+    QVERIFY(isSortedAndFiltered(proxy, Qt::AscendingOrder, QLatin1String("3")));
+
+    // a large range of changed rows is filtered and sorted in the background
+    model.prependToAll(QLatin1String("3"));
+    QTRY_COMPARE(proxy.rowCount(), model.rowCount());
+    QTRY_VERIFY(isSortedAndFiltered(proxy, Qt::AscendingOrder, QLatin1String("3")));
+#endif
+}
+
 #include "tst_qsortfilterproxymodel.moc"
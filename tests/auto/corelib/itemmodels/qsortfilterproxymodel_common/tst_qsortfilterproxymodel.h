@@ -162,6 +162,9 @@ private slots:
     void checkFilteredIndexes();
     void invalidateColumnsOrRowsFilter();
 
+    void asynchronousSortFilter();
+    void asynchronousSortFilterLargeChanges();
+
 protected:
     void buildHierarchy(const QStringList &data, QAbstractItemModel *model);
     void checkHierarchy(const QStringList &data, const QAbstractItemModel *model);
@@ -34,6 +34,17 @@
 #endif
 #include <QtTest/QtTest>
 
+#ifdef TST_QEVENTDISPATCHER_EPOLL
+#  define tst_QEventDispatcher tst_QEventDispatcherEpoll
+
+// run the same tests with QEventDispatcherEpoll in every thread
+static void useEpollEventDispatcher()
+{
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+}
+Q_CONSTRUCTOR_FUNCTION(useEpollEventDispatcher)
+#endif
+
 enum {
     PreciseTimerInterval    =   10,
     CoarseTimerInterval     =  200,
@@ -91,6 +102,10 @@ bool tst_QEventDispatcher::event(QEvent *e)
 // drain the system event queue after the test starts to avoid destabilizing the test functions
 void tst_QEventDispatcher::initTestCase()
 {
+#ifdef TST_QEVENTDISPATCHER_EPOLL
+    QVERIFY(eventDispatcher->inherits("QEventDispatcherEpoll"));
+#endif
+
     QElapsedTimer elapsedTimer;
     elapsedTimer.start();
     while (!elapsedTimer.hasExpired(CoarseTimerInterval) && eventDispatcher->processEvents(QEventLoop::AllEvents)) {
@@ -33,6 +33,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QTemporaryFile>
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
@@ -49,6 +50,15 @@
 #  undef min
 #endif // Q_CC_MSVC
 
+#ifdef TST_QSOCKETNOTIFIER_EPOLL
+// run the same tests with QEventDispatcherEpoll in every thread
+static void useEpollEventDispatcher()
+{
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+}
+Q_CONSTRUCTOR_FUNCTION(useEpollEventDispatcher)
+#endif
+
 
 class tst_QSocketNotifier : public QObject
 {
@@ -58,6 +68,7 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+    void regularFile();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -314,6 +325,29 @@ void tst_QSocketNotifier::posixSockets()
     }
     qt_safe_close(posixSocket);
 }
+
+void tst_QSocketNotifier::regularFile()
+{
+    // poll() reports regular files as always ready, and so must every dispatcher
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QVERIFY(file.write("hello") == 5);
+    QVERIFY(file.flush());
+
+    QSocketNotifier readNotifier(file.handle(), QSocketNotifier::Read);
+    QSignalSpy readSpy(&readNotifier, &QSocketNotifier::activated);
+    QVERIFY(readSpy.isValid());
+    QTRY_VERIFY(readSpy.count() > 0);
+
+    readNotifier.setEnabled(false);
+    QSocketNotifier writeNotifier(file.handle(), QSocketNotifier::Write);
+    QSignalSpy writeSpy(&writeNotifier, &QSocketNotifier::activated);
+    QVERIFY(writeSpy.isValid());
+    QTRY_VERIFY(writeSpy.count() > 0);
+    const int readCount = readSpy.count();
+    QCoreApplication::processEvents();
+    QCOMPARE(readSpy.count(), readCount);
+}
 #endif
 
 void tst_QSocketNotifier::async_readDatagramSlot()
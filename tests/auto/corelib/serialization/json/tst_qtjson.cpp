@@ -106,6 +106,9 @@ private Q_SLOTS:
     void fromJsonErrors();
     void parseNumbers();
     void parseStrings();
+    void parseStringsAcrossBlocks_data();
+    void parseStringsAcrossBlocks();
+    void parseLongWhitespace();
     void parseDuplicateKeys();
     void testParser();
 
@@ -2251,6 +2254,63 @@ void tst_QtJson::parseStrings()
 
 }
 
+void tst_QtJson::parseStringsAcrossBlocks_data()
+{
+    QTest::addColumn<QByteArray>("special");
+    QTest::addColumn<QString>("decoded");
+
+    QTest::newRow("escaped-quote") << QByteArray("\\\"") << QString("\"");
+    QTest::newRow("escaped-backslash") << QByteArray("\\\\") << QString("\\");
+    QTest::newRow("escaped-unicode") << QByteArray("\\u0402") << QString(QChar(0x402));
+    QTest::newRow("utf8") << QByteArray(UNICODE_DJE) << QString(QChar(0x402));
+    QTest::newRow("utf8-4byte") << QByteArray("\xf0\x9f\x98\x80")
+                                << QString::fromUcs4(U"\U0001F600");
+}
+
+void tst_QtJson::parseStringsAcrossBlocks()
+{
+    // The parser scans strings a block at a time where SIMD is available;
+    // move the interesting character across the block boundaries.
+    QFETCH(QByteArray, special);
+    QFETCH(QString, decoded);
+
+    for (int prefix = 0; prefix < 70; ++prefix) {
+        for (int suffix : { 0, 1, 15, 16, 17, 31, 32, 33 }) {
+            QByteArray json = "[\"" + QByteArray(prefix, 'a') + special
+                    + QByteArray(suffix, 'b') + "\"]";
+            QString expected = QString(prefix, 'a') + decoded + QString(suffix, 'b');
+
+            QJsonParseError error;
+            QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().at(0).toString(), expected);
+
+            // unterminated string
+            json.chop(2);
+            doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+        }
+    }
+}
+
+void tst_QtJson::parseLongWhitespace()
+{
+    for (int n = 0; n < 70; ++n) {
+        const QByteArray ws = QByteArray(" \t\r\n").repeated(n).left(n);
+        QByteArray json = ws + "{" + ws + "\"a\"" + ws + ":" + ws + "[" + ws + "1" + ws + ","
+                + ws + "true" + ws + "]" + ws + "}" + ws;
+
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc.object().value("a").toArray(), QJsonArray({ 1, true }));
+
+        doc = QJsonDocument::fromJson(json + 'x', &error);
+        QCOMPARE(error.error, QJsonParseError::GarbageAtEnd);
+        QCOMPARE(error.offset, json.size());
+    }
+}
+
 void tst_QtJson::parseDuplicateKeys()
 {
     const char *json = "{ \"B\": true, \"A\": null, \"B\": false }";
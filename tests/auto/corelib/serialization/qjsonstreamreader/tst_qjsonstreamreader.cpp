@@ -0,0 +1,299 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonstreamreader.h>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void tokens_data();
+    void tokens();
+    void chunked_data() { tokens_data(); }
+    void chunked();
+    void errors_data();
+    void errors();
+    void device();
+    void sequence();
+    void skipValue();
+    void textViews();
+    void resumeSkipValue();
+};
+
+// Renders the token stream in a compact form so tests can compare it as a string
+static QString tokenString(QJsonStreamReader &reader)
+{
+    QStringList result;
+    for (;;) {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::StartArray:     result << "["; break;
+        case QJsonStreamReader::EndArray:       result << "]"; break;
+        case QJsonStreamReader::StartObject:    result << "{"; break;
+        case QJsonStreamReader::EndObject:      result << "}"; break;
+        case QJsonStreamReader::Name:           result << reader.toString() + ':'; break;
+        case QJsonStreamReader::String:         result << '"' + reader.toString() + '"'; break;
+        case QJsonStreamReader::Bool:           result << (reader.toBool() ? "true" : "false"); break;
+        case QJsonStreamReader::Null:           result << "null"; break;
+        case QJsonStreamReader::Number:
+            result << (reader.isInteger() ? QString::number(reader.toInteger())
+                                          : QString::number(reader.toDouble()) + 'd');
+            break;
+        case QJsonStreamReader::EndDocument:
+        case QJsonStreamReader::Invalid:
+        case QJsonStreamReader::NoToken:
+            break;
+        }
+        if (reader.atEnd())
+            break;
+    }
+    return result.join(' ');
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty-array") << QByteArray("[]") << "[ ]";
+    QTest::newRow("empty-object") << QByteArray(" { } ") << "{ }";
+    QTest::newRow("scalars") << QByteArray("[true, false, null, 1, -2, 1.5, 1e3, \"x\"]")
+                             << "[ true false null 1 -2 1.5d 1000 \"x\" ]";
+    QTest::newRow("object") << QByteArray("{\"a\": 1, \"b\": [2, {\"c\": \"d\"}], \"e\": {}}")
+                            << "{ a: 1 b: [ 2 { c: \"d\" } ] e: { } }";
+    QTest::newRow("escapes") << QByteArray("[\"a\\\"b\\\\c\\u0041\\n\"]")
+                             << "[ \"a\"b\\cA\n\" ]";
+    QTest::newRow("utf8") << QByteArray("{\"\xd0\x82\": \"\xf0\x9f\x98\x80\"}")
+                          << QString::fromUtf8("{ \xd0\x82: \"\xf0\x9f\x98\x80\" }");
+    QTest::newRow("top-level-scalar") << QByteArray("\"top\" ") << "\"top\"";
+    QTest::newRow("whitespace") << QByteArray("\r\n\t[ 1 ,\n 2 ]\n") << "[ 1 2 ]";
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(tokenString(reader), expected);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+    QCOMPARE(reader.depth(), 0);
+    QCOMPARE(reader.currentOffset(), qint64(json.size()));
+}
+
+void tst_QJsonStreamReader::chunked()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    // feed one byte at a time; every token must survive being split
+    QJsonStreamReader reader;
+    QStringList tokens;
+    for (char c : qAsConst(json)) {
+        reader.addData(&c, 1);
+        QString s = tokenString(reader);
+        if (!s.isEmpty())
+            tokens << s;
+        QVERIFY2(reader.error() != QJsonStreamReader::NotWellFormedError,
+                 qPrintable(reader.errorString()));
+    }
+    // a top-level number can only be known to have ended by what follows it
+    reader.addData(" ", 1);
+    QString s = tokenString(reader);
+    if (!s.isEmpty())
+        tokens << s;
+    QCOMPARE(tokens.join(' '), expected);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+
+    QTest::newRow("missing-name-separator") << QByteArray("{\"a\" 1}")
+                                            << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]")
+                                             << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("unterminated-object") << QByteArray("{\"a\": 1 \"b\": 2}")
+                                         << QJsonParseError::UnterminatedObject;
+    QTest::newRow("trailing-comma-array") << QByteArray("[1,]") << QJsonParseError::MissingObject;
+    QTest::newRow("trailing-comma-object") << QByteArray("{\"a\":1,}")
+                                           << QJsonParseError::MissingObject;
+    QTest::newRow("illegal-value") << QByteArray("[tru]") << QJsonParseError::IllegalValue;
+    QTest::newRow("illegal-number") << QByteArray("[-]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("illegal-escape") << QByteArray("[\"\\u12\"]")
+                                    << QJsonParseError::IllegalEscapeSequence;
+    QTest::newRow("illegal-utf8") << QByteArray("[\"\xff\"]") << QJsonParseError::IllegalUTF8String;
+    QTest::newRow("deep-nesting") << QByteArray(2048, '[') << QJsonParseError::DeepNesting;
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+
+    QJsonStreamReader reader(json);
+    tokenString(reader);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.parseError(), error);
+    QVERIFY(!reader.errorString().isEmpty());
+
+    // errors are final
+    reader.addData(" ");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+
+    // the same error as QJsonDocument, where that accepts the document kind
+    QJsonParseError documentError;
+    QJsonDocument::fromJson(json, &documentError);
+    if (documentError.error != QJsonParseError::UnterminatedArray)
+        QCOMPARE(documentError.error, error);
+}
+
+void tst_QJsonStreamReader::device()
+{
+    // large enough to need several reads from the device
+    QByteArray json = "[";
+    for (int i = 0; i < 20000; ++i)
+        json += "{\"id\": " + QByteArray::number(i) + ", \"name\": \"item\\t" + QByteArray::number(i) + "\"},";
+    json += "null]";
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    for (int i = 0; i < 20000; ++i) {
+        QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+        QCOMPARE(reader.toString(), QString("id"));
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+        QCOMPARE(reader.toInteger(), qint64(i));
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+        QCOMPARE(reader.toString(), "item\t" + QString::number(i));
+        QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    }
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Null);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QCOMPARE(reader.currentOffset(), qint64(json.size()));
+
+    // a number at the very end of a file is complete
+    QByteArray number = "42";
+    QBuffer numberBuffer(&number);
+    QVERIFY(numberBuffer.open(QIODevice::ReadOnly));
+    reader.setDevice(&numberBuffer);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), qint64(42));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::sequence()
+{
+    QJsonStreamReader reader("{\"a\": 1}\n{\"a\": 2}\n");
+    QCOMPARE(tokenString(reader), QString("{ a: 1 } { a: 2 }"));
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+
+    // more records can follow later
+    reader.addData("{\"a\": 3");
+    QCOMPARE(tokenString(reader), QString("{ a:"));   // more digits could follow
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    QCOMPARE(reader.depth(), 1);
+    reader.addData("}\n");
+    QCOMPARE(tokenString(reader), QString("3 }"));
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+}
+
+void tst_QJsonStreamReader::skipValue()
+{
+    QJsonStreamReader reader("{\"skip\": {\"x\": [1, {\"y\": []}]}, \"a\": [1, 2], \"b\": 3, \"c\": 4}");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QVERIFY(reader.skipValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.depth(), 1);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QVERIFY(reader.skipValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QVERIFY(reader.skipValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), qint64(3));
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.toString(), QString("c"));
+    QCOMPARE(tokenString(reader), QString("4 }"));
+}
+
+void tst_QJsonStreamReader::resumeSkipValue()
+{
+    QJsonStreamReader reader("[[1, [2, ");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QVERIFY(!reader.skipValue());
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+
+    reader.addData("3]], \"after\"]");
+    QVERIFY(reader.skipValue());
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.toString(), QString("after"));
+}
+
+void tst_QJsonStreamReader::textViews()
+{
+    QJsonStreamReader reader("[\"plain\", \"esc\\naped\", 1]");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QVERIFY(reader.text().isNull());
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QVERIFY(reader.text() == u"plain");
+    QCOMPARE(reader.text().size_bytes(), qsizetype(5));     // UTF-8, straight from the buffer
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QVERIFY(reader.text() == u"esc\naped");
+    QCOMPARE(reader.text().size_bytes(), qsizetype(16));    // decoded to UTF-16
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QVERIFY(reader.text().isNull());
+    QVERIFY(reader.toString().isNull());
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonStreamReader)
+#include "tst_qjsonstreamreader.moc"
@@ -5,6 +5,7 @@ SUBDIRS = \
     qcborstreamwriter \
     qcborvalue \
     qcborvalue_json \
+    qjsonstreamreader \
     qdatastream \
     qdatastream_core_pixmap \
     qtextstream \
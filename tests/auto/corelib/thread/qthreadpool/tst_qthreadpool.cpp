@@ -101,6 +101,9 @@ private slots:
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
+    void workStealing_data();
+    void workStealing();
+    void workStealingTryTake();
 
 private:
     QMutex m_functionTestMutex;
@@ -1310,5 +1313,69 @@ void tst_QThreadPool::waitForDoneAfterTake()
 
 }
 
+void tst_QThreadPool::workStealing_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<int>("tasksPerSpawner");
+
+    QTest::newRow("1-thread") << 1 << 100;
+    QTest::newRow("4-threads") << 4 << 100;
+    // more than fit into a thread's own queue
+    QTest::newRow("4-threads-overflow") << 4 << 5000;
+}
+
+void tst_QThreadPool::workStealing()
+{
+    QFETCH(int, threadCount);
+    QFETCH(int, tasksPerSpawner);
+    const int spawnerCount = 16;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    QAtomicInt count;
+    for (int i = 0; i < spawnerCount; ++i) {
+        threadPool.start([&] {
+            for (int j = 0; j < tasksPerSpawner; ++j)
+                threadPool.start([&] { count.ref(); });
+        });
+    }
+
+    QVERIFY(threadPool.waitForDone(10000));
+    QCOMPARE(count.loadRelaxed(), spawnerCount * tasksPerSpawner);
+    QCOMPARE(threadPool.activeThreadCount(), 0);
+
+    // runnables started from outside the pool still go through the shared queue
+    count.storeRelaxed(0);
+    for (int i = 0; i < 100; ++i)
+        threadPool.start([&] { count.ref(); });
+    QVERIFY(threadPool.waitForDone(10000));
+    QCOMPARE(count.loadRelaxed(), 100);
+}
+
+void tst_QThreadPool::workStealingTryTake()
+{
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    bool taken = false;
+    bool ran = false;
+    QRunnable *child = QRunnable::create([&] { ran = true; });
+    child->setAutoDelete(false);
+    threadPool.start([&] {
+        threadPool.start(child);
+        taken = threadPool.tryTake(child);
+    });
+
+    QVERIFY(threadPool.waitForDone(10000));
+    QVERIFY(taken);
+    QVERIFY(!ran);
+    delete child;
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
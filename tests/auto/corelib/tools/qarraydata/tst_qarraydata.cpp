@@ -74,6 +74,7 @@ private slots:
     void arrayOpsExtra();
     void fromRawData_data();
     void fromRawData();
+    void externalStorage();
     void literals();
     void variadicLiterals();
     void rValueReferences();
@@ -1820,6 +1821,53 @@ void tst_QArrayData::fromRawData()
     }
 }
 
+void tst_QArrayData::externalStorage()
+{
+    struct Block {
+        alignas(QArrayData) char header[QArrayData::ExternalHeaderSize];
+        char data[16];
+    } block;
+    static_assert(offsetof(Block, data) == QArrayData::ExternalHeaderSize);
+    memcpy(block.data, "external", 9);
+
+    int cleanups = 0;
+    const auto cleanup = [](void *info) { ++*static_cast<int *>(info); };
+    const auto makeArray = [&]() {
+        QArrayData *header = QArrayData::initializeExternalHeader(block.header, sizeof(block.data),
+                                                                  cleanup, &cleanups);
+        return QByteArray(QByteArray::DataPointer(static_cast<QTypedArrayData<char> *>(header),
+                                                  block.data + 2, 6));
+    };
+
+    {
+        QByteArray array = makeArray();
+        QVERIFY(array.data_ptr().flags() & QArrayData::ExternalStorage);
+        QCOMPARE(array, "ternal");
+        QCOMPARE(array.constData(), block.data + 2);
+
+        QByteArray copy = array;
+        copy[0] = 'T';
+        QCOMPARE(block.data[2], 't');
+        copy = QByteArray();
+
+        // sole owner: modified in place
+        array[0] = 'T';
+        QCOMPARE(block.data[2], 'T');
+        QCOMPARE(cleanups, 0);
+    }
+    QCOMPARE(cleanups, 1);
+
+    cleanups = 0;
+    {
+        QByteArray array = makeArray();
+        array.append(" storage, now somewhere else");
+        QCOMPARE(cleanups, 1);
+        QCOMPARE(array, "Ternal storage, now somewhere else");
+        QVERIFY(array.constData() < block.data || array.constData() >= block.data + sizeof(block.data));
+    }
+    QCOMPARE(cleanups, 1);
+}
+
 void tst_QArrayData::literals()
 {
     {
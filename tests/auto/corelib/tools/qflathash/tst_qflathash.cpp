@@ -0,0 +1,235 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <private/qflathash_p.h>
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qstring.h>
+#include <qstringview.h>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void constructing();
+    void insertion();
+    void removal();
+    void iterators();
+    void heterogeneousLookup();
+    void compareWithQHash();
+    void nonTrivialTypes();
+};
+
+void tst_QFlatHash::constructing()
+{
+    using Hash = QFlatHash<int, QByteArray>;
+    Hash empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.size(), 0);
+    QCOMPARE(empty.capacity(), 0);
+    QVERIFY(!empty.contains(1));
+    QCOMPARE(empty.begin(), empty.end());
+
+    Hash hash{ { 1, "one" }, { 2, "two" }, { 3, "three" } };
+    QCOMPARE(hash.size(), 3);
+    QCOMPARE(hash.value(2), QByteArray("two"));
+
+    Hash copy = hash;
+    copy.insert(4, "four");
+    QCOMPARE(copy.size(), 4);
+    QCOMPARE(hash.size(), 3);
+    QVERIFY(!hash.contains(4));
+
+    Hash moved = std::move(copy);
+    QCOMPARE(moved.size(), 4);
+    QVERIFY(copy.isEmpty());
+    QCOMPARE(moved.value(4), QByteArray("four"));
+
+    copy = moved;
+    QCOMPARE(copy.size(), 4);
+    copy.clear();
+    QVERIFY(copy.isEmpty());
+    QVERIFY(!copy.contains(1));
+
+    Hash reserved;
+    reserved.reserve(1000);
+    QVERIFY(reserved.capacity() >= 1000);
+}
+
+void tst_QFlatHash::insertion()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 10000; ++i)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.size(), 10000);
+    for (int i = 0; i < 10000; ++i)
+        QCOMPARE(hash.value(i, -1), i * 2);
+    QCOMPARE(hash.value(10000, -1), -1);
+
+    // inserting an existing key replaces the value
+    auto it = hash.insert(42, 0);
+    QCOMPARE(it.key(), 42);
+    QCOMPARE(*it, 0);
+    QCOMPARE(hash.size(), 10000);
+
+    hash[42] = 1;
+    QCOMPARE(hash.value(42), 1);
+    ++hash[10000];
+    QCOMPARE(hash.value(10000), 1);
+    QCOMPARE(hash.size(), 10001);
+}
+
+void tst_QFlatHash::removal()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    for (int i = 0; i < 1000; i += 2)
+        QVERIFY(hash.remove(i));
+    QVERIFY(!hash.remove(0));
+    QCOMPARE(hash.size(), 500);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), bool(i & 1));
+
+    // churn: removed slots must be reused without growing forever
+    const qsizetype capacity = hash.capacity();
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 100; ++i)
+            hash.insert(100000 + round * 100 + i, i);
+        for (int i = 0; i < 100; ++i)
+            QVERIFY(hash.remove(100000 + round * 100 + i));
+    }
+    QCOMPARE(hash.size(), 500);
+    QCOMPARE(hash.capacity(), capacity);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), bool(i & 1));
+
+    auto it = hash.begin();
+    while (it != hash.end()) {
+        if (it.key() % 3 == 0)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), (i & 1) && i % 3 != 0);
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> hash;
+    int expectedSum = 0;
+    for (int i = 0; i < 500; ++i) {
+        hash.insert(i, i);
+        expectedSum += i;
+    }
+
+    int sum = 0;
+    int count = 0;
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+        QCOMPARE(it.key(), it.value());
+        sum += *it;
+        ++count;
+    }
+    QCOMPARE(count, 500);
+    QCOMPARE(sum, expectedSum);
+
+    for (int &value : hash)
+        value = -value;
+    QCOMPARE(hash.value(10), -10);
+
+    QFlatHash<int, int>::const_iterator cit = hash.find(7);
+    QCOMPARE(cit.key(), 7);
+    QCOMPARE(hash.find(1000), hash.end());
+}
+
+void tst_QFlatHash::heterogeneousLookup()
+{
+    QFlatHash<QString, int> strings;
+    strings.insert(QStringLiteral("alpha"), 1);
+    strings.insert(QStringLiteral("beta"), 2);
+
+    const QString text = QStringLiteral("alpha beta gamma");
+    QCOMPARE(strings.value(QStringView(text).left(5)), 1);
+    QCOMPARE(strings.value(QStringView(text).mid(6, 4)), 2);
+    QVERIFY(!strings.contains(QStringView(text).right(5)));
+    QCOMPARE(strings.constFind(QStringView(text).mid(6, 4)).key(), QStringLiteral("beta"));
+    QVERIFY(strings.remove(QStringView(text).left(5)));
+    QCOMPARE(strings.size(), 1);
+
+    QFlatHash<QByteArray, int> bytes;
+    bytes.insert("key", 3);
+    QCOMPARE(bytes.value(QByteArrayView("key")), 3);
+    QVERIFY(!bytes.contains(QByteArrayView("ke")));
+}
+
+void tst_QFlatHash::compareWithQHash()
+{
+    // random operations, checked against QHash
+    QRandomGenerator rng(1234);
+    QFlatHash<quint32, quint32> flat;
+    QHash<quint32, quint32> hash;
+    for (int i = 0; i < 100000; ++i) {
+        const quint32 key = rng.bounded(5000u);
+        switch (rng.bounded(3u)) {
+        case 0:
+            flat.insert(key, quint32(i));
+            hash.insert(key, quint32(i));
+            break;
+        case 1:
+            QCOMPARE(flat.remove(key), hash.remove(key) != 0);
+            break;
+        case 2:
+            QCOMPARE(flat.value(key, ~0u), hash.value(key, ~0u));
+            break;
+        }
+        QCOMPARE(flat.size(), hash.size());
+    }
+    for (auto it = flat.cbegin(); it != flat.cend(); ++it)
+        QCOMPARE(*it, hash.value(it.key()));
+}
+
+void tst_QFlatHash::nonTrivialTypes()
+{
+    QFlatHash<QString, QStringList> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash[QString::number(i)].append(QString::number(i * i));
+    QFlatHash<QString, QStringList> copy = hash;
+    for (int i = 0; i < 1000; i += 2)
+        QVERIFY(hash.remove(QString::number(i)));
+    QCOMPARE(hash.size(), 500);
+    QCOMPARE(copy.size(), 1000);
+    QCOMPARE(copy.value(QStringLiteral("10")), QStringList(QStringLiteral("100")));
+    QCOMPARE(hash.value(QStringLiteral("11")), QStringList(QStringLiteral("121")));
+    QVERIFY(hash.value(QStringLiteral("10")).isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
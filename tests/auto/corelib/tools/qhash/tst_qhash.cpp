@@ -73,6 +73,7 @@ private slots:
     void emplace();
 
     void badHashFunction();
+    void heterogeneousLookup();
 };
 
 struct IdentityTracker {
@@ -1754,5 +1755,35 @@ void tst_QHash::badHashFunction()
 
 }
 
+void tst_QHash::heterogeneousLookup()
+{
+    QHash<QString, int> hash;
+    QVERIFY(!hash.contains(QStringView(u"one")));
+    QCOMPARE(hash.value(QStringView(u"one"), -1), -1);
+    QCOMPARE(hash.find(QStringView(u"one")), hash.end());
+    QVERIFY(!hash.isDetached());
+
+    hash.insert(QStringLiteral("one"), 1);
+    hash.insert(QStringLiteral("two"), 2);
+    const QString text = QStringLiteral("one two three");
+    QVERIFY(hash.contains(QStringView(text).left(3)));
+    QCOMPARE(hash.count(QStringView(text).left(3)), 1);
+    QCOMPARE(hash.value(QStringView(text).mid(4, 3)), 2);
+    QCOMPARE(hash.value(QStringView(text).right(5), -1), -1);
+    QCOMPARE(hash.constFind(QStringView(text).mid(4, 3)).key(), QStringLiteral("two"));
+
+    auto it = hash.find(QStringView(text).left(3));
+    QVERIFY(it != hash.end());
+    *it = 11;
+    QCOMPARE(hash.value(QStringLiteral("one")), 11);
+
+    QHash<QByteArray, int> bytes;
+    bytes.insert("key", 1);
+    const QByteArray data = "key value";
+    QVERIFY(bytes.contains(QByteArrayView(data).first(3)));
+    QCOMPARE(bytes.value(QByteArrayView(data).first(3)), 1);
+    QVERIFY(!bytes.contains(QByteArrayView(data).first(2)));
+}
+
 QTEST_APPLESS_MAIN(tst_QHash)
 #include "tst_qhash.moc"
@@ -11,6 +11,7 @@ SUBDIRS=\
     qcryptographichash \
     qeasingcurve \
     qexplicitlyshareddatapointer \
+    qflathash \
     qflatmap \
     qfreelist \
     qhash \
@@ -5,6 +5,7 @@ SUBDIRS=\
    qpixmap \
    qpixmapcache \
    qimage \
+   qimagedecodecache \
    qimageiohandler \
    qimagewriter \
    qmovie \
@@ -34,6 +34,7 @@
 #include <qlist.h>
 #include <qtransform.h>
 #include <qrandom.h>
+#include <qthreadpool.h>
 #include <stdio.h>
 
 #include <qpainter.h>
@@ -129,6 +130,8 @@ private slots:
     void transformed_data();
     void transformed();
     void transformed2();
+    void largeTransformed_data();
+    void largeTransformed();
 
     void scaled();
 
@@ -1699,7 +1702,8 @@ void tst_QImage::smoothScale2_data()
     QTest::addColumn<int>("size");
 
     int sizes[] = { 2, 3, 4, 6, 7, 8, 10, 16, 20, 32, 40, 64, 100, 101, 128, 0 };
-    QImage::Format formats[] = { QImage::Format_RGB32, QImage::Format_ARGB32_Premultiplied, QImage::Format_RGBX64, QImage::Format_RGBA64_Premultiplied, QImage::Format_Invalid };
+    QImage::Format formats[] = { QImage::Format_RGB32, QImage::Format_ARGB32_Premultiplied, QImage::Format_RGBX64, QImage::Format_RGBA64_Premultiplied,
+                                 QImage::Format_Grayscale8, QImage::Format_Grayscale16, QImage::Format_Invalid };
     for (int j = 0; formats[j] != QImage::Format_Invalid; ++j) {
         QString formatstr = formatToString(formats[j]);
         for (int i = 0; sizes[i] != 0; ++i) {
@@ -1715,8 +1719,9 @@ void tst_QImage::smoothScale2()
     QFETCH(int, size);
 
     bool opaque = (format == QImage::Format_RGB32 || format == QImage::Format_RGBX64);
+    bool gray = (format == QImage::Format_Grayscale8 || format == QImage::Format_Grayscale16);
 
-    QRgb expected = opaque ? qRgb(63, 127, 255) : qRgba(31, 63, 127, 127);
+    QRgb expected = gray ? qRgb(127, 127, 127) : opaque ? qRgb(63, 127, 255) : qRgba(31, 63, 127, 127);
 
     QImage img(size, size, format);
     img.fill(expected);
@@ -1860,6 +1865,8 @@ void tst_QImage::smoothScale4_data()
     QTest::addColumn<QImage::Format>("format");
 
     QTest::newRow("RGB32") << QImage::Format_RGB32;
+    QTest::newRow("Grayscale8") << QImage::Format_Grayscale8;
+    QTest::newRow("Grayscale16") << QImage::Format_Grayscale16;
 #if QT_CONFIG(raster_64bit)
     QTest::newRow("RGBx64") << QImage::Format_RGBX64;
 #endif
@@ -2093,6 +2100,64 @@ void tst_QImage::transformed2()
     }
 }
 
+void tst_QImage::largeTransformed_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<QTransform>("transform");
+    QTest::addColumn<Qt::TransformationMode>("mode");
+
+    const QImage::Format formats[] = {
+        QImage::Format_RGB32,
+        QImage::Format_ARGB32_Premultiplied,
+        QImage::Format_RGB888,
+        QImage::Format_Grayscale8,
+        QImage::Format_RGBA64,
+    };
+    for (QImage::Format format : formats) {
+        const char *name = formatToString(format).latin1();
+        for (int angle : { 90, 180, 270 }) {
+            QTest::addRow("%s, rotate %d", name, angle)
+                    << format << QTransform().rotate(angle) << Qt::FastTransformation;
+        }
+        QTest::addRow("%s, rotate 30 fast", name)
+                << format << QTransform().rotate(30) << Qt::FastTransformation;
+        QTest::addRow("%s, rotate 30 smooth", name)
+                << format << QTransform().rotate(30) << Qt::SmoothTransformation;
+        QTest::addRow("%s, shear smooth", name)
+                << format << QTransform().shear(0.2, 0.1) << Qt::SmoothTransformation;
+    }
+}
+
+void tst_QImage::largeTransformed()
+{
+    // Large transformations are split over the global thread pool, which
+    // must give the same result as doing them on a single thread.
+    QFETCH(QImage::Format, format);
+    QFETCH(QTransform, transform);
+    QFETCH(Qt::TransformationMode, mode);
+
+    QImage image(600, 400, QImage::Format_ARGB32);
+    QRandomGenerator rng(1234);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = rng.generate();
+    }
+    image = image.convertToFormat(format);
+
+    // Work started from a thread of the pool is never split further
+    QImage expected;
+    QThreadPool::globalInstance()->start([&]() {
+        expected = image.transformed(transform, mode);
+    });
+    QThreadPool::globalInstance()->waitForDone();
+
+    const QImage actual = image.transformed(transform, mode);
+    QVERIFY(!actual.isNull());
+    QCOMPARE(actual.format(), expected.format());
+    QCOMPARE(actual, expected);
+}
+
 void tst_QImage::scaled()
 {
     QImage img(102, 3, QImage::Format_Mono);
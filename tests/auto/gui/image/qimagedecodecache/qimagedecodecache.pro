@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qimagedecodecache
+QT += gui-private testlib
+SOURCES  += tst_qimagedecodecache.cpp
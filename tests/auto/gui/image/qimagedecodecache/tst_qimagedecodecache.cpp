@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include <QtTest/QtTest>
+
+#include <QImage>
+#include <QPixmap>
+#include <QPixmapCache>
+#include <QTemporaryDir>
+
+#include <private/qimagedecodecache_p.h>
+
+class tst_QImageDecodeCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void hitsAndMisses();
+    void changedFile();
+    void eviction();
+    void missingFile();
+    void imageAsync();
+    void pixmapLoad();
+
+private:
+    QString writeImage(const QString &name, const QSize &size, QColor color);
+
+    QTemporaryDir m_temporaryDir;
+};
+
+void tst_QImageDecodeCache::initTestCase()
+{
+    QVERIFY2(m_temporaryDir.isValid(), qPrintable(m_temporaryDir.errorString()));
+}
+
+QString tst_QImageDecodeCache::writeImage(const QString &name, const QSize &size, QColor color)
+{
+    const QString fileName = m_temporaryDir.filePath(name);
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(color);
+    if (!image.save(fileName, "png"))
+        return QString();
+    return fileName;
+}
+
+void tst_QImageDecodeCache::hitsAndMisses()
+{
+    const QString fileName = writeImage(QStringLiteral("hits.png"), QSize(40, 30), Qt::red);
+    QVERIFY(!fileName.isEmpty());
+
+    QImageDecodeCache cache;
+    const QImage first = cache.image(fileName);
+    QCOMPARE(first.size(), QSize(40, 30));
+    QCOMPARE(first.pixel(0, 0), qRgb(255, 0, 0));
+    QCOMPARE(cache.statistics().misses, 1);
+    QCOMPARE(cache.statistics().hits, 0);
+
+    // The decoded data is shared, not decoded again
+    const QImage second = cache.image(fileName);
+    QCOMPARE(second.constBits(), first.constBits());
+    QCOMPARE(cache.statistics().misses, 1);
+    QCOMPARE(cache.statistics().hits, 1);
+    QCOMPARE(cache.statistics().count, 1);
+    QCOMPARE(cache.statistics().totalCost, first.sizeInBytes());
+
+    // The format is part of the key
+    const QImage third = cache.image(fileName, "png");
+    QCOMPARE(third, first);
+    QCOMPARE(cache.statistics().misses, 2);
+
+    cache.resetStatistics();
+    QCOMPARE(cache.statistics().hits, 0);
+    QCOMPARE(cache.statistics().misses, 0);
+    QCOMPARE(cache.statistics().count, 2);
+
+    cache.clear();
+    QCOMPARE(cache.statistics().count, 0);
+    QCOMPARE(cache.statistics().totalCost, 0);
+}
+
+void tst_QImageDecodeCache::changedFile()
+{
+    const QString fileName = writeImage(QStringLiteral("changed.png"), QSize(10, 10), Qt::red);
+    QVERIFY(!fileName.isEmpty());
+
+    QImageDecodeCache cache;
+    QCOMPARE(cache.image(fileName).size(), QSize(10, 10));
+    QVERIFY(!writeImage(QStringLiteral("changed.png"), QSize(20, 10), Qt::blue).isEmpty());
+    const QImage image = cache.image(fileName);
+    QCOMPARE(image.size(), QSize(20, 10));
+    QCOMPARE(image.pixel(0, 0), qRgb(0, 0, 255));
+    QCOMPARE(cache.statistics().misses, 2);
+}
+
+void tst_QImageDecodeCache::eviction()
+{
+    const QString a = writeImage(QStringLiteral("a.png"), QSize(64, 64), Qt::red);
+    const QString b = writeImage(QStringLiteral("b.png"), QSize(64, 64), Qt::green);
+    const QString c = writeImage(QStringLiteral("c.png"), QSize(64, 64), Qt::blue);
+    QVERIFY(!a.isEmpty() && !b.isEmpty() && !c.isEmpty());
+
+    // Room for two images
+    QImageDecodeCache cache;
+    cache.setMaxCost(2 * 64 * 64 * 4);
+    QCOMPARE(cache.maxCost(), 2 * 64 * 64 * 4);
+    cache.image(a);
+    cache.image(b);
+    cache.image(a);
+    cache.image(c); // evicts b, the least recently used
+    QCOMPARE(cache.statistics().count, 2);
+    QCOMPARE(cache.statistics().hits, 1);
+    QCOMPARE(cache.statistics().misses, 3);
+
+    cache.image(a);
+    QCOMPARE(cache.statistics().hits, 2);
+    cache.image(b);
+    QCOMPARE(cache.statistics().misses, 4);
+
+    // Shrinking the budget evicts right away
+    cache.setMaxCost(64 * 64 * 4);
+    QCOMPARE(cache.statistics().count, 1);
+    QVERIFY(cache.statistics().totalCost <= cache.statistics().maxCost);
+}
+
+void tst_QImageDecodeCache::missingFile()
+{
+    QImageDecodeCache cache;
+    QVERIFY(cache.image(m_temporaryDir.filePath(QStringLiteral("missing.png"))).isNull());
+    QCOMPARE(cache.statistics().count, 0);
+}
+
+void tst_QImageDecodeCache::imageAsync()
+{
+#if !QT_CONFIG(future)
+    QSKIP("This test requires QFuture");
+#else
+    const QString fileName = writeImage(QStringLiteral("async.png"), QSize(300, 200), Qt::yellow);
+    QVERIFY(!fileName.isEmpty());
+
+    QImageDecodeCache cache;
+    QFuture<QImage> first = cache.imageAsync(fileName);
+    QFuture<QImage> second = cache.imageAsync(fileName);
+    const QImage image = first.result();
+    QCOMPARE(image.size(), QSize(300, 200));
+    QCOMPARE(second.result(), image);
+    QCOMPARE(cache.statistics().misses, 1);
+    QCOMPARE(cache.statistics().hits, 1);
+
+    // Served from the cache once decoded
+    QFuture<QImage> third = cache.imageAsync(fileName);
+    QVERIFY(third.isFinished());
+    QCOMPARE(third.result().constBits(), image.constBits());
+    QCOMPARE(cache.image(fileName).constBits(), image.constBits());
+    QCOMPARE(cache.statistics().hits, 3);
+
+    QFuture<QImage> missing = cache.imageAsync(m_temporaryDir.filePath(QStringLiteral("missing.png")));
+    QVERIFY(missing.result().isNull());
+#endif
+}
+
+void tst_QImageDecodeCache::pixmapLoad()
+{
+    const QString fileName = writeImage(QStringLiteral("pixmap.png"), QSize(32, 32), Qt::green);
+    QVERIFY(!fileName.isEmpty());
+
+    QImageDecodeCache *cache = QImageDecodeCache::instance();
+    QVERIFY(cache);
+    cache->clear();
+    cache->resetStatistics();
+
+    QPixmap first;
+    QVERIFY(first.load(fileName));
+    QCOMPARE(cache->statistics().misses, 1);
+
+    // Reloaded from the decoded image, not from the file
+    QPixmapCache::clear();
+    QPixmap second;
+    QVERIFY(second.load(fileName));
+    QCOMPARE(cache->statistics().misses, 1);
+    QCOMPARE(cache->statistics().hits, 1);
+    QCOMPARE(second.toImage(), first.toImage());
+}
+
+QTEST_MAIN(tst_QImageDecodeCache)
+#include "tst_qimagedecodecache.moc"
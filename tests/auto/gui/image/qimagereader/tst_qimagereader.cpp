@@ -177,6 +177,10 @@ private slots:
 
     void xbmBufferHandling();
 
+    void progressiveDecoding_data();
+    void progressiveDecoding();
+    void progressiveDecodingErrors();
+
 private:
     QString prefix;
     QTemporaryDir m_temporaryDir;
@@ -2093,5 +2097,117 @@ void tst_QImageReader::xbmBufferHandling()
     QImage::fromData(buffer, "xbm");
 }
 
+void tst_QImageReader::progressiveDecoding_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QByteArray>("format");
+    QTest::addColumn<int>("chunkSize");
+
+    const struct {
+        const char *fileName;
+        const char *format;
+    } images[] = {
+        { "kollada.png", "png" },
+        { "kollada-16bpc.png", "png" },
+        { "basn0g16.png", "png" },
+        { "tbwn0g16.png", "png" },
+        { "YCbCr_cmyk.png", "png" },
+        { "txts.png", "png" }, // interlaced, with texts
+        { "trolltech.gif", "gif" },
+        { "trans.gif", "gif" },
+        { "four-frames.gif", "gif" }, // animated
+        { "noclearcode.gif", "gif" },
+    };
+    for (const auto &image : images) {
+        for (int chunkSize : { 1, 7, 100, 0 }) {
+            QTest::addRow("%s, %d", image.fileName, chunkSize)
+                    << QString::fromLatin1(image.fileName) << QByteArray(image.format) << chunkSize;
+        }
+    }
+}
+
+void tst_QImageReader::progressiveDecoding()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QByteArray, format);
+    QFETCH(int, chunkSize);
+
+    SKIP_IF_UNSUPPORTED(format);
+
+    QFile file(prefix + fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray data = file.readAll();
+    const QImage expected = QImageReader(prefix + fileName).read();
+    QVERIFY(!expected.isNull());
+
+    QImageReader reader;
+    if (chunkSize == 0)
+        chunkSize = data.size();
+    // Decoding may finish before the end of the data, with the first frame
+    for (int i = 0; i < data.size() && !reader.isProgressiveDecodingFinished(); i += chunkSize) {
+        QVERIFY2(reader.decodeProgressively(data.mid(i, chunkSize)),
+                 qPrintable(reader.errorString()));
+        const QImage image = reader.progressiveImage();
+        const QRect updateRect = reader.progressiveUpdateRect();
+        QVERIFY(updateRect.isEmpty() || image.rect().contains(updateRect));
+        if (!image.isNull())
+            QCOMPARE(image.size(), expected.size());
+    }
+    QVERIFY(reader.isProgressiveDecodingFinished());
+    QCOMPARE(reader.format(), format);
+
+    const QImage image = reader.progressiveImage();
+    QCOMPARE(image.format(), expected.format());
+    QCOMPARE(image, expected);
+    QCOMPARE(image.textKeys(), expected.textKeys());
+    QCOMPARE(image.colorSpace(), expected.colorSpace());
+}
+
+void tst_QImageReader::progressiveDecodingErrors()
+{
+    QFile file(prefix + "kollada.png");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray data = file.readAll();
+
+    {
+        // Not while reading from a device
+        QBuffer buffer;
+        QImageReader reader(&buffer);
+        QVERIFY(!reader.decodeProgressively(data));
+        QCOMPARE(reader.error(), QImageReader::DeviceError);
+    }
+    {
+        // The format is only known once enough data has been received
+        QImageReader reader;
+        QVERIFY(reader.decodeProgressively(data.left(4)));
+        QVERIFY(reader.progressiveImage().isNull());
+        QVERIFY(reader.decodeProgressively(data.mid(4)));
+        QVERIFY(reader.isProgressiveDecodingFinished());
+        QCOMPARE(reader.progressiveImage().size(), QSize(436, 160));
+    }
+    {
+        QImageReader reader;
+        QVERIFY(!reader.decodeProgressively(QByteArray(64, 'x')));
+        QCOMPARE(reader.error(), QImageReader::UnsupportedFormatError);
+    }
+    {
+        QImageReader reader;
+        QByteArray corrupt = data;
+        corrupt.replace(200, 300, QByteArray(300, '\0'));
+        QVERIFY(!reader.decodeProgressively(corrupt));
+        QCOMPARE(reader.error(), QImageReader::InvalidDataError);
+    }
+    {
+        // Starting over after setting a null device
+        QImageReader reader;
+        QVERIFY(reader.decodeProgressively(data.left(1000)));
+        QVERIFY(!reader.isProgressiveDecodingFinished());
+        reader.setDevice(nullptr);
+        QVERIFY(reader.progressiveImage().isNull());
+        QVERIFY(reader.decodeProgressively(data));
+        QVERIFY(reader.isProgressiveDecodingFinished());
+    }
+}
+
 QTEST_MAIN(tst_QImageReader)
 #include "tst_qimagereader.moc"
@@ -30,6 +30,7 @@
 #include <QtTest/QtTest>
 
 
+#include <QBuffer>
 #include <QDebug>
 #include <QFile>
 #include <QImage>
@@ -80,6 +81,9 @@ private slots:
 
     void writeEmpty();
 
+    void parallelWrite_data();
+    void parallelWrite();
+
 private:
     QTemporaryDir m_temporaryDir;
     QString prefix;
@@ -146,6 +150,18 @@ void tst_QImageWriter::getSetCheck()
     QCOMPARE(INT_MIN, obj1.compression());
     obj1.setCompression(INT_MAX);
     QCOMPARE(INT_MAX, obj1.compression());
+
+    // bool QImageWriter::parallelWrite()
+    // void QImageWriter::setParallelWrite(bool)
+    QCOMPARE(false, obj1.parallelWrite());
+    obj1.setParallelWrite(true);
+    QCOMPARE(true, obj1.parallelWrite());
+
+    // bool QImageWriter::fastWrite()
+    // void QImageWriter::setFastWrite(bool)
+    QCOMPARE(false, obj1.fastWrite());
+    obj1.setFastWrite(true);
+    QCOMPARE(true, obj1.fastWrite());
 }
 
 void tst_QImageWriter::writeImage_data()
@@ -402,6 +418,8 @@ void tst_QImageWriter::supportsOption_data()
                               << QImageIOHandler::Description
                               << QImageIOHandler::Quality
                               << QImageIOHandler::CompressionRatio
+                              << QImageIOHandler::ParallelWrite
+                              << QImageIOHandler::FastWrite
                               << QImageIOHandler::Size
                               << QImageIOHandler::ScaledSize);
 }
@@ -428,6 +446,8 @@ void tst_QImageWriter::supportsOption()
         QImageIOHandler::Endianness,
         QImageIOHandler::Animation,
         QImageIOHandler::BackgroundColor,
+        QImageIOHandler::ParallelWrite,
+        QImageIOHandler::FastWrite,
     };
 
     QImageWriter writer(writePrefix + fileName);
@@ -539,5 +559,62 @@ void tst_QImageWriter::writeEmpty()
     QVERIFY(!QFileInfo(fileName).exists());
 }
 
+void tst_QImageWriter::parallelWrite_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<bool>("fast");
+
+    const QImage::Format formats[] = {
+        QImage::Format_RGB32, QImage::Format_ARGB32, QImage::Format_ARGB32_Premultiplied,
+        QImage::Format_RGB888, QImage::Format_RGBA8888, QImage::Format_Grayscale8,
+        QImage::Format_Grayscale16, QImage::Format_RGBX64, QImage::Format_RGBA64,
+        QImage::Format_RGBA64_Premultiplied, QImage::Format_Indexed8
+    };
+    for (QImage::Format format : formats) {
+        for (bool fast : { false, true }) {
+            QTest::addRow("%s%s", QMetaEnum::fromType<QImage::Format>().valueToKey(format),
+                          fast ? ", fast" : "") << format << fast;
+        }
+    }
+}
+
+void tst_QImageWriter::parallelWrite()
+{
+    SKIP_IF_UNSUPPORTED("png");
+
+    QFETCH(QImage::Format, format);
+    QFETCH(bool, fast);
+
+    // Large enough to be split in several chunks, with an odd width
+    QImage image(997, 1213, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = qRgba(x * 255 / image.width(), y * 255 / image.height(), (x ^ y) & 0xff, (x + y) & 0xff);
+    }
+    image = image.convertToFormat(format);
+    image.setText(QStringLiteral("Title"), QStringLiteral("Parallel"));
+
+    QByteArray serialData;
+    QBuffer serialBuffer(&serialData);
+    QImageWriter serialWriter(&serialBuffer, "png");
+    serialWriter.setFastWrite(fast);
+    QVERIFY(serialWriter.write(image));
+
+    QByteArray parallelData;
+    QBuffer parallelBuffer(&parallelData);
+    QImageWriter parallelWriter(&parallelBuffer, "png");
+    parallelWriter.setParallelWrite(true);
+    parallelWriter.setFastWrite(fast);
+    QVERIFY(parallelWriter.write(image));
+
+    const QImage expected = QImage::fromData(serialData, "png");
+    const QImage result = QImage::fromData(parallelData, "png");
+    QVERIFY(!result.isNull());
+    QCOMPARE(result.format(), expected.format());
+    QCOMPARE(result, expected);
+    QCOMPARE(result.text(QStringLiteral("Title")), QStringLiteral("Parallel"));
+}
+
 QTEST_MAIN(tst_QImageWriter)
 #include "tst_qimagewriter.moc"
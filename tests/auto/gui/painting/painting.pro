@@ -9,6 +9,7 @@ SUBDIRS=\
    qpagelayout \
    qpagesize \
    qpainter \
+   qparallelimagerenderer \
    qpathclipper \
    qpdfwriter \
    qpen \
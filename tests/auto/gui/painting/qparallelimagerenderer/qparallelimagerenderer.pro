@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qparallelimagerenderer
+SOURCES  += tst_qparallelimagerenderer.cpp
+QT += testlib
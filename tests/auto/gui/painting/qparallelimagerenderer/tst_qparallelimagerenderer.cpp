@@ -0,0 +1,222 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QParallelImageRenderer>
+#include <QPicture>
+#include <QThreadPool>
+
+class tst_QParallelImageRenderer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaults();
+    void nullArguments();
+    void sameAsSerial_data();
+    void sameAsSerial();
+    void pictureClipCannotEscapeBand();
+    void smallImage();
+    void fromThreadPool();
+};
+
+static QImage renderSerially(QImage image, const QPicture &picture)
+{
+    QPainter painter(&image);
+    QPicture(picture).play(&painter);
+    painter.end();
+    return image;
+}
+
+void tst_QParallelImageRenderer::defaults()
+{
+    QParallelImageRenderer renderer;
+    QCOMPARE(renderer.bandCount(), 0);
+    QCOMPARE(renderer.threadPool(), nullptr);
+
+    renderer.setBandCount(4);
+    QCOMPARE(renderer.bandCount(), 4);
+    renderer.setBandCount(-1);
+    QCOMPARE(renderer.bandCount(), 0);
+
+    QThreadPool pool;
+    renderer.setThreadPool(&pool);
+    QCOMPARE(renderer.threadPool(), &pool);
+}
+
+void tst_QParallelImageRenderer::nullArguments()
+{
+    QParallelImageRenderer renderer;
+    QPicture picture;
+    QImage image;
+    QVERIFY(!renderer.render(nullptr, picture));
+    QVERIFY(!renderer.render(&image, picture));
+
+    image = QImage(256, 256, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    QVERIFY(renderer.render(&image, picture));
+    QCOMPARE(image.pixel(100, 100), QColor(Qt::red).rgb());
+}
+
+void tst_QParallelImageRenderer::sameAsSerial_data()
+{
+    QTest::addColumn<QImage::Format>("format");
+    QTest::addColumn<int>("bands");
+    QTest::addColumn<bool>("antialiasing");
+    QTest::addColumn<QTransform>("transform");
+
+    const QTransform rotation = QTransform().rotate(17).scale(1.3, 0.9);
+    QTest::newRow("ARGB32_Premultiplied") << QImage::Format_ARGB32_Premultiplied << 4 << false << QTransform();
+    QTest::newRow("ARGB32_Premultiplied, antialiased") << QImage::Format_ARGB32_Premultiplied << 4 << true << QTransform();
+    QTest::newRow("ARGB32_Premultiplied, transformed") << QImage::Format_ARGB32_Premultiplied << 3 << true << rotation;
+    QTest::newRow("RGB32, automatic bands") << QImage::Format_RGB32 << 0 << true << QTransform();
+    QTest::newRow("RGB16") << QImage::Format_RGB16 << 5 << true << rotation;
+    QTest::newRow("RGBA64") << QImage::Format_RGBA64 << 2 << true << QTransform();
+    QTest::newRow("Grayscale8") << QImage::Format_Grayscale8 << 7 << false << rotation;
+}
+
+void tst_QParallelImageRenderer::sameAsSerial()
+{
+    QFETCH(QImage::Format, format);
+    QFETCH(int, bands);
+    QFETCH(bool, antialiasing);
+    QFETCH(QTransform, transform);
+
+    QImage source(64, 64, QImage::Format_ARGB32);
+    source.fill(Qt::transparent);
+    QPainter(&source).fillRect(8, 8, 48, 48, QColor(0, 0, 255, 128));
+
+    QPicture picture;
+    QPainter p(&picture);
+    p.setRenderHint(QPainter::Antialiasing, antialiasing);
+    p.setRenderHint(QPainter::SmoothPixmapTransform);
+    p.setTransform(transform);
+    p.fillRect(10, 10, 500, 500, QBrush(Qt::green, Qt::Dense4Pattern));
+    QLinearGradient gradient(0, 0, 600, 600);
+    gradient.setColorAt(0, Qt::yellow);
+    gradient.setColorAt(1, QColor(0, 0, 0, 100));
+    p.setBrush(gradient);
+    p.setPen(QPen(Qt::red, 3));
+    p.drawEllipse(QPointF(300, 300), 220.5, 180.25);
+    p.setPen(QPen(Qt::black, 0));
+    for (int i = 0; i < 60; ++i)
+        p.drawLine(QPointF(i * 9.5, 0), QPointF(600 - i * 7.25, 600));
+    QPainterPath path;
+    path.moveTo(20, 580);
+    path.cubicTo(200, 100, 400, 900, 580, 20);
+    p.strokePath(path, QPen(Qt::magenta, 11, Qt::DashLine, Qt::RoundCap));
+    p.setCompositionMode(QPainter::CompositionMode_Multiply);
+    p.drawImage(QRectF(150, 90, 300, 260), source);
+    p.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    p.setClipRect(100, 100, 300, 300);
+    p.drawImage(QPointF(90, 250), source);
+    p.end();
+
+    QImage image(600, 600, format);
+    image.fill(Qt::white);
+    const QImage expected = renderSerially(image, picture);
+
+    QParallelImageRenderer renderer;
+    renderer.setBandCount(bands);
+    QVERIFY(renderer.render(&image, picture));
+    QCOMPARE(image, expected);
+}
+
+void tst_QParallelImageRenderer::pictureClipCannotEscapeBand()
+{
+    // Clip operations recorded in the picture must not let a band paint
+    // outside of its rows, or the bands would race on the shared pixels.
+    QPicture picture;
+    QPainter p(&picture);
+    p.setClipRect(0, 0, 10, 10);
+    p.setClipRect(0, 0, 400, 400, Qt::ReplaceClip);
+    p.setClipping(false);
+    p.setCompositionMode(QPainter::CompositionMode_Plus);
+    p.fillRect(0, 0, 400, 400, QColor(1, 1, 1));
+    p.end();
+
+    QImage image(400, 400, QImage::Format_RGB32);
+    image.fill(Qt::black);
+    QParallelImageRenderer renderer;
+    renderer.setBandCount(4);
+    QVERIFY(renderer.render(&image, picture));
+    // every pixel is added to exactly once
+    QImage expected(image.size(), QImage::Format_RGB32);
+    expected.fill(qRgb(1, 1, 1));
+    QCOMPARE(image, expected);
+}
+
+void tst_QParallelImageRenderer::smallImage()
+{
+    QPicture picture;
+    QPainter p(&picture);
+    p.fillRect(0, 0, 10, 10, Qt::blue);
+    p.end();
+
+    QImage image(16, 16, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    const QImage expected = renderSerially(image, picture);
+
+    QParallelImageRenderer renderer;
+    renderer.setBandCount(8);
+    QVERIFY(renderer.render(&image, picture));
+    QCOMPARE(image, expected);
+}
+
+void tst_QParallelImageRenderer::fromThreadPool()
+{
+    QPicture picture;
+    QPainter p(&picture);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setBrush(Qt::darkCyan);
+    p.drawEllipse(10, 10, 480, 480);
+    p.end();
+
+    QImage image(500, 500, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    const QImage expected = renderSerially(image, picture);
+
+    // rendering from a thread of the pool itself must not wait for the pool
+    QThreadPool pool;
+    pool.setMaxThreadCount(1);
+    QParallelImageRenderer renderer;
+    renderer.setThreadPool(&pool);
+    renderer.setBandCount(4);
+    bool rendered = false;
+    pool.start([&]() { rendered = renderer.render(&image, picture); });
+    QVERIFY(pool.waitForDone(30000));
+    QVERIFY(rendered);
+    QCOMPARE(image, expected);
+}
+
+QTEST_MAIN(tst_QParallelImageRenderer)
+#include "tst_qparallelimagerenderer.moc"
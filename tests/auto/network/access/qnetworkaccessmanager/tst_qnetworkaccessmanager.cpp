@@ -30,9 +30,78 @@
 
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QHttpConnectionPoolConfiguration>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
 
 #include <QtCore/QDebug>
 
+// Answers each request with a response that echoes the request body, but
+// holds the responses back until holdUntil requests are pending, so that
+// these have to be in flight at the same time.
+class PoolTestServer : public QTcpServer
+{
+    Q_OBJECT
+public:
+    int holdUntil = 1;
+    int connectionCount = 0;
+    int openConnections = 0;
+    int maximumOpenConnections = 0;
+
+    QUrl url(int index) const
+    {
+        return QUrl(QStringLiteral("http://127.0.0.1:%1/%2").arg(serverPort()).arg(index));
+    }
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        QTcpSocket *socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(socketDescriptor);
+        ++connectionCount;
+        maximumOpenConnections = qMax(maximumOpenConnections, ++openConnections);
+
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            QByteArray &buffer = buffers[socket];
+            buffer += socket->readAll();
+            int end;
+            while ((end = buffer.indexOf("\r\n\r\n")) != -1) {
+                const QByteArray header = buffer.left(end).toLower();
+                const int field = header.indexOf("\r\ncontent-length:");
+                const int length = field == -1
+                        ? 0 : header.mid(field + 17, header.indexOf('\r', field + 2) - field - 17).trimmed().toInt();
+                if (buffer.size() < end + 4 + length)
+                    break;
+                pending.append({ socket, buffer.mid(end + 4, length) });
+                buffer.remove(0, end + 4 + length);
+            }
+            if (pending.size() < holdUntil)
+                return;
+            for (const Response &response : qExchange(pending, {})) {
+                if (response.socket) {
+                    response.socket->write("HTTP/1.1 200 OK\r\nContent-Length: "
+                                           + QByteArray::number(response.body.size())
+                                           + "\r\n\r\n" + response.body);
+                }
+            }
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            --openConnections;
+            buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+
+private:
+    struct Response
+    {
+        QPointer<QTcpSocket> socket;
+        QByteArray body;
+    };
+    QHash<QTcpSocket *, QByteArray> buffers;
+    QList<Response> pending;
+};
+
 class tst_QNetworkAccessManager : public QObject
 {
     Q_OBJECT
@@ -42,6 +111,18 @@ public:
 
 private slots:
     void alwaysCacheRequest();
+    void connectionPoolConfiguration();
+    void connectionsPerHost();
+    void connectionReuse();
+    void idleTimeout();
+    void maximumConnections();
+    void preConnect();
+    void downloadSink();
+    void uploadFromMappedFile();
+
+private:
+    static QList<QNetworkReply *> getAll(QNetworkAccessManager &manager,
+                                         const PoolTestServer &server, int count);
 };
 
 tst_QNetworkAccessManager::tst_QNetworkAccessManager()
@@ -59,5 +140,252 @@ void tst_QNetworkAccessManager::alwaysCacheRequest()
     delete reply;
 }
 
+QList<QNetworkReply *> tst_QNetworkAccessManager::getAll(QNetworkAccessManager &manager,
+                                                       const PoolTestServer &server, int count)
+{
+    QList<QNetworkReply *> replies;
+    for (int i = 0; i < count; ++i) {
+        QNetworkRequest request(server.url(i));
+        request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+        replies.append(manager.get(request));
+    }
+    return replies;
+}
+
+void tst_QNetworkAccessManager::connectionPoolConfiguration()
+{
+    QHttpConnectionPoolConfiguration configuration;
+    QCOMPARE(configuration.maximumConnectionsPerHost(), 6);
+    QCOMPARE(configuration.maximumConnections(), 0);
+    QCOMPARE(configuration.idleTimeout(), 120 * 1000);
+    QCOMPARE(configuration.preConnectCount(), 1);
+
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: invalid number of connections per host");
+    QVERIFY(!configuration.setMaximumConnectionsPerHost(0));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: invalid maximum number of connections");
+    QVERIFY(!configuration.setMaximumConnections(-1));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: invalid idle timeout");
+    QVERIFY(!configuration.setIdleTimeout(-1));
+    QTest::ignoreMessage(QtWarningMsg, "QHttpConnectionPoolConfiguration: invalid pre-connect count");
+    QVERIFY(!configuration.setPreConnectCount(0));
+    QCOMPARE(configuration, QHttpConnectionPoolConfiguration());
+
+    QVERIFY(configuration.setMaximumConnectionsPerHost(32));
+    QVERIFY(configuration.setMaximumConnections(100));
+    QVERIFY(configuration.setIdleTimeout(0));
+    QVERIFY(configuration.setPreConnectCount(4));
+    QVERIFY(configuration != QHttpConnectionPoolConfiguration());
+
+    QNetworkAccessManager manager;
+    QCOMPARE(manager.connectionPoolConfiguration(), QHttpConnectionPoolConfiguration());
+    manager.setConnectionPoolConfiguration(configuration);
+    QCOMPARE(manager.connectionPoolConfiguration(), configuration);
+
+    const QHttpConnectionPoolStatistics statistics = manager.connectionPoolStatistics();
+    QCOMPARE(statistics.openConnections(), 0);
+    QCOMPARE(statistics.connectionsOpened(), 0);
+    QCOMPARE(statistics.requestsSent(), 0);
+    QCOMPARE(statistics.requestsOnReusedConnections(), 0);
+}
+
+void tst_QNetworkAccessManager::connectionsPerHost()
+{
+    const int count = 10;
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    // the server only answers once all requests are in flight
+    server.holdUntil = count;
+
+    QNetworkAccessManager manager;
+    QHttpConnectionPoolConfiguration configuration;
+    QVERIFY(configuration.setMaximumConnectionsPerHost(count));
+    manager.setConnectionPoolConfiguration(configuration);
+
+    const QList<QNetworkReply *> replies = getAll(manager, server, count);
+    for (QNetworkReply *reply : replies) {
+        QTRY_VERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+    }
+    qDeleteAll(replies);
+
+    QCOMPARE(server.connectionCount, count);
+    const QHttpConnectionPoolStatistics statistics = manager.connectionPoolStatistics();
+    QCOMPARE(statistics.connectionsOpened(), count);
+    QCOMPARE(statistics.openConnections(), count);
+    QCOMPARE(statistics.requestsSent(), count);
+    QCOMPARE(statistics.requestsOnReusedConnections(), 0);
+}
+
+void tst_QNetworkAccessManager::connectionReuse()
+{
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    for (int i = 0; i < 3; ++i) {
+        QScopedPointer<QNetworkReply> reply(getAll(manager, server, 1).first());
+        QTRY_VERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+    }
+
+    QCOMPARE(server.connectionCount, 1);
+    const QHttpConnectionPoolStatistics statistics = manager.connectionPoolStatistics();
+    QCOMPARE(statistics.connectionsOpened(), 1);
+    QCOMPARE(statistics.requestsSent(), 3);
+    QCOMPARE(statistics.requestsOnReusedConnections(), 2);
+}
+
+void tst_QNetworkAccessManager::idleTimeout()
+{
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    QHttpConnectionPoolConfiguration configuration;
+    QVERIFY(configuration.setIdleTimeout(0));
+    manager.setConnectionPoolConfiguration(configuration);
+
+    QScopedPointer<QNetworkReply> reply(getAll(manager, server, 1).first());
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+
+    QTRY_COMPARE(manager.connectionPoolStatistics().openConnections(), 0);
+    QTRY_COMPARE(server.openConnections, 0);
+    QCOMPARE(manager.connectionPoolStatistics().connectionsOpened(), 1);
+}
+
+void tst_QNetworkAccessManager::maximumConnections()
+{
+    const int limit = 2;
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    QHttpConnectionPoolConfiguration configuration;
+    QVERIFY(configuration.setMaximumConnections(limit));
+    manager.setConnectionPoolConfiguration(configuration);
+
+    const QList<QNetworkReply *> replies = getAll(manager, server, 6);
+    for (QNetworkReply *reply : replies) {
+        QTRY_VERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+    }
+    qDeleteAll(replies);
+
+    QVERIFY(server.maximumOpenConnections <= limit);
+    const QHttpConnectionPoolStatistics statistics = manager.connectionPoolStatistics();
+    QVERIFY(statistics.connectionsOpened() <= limit);
+    QCOMPARE(statistics.requestsSent(), 6);
+}
+
+void tst_QNetworkAccessManager::preConnect()
+{
+    const int count = 4;
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QNetworkAccessManager manager;
+    QHttpConnectionPoolConfiguration configuration;
+    QVERIFY(configuration.setPreConnectCount(count));
+    manager.setConnectionPoolConfiguration(configuration);
+
+    manager.connectToHost(QLatin1String("127.0.0.1"), server.serverPort());
+    QTRY_COMPARE(server.connectionCount, count);
+    QTRY_COMPARE(manager.connectionPoolStatistics().openConnections(), count);
+    QCOMPARE(manager.connectionPoolStatistics().requestsSent(), 0);
+
+    // the pre-connected connections are picked up by HTTP/1.1 requests
+    server.holdUntil = count;
+    const QList<QNetworkReply *> replies = getAll(manager, server, count);
+    for (QNetworkReply *reply : replies) {
+        QTRY_VERIFY(reply->isFinished());
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+    }
+    qDeleteAll(replies);
+    QCOMPARE(server.connectionCount, count);
+}
+
+static QByteArray testPayload(int size)
+{
+    QByteArray payload(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        payload[i] = char('a' + (i * 7) % 26);
+    return payload;
+}
+
+void tst_QNetworkAccessManager::downloadSink()
+{
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    // large enough not to be downloaded into the zerocopy buffer
+    const QByteArray payload = testPayload(1024 * 1024);
+    QBuffer sink;
+    QVERIFY(sink.open(QIODevice::WriteOnly));
+
+    QNetworkAccessManager manager;
+    QNetworkRequest request(server.url(0));
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QByteArray("text/plain"));
+    QScopedPointer<QNetworkReply> reply(manager.post(request, payload));
+    reply->setDownloadSink(&sink);
+    QCOMPARE(reply->downloadSink(), &sink);
+    QSignalSpy readyReadSpy(reply.data(), &QIODevice::readyRead);
+
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(readyReadSpy.count(), 0);
+    QCOMPARE(reply->bytesAvailable(), 0);
+    QCOMPARE(sink.data(), payload);
+
+    // small replies that use the zerocopy buffer are handed over as well
+    sink.buffer().clear();
+    sink.seek(0);
+    reply.reset(manager.post(request, payload.left(100)));
+    reply->setDownloadSink(&sink);
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->bytesAvailable(), 0);
+    QCOMPARE(sink.data(), payload.left(100));
+
+    // without a sink, data is buffered as usual
+    reply.reset(manager.post(request, payload.left(100)));
+    reply->setDownloadSink(&sink);
+    reply->setDownloadSink(nullptr);
+    QCOMPARE(reply->downloadSink(), nullptr);
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->readAll(), payload.left(100));
+}
+
+void tst_QNetworkAccessManager::uploadFromMappedFile()
+{
+    PoolTestServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    const QByteArray payload = testPayload(3 * 1024 * 1024 + 17);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(payload), payload.size());
+    // only the data after the current position is uploaded
+    QVERIFY(file.seek(17));
+
+    QNetworkAccessManager manager;
+    QNetworkRequest request(server.url(0));
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+    QScopedPointer<QNetworkReply> reply(manager.put(request, &file));
+    QSignalSpy uploadProgressSpy(reply.data(), &QNetworkReply::uploadProgress);
+
+    QTRY_VERIFY(reply->isFinished());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->readAll(), payload.mid(17));
+    const auto complete = [&](const QList<QVariant> &progress) {
+        return progress.at(0).toLongLong() == payload.size() - 17
+                && progress.at(1).toLongLong() == payload.size() - 17;
+    };
+    QVERIFY(std::any_of(uploadProgressSpy.cbegin(), uploadProgressSpy.cend(), complete));
+    // the data was sent from the mapping, not read through the file
+    QCOMPARE(file.pos(), 17);
+}
+
 QTEST_MAIN(tst_QNetworkAccessManager)
 #include "tst_qnetworkaccessmanager.moc"
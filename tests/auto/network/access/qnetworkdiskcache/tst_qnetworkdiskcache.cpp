@@ -69,6 +69,7 @@ private slots:
     void updateMetaData();
     void fileMetaData();
     void expire();
+    void persistentIndex();
 
     void oldCacheVersionFile_data();
     void oldCacheVersionFile();
@@ -256,13 +257,17 @@ void tst_QNetworkDiskCache::cacheSize()
     QCOMPARE(cache.cacheSize(), qint64(0));
 }
 
+// Lists everything in the cache directory but the cache's own index file
 static QStringList countFiles(const QString dir)
 {
     QStringList list;
     QDir::Filters filter(QDir::AllEntries | QDir::NoDotAndDotDot);
     QDirIterator it(dir, filter, QDirIterator::Subdirectories);
-    while (it.hasNext())
-        list.append(it.next());
+    while (it.hasNext()) {
+        const QString fileName = it.next();
+        if (!fileName.endsWith(QLatin1String("/index")))
+            list.append(fileName);
+    }
     return list;
 }
 
@@ -534,6 +539,44 @@ void tst_QNetworkDiskCache::expire()
     }
 }
 
+void tst_QNetworkDiskCache::persistentIndex()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QUrl urls[] = { QUrl("http://localhost:4/0"), QUrl("http://localhost:4/1"),
+                          QUrl("http://localhost:4/2") };
+    {
+        QNetworkDiskCache cache;
+        cache.setCacheDirectory(dir.path());
+        for (const QUrl &url : urls) {
+            QNetworkCacheMetaData m;
+            m.setUrl(url);
+            QIODevice *d = cache.prepare(m);
+            QVERIFY(d);
+            d->write(QByteArray(1000, 'Z'));
+            cache.insert(d);
+        }
+        // Reading the first item makes the second one the least recently used
+        QScopedPointer<QIODevice> d(cache.data(urls[0]));
+        QVERIFY(d);
+    }
+
+    // The order is preserved by the index written when the first cache was destroyed
+    SubQNetworkDiskCache cache;
+    cache.setCacheDirectory(dir.path());
+    const qint64 size = cache.cacheSize();
+    QVERIFY(size > 3000);
+    cache.setMaximumCacheSize(size - 1);
+    QVERIFY(cache.cacheSize() < size);
+
+    QScopedPointer<QIODevice> d(cache.data(urls[0]));
+    QVERIFY(d);
+    d.reset(cache.data(urls[1]));
+    QVERIFY(!d);
+    d.reset(cache.data(urls[2]));
+    QVERIFY(d);
+}
+
 void tst_QNetworkDiskCache::oldCacheVersionFile_data()
 {
     QTest::addColumn<int>("pass");
@@ -90,6 +90,7 @@ private slots:
     void waitForConnectionTest();
     void setSocketDescriptor();
     void listenWhileListening();
+    void portSharing();
     void addressReusable();
     void setNewSocketDescriptorBlocking();
 #ifndef QT_NO_NETWORKPROXY
@@ -564,6 +565,57 @@ void tst_QTcpServer::listenWhileListening()
     QVERIFY(!server.listen());
 }
 
+//----------------------------------------------------------------------------------
+void tst_QTcpServer::portSharing()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        QSKIP("Port sharing only applies to native sockets");
+
+    QTcpServer first;
+    QVERIFY(!first.isPortSharingEnabled());
+    QVERIFY(first.listen(QHostAddress::LocalHost));
+
+    // without port sharing, the port is taken
+    QTcpServer second;
+    second.setPortSharingEnabled(true);
+    QVERIFY(!second.listen(QHostAddress::LocalHost, first.serverPort()));
+    first.close();
+
+    first.setPortSharingEnabled(true);
+    QVERIFY(first.isPortSharingEnabled());
+#ifdef Q_OS_WIN
+    QVERIFY(!first.listen(QHostAddress::LocalHost));
+    QCOMPARE(first.serverError(), QAbstractSocket::UnsupportedSocketOperationError);
+#else
+    QVERIFY2(first.listen(QHostAddress::LocalHost), qPrintable(first.errorString()));
+    QVERIFY2(second.listen(QHostAddress::LocalHost, first.serverPort()),
+             qPrintable(second.errorString()));
+
+    // every connection is accepted by exactly one of the servers
+    int accepted = 0;
+    for (QTcpServer *server : {&first, &second}) {
+        connect(server, &QTcpServer::newConnection, server, [server, &accepted] {
+            while (QTcpSocket *socket = server->nextPendingConnection()) {
+                delete socket;
+                ++accepted;
+            }
+        });
+    }
+
+    const int clientCount = 8;
+    QList<QTcpSocket *> clients;
+    for (int i = 0; i < clientCount; ++i) {
+        QTcpSocket *client = new QTcpSocket(this);
+        clients << client;
+        client->connectToHost(QHostAddress::LocalHost, first.serverPort());
+        QVERIFY(client->waitForConnected(5000));
+    }
+    QTRY_COMPARE(accepted, clientCount);
+    qDeleteAll(clients);
+#endif
+}
+
 //----------------------------------------------------------------------------------
 
 class SeverWithBlockingSockets : public QTcpServer
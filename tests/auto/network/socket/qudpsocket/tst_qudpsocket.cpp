@@ -90,6 +90,7 @@ private slots:
     void bindAndConnectToHost();
     void pendingDatagramSize();
     void writeDatagram();
+    void receiveAndWriteDatagrams();
     void performance();
     void bindMode();
     void writeDatagramToNonExistingPeer_data();
@@ -911,6 +912,55 @@ void tst_QUdpSocket::writeDatagram()
     }
 }
 
+void tst_QUdpSocket::receiveAndWriteDatagrams()
+{
+    QUdpSocket server;
+    QVERIFY2(server.bind(), server.errorString().toLatin1().constData());
+    QHostAddress serverAddress = makeNonAny(server.localAddress());
+
+    QUdpSocket client;
+    QSignalSpy bytesspy(&client, SIGNAL(bytesWritten(qint64)));
+
+    QList<QNetworkDatagram> datagrams;
+    qint64 totalSize = 0;
+    for (int i = 0; i < 100; ++i) {
+        QByteArray data = QByteArray::number(i).repeated(i + 1);
+        totalSize += data.size();
+        datagrams.append(QNetworkDatagram(data, serverAddress, server.localPort()));
+    }
+
+    QCOMPARE(client.writeDatagrams(QList<QNetworkDatagram>()), 0);
+    QCOMPARE(client.writeDatagrams(datagrams), datagrams.size());
+    QCOMPARE(bytesspy.count(), 1);
+    QCOMPARE(bytesspy.at(0).at(0).toLongLong(), totalSize);
+
+    QList<QNetworkDatagram> received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < datagrams.size() && timer.elapsed() < 5000) {
+        if (server.hasPendingDatagrams() || server.waitForReadyRead(100))
+            received += server.receiveDatagrams(datagrams.size() - received.size());
+    }
+    if (received.size() != datagrams.size())
+        QSKIP("UDP packets lost, unable to complete the test.");
+
+    for (int i = 0; i < received.size(); ++i) {
+        QVERIFY(received.at(i).isValid());
+        QCOMPARE(received.at(i).data(), datagrams.at(i).data());
+        QCOMPARE(received.at(i).senderPort(), int(client.localPort()));
+        QCOMPARE(received.at(i).destinationPort(), int(server.localPort()));
+    }
+    QVERIFY(server.receiveDatagrams(10).isEmpty());
+
+    // datagrams larger than maxSize are truncated
+    QCOMPARE(client.writeDatagrams({ QNetworkDatagram(QByteArray(100, 'a'), serverAddress,
+                                                      server.localPort()) }), 1);
+    QVERIFY(server.waitForReadyRead(5000));
+    received = server.receiveDatagrams(10, 10);
+    QCOMPARE(received.size(), 1);
+    QCOMPARE(received.at(0).data(), QByteArray(10, 'a'));
+}
+
 void tst_QUdpSocket::performance()
 {
     QByteArray arr(8192, '@');
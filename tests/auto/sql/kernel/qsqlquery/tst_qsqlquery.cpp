@@ -96,6 +96,8 @@ private slots:
     void forwardOnly();
     void forwardOnlyMultipleResultSet_data() { generic_data(); }
     void forwardOnlyMultipleResultSet();
+    void fetchBatch_data() { generic_data(); }
+    void fetchBatch();
     void psql_forwardOnlyQueryResultsLost_data() { generic_data("QPSQL"); }
     void psql_forwardOnlyQueryResultsLost();
 
@@ -166,6 +168,10 @@ private slots:
     void psql_bindWithDoubleColonCastOperator();
     void psql_specialFloatValues_data() { generic_data("QPSQL"); }
     void psql_specialFloatValues();
+    void psql_copy_data() { generic_data("QPSQL"); }
+    void psql_copy();
+    void psql_pipelinedBatch_data() { generic_data("QPSQL"); }
+    void psql_pipelinedBatch();
     void queryOnInvalidDatabase_data() { generic_data(); }
     void queryOnInvalidDatabase();
     void createQueryOnClosedDatabase_data() { generic_data(); }
@@ -249,6 +255,9 @@ private slots:
     void sqlite_real_data() { generic_data("QSQLITE"); }
     void sqlite_real();
 
+    void sqlite_batchTransactions_data() { generic_data("QSQLITE"); }
+    void sqlite_batchTransactions();
+
     void aggregateFunctionTypes_data() { generic_data(); }
     void aggregateFunctionTypes();
 
@@ -2903,6 +2912,132 @@ void tst_QSqlQuery::psql_specialFloatValues()
     QVERIFY_SQL( query, exec("drop table " + tableName) );
 }
 
+void tst_QSqlQuery::psql_copy()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString tableName = qTableName("copytest", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName
+                        + " (id INTEGER, t TEXT, b BYTEA, d DOUBLE PRECISION)"));
+
+    const QVariantList ids = { 1, 2, 3, 4 };
+    const QVariantList texts = { QString("tab\there"), QVariant(QMetaType::fromType<QString>()),
+                                 QString("back\\slash\nline"), QString("\\N") };
+    const QVariantList blobs = { QByteArray("\0\1\\", 3), QVariant(QMetaType::fromType<QByteArray>()),
+                                 QByteArray("\t"), QByteArray() };
+    const QVariantList doubles = { 1.5, qInf(), -0.25, QVariant(QMetaType::fromType<double>()) };
+
+    QVERIFY_SQL(q, prepare("COPY " + tableName + " (id, t, b, d) FROM STDIN"));
+    q.addBindValue(ids.mid(0, 3));
+    q.addBindValue(texts.mid(0, 3));
+    q.addBindValue(blobs.mid(0, 3));
+    q.addBindValue(doubles.mid(0, 3));
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), 3);
+
+    // exec() sends the bound values as a single row
+    q.addBindValue(ids.at(3));
+    q.addBindValue(texts.at(3));
+    q.addBindValue(blobs.at(3));
+    q.addBindValue(doubles.at(3));
+    QVERIFY_SQL(q, exec());
+    QCOMPARE(q.numRowsAffected(), 1);
+
+    QVERIFY_SQL(q, exec("SELECT id, t, b, d FROM " + tableName + " ORDER BY id"));
+    for (int i = 0; i < ids.count(); ++i) {
+        QVERIFY_SQL(q, next());
+        QCOMPARE(q.value(0).toInt(), ids.at(i).toInt());
+        QCOMPARE(q.value(1).isNull(), texts.at(i).isNull());
+        QCOMPARE(q.value(1).toString(), texts.at(i).toString());
+        QCOMPARE(q.value(2).isNull(), blobs.at(i).isNull());
+        QCOMPARE(q.value(2).toByteArray(), blobs.at(i).toByteArray());
+        QCOMPARE(q.value(3).isNull(), doubles.at(i).isNull());
+        QCOMPARE(q.value(3).toDouble(), doubles.at(i).toDouble());
+    }
+
+    // a row that does not fit the table aborts the whole COPY
+    QVERIFY_SQL(q, prepare("COPY " + tableName + " (id) FROM STDIN"));
+    q.addBindValue(QVariantList{ 5, QString("no number") });
+    QVERIFY(!q.execBatch());
+    QVERIFY(q.lastError().isValid());
+    QVERIFY_SQL(q, exec("SELECT COUNT(*) FROM " + tableName));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt(), ids.count());
+
+    for (bool forwardOnly : { false, true }) {
+        QSqlQuery copy(db);
+        copy.setForwardOnly(forwardOnly);
+        QVERIFY_SQL(copy, exec("COPY (SELECT id, t FROM " + tableName + " ORDER BY id) TO STDOUT"));
+        QVERIFY(copy.isSelect());
+        QCOMPARE(copy.record().count(), 2);
+        if (!forwardOnly)
+            QCOMPARE(copy.size(), ids.count());
+        for (int i = 0; i < ids.count(); ++i) {
+            QVERIFY_SQL(copy, next());
+            QCOMPARE(copy.value(0).toString(), ids.at(i).toString());
+            QCOMPARE(copy.isNull(1), texts.at(i).isNull());
+            QCOMPARE(copy.value(1).toString(), texts.at(i).toString());
+        }
+        QVERIFY(!copy.next());
+        QVERIFY(!copy.lastError().isValid());
+    }
+
+    // a COPY that is not read to the end must not block the connection
+    {
+        QSqlQuery copy(db);
+        copy.setForwardOnly(true);
+        QVERIFY_SQL(copy, exec("COPY " + tableName + " TO STDOUT"));
+        QVERIFY_SQL(copy, next());
+    }
+    QVERIFY_SQL(q, exec("SELECT COUNT(*) FROM " + tableName));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt(), ids.count());
+}
+
+void tst_QSqlQuery::psql_pipelinedBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString tableName = qTableName("pipelinetest", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + " (id INTEGER PRIMARY KEY, t TEXT)"));
+
+    // more rows than are sent in one go
+    const int rowCount = 1000;
+    QVariantList ids, texts;
+    for (int i = 0; i < rowCount; ++i) {
+        ids << i;
+        texts << QString::number(i);
+    }
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " (id, t) VALUES (?, ?)"));
+    q.addBindValue(ids);
+    q.addBindValue(texts);
+    QVERIFY_SQL(q, execBatch());
+
+    // an error discards its group of statements and stops the batch
+    q.addBindValue(QVariantList{ rowCount, 0, rowCount + 1 });
+    q.addBindValue(QVariantList{ "a", "b", "c" });
+    QVERIFY(!q.execBatch());
+    QVERIFY(q.lastError().isValid());
+
+    QVERIFY_SQL(q, exec("SELECT COUNT(*), SUM(id) FROM " + tableName));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt(), rowCount);
+    QCOMPARE(q.value(1).toInt(), rowCount * (rowCount - 1) / 2);
+
+    // the connection is usable afterwards
+    QVERIFY_SQL(q, exec("SELECT t FROM " + tableName + " WHERE id = 42"));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toString(), QString("42"));
+}
+
 /* For task 157397: Using QSqlQuery with an invalid QSqlDatabase
    does not set the last error of the query.
    This test function will output some warnings, that's ok.
@@ -3068,6 +3203,59 @@ void tst_QSqlQuery::sqlite_finish()
     QSqlDatabase::removeDatabase( "sqlite_finish_sqlite" );
 }
 
+void tst_QSqlQuery::fetchBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    for (bool forwardOnly : {false, true}) {
+        QSqlQuery q(db);
+        q.setForwardOnly(forwardOnly);
+        QVERIFY(q.fetchBatch(10).isEmpty());
+
+        QVERIFY_SQL(q, exec("select id, t_varchar from " + qtest + " order by id"));
+        QSqlBatch batch = q.fetchBatch(2);
+        QCOMPARE(batch.rowCount(), 2);
+        QCOMPARE(batch.columnCount(), 2);
+        QCOMPARE(batch.columnType(0), QSqlBatch::Int64);
+        QCOMPARE(batch.columnType(1), QSqlBatch::Text);
+        QCOMPARE(batch.int64Data(0)[0], qint64(1));
+        QCOMPARE(batch.int64Data(0)[1], qint64(2));
+        QVERIFY(!batch.doubleData(0));
+        QCOMPARE(batch.bytes(0, 1), QByteArrayView("VarChar1"));
+        QCOMPARE(batch.value(1, 1), QVariant(QStringLiteral("VarChar2")));
+        QVERIFY(!batch.isNull(1, 1));
+        // the query is positioned on the last row of the batch
+        QCOMPARE(q.at(), 1);
+        QCOMPARE(q.value(0).toInt(), 2);
+
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), 3);
+        batch = q.fetchBatch(10);
+        QCOMPARE(batch.rowCount(), 2);
+        QCOMPARE(batch.int64Data(0)[0], qint64(4));
+        QCOMPARE(batch.bytes(1, 1), QByteArrayView("VarChar5"));
+        QCOMPARE(q.at(), int(QSql::AfterLastRow));
+        QVERIFY(q.fetchBatch(10).isEmpty());
+        QVERIFY(!q.next());
+
+        const QString qtest_null(qTableName("qtest_null", __FILE__, db));
+        QVERIFY_SQL(q, exec("select id, t_varchar from " + qtest_null + " order by id"));
+        batch = q.fetchBatch(1);
+        QCOMPARE(batch.rowCount(), 1);
+        QVERIFY(batch.isNull(0, 1));
+        QCOMPARE(batch.bytes(0, 1), QByteArrayView());
+        batch = q.fetchBatch(100);
+        QCOMPARE(batch.rowCount(), 3);
+        QVERIFY(!batch.isNull(0, 1));
+        QCOMPARE(batch.bytes(0, 1), QByteArrayView("n"));
+        QCOMPARE(batch.bytes(1, 1), QByteArrayView("i"));
+        QVERIFY(batch.isNull(2, 1));
+        QCOMPARE(batch.value(2, 1), QVariant(QMetaType::fromType<QString>()));
+    }
+}
+
 void tst_QSqlQuery::nextResult()
 {
     QFETCH( QString, dbName );
@@ -4294,6 +4482,62 @@ void tst_QSqlQuery::sqlite_real()
     QCOMPARE(q.value(0).toDouble(), 5.6);
 }
 
+void tst_QSqlQuery::sqlite_batchTransactions()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString tableName(qTableName("sqlitebatch", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + " (id INTEGER PRIMARY KEY, t TEXT)"));
+
+    {
+        QSqlDatabase batchDb = QSqlDatabase::cloneDatabase(db, "sqliteBatchTest");
+        batchDb.setConnectOptions("QSQLITE_BATCH_TRANSACTION_SIZE=2");
+        QVERIFY_SQL(batchDb, open());
+        QSqlQuery batch(batchDb);
+
+        // the fourth row violates the primary key, the rows before it are kept
+        QVERIFY_SQL(batch, prepare("INSERT INTO " + tableName + " (id, t) VALUES (?, ?)"));
+        batch.addBindValue(QVariantList{1, 2, 3, 3, 5});
+        batch.addBindValue(QVariantList{"a", "b", QVariant(), "d", "e"});
+        QVERIFY(!batch.execBatch());
+        QVERIFY(batch.lastError().isValid());
+
+        // a transaction of the user is left alone
+        QVERIFY_SQL(batchDb, transaction());
+        batch.addBindValue(QVariantList{10, 11, 12});
+        batch.addBindValue(QVariantList{"x", "y", "z"});
+        QVERIFY_SQL(batch, execBatch());
+        QVERIFY_SQL(batchDb, rollback());
+
+        // named placeholders and lists of different lengths
+        QVERIFY_SQL(batch, prepare("INSERT INTO " + tableName + " (id, t) VALUES (:id, :t)"));
+        batch.bindValue(":id", QVariantList{20, 21});
+        batch.bindValue(":t", QVariantList{"f"});
+        QVERIFY(!batch.execBatch());
+        batch.bindValue(":id", QVariantList{20, 21});
+        batch.bindValue(":t", QVariantList{"f", "g"});
+        QVERIFY_SQL(batch, execBatch());
+    }
+    QSqlDatabase::removeDatabase("sqliteBatchTest");
+
+    QVERIFY_SQL(q, exec("SELECT id, t FROM " + tableName + " ORDER BY id"));
+    const QList<QPair<int, QVariant>> expected = {
+        { 1, QString("a") }, { 2, QString("b") }, { 3, QVariant() },
+        { 20, QString("f") }, { 21, QString("g") }
+    };
+    for (const auto &row : expected) {
+        QVERIFY_SQL(q, next());
+        QCOMPARE(q.value(0).toInt(), row.first);
+        QCOMPARE(q.value(1).isNull(), row.second.isNull());
+        QCOMPARE(q.value(1).toString(), row.second.toString());
+    }
+    QVERIFY(!q.next());
+}
+
 void tst_QSqlQuery::aggregateFunctionTypes()
 {
     QFETCH(QString, dbName);
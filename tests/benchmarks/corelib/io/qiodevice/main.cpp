@@ -29,6 +29,7 @@
 #include <QIODevice>
 #include <QFile>
 #include <QString>
+#include <QtEndian>
 
 #include <qtest.h>
 
@@ -41,6 +42,8 @@ private slots:
     void read_old_data() { read_data(); }
     void peekAndRead();
     void peekAndRead_data() { read_data(); }
+    void writeRecords_data();
+    void writeRecords();
     //void read_new();
     //void read_new_data() { read_data(); }
 private:
@@ -119,6 +122,48 @@ void tst_qiodevice::peekAndRead()
     }
 }
 
+void tst_qiodevice::writeRecords_data()
+{
+    QTest::addColumn<int>("payloadSize");
+    QTest::addColumn<bool>("vectored");
+
+    for (int payloadSize : { 64, 1024, 16 * 1024 }) {
+        const QByteArray size = QByteArray::number(payloadSize);
+        QTest::newRow(size + "-write") << payloadSize << false;
+        QTest::newRow(size + "-writev") << payloadSize << true;
+    }
+}
+
+// Writes a stream of length-prefixed records to an unbuffered file, either
+// with one write() per header and payload or with a single writev()
+void tst_qiodevice::writeRecords()
+{
+    QFETCH(int, payloadSize);
+    QFETCH(bool, vectored);
+
+    const int recordCount = 1000;
+    const QByteArray payload(payloadSize, 'x');
+    const quint32 header = qToBigEndian(quint32(payloadSize));
+    const QByteArrayView headerView(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    QFile file("tmpRecords");
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Unbuffered));
+
+    QBENCHMARK {
+        file.seek(0);
+        for (int i = 0; i < recordCount; ++i) {
+            if (vectored) {
+                file.writev({ headerView, payload });
+            } else {
+                file.write(headerView.data(), headerView.size());
+                file.write(payload);
+            }
+        }
+    }
+
+    file.remove();
+}
+
 QTEST_MAIN(tst_qiodevice)
 
 #include "main.moc"
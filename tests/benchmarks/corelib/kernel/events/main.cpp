@@ -30,6 +30,9 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#include <memory>
+#include <vector>
+
 class PingPong : public QObject
 {
 public:
@@ -83,6 +86,38 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+class SignalEmitter : public QThread
+{
+    Q_OBJECT
+public:
+    int count = 0;
+
+signals:
+    void valueChanged(int value);
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < count; ++i)
+            emit valueChanged(i);
+    }
+};
+
+class SignalReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    int received = 0;
+    int expected = 0;
+
+public slots:
+    void setValue(int)
+    {
+        if (++received == expected)
+            QTestEventLoop::instance().exitLoop();
+    }
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -96,6 +131,8 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void queuedSignals_data();
+    void queuedSignals();
 };
 
 void EventsBench::initTestCase()
@@ -169,6 +206,42 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::queuedSignals_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("signalsPerThread");
+    QTest::newRow("1 thread, 100000 signals") << 1 << 100000;
+    QTest::newRow("4 threads, 25000 signals each") << 4 << 25000;
+}
+
+// throughput of queued connections emitted from worker threads and
+// delivered in the main thread
+void EventsBench::queuedSignals()
+{
+    QFETCH(int, threads);
+    QFETCH(int, signalsPerThread);
+
+    SignalReceiver receiver;
+    std::vector<std::unique_ptr<SignalEmitter>> emitters;
+    for (int i = 0; i < threads; ++i) {
+        emitters.emplace_back(new SignalEmitter);
+        emitters.back()->count = signalsPerThread;
+        connect(emitters.back().get(), &SignalEmitter::valueChanged,
+                &receiver, &SignalReceiver::setValue, Qt::QueuedConnection);
+    }
+
+    QBENCHMARK {
+        receiver.received = 0;
+        receiver.expected = threads * signalsPerThread;
+        for (const auto &emitter : emitters)
+            emitter->start();
+        QTestEventLoop::instance().enterLoop(60);
+        for (const auto &emitter : emitters)
+            emitter->wait();
+    }
+    QCOMPARE(receiver.received, threads * signalsPerThread);
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "main.moc"
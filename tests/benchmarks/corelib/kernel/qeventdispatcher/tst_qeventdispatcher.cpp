@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSocketNotifier>
+#include <QtTest/QtTest>
+
+#include <QtCore/private/qeventdispatcher_unix_p.h>
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+#  include <QtCore/private/qeventdispatcher_epoll_p.h>
+#endif
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+class tst_QEventDispatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void idleSockets_data();
+    void idleSockets();
+};
+
+static QAbstractEventDispatcher *createDispatcher(const QByteArray &name)
+{
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    if (name == "epoll")
+        return new QEventDispatcherEpoll;
+#endif
+    Q_ASSERT(name == "poll");
+    return new QEventDispatcherUNIX;
+}
+
+void tst_QEventDispatcher::idleSockets_data()
+{
+    QTest::addColumn<QByteArray>("dispatcher");
+    QTest::addColumn<int>("socketCount");
+
+    QList<QByteArray> dispatchers = { "poll" };
+#if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
+    dispatchers << "epoll";
+#endif
+    for (const QByteArray &dispatcher : qAsConst(dispatchers)) {
+        for (int socketCount : { 100, 1000, 10000 })
+            QTest::addRow("%s-%d", dispatcher.constData(), socketCount) << dispatcher << socketCount;
+    }
+}
+
+// One event loop iteration, woken up by wakeUp(), while socketCount sockets
+// with enabled read notifiers are idle.
+void tst_QEventDispatcher::idleSockets()
+{
+    QFETCH(QByteArray, dispatcher);
+    QFETCH(int, socketCount);
+
+    rlimit limit;
+    QVERIFY(getrlimit(RLIMIT_NOFILE, &limit) == 0);
+    const rlim_t needed = rlim_t(socketCount) + 64;
+    if (limit.rlim_cur < needed) {
+        if (limit.rlim_max != RLIM_INFINITY && limit.rlim_max < needed)
+            QSKIP("Not enough file descriptors available");
+        limit.rlim_cur = needed;
+        QVERIFY(setrlimit(RLIMIT_NOFILE, &limit) == 0);
+    }
+
+    int pair[2];
+    QVERIFY(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == 0);
+
+    QScopedPointer<QAbstractEventDispatcher> eventDispatcher(createDispatcher(dispatcher));
+    QList<QSocketNotifier *> notifiers;
+    notifiers.reserve(socketCount);
+    for (int i = 0; i < socketCount; ++i) {
+        const int fd = ::dup(pair[0]);
+        QVERIFY(fd != -1);
+        // register with our dispatcher rather than the application's
+        auto notifier = new QSocketNotifier(fd, QSocketNotifier::Read);
+        notifier->setEnabled(false);
+        eventDispatcher->registerSocketNotifier(notifier);
+        notifiers << notifier;
+    }
+
+    QBENCHMARK {
+        eventDispatcher->wakeUp();
+        eventDispatcher->processEvents(QEventLoop::WaitForMoreEvents);
+    }
+
+    for (QSocketNotifier *notifier : qAsConst(notifiers)) {
+        eventDispatcher->unregisterSocketNotifier(notifier);
+        ::close(int(notifier->socket()));
+        delete notifier;
+    }
+    ::close(pair[0]);
+    ::close(pair[1]);
+}
+
+QTEST_MAIN(tst_QEventDispatcher)
+
+#include "tst_qeventdispatcher.moc"
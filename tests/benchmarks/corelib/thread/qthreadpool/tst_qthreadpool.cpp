@@ -40,6 +40,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void throughput_data();
+    void throughput();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,5 +77,62 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::throughput_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("workStealing");
+    QTest::addColumn<bool>("fromPoolThreads");
+
+    QList<int> threadCounts;
+    for (int n = 1; n < QThread::idealThreadCount(); n *= 2)
+        threadCounts << n;
+    threadCounts << QThread::idealThreadCount();
+
+    for (int n : qAsConst(threadCounts)) {
+        for (bool workStealing : { false, true }) {
+            const char *mode = workStealing ? "stealing" : "shared-queue";
+            QTest::addRow("%d-threads-%s-external", n, mode) << n << workStealing << false;
+            QTest::addRow("%d-threads-%s-from-pool", n, mode) << n << workStealing << true;
+        }
+    }
+}
+
+void tst_QThreadPool::throughput()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+    QFETCH(bool, fromPoolThreads);
+
+    enum { SpawnerCount = 64, TasksPerSpawner = 1600, TaskCount = SpawnerCount * TasksPerSpawner };
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    QAtomicInt remaining;
+    QSemaphore done;
+    const auto task = [&] {
+        if (!remaining.deref())
+            done.release();
+    };
+
+    QBENCHMARK {
+        remaining.storeRelaxed(TaskCount);
+        if (fromPoolThreads) {
+            // fan out from inside the pool, like nested QtConcurrent::run() calls
+            for (int i = 0; i < SpawnerCount; ++i) {
+                threadPool.start([&] {
+                    for (int j = 0; j < TasksPerSpawner; ++j)
+                        threadPool.start(task);
+                });
+            }
+        } else {
+            for (int i = 0; i < TaskCount; ++i)
+                threadPool.start(task);
+        }
+        done.acquire();
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
@@ -31,11 +31,16 @@
 
 #include <QFile>
 #include <QHash>
+#include <QRandomGenerator>
 #include <QString>
 #include <QStringList>
 #include <QUuid>
 #include <QTest>
 
+#include <private/qflathash_p.h>
+
+#include <algorithm>
+
 
 class tst_QHash : public QObject
 {
@@ -61,10 +66,39 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void insert_qhash_data() { data(); }
+    void insert_qhash() { insert_template<QHash<QString, int>>(); }
+    void insert_qflathash_data() { data(); }
+    void insert_qflathash() { insert_template<QFlatHash<QString, int>>(); }
+
+    void lookup_qhash_data() { data(); }
+    void lookup_qhash() { lookup_template<QHash<QString, int>, QString>(); }
+    void lookup_qflathash_data() { data(); }
+    void lookup_qflathash() { lookup_template<QFlatHash<QString, int>, QString>(); }
+    void lookup_qhash_stringview_data() { data(); }
+    void lookup_qhash_stringview() { lookup_template<QHash<QString, int>, QStringView>(); }
+    void lookup_qflathash_stringview_data() { data(); }
+    void lookup_qflathash_stringview() { lookup_template<QFlatHash<QString, int>, QStringView>(); }
+
+    void lookupMissing_qhash_data() { data(); }
+    void lookupMissing_qhash() { lookupMissing_template<QHash<QString, int>>(); }
+    void lookupMissing_qflathash_data() { data(); }
+    void lookupMissing_qflathash() { lookupMissing_template<QFlatHash<QString, int>>(); }
+
+    void lookupLarge_qhash_data() { largeData(); }
+    void lookupLarge_qhash() { lookupLarge_template<QHash<quint64, quint64>>(); }
+    void lookupLarge_qflathash_data() { largeData(); }
+    void lookupLarge_qflathash() { lookupLarge_template<QFlatHash<quint64, quint64>>(); }
+
 private:
     void data();
+    void largeData();
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
+    template <typename Hash> void insert_template();
+    template <typename Hash, typename Lookup> void lookup_template();
+    template <typename Hash> void lookupMissing_template();
+    template <typename Hash> void lookupLarge_template();
 
     QStringList smallFilePaths;
     QStringList uuids;
@@ -168,6 +202,96 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::largeData()
+{
+    QTest::addColumn<int>("size");
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("1M") << 1000000;
+    QTest::newRow("10M") << 10000000;
+}
+
+template <typename Hash> void tst_QHash::insert_template()
+{
+    QFETCH(QStringList, items);
+
+    QBENCHMARK {
+        Hash hash;
+        for (int i = 0, n = items.size(); i != n; ++i)
+            hash.insert(items.at(i), i);
+    }
+}
+
+template <typename Hash, typename Lookup> void tst_QHash::lookup_template()
+{
+    QFETCH(QStringList, items);
+
+    Hash hash;
+    for (int i = 0, n = items.size(); i != n; ++i)
+        hash.insert(items.at(i), i);
+
+    // look up through a separate copy of the text, as a parser would
+    const QString text = items.join(QLatin1Char(' '));
+    QList<QStringView> views;
+    views.reserve(items.size());
+    qsizetype pos = 0;
+    for (const QString &item : qAsConst(items)) {
+        views.append(QStringView(text).mid(pos, item.size()));
+        pos += item.size() + 1;
+    }
+
+    int sum = 0;
+    QBENCHMARK {
+        for (QStringView view : qAsConst(views)) {
+            if constexpr (std::is_same_v<Lookup, QStringView>)
+                sum += hash.value(view);
+            else
+                sum += hash.value(view.toString());
+        }
+    }
+    QVERIFY(sum != -1);
+}
+
+template <typename Hash> void tst_QHash::lookupMissing_template()
+{
+    QFETCH(QStringList, items);
+
+    Hash hash;
+    for (int i = 0, n = items.size(); i != n; i += 2)
+        hash.insert(items.at(i), i);
+
+    int found = 0;
+    QBENCHMARK {
+        for (int i = 1, n = items.size(); i < n; i += 2)
+            found += hash.contains(items.at(i));
+    }
+    QCOMPARE(found, 0);
+}
+
+template <typename Hash> void tst_QHash::lookupLarge_template()
+{
+    QFETCH(int, size);
+
+    // keys spread over the table, looked up in random order to defeat the caches
+    Hash hash;
+    QList<quint64> keys;
+    keys.reserve(size);
+    QRandomGenerator rng(size);
+    for (int i = 0; i < size; ++i) {
+        const quint64 key = rng.generate64();
+        hash.insert(key, quint64(i));
+        keys.append(key);
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+    const int lookups = qMin(size, 1000000);
+
+    quint64 sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < lookups; ++i)
+            sum += hash.value(keys.at(i));
+    }
+    QVERIFY(sum != 0);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "main.moc"
@@ -4,6 +4,7 @@ SUBDIRS = \
         containers-sequential \
         qcontiguouscache \
         qcryptographichash \
+        qhash \
         qlist \
         qmap \
         qrect \
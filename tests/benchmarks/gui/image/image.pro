@@ -4,5 +4,7 @@ SUBDIRS = \
         qimageconversion \
         qimagereader \
         qimagescale \
+        qimagetransform \
+        qimagewriter \
         qpixmap \
         qpixmapcache
@@ -28,6 +28,13 @@
 
 #include <qtest.h>
 #include <QImage>
+#include <QMetaEnum>
+
+static QByteArray formatToString(QImage::Format format)
+{
+    const QMetaEnum formatEnum = QMetaEnum::fromType<QImage::Format>();
+    return QByteArray(formatEnum.valueToKey(format)).mid(7); // strip "Format_"
+}
 
 class tst_QImageScale : public QObject
 {
@@ -39,6 +46,9 @@ private slots:
     void scaleArgb32pm_data();
     void scaleArgb32pm();
 
+    void scaleFormats_data();
+    void scaleFormats();
+
 private:
     QImage generateImageRgb32(int width, int height);
     QImage generateImageArgb32(int width, int height);
@@ -100,6 +110,34 @@ void tst_QImageScale::scaleArgb32pm()
     }
 }
 
+void tst_QImageScale::scaleFormats_data()
+{
+    QTest::addColumn<QImage>("inputImage");
+    QTest::addColumn<QSize>("outputSize");
+
+    const QImage image = generateImageArgb32(1000, 1000);
+    const QSize sizes[] = { QSize(2000, 500), QSize(500, 2000), QSize(500, 500), QSize(200, 200) };
+    for (int i = QImage::Format_RGB32; i < QImage::NImageFormats; ++i) {
+        const QImage::Format format = QImage::Format(i);
+        const QImage converted = image.convertToFormat(format);
+        for (const QSize &size : sizes) {
+            QTest::addRow("%s 1000x1000 -> %dx%d", formatToString(format).constData(),
+                          size.width(), size.height()) << converted << size;
+        }
+    }
+}
+
+void tst_QImageScale::scaleFormats()
+{
+    QFETCH(QImage, inputImage);
+    QFETCH(QSize, outputSize);
+
+    QBENCHMARK {
+        volatile QImage output = inputImage.scaled(outputSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        (void)output;
+    }
+}
+
 /*
  Fill a RGB32 image with "random" pixel values.
  */
@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qimagetransform
+QT += testlib
+SOURCES += tst_qimagetransform.cpp
@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QImage>
+#include <QTransform>
+
+class tst_QImageTransform : public QObject
+{
+    Q_OBJECT
+private slots:
+    void rotated_data();
+    void rotated();
+
+    void transformed_data();
+    void transformed();
+
+private:
+    QImage generateImage(int width, int height, QImage::Format format);
+};
+
+void tst_QImageTransform::rotated_data()
+{
+    QTest::addColumn<QImage>("inputImage");
+    QTest::addColumn<int>("angle");
+
+    // An A4 page scanned at 300 dpi, and a 4K frame
+    const QSize sizes[] = { QSize(2480, 3508), QSize(3840, 2160) };
+    const QImage::Format formats[] = { QImage::Format_RGB32, QImage::Format_RGB888,
+                                       QImage::Format_Grayscale8 };
+    for (const QSize &size : sizes) {
+        for (QImage::Format format : formats) {
+            const QImage image = generateImage(size.width(), size.height(), format);
+            for (int angle : { 90, 180, 270 }) {
+                QTest::addRow("%dx%d %s rotate(%d)", size.width(), size.height(),
+                              format == QImage::Format_RGB32 ? "RGB32"
+                              : format == QImage::Format_RGB888 ? "RGB888" : "Grayscale8",
+                              angle) << image << angle;
+            }
+        }
+    }
+}
+
+void tst_QImageTransform::rotated()
+{
+    QFETCH(QImage, inputImage);
+    QFETCH(int, angle);
+
+    const QTransform transform = QTransform().rotate(angle);
+    QBENCHMARK {
+        const QImage output = inputImage.transformed(transform);
+        QCOMPARE(output.format(), inputImage.format());
+    }
+}
+
+void tst_QImageTransform::transformed_data()
+{
+    QTest::addColumn<QImage>("inputImage");
+    QTest::addColumn<QTransform>("transform");
+    QTest::addColumn<Qt::TransformationMode>("mode");
+
+    const QImage image = generateImage(2480, 3508, QImage::Format_RGB32);
+    QTest::newRow("deskew rotate(1.5) fast") << image << QTransform().rotate(1.5)
+                                             << Qt::FastTransformation;
+    QTest::newRow("deskew rotate(1.5) smooth") << image << QTransform().rotate(1.5)
+                                               << Qt::SmoothTransformation;
+    QTest::newRow("rotate(30) smooth") << image << QTransform().rotate(30)
+                                       << Qt::SmoothTransformation;
+    QTest::newRow("shear(0.1, 0) smooth") << image << QTransform().shear(0.1, 0)
+                                          << Qt::SmoothTransformation;
+    QTest::newRow("scale(0.7) rotate(10) smooth") << image << QTransform().scale(0.7, 0.7).rotate(10)
+                                                  << Qt::SmoothTransformation;
+}
+
+void tst_QImageTransform::transformed()
+{
+    QFETCH(QImage, inputImage);
+    QFETCH(QTransform, transform);
+    QFETCH(Qt::TransformationMode, mode);
+
+    QBENCHMARK {
+        const QImage output = inputImage.transformed(transform, mode);
+        QVERIFY(!output.isNull());
+    }
+}
+
+QImage tst_QImageTransform::generateImage(int width, int height, QImage::Format format)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *scanline = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < width; ++x)
+            scanline[x] = qRgb(x, y, x ^ y);
+    }
+    return image.convertToFormat(format);
+}
+
+QTEST_MAIN(tst_QImageTransform)
+#include "tst_qimagetransform.moc"
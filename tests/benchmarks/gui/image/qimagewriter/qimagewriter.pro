@@ -0,0 +1,4 @@
+TEMPLATE = app
+TARGET = tst_bench_qimagewriter
+QT += testlib
+SOURCES += tst_qimagewriter.cpp
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+
+#include <qtest.h>
+#include <QBuffer>
+#include <QImage>
+#include <QImageWriter>
+#include <QPainter>
+
+class tst_QImageWriter : public QObject
+{
+    Q_OBJECT
+private slots:
+    void writePng_data();
+    void writePng();
+
+private:
+    QImage generateImage(int width, int height, QImage::Format format);
+};
+
+void tst_QImageWriter::writePng_data()
+{
+    QTest::addColumn<QImage>("image");
+    QTest::addColumn<bool>("parallel");
+    QTest::addColumn<bool>("fast");
+
+    // 4K and 8K screenshots
+    const QSize sizes[] = { QSize(3840, 2160), QSize(7680, 4320) };
+    const QImage::Format formats[] = { QImage::Format_RGB32, QImage::Format_ARGB32 };
+    for (const QSize &size : sizes) {
+        for (QImage::Format format : formats) {
+            const QImage image = generateImage(size.width(), size.height(), format);
+            for (bool parallel : { false, true }) {
+                for (bool fast : { false, true }) {
+                    QTest::addRow("%dx%d %s%s%s", size.width(), size.height(),
+                                  format == QImage::Format_RGB32 ? "RGB32" : "ARGB32",
+                                  parallel ? " parallel" : "", fast ? " fast" : "")
+                            << image << parallel << fast;
+                }
+            }
+        }
+    }
+}
+
+void tst_QImageWriter::writePng()
+{
+    QFETCH(QImage, image);
+    QFETCH(bool, parallel);
+    QFETCH(bool, fast);
+
+    QByteArray data;
+    QBENCHMARK {
+        data.clear();
+        QBuffer buffer(&data);
+        QImageWriter writer(&buffer, "png");
+        writer.setParallelWrite(parallel);
+        writer.setFastWrite(fast);
+        QVERIFY(writer.write(image));
+    }
+    qDebug("%lld bytes", qlonglong(data.size()));
+}
+
+// Something between a desktop screenshot and a photo: flat areas, text-like
+// detail and gradients.
+QImage tst_QImageWriter::generateImage(int width, int height, QImage::Format format)
+{
+    QImage image(width, height, format);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    QLinearGradient gradient(0, 0, width, height);
+    gradient.setColorAt(0, QColor(32, 64, 128, 255));
+    gradient.setColorAt(1, QColor(200, 120, 40, 160));
+    painter.fillRect(0, 0, width, height / 2, gradient);
+    painter.fillRect(width / 8, height / 8, width / 2, height / 2, QColor(240, 240, 240));
+    // Lines of "glyphs"
+    for (int y = height / 8 + 8; y + 12 < height * 5 / 8; y += 18) {
+        for (int x = width / 8 + 8; x + 8 < width * 5 / 8; x += 9) {
+            if ((x * 31 + y * 17) % 11 > 1)
+                painter.fillRect(x, y + (x % 3), 6, 12 - (x % 5), Qt::black);
+        }
+    }
+    painter.end();
+    for (int y = height / 2; y < height; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = width / 2; x < width; ++x)
+            line[x] = qRgb((x * 7) ^ y, (y * 3) + x, x * y);
+    }
+    return image;
+}
+
+QTEST_MAIN(tst_QImageWriter)
+#include "tst_qimagewriter.moc"
@@ -32,6 +32,9 @@
 #include <QPixmap>
 #include <QImage>
 #include <QPaintEngine>
+#include <QParallelImageRenderer>
+#include <QPicture>
+#include <QRandomGenerator>
 #include <QTileRules>
 #include <qmath.h>
 
@@ -220,6 +223,9 @@ private slots:
     void drawTransformedSemiTransparentImage();
     void drawTransformedFilledImage();
 
+    void parallelRendering_data();
+    void parallelRendering();
+
 private:
     void setupBrushes();
     void createPrimitives();
@@ -1684,6 +1690,73 @@ void tst_QPainter::drawTransformedFilledImage()
     }
 }
 
+static QPicture mapTilePicture(const QSize &size)
+{
+    QRandomGenerator random(42);
+    auto point = [&]() {
+        return QPointF(random.bounded(size.width()), random.bounded(size.height()));
+    };
+
+    QPicture picture;
+    QPainter p(&picture);
+    p.setRenderHint(QPainter::Antialiasing);
+    for (int i = 0; i < 200; ++i) {
+        QPolygonF area;
+        const QPointF center = point();
+        for (int j = 0; j < 12; ++j)
+            area << center + QPointF(random.bounded(-400, 400), random.bounded(-400, 400));
+        QLinearGradient gradient(area.boundingRect().topLeft(), area.boundingRect().bottomRight());
+        gradient.setColorAt(0, QColor::fromRgba(random.generate() | 0x80000000));
+        gradient.setColorAt(1, QColor::fromRgba(random.generate() | 0x80000000));
+        p.setPen(Qt::NoPen);
+        p.setBrush(gradient);
+        p.drawPolygon(area);
+    }
+    for (int i = 0; i < 500; ++i) {
+        QPainterPath road(point());
+        road.cubicTo(point(), point(), point());
+        p.setPen(QPen(QColor::fromRgb(random.generate()), random.bounded(1, 12)));
+        p.setBrush(Qt::NoBrush);
+        p.drawPath(road);
+    }
+    p.end();
+    return picture;
+}
+
+void tst_QPainter::parallelRendering_data()
+{
+    QTest::addColumn<int>("bands");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("2 bands") << 2;
+    QTest::newRow("4 bands") << 4;
+    QTest::newRow("8 bands") << 8;
+    QTest::newRow("automatic") << 0;
+}
+
+void tst_QPainter::parallelRendering()
+{
+    QFETCH(int, bands);
+
+    const QSize size(4096, 4096);
+    const QPicture picture = mapTilePicture(size);
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+
+    QParallelImageRenderer renderer;
+    renderer.setBandCount(bands);
+    QBENCHMARK {
+        image.fill(Qt::white);
+        renderer.render(&image, picture);
+    }
+
+    QImage serial(size, QImage::Format_ARGB32_Premultiplied);
+    serial.fill(Qt::white);
+    QPainter p(&serial);
+    QPicture(picture).play(&p);
+    p.end();
+    QCOMPARE(image, serial);
+}
+
 
 QTEST_MAIN(tst_QPainter)
 
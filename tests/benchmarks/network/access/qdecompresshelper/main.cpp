@@ -36,9 +36,11 @@ class tst_QDecompressHelper : public QObject
 private slots:
     void decompress_data();
     void decompress();
+    void decompressStreaming_data();
+    void decompressStreaming();
 };
 
-void tst_QDecompressHelper::decompress_data()
+static void addEncodings()
 {
     QTest::addColumn<QByteArray>("encoding");
     QTest::addColumn<QString>("fileName");
@@ -65,6 +67,11 @@ void tst_QDecompressHelper::decompress_data()
         QSKIP("There's no decompression support");
 }
 
+void tst_QDecompressHelper::decompress_data()
+{
+    addEncodings();
+}
+
 void tst_QDecompressHelper::decompress()
 {
     QFETCH(QByteArray, encoding);
@@ -76,6 +83,8 @@ void tst_QDecompressHelper::decompress()
         file.seek(0);
         QDecompressHelper helper;
         helper.setEncoding(encoding);
+        // The test files are far more compressed than any real content
+        helper.setArchiveBombDetectionEnabled(false);
         QVERIFY(helper.isValid());
 
         helper.feed(file.readAll());
@@ -91,6 +100,43 @@ void tst_QDecompressHelper::decompress()
     }
 }
 
+void tst_QDecompressHelper::decompressStreaming_data()
+{
+    addEncodings();
+}
+
+// Feeds the data in the pieces it would be read from the socket in, and
+// decompresses it into the buffer that is handed over to the user thread.
+void tst_QDecompressHelper::decompressStreaming()
+{
+    QFETCH(QByteArray, encoding);
+    QFETCH(QString, fileName);
+
+    QFile file { fileName };
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray compressed = file.readAll();
+    const qsizetype socketReadSize = 16 * 1024;
+
+    QBENCHMARK {
+        QDecompressHelper helper;
+        helper.setEncoding(encoding);
+        // The test files are far more compressed than any real content
+        helper.setArchiveBombDetectionEnabled(false);
+        QVERIFY(helper.isValid());
+
+        qint64 bytes = 0;
+        for (qsizetype i = 0; i < compressed.size(); i += socketReadSize) {
+            helper.feed(compressed.mid(i, socketReadSize));
+            QByteDataBuffer out;
+            const qint64 bytesRead = helper.readAll(&out);
+            QVERIFY(bytesRead >= 0);
+            bytes += bytesRead;
+        }
+
+        QCOMPARE(bytes, 50 * 1024 * 1024);
+    }
+}
+
 QTEST_MAIN(tst_QDecompressHelper)
 
 #include "main.moc"
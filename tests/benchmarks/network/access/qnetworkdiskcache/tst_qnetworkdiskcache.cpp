@@ -39,6 +39,7 @@
 
 
 enum Numbers { NumFakeCacheObjects   = 200,    //entries in pre-populated cache
+               NumLargeCacheObjects  = 10000,  //entries in a pre-populated large cache
                NumInsertions  = 100,           //insertions to be timed
                NumRemovals    = 100,           //removals to be timed
                NumReadContent = 100,           //meta requests to be timed
@@ -53,7 +54,7 @@ class tst_qnetworkdiskcache : public QObject
 {
     Q_OBJECT
 private:
-    void injectFakeData();
+    void injectFakeData(quint32 count = NumFakeCacheObjects);
     void insertOneItem();
     bool isUrlCached(quint32 id);
     void cleanRecursive(QString &path);
@@ -77,6 +78,8 @@ private slots:
 
     void timeExpiration_data();
     void timeExpiration();
+    void timeLargeCacheExpiration_data();
+    void timeLargeCacheExpiration();
 };
 
 
@@ -323,11 +326,68 @@ void tst_qnetworkdiskcache::timeExpiration()
     cleanRecursive(cacheDir);
 
 }
+void tst_qnetworkdiskcache::timeLargeCacheExpiration_data()
+{
+    QTest::addColumn<QString>("cacheRootDirectory");
+
+    QString cacheLoc = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QTest::newRow("QStandardPaths Cache Location") << cacheLoc;
+}
+
+//Times opening a cache with many entries and evicting
+//some of them, as an application does on startup.
+void tst_qnetworkdiskcache::timeLargeCacheExpiration()
+{
+    QFETCH(QString, cacheRootDirectory);
+
+    cacheDir = QString( cacheRootDirectory + QDir::separator() + "man_qndc");
+    QDir d;
+    qDebug() << "Setting cache directory to = " << d.absoluteFilePath(cacheDir);
+
+    //Housekeeping
+    initCacheObject();
+    cleanRecursive(cacheDir); // slow op.
+    cache->setCacheDirectory(cacheDir);
+    cache->setMaximumCacheSize(qint64(HugeCacheLimit));
+    cache->clear();
+
+    injectFakeData(NumLargeCacheObjects); // SLOW
+    cleanupCacheObject();
+
+    QBENCHMARK_ONCE {
+        initCacheObject();
+        cache->setCacheDirectory(cacheDir);
+        cache->setMaximumCacheSize(qint64(HugeCacheLimit));
+        const qint64 size = cache->cacheSize();
+        QVERIFY(size > 0);
+
+        //the first insertion overflows the cache
+        cache->setMaximumCacheSize(size);
+        for (quint32 i = NumLargeCacheObjects; i < (NumLargeCacheObjects + NumInsertions); i++) {
+            QNetworkCacheMetaData meta;
+            QString fakeURL;
+            QTextStream stream(&fakeURL);
+            stream << fakeURLbase << i;
+            QUrl url(fakeURL);
+            meta.setUrl(url);
+            meta.setSaveToDisk(true);
+
+            QIODevice *device = cache->prepare(meta);
+            device->write(payload);
+            cache->insert(device);
+        }
+    }
+
+    //Cleanup (slow)
+    cleanupCacheObject();
+    cleanRecursive(cacheDir);
+}
+
 // This function simulates a partially or fully occupied disk cache
 // like a normal user of a cache might encounter is real-life browsing.
 // The point of this is to trigger degradation in file-system and media performance
 // that occur due to the quantity and layout of data.
-void tst_qnetworkdiskcache::injectFakeData()
+void tst_qnetworkdiskcache::injectFakeData(quint32 count)
 {
 
     QNetworkCacheMetaData::RawHeaderList headers;
@@ -335,7 +395,7 @@ void tst_qnetworkdiskcache::injectFakeData()
 
 
     //Prep cache dir with fake data using QNetworkDiskCache APIs
-    for (quint32 i = 0; i < NumFakeCacheObjects; i++) {
+    for (quint32 i = 0; i < count; i++) {
 
         //prepare metata for url
         QNetworkCacheMetaData meta;
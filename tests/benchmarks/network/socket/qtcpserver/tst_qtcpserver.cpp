@@ -59,6 +59,8 @@ private slots:
     void ipv4LoopbackPerformanceTest();
     void ipv6LoopbackPerformanceTest();
     void ipv4PerformanceTest();
+    void acceptRate_data();
+    void acceptRate();
 };
 
 tst_QTcpServer::tst_QTcpServer()
@@ -262,5 +264,118 @@ void tst_QTcpServer::ipv4PerformanceTest()
     delete clientB;
 }
 
+//----------------------------------------------------------------------------------
+// Answers each request with a short reply and closes the connection, all on
+// the thread that owns the server
+class ReplyingServer : public QTcpServer
+{
+public:
+    ReplyingServer()
+    {
+        setPortSharingEnabled(true);
+        setMaxPendingConnections(INT_MAX);
+        connect(this, &QTcpServer::newConnection, this, [this] {
+            while (QTcpSocket *socket = nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, socket, [socket] {
+                    socket->readAll();
+                    socket->write("ok", 2);
+                    socket->disconnectFromHost();
+                });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+};
+
+void tst_QTcpServer::acceptRate_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QList<int> counts = { 1, 2, 4, QThread::idealThreadCount() };
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+    for (int count : qAsConst(counts))
+        QTest::addRow("%d", count) << count;
+}
+
+void tst_QTcpServer::acceptRate()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(int, threadCount);
+
+    // one server per thread, all listening on the same port
+    quint16 port = 0;
+    QList<QThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        QThread *thread = new QThread;
+        ReplyingServer *server = new ReplyingServer;
+        server->moveToThread(thread);
+        connect(thread, &QThread::finished, server, &QObject::deleteLater);
+        thread->start();
+        threads << thread;
+
+        bool ok = false;
+        QMetaObject::invokeMethod(server, [server, port, &ok] {
+            ok = server->listen(QHostAddress::LocalHost, port);
+            if (!ok)
+                qWarning() << server->errorString();
+        }, Qt::BlockingQueuedConnection);
+        if (!ok) {
+            for (QThread *thread : qAsConst(threads)) {
+                thread->quit();
+                thread->wait();
+                delete thread;
+            }
+            QSKIP("Port sharing is not supported on this platform");
+        }
+        if (!port)
+            port = server->serverPort();
+    }
+
+    // clients connect, send a request and wait for the reply as fast as they can
+    const int clientThreadCount = qMax(4, threadCount);
+    const int connectionsPerClient = 250;
+    QAtomicInt failures;
+    QList<QThread *> clients;
+    for (int i = 0; i < clientThreadCount; ++i) {
+        clients << QThread::create([port, &failures] {
+            for (int j = 0; j < connectionsPerClient; ++j) {
+                QTcpSocket socket;
+                socket.connectToHost(QHostAddress::LocalHost, port);
+                if (!socket.waitForConnected(5000)) {
+                    failures.ref();
+                    continue;
+                }
+                socket.write("hello", 5);
+                while (socket.bytesAvailable() < 2 && socket.waitForReadyRead(5000))
+                    ;
+                if (socket.readAll() != "ok")
+                    failures.ref();
+            }
+        });
+    }
+
+    QElapsedTimer stopWatch;
+    stopWatch.start();
+    for (QThread *client : qAsConst(clients))
+        client->start();
+    for (QThread *client : qAsConst(clients))
+        client->wait();
+    const qint64 elapsed = qMax<qint64>(stopWatch.elapsed(), 1);
+    qDeleteAll(clients);
+
+    for (QThread *thread : qAsConst(threads)) {
+        thread->quit();
+        thread->wait();
+        delete thread;
+    }
+
+    const int connections = clientThreadCount * connectionsPerClient;
+    qDebug("\t\t%d thread(s): %d connections/%.1fs: %.0f connections/s",
+           threadCount, connections, elapsed / 1000.0, connections * 1000.0 / elapsed);
+    QCOMPARE(failures.loadRelaxed(), 0);
+}
+
 QTEST_MAIN(tst_QTcpServer)
 #include "tst_qtcpserver.moc"
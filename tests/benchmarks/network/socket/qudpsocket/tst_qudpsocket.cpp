@@ -41,6 +41,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void writeAndReceive_data();
+    void writeAndReceive();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -76,5 +78,57 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::writeAndReceive_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::addColumn<int>("size");
+    for (int size : {64, 512, 1400}) {
+        QTest::addRow("single-%d", size) << false << size;
+        QTest::addRow("batched-%d", size) << true << size;
+    }
+}
+
+// Measures the time to send and then receive a burst of small datagrams over
+// the loopback interface, one at a time or with writeDatagrams() and
+// receiveDatagrams(); divide Burst by the result to get packets per second.
+void tst_QUdpSocket::writeAndReceive()
+{
+    QFETCH(bool, batched);
+    QFETCH(int, size);
+    constexpr int Burst = 64;
+
+    QUdpSocket server;
+    QVERIFY(server.bind(QHostAddress::LocalHost));
+    QUdpSocket client;
+
+    const QList<QNetworkDatagram> datagrams(Burst, QNetworkDatagram(QByteArray(size, 'a'),
+                                                                    QHostAddress::LocalHost,
+                                                                    server.localPort()));
+    int received = 0;
+    QBENCHMARK {
+        if (batched) {
+            QCOMPARE(client.writeDatagrams(datagrams), Burst);
+        } else {
+            for (const QNetworkDatagram &datagram : datagrams)
+                QCOMPARE(client.writeDatagram(datagram), size);
+        }
+
+        received = 0;
+        while (received < Burst) {
+            if (!server.hasPendingDatagrams())
+                QVERIFY(server.waitForReadyRead(5000));
+            if (batched) {
+                received += server.receiveDatagrams(Burst - received).size();
+            } else {
+                while (received < Burst && server.hasPendingDatagrams()) {
+                    QCOMPARE(server.receiveDatagram().data().size(), size);
+                    ++received;
+                }
+            }
+        }
+    }
+    QCOMPARE(received, Burst);
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
@@ -52,6 +52,12 @@ private slots:
     void benchmark();
     void benchmarkSelectPrepared_data() { generic_data(); }
     void benchmarkSelectPrepared();
+    void benchmarkInsertPrepared_data() { generic_data(); }
+    void benchmarkInsertPrepared();
+    void benchmarkExecBatch_data() { generic_data(); }
+    void benchmarkExecBatch();
+    void benchmarkPsqlCopy_data() { generic_data("QPSQL"); }
+    void benchmarkPsqlCopy();
 
 private:
     // returns all database connections
@@ -293,4 +299,101 @@ void tst_QSqlQuery::benchmarkSelectPrepared()
     tst_Databases::safeDropTable(db, tableName);
 }
 
+static const int BatchRowCount = 10000;
+
+void tst_QSqlQuery::benchmarkInsertPrepared()
+{
+    QFETCH( QString, dbName );
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, t VARCHAR(45), d DOUBLE PRECISION)"));
+
+    const bool transactions = db.driver()->hasFeature(QSqlDriver::Transactions);
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?, ?)"));
+    QBENCHMARK {
+        if (transactions)
+            QVERIFY(db.transaction());
+        for (int i = 0; i < BatchRowCount; ++i) {
+            q.bindValue(0, i);
+            q.bindValue(1, QStringLiteral("Value%1").arg(i));
+            q.bindValue(2, i / 3.0);
+            QVERIFY_SQL(q, exec());
+        }
+        if (transactions)
+            QVERIFY(db.commit());
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::benchmarkExecBatch()
+{
+    QFETCH( QString, dbName );
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, t VARCHAR(45), d DOUBLE PRECISION)"));
+
+    QVariantList ids, texts, doubles;
+    for (int i = 0; i < BatchRowCount; ++i) {
+        ids << i;
+        texts << QStringLiteral("Value%1").arg(i);
+        doubles << i / 3.0;
+    }
+
+    const bool transactions = db.driver()->hasFeature(QSqlDriver::Transactions);
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?, ?)"));
+    QBENCHMARK {
+        if (transactions)
+            QVERIFY(db.transaction());
+        q.addBindValue(ids);
+        q.addBindValue(texts);
+        q.addBindValue(doubles);
+        QVERIFY_SQL(q, execBatch());
+        if (transactions)
+            QVERIFY(db.commit());
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::benchmarkPsqlCopy()
+{
+    QFETCH( QString, dbName );
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, t VARCHAR(45), d DOUBLE PRECISION)"));
+
+    QVariantList ids, texts, doubles;
+    for (int i = 0; i < BatchRowCount; ++i) {
+        ids << i;
+        texts << QStringLiteral("Value%1").arg(i);
+        doubles << i / 3.0;
+    }
+
+    QVERIFY_SQL(q, prepare("COPY " + tableName + " (id, t, d) FROM STDIN"));
+    QBENCHMARK {
+        q.addBindValue(ids);
+        q.addBindValue(texts);
+        q.addBindValue(doubles);
+        QVERIFY_SQL(q, execBatch());
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 #include "main.moc"